@@ -18,10 +18,75 @@
 #include <map>
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/mul_fp32.h"
 #include "nnacl/fp32/power_fp32.h"
+#include "nnacl/fp32/sub_fp32.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+using ElementFunc = int (*)(const float *, const float *, float *, int);
+using ElementOptFunc = int (*)(const float *, const float *, float *, int, const ArithmeticParameter *);
+
+// Routes the contiguous loops of a float op to the SIMD kernels of nnacl.
+template <typename Op>
+class NnaclElementwiseLoop {
+ public:
+  NnaclElementwiseLoop(Op op, ElementFunc element_func, ElementOptFunc element_opt_func)
+      : op_(op), element_func_(element_func), element_opt_func_(element_opt_func) {}
+  ~NnaclElementwiseLoop() = default;
+  float operator()(float a, float b) const { return op_(a, b); }
+  void Vector(const float *a, const float *b, float *out, size_t size) const {
+    (void)element_func_(a, b, out, SizeToInt(size));
+  }
+  void ScalarA(const float *a, const float *b, float *out, size_t size) const {
+    ArithmeticParameter param{};
+    param.in_elements_num0_ = 1;
+    param.in_elements_num1_ = SizeToInt(size);
+    (void)element_opt_func_(a, b, out, SizeToInt(size), &param);
+  }
+  void ScalarB(const float *a, const float *b, float *out, size_t size) const {
+    ArithmeticParameter param{};
+    param.in_elements_num0_ = SizeToInt(size);
+    param.in_elements_num1_ = 1;
+    (void)element_opt_func_(a, b, out, SizeToInt(size), &param);
+  }
+
+ private:
+  Op op_;
+  ElementFunc element_func_;
+  ElementOptFunc element_opt_func_;
+};
+
+template <typename Op>
+NnaclElementwiseLoop<Op> MakeNnaclElementwiseLoop(Op op, ElementFunc element_func, ElementOptFunc element_opt_func) {
+  return NnaclElementwiseLoop<Op>(op, element_func, element_opt_func);
+}
+
+template <typename T>
+T DivideWithZeroCheck(T dividend, T divisor) {
+  auto zero = (T)0;
+  if (divisor == zero) {
+    if (dividend == zero) {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+    if (std::numeric_limits<T>::has_infinity) {
+      return dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+    }
+    return dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+  }
+  return dividend / divisor;
+}
+}  // namespace
+
+template <typename T>
+template <typename Loop>
+void ArithmeticCPUKernel<T>::LaunchBroadcast(const Loop &loop, const T *input1, const T *input2, T *out) {
+  auto task = [&](size_t start, size_t end) { BroadcastLaunch(broadcast_pattern_, input1, input2, out, loop, start, end); };
+  CPUKernelUtils::ParallelForAutoSearch(task, output_size_, &parallel_search_info_);
+}
+
 template <typename T>
 void ArithmeticCPUKernel<T>::AssignAdd(T *input1, const T *input2, T *out) {
   auto task = [&input1, &input2, &out](size_t start, size_t end) {
@@ -30,183 +95,86 @@ void ArithmeticCPUKernel<T>::AssignAdd(T *input1, const T *input2, T *out) {
       input1[i] = out[i];
     }
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  CPUKernelUtils::ParallelForAutoSearch(task, output_size_, &parallel_search_info_);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Add(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] + input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a + b; };
+  if constexpr (std::is_same_v<T, float>) {
+    LaunchBroadcast(MakeNnaclElementwiseLoop(op, ElementAdd, ElementOptAdd), input1, input2, out);
+  } else {
+    LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
+  }
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Sub(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  if (output_size_ > MAX_SUB_SERIAL_SIZE) {
-    auto task = [&](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        out[i] = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a - b; };
+  if constexpr (std::is_same_v<T, float>) {
+    LaunchBroadcast(MakeNnaclElementwiseLoop(op, ElementSub, ElementOptSub), input1, input2, out);
   } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      out[i] = input1[base_iter.GetInputPosA()] - input2[base_iter.GetInputPosB()];
-      base_iter.GenNextPos();
-    }
+    LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
   }
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Mul(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] * input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a * b; };
+  if constexpr (std::is_same_v<T, float>) {
+    LaunchBroadcast(MakeNnaclElementwiseLoop(op, ElementMul, ElementOptMul), input1, input2, out);
+  } else {
+    LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
+  }
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::RealDiv(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = dividend / divisor;
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(DivideWithZeroCheck<T>), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Div(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = dividend / divisor;
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(DivideWithZeroCheck<T>), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::FloorDiv(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = (T)floor(static_cast<double>(dividend) / static_cast<double>(divisor));
+  auto op = [](T dividend, T divisor) {
+    auto zero = (T)0;
+    if (divisor == zero) {
+      return DivideWithZeroCheck(dividend, divisor);
     }
+    return (T)floor(static_cast<double>(dividend) / static_cast<double>(divisor));
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Mod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto data_div = x / y;
-      auto data_div_min = data_div < 0.0 ? data_div : 0.0;
-      auto data_div_max = data_div > 0.0 ? data_div : 0.0;
-      auto data_div_max_floor = floor(data_div_max);
-      auto data_div_min_ceil = ceil(data_div_min);
-      auto data_div_res = data_div_max_floor + data_div_min_ceil;
-      out[i] = static_cast<T>(x - data_div_res * y);
-    }
+  auto op = [](T a, T b) {
+    auto x = static_cast<double>(a);
+    auto y = static_cast<double>(b);
+    auto data_div = x / y;
+    auto data_div_min = data_div < 0.0 ? data_div : 0.0;
+    auto data_div_max = data_div > 0.0 ? data_div : 0.0;
+    auto data_div_max_floor = floor(data_div_max);
+    auto data_div_min_ceil = ceil(data_div_min);
+    auto data_div_res = data_div_max_floor + data_div_min_ceil;
+    return static_cast<T>(x - data_div_res * y);
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::FloorMod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto res = x - floor(x / y) * y;
-      out[i] = static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
-    }
+  auto op = [](T a, T b) {
+    auto x = static_cast<double>(a);
+    auto y = static_cast<double>(b);
+    auto res = x - floor(x / y) * y;
+    return static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
 }
 
 template <typename T>
@@ -219,58 +187,23 @@ void ArithmeticCPUKernel<T>::Pow(const T *input1, const T *input2, T *out) {
     Power(input1, input2, out, len, scale, shift, broadcast);
     return;
   }
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  if (output_size_ > MAX_POW_SERIAL_SIZE) {
-    auto task = [&](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-        auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-        out[i] = static_cast<T>(std::pow(x, y));
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size_);
-  } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      auto sx = static_cast<double>(input1[base_iter.GetInputPosA()]);
-      auto sy = static_cast<double>(input2[base_iter.GetInputPosB()]);
-      out[i] = static_cast<T>(std::pow(sx, sy));
-      base_iter.GenNextPos();
-    }
-  }
+  auto op = [](T a, T b) { return static_cast<T>(std::pow(static_cast<double>(a), static_cast<double>(b))); };
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::SquaredDifference(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      T diff = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-      out[i] = diff * diff;
-      iter.GenNextPos();
-    }
+  auto op = [](T a, T b) {
+    T diff = a - b;
+    return diff * diff;
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Atan2(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] =
-        (T)atan2(static_cast<double>(input1[iter.GetInputPosA()]), static_cast<double>(input2[iter.GetInputPosB()]));
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return (T)atan2(static_cast<double>(a), static_cast<double>(b)); };
+  LaunchBroadcast(MakeElementwiseLoop<T, T>(op), input1, input2, out);
 }
 
 static const std::map<std::string, OperateType> kArithmeticBinOpTypeMap = {
@@ -320,6 +253,7 @@ void ArithmeticCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
   CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
   CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_pattern_ = CPUKernelUtils::GetBroadcastPattern(input_shape1_, input_shape2_, output_shape_);
   dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetInputDeviceDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
@@ -21,9 +21,6 @@
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
-#define MAX_SUB_SERIAL_SIZE 15000
-#define MAX_POW_SERIAL_SIZE 700
-
 namespace mindspore {
 namespace kernel {
 template <typename T>
@@ -50,12 +47,15 @@ class ArithmeticCPUKernel : public CPUKernel {
   void AssignAdd(T *input1, const T *input2, T *out);
   void Atan2(const T *input1, const T *input2, T *out);
   void SquaredDifference(const T *input1, const T *input2, T *out);
+  template <typename Loop>
+  void LaunchBroadcast(const Loop &loop, const T *input1, const T *input2, T *out);
   std::vector<size_t> input_shape1_;
   std::vector<size_t> input_shape2_;
   std::vector<size_t> input_element_num1_;
   std::vector<size_t> input_element_num2_;
   std::vector<size_t> output_shape_;
   std::vector<size_t> output_element_num_;
+  BroadcastPattern broadcast_pattern_;
   size_t output_size_;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
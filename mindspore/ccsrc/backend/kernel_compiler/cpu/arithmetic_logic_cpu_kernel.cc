@@ -21,124 +21,59 @@
 
 namespace mindspore {
 namespace kernel {
+template <typename T>
+template <typename Loop>
+void ArithmeticLogicCPUKernel<T>::LaunchBroadcast(const Loop &loop, const T *input1, const T *input2, bool *out) {
+  auto task = [&](size_t start, size_t end) { BroadcastLaunch(broadcast_pattern_, input1, input2, out, loop, start, end); };
+  CPUKernelUtils::ParallelForAutoSearch(task, output_size_, &parallel_search_info_);
+}
+
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::Less(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  if (output_size_ > MAX_LESS_SERIAL_SIZE) {
-    auto task = [&](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        out[i] = input1[iter.GetInputPosA()] < input2[iter.GetInputPosB()];
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size_);
-  } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      out[i] = input1[base_iter.GetInputPosA()] < input2[base_iter.GetInputPosB()];
-      base_iter.GenNextPos();
-    }
-  }
+  auto op = [](T a, T b) { return a < b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::Equal(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] == input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a == b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::NotEqual(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] != input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a != b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::LogicalAnd(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] && input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a && b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::LogicalOr(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] || input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a || b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::Greater(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] > input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a > b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::GreaterEqual(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] >= input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a >= b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticLogicCPUKernel<T>::LessEqual(const T *input1, const T *input2, bool *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] <= input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](T a, T b) { return a <= b; };
+  LaunchBroadcast(MakeElementwiseLoop<T, bool>(op), input1, input2, out);
 }
 
 static const std::map<std::string, OperateType> kArithmeticBinOpTypeMap = {
@@ -180,6 +115,7 @@ void ArithmeticLogicCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
   CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
   CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_pattern_ = CPUKernelUtils::GetBroadcastPattern(input_shape1_, input_shape2_, output_shape_);
   dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetInputDeviceDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
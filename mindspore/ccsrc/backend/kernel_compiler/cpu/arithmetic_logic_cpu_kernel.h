@@ -21,8 +21,6 @@
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
-#define MAX_LESS_SERIAL_SIZE 15000
-
 namespace mindspore {
 namespace kernel {
 template <typename T>
@@ -46,12 +44,15 @@ class ArithmeticLogicCPUKernel : public CPUKernel {
   void LessEqual(const T *input1, const T *input2, bool *out);
   void LogicalAnd(const T *input1, const T *input2, bool *out);
   void LogicalOr(const T *input1, const T *input2, bool *out);
+  template <typename Loop>
+  void LaunchBroadcast(const Loop &loop, const T *input1, const T *input2, bool *out);
   std::vector<size_t> input_shape1_;
   std::vector<size_t> input_shape2_;
   std::vector<size_t> input_element_num1_;
   std::vector<size_t> input_element_num2_;
   std::vector<size_t> output_shape_;
   std::vector<size_t> output_element_num_;
+  BroadcastPattern broadcast_pattern_;
   size_t output_size_;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
@@ -31,7 +31,7 @@ void Square(const T *in, T *out, size_t size) {
       out[i] = in[i] * in[i];
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -47,7 +47,7 @@ void Sign(const T *in, T *out, size_t size) {
       }
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -57,7 +57,7 @@ void Neg(const T *in, T *out, size_t size) {
       out[i] = -in[i];
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -67,7 +67,7 @@ void LogicalNot(const T *in, T *out, size_t size) {
       out[i] = !in[i];
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -77,7 +77,7 @@ void OnesLike(const T *, T *out, size_t size) {
       out[i] = static_cast<T>(1);
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -87,7 +87,7 @@ void ZerosLike(const T *, T *out, size_t size) {
       out[i] = static_cast<T>(0);
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -97,7 +97,7 @@ void Floor(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(floor(in[i]));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -107,7 +107,7 @@ void Rint(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(rint(in[i]));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -117,7 +117,7 @@ void Round(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(nearbyint(in[i]));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -127,7 +127,7 @@ void Reciprocal(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(1.0 / in[i]);
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kCheapElementCost);
 }
 
 template <typename T>
@@ -140,7 +140,7 @@ void Gelu(const T *in, T *out, size_t size) {
       out[i] = x * (static_cast<T>(1.0) + tanh_res) / static_cast<T>(2.0);
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -150,7 +150,7 @@ void Asin(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(asin(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -160,7 +160,7 @@ void ACos(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(acos(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -170,7 +170,7 @@ void Atan(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(atan(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -180,7 +180,7 @@ void Sin(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(sin(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -190,7 +190,7 @@ void Cos(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(cos(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -200,7 +200,7 @@ void Tan(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(tan(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -210,7 +210,7 @@ void Sinh(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(sinh(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -220,7 +220,7 @@ void Cosh(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(cosh(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -230,7 +230,7 @@ void Asinh(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(asinh(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -240,7 +240,7 @@ void Acosh(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(acosh(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -250,7 +250,7 @@ void Atanh(const T *in, T *out, size_t size) {
       out[i] = static_cast<T>(atanh(static_cast<double>(in[i])));
     }
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  CPUKernelUtils::ParallelForWithCost(task, size, kTranscendentalElementCost);
 }
 
 template <typename T>
@@ -15,6 +15,9 @@
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <sstream>
 #include <utility>
 #include "common/thread_pool.h"
 
@@ -45,6 +48,8 @@ void CPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
 }
 
 void CPUKernel::Init(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  parallel_search_info_.kernel_name = kernel_node->fullname_with_scope();
   InitKernel(kernel_node);
   InitInputOutputSize(kernel_node);
 }
@@ -85,23 +90,99 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   std::reverse(element_num->begin(), element_num->end());
 }
 
+namespace {
+void ParallelLaunch(const CTask &task, size_t count, size_t grain, size_t thread_num) {
+  if (thread_num <= 1 || count <= grain) {
+    task(0, count);
+    return;
+  }
+  auto run_range = [](const void *closure, size_t start, size_t end) {
+    (*static_cast<const CTask *>(closure))(start, end);
+    return static_cast<int>(common::SUCCESS);
+  };
+  (void)common::ThreadPool::GetInstance().ParallelLaunch(run_range, &task, count, grain, thread_num);
+}
+
+// A few chunks per thread let threads which finish early steal from the others.
+size_t GetParallelGrain(size_t count, size_t thread_num) {
+  size_t chunk_num = thread_num * kParallelChunksPerThread;
+  return std::max((count + chunk_num - 1) / chunk_num, static_cast<size_t>(1));
+}
+
+void InitParallelSearch(size_t count, ParallelSearchInfo *parallel_search_info) {
+  size_t max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  parallel_search_info->count = count;
+  parallel_search_info->search_step = 0;
+  parallel_search_info->best_thread_num = 0;
+  parallel_search_info->candidate_thread_nums.clear();
+  for (size_t thread_num = 1; thread_num < max_thread_num; thread_num *= 2) {
+    parallel_search_info->candidate_thread_nums.push_back(thread_num);
+  }
+  parallel_search_info->candidate_thread_nums.push_back(max_thread_num);
+  parallel_search_info->cost_times.assign(parallel_search_info->candidate_thread_nums.size(), DBL_MAX);
+}
+}  // namespace
+
 void CPUKernelUtils::ParallelFor(const CTask &task, size_t count) {
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  const float block_size = 128.0;
-  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
-  std::vector<common::Task> tasks;
-  size_t start = 0;
-  size_t once_compute_size = (count + thread_num - 1) / thread_num;
-  while (start < count) {
-    size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
-    auto block = [&, start, end]() {
-      task(start, end);
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(block);
-    start += once_compute_size;
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  // Without a cost estimate never go below the minimum grain, where the dispatch costs more than the work.
+  ParallelLaunch(task, count, std::max(GetParallelGrain(count, thread_num), kParallelMinGrain), thread_num);
+}
+
+void CPUKernelUtils::ParallelForWithCost(const CTask &task, size_t count, float cost) {
+  size_t max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  float total_cost = static_cast<float>(count) * cost;
+  size_t thread_num = std::min(max_thread_num, static_cast<size_t>(total_cost / kParallelMinTaskCost));
+  thread_num = std::max(thread_num, static_cast<size_t>(1));
+  ParallelLaunch(task, count, GetParallelGrain(count, thread_num), thread_num);
+}
+
+void CPUKernelUtils::ParallelForAutoSearch(const CTask &task, size_t count, ParallelSearchInfo *parallel_search_info) {
+  MS_EXCEPTION_IF_NULL(parallel_search_info);
+  if (parallel_search_info->count != count || parallel_search_info->candidate_thread_nums.empty()) {
+    InitParallelSearch(count, parallel_search_info);
+  }
+  if (parallel_search_info->best_thread_num != 0) {
+    size_t thread_num = parallel_search_info->best_thread_num;
+    ParallelLaunch(task, count, GetParallelGrain(count, thread_num), thread_num);
+    return;
+  }
+
+  size_t candidate = parallel_search_info->search_step / kParallelSearchRounds;
+  size_t thread_num = parallel_search_info->candidate_thread_nums[candidate];
+  auto start_time = std::chrono::steady_clock::now();
+  ParallelLaunch(task, count, GetParallelGrain(count, thread_num), thread_num);
+  double cost_time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_time).count();
+  auto &cost_times = parallel_search_info->cost_times;
+  cost_times[candidate] = std::min(cost_times[candidate], cost_time);
+
+  if (++parallel_search_info->search_step < cost_times.size() * kParallelSearchRounds) {
+    return;
+  }
+  auto best = std::min_element(cost_times.begin(), cost_times.end()) - cost_times.begin();
+  parallel_search_info->best_thread_num = parallel_search_info->candidate_thread_nums[best];
+  MS_LOG(INFO) << DumpParallelSearchInfo(*parallel_search_info);
+}
+
+std::string CPUKernelUtils::DumpParallelSearchInfo(const ParallelSearchInfo &parallel_search_info) {
+  std::ostringstream buffer;
+  buffer << "Parallel search of kernel " << parallel_search_info.kernel_name << " with "
+         << parallel_search_info.count << " elements";
+  if (parallel_search_info.best_thread_num == 0) {
+    buffer << " is not finished, step " << parallel_search_info.search_step << ".";
+  } else {
+    buffer << " chose thread num " << parallel_search_info.best_thread_num << ".";
+  }
+  buffer << " Cost time (us) by thread num:";
+  for (size_t i = 0; i < parallel_search_info.cost_times.size(); ++i) {
+    buffer << " " << parallel_search_info.candidate_thread_nums[i] << ": ";
+    if (parallel_search_info.cost_times[i] == DBL_MAX) {
+      buffer << "-";
+    } else {
+      buffer << parallel_search_info.cost_times[i];
+    }
+  }
+  return buffer.str();
 }
 
 std::vector<size_t> CPUKernelUtils::FlatShapeByAxis(const std::vector<size_t> &shape, int axis) {
@@ -123,6 +204,60 @@ std::vector<size_t> CPUKernelUtils::FlatShapeByAxis(const std::vector<size_t> &s
   return flat_shape;
 }
 
+BroadcastPattern CPUKernelUtils::GetBroadcastPattern(const std::vector<size_t> &shape_a,
+                                                     const std::vector<size_t> &shape_b,
+                                                     const std::vector<size_t> &output_shape) {
+  const int kSpanA = 1;
+  const int kSpanB = 2;
+  const int kSpanBoth = kSpanA | kSpanB;
+  size_t dimension = output_shape.size();
+  if (shape_a.size() > dimension || shape_b.size() > dimension) {
+    MS_LOG(EXCEPTION) << "Input shapes " << shape_a << " and " << shape_b << " can not broadcast to " << output_shape;
+  }
+  // Merge adjacent output dimensions which are spanned by the same inputs, dimensions of size 1 carry no data.
+  std::vector<std::pair<int, size_t>> merged_dims;
+  for (size_t i = 0; i < dimension; ++i) {
+    size_t out_dim = output_shape[i];
+    if (out_dim == 1) {
+      continue;
+    }
+    size_t a_dim = i + shape_a.size() < dimension ? 1 : shape_a[i + shape_a.size() - dimension];
+    size_t b_dim = i + shape_b.size() < dimension ? 1 : shape_b[i + shape_b.size() - dimension];
+    int span = (a_dim == out_dim ? kSpanA : 0) | (b_dim == out_dim ? kSpanB : 0);
+    if (span == 0 || (a_dim != out_dim && a_dim != 1) || (b_dim != out_dim && b_dim != 1)) {
+      MS_LOG(EXCEPTION) << "Input shapes " << shape_a << " and " << shape_b << " can not broadcast to "
+                        << output_shape;
+    }
+    if (!merged_dims.empty() && merged_dims.back().first == span) {
+      merged_dims.back().second *= out_dim;
+    } else {
+      merged_dims.emplace_back(span, out_dim);
+    }
+  }
+
+  BroadcastPattern pattern;
+  if (merged_dims.empty()) {
+    merged_dims.emplace_back(kSpanBoth, 1);
+  }
+  for (const auto &dim : merged_dims) {
+    pattern.shape_a.push_back((dim.first & kSpanA) != 0 ? dim.second : 1);
+    pattern.shape_b.push_back((dim.first & kSpanB) != 0 ? dim.second : 1);
+    pattern.output_shape.push_back(dim.second);
+  }
+  pattern.inner_size = merged_dims.back().second;
+  if (merged_dims.size() == 1) {
+    int span = merged_dims[0].first;
+    pattern.type = span == kSpanBoth ? BROADCAST_SAME_SHAPE : (span == kSpanB ? BROADCAST_SCALAR_A : BROADCAST_SCALAR_B);
+  } else if (merged_dims.size() == 2 && merged_dims[1].first == kSpanBoth) {
+    pattern.type = merged_dims[0].first == kSpanB ? BROADCAST_ROW_A : BROADCAST_ROW_B;
+  } else if (merged_dims.size() == 2 && merged_dims[0].first == kSpanBoth) {
+    pattern.type = merged_dims[1].first == kSpanB ? BROADCAST_COLUMN_A : BROADCAST_COLUMN_B;
+  } else {
+    pattern.type = BROADCAST_GENERAL;
+  }
+  return pattern;
+}
+
 BroadcastIterator::BroadcastIterator(std::vector<size_t> input_shape_a, std::vector<size_t> input_shape_b,
                                      std::vector<size_t> output_shape)
     : input_shape_a_(std::move(input_shape_a)),
@@ -15,6 +15,7 @@
  */
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -62,6 +63,14 @@ const char DELTA[] = "delta";
 const char SORTED[] = "sorted";
 const char ADJ_ST[] = "adjoint_st";
 const char ADJ_dT[] = "adjoint_dt";
+const size_t kParallelMinGrain = 128;
+const size_t kParallelChunksPerThread = 4;
+// Work in nanoseconds that one thread needs to get before another thread is worth waking up.
+const float kParallelMinTaskCost = 10000.0;
+// Rough per element costs in nanoseconds for CPUKernelUtils::ParallelForWithCost.
+const float kCheapElementCost = 1.0;
+const float kTranscendentalElementCost = 20.0;
+const size_t kParallelSearchRounds = 2;
 
 enum OperateType {
   ADD = 0,
@@ -122,6 +131,17 @@ enum OperateType {
   IDENTITY,
 };
 
+// Learned by CPUKernelUtils::ParallelForAutoSearch: the first launches of a kernel try every candidate thread num,
+// later launches with the same element count reuse the fastest one.
+struct ParallelSearchInfo {
+  std::string kernel_name;
+  size_t count{0};
+  size_t search_step{0};
+  size_t best_thread_num{0};
+  std::vector<size_t> candidate_thread_nums;
+  std::vector<double> cost_times;
+};
+
 class CPUKernel : public kernel::KernelMod {
  public:
   CPUKernel() = default;
@@ -137,12 +157,37 @@ class CPUKernel : public kernel::KernelMod {
   const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
   const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
   const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  const ParallelSearchInfo &parallel_search_info() const { return parallel_search_info_; }
 
  protected:
   virtual void InitInputOutputSize(const CNodePtr &kernel_node);
   std::vector<size_t> input_size_list_;
   std::vector<size_t> output_size_list_;
   std::vector<size_t> workspace_size_list_;
+  ParallelSearchInfo parallel_search_info_;
+};
+
+// How the two inputs of a binary op map onto the output once adjacent dimensions with the same broadcast behaviour
+// are merged. ROW means an input of shape (1, inner) repeated over the outer rows of the output, COLUMN an input of
+// shape (outer, 1) repeated along each row.
+enum BroadcastType {
+  BROADCAST_SAME_SHAPE = 0,
+  BROADCAST_SCALAR_A,
+  BROADCAST_SCALAR_B,
+  BROADCAST_ROW_A,
+  BROADCAST_ROW_B,
+  BROADCAST_COLUMN_A,
+  BROADCAST_COLUMN_B,
+  BROADCAST_GENERAL,
+};
+
+struct BroadcastPattern {
+  BroadcastType type{BROADCAST_GENERAL};
+  size_t inner_size{1};
+  // Collapsed shapes, used by BroadcastIterator for the general pattern.
+  std::vector<size_t> shape_a;
+  std::vector<size_t> shape_b;
+  std::vector<size_t> output_shape;
 };
 
 class CPUKernelUtils {
@@ -152,8 +197,14 @@ class CPUKernelUtils {
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
   static void ParallelFor(const CTask &task, size_t count);
+  // cost is the estimated time in nanoseconds to compute one element.
+  static void ParallelForWithCost(const CTask &task, size_t count, float cost);
+  static void ParallelForAutoSearch(const CTask &task, size_t count, ParallelSearchInfo *parallel_search_info);
+  static std::string DumpParallelSearchInfo(const ParallelSearchInfo &parallel_search_info);
   static std::vector<size_t> FlatShapeByAxis(const std::vector<size_t> &shape, int axis);
   static std::vector<size_t> GetBroadcastShape(const std::vector<size_t> &x, const std::vector<size_t> &y);
+  static BroadcastPattern GetBroadcastPattern(const std::vector<size_t> &shape_a, const std::vector<size_t> &shape_b,
+                                              const std::vector<size_t> &output_shape);
 };
 
 class BroadcastIterator {
@@ -182,6 +233,91 @@ class BroadcastIterator {
   int output_dimension_{0};
 };
 
+// Contiguous loops of a binary op which the compiler can vectorise. Kernels with hand written SIMD loops provide a class
+// with the same members.
+template <typename T, typename S, typename Op>
+class ElementwiseLoop {
+ public:
+  explicit ElementwiseLoop(Op op) : op_(op) {}
+  ~ElementwiseLoop() = default;
+  S operator()(T a, T b) const { return op_(a, b); }
+  void Vector(const T *a, const T *b, S *out, size_t size) const {
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = op_(a[i], b[i]);
+    }
+  }
+  void ScalarA(const T *a, const T *b, S *out, size_t size) const {
+    T scalar = a[0];
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = op_(scalar, b[i]);
+    }
+  }
+  void ScalarB(const T *a, const T *b, S *out, size_t size) const {
+    T scalar = b[0];
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = op_(a[i], scalar);
+    }
+  }
+
+ private:
+  Op op_;
+};
+
+template <typename T, typename S, typename Op>
+ElementwiseLoop<T, S, Op> MakeElementwiseLoop(Op op) {
+  return ElementwiseLoop<T, S, Op>(op);
+}
+
+// Compute the output range [start, end) of a binary op with the loops matching its broadcast pattern.
+template <typename T, typename S, typename Loop>
+void BroadcastLaunch(const BroadcastPattern &pattern, const T *a, const T *b, S *out, const Loop &loop, size_t start,
+                     size_t end) {
+  size_t inner = pattern.inner_size;
+  switch (pattern.type) {
+    case BROADCAST_SAME_SHAPE:
+      loop.Vector(a + start, b + start, out + start, end - start);
+      return;
+    case BROADCAST_SCALAR_A:
+      loop.ScalarA(a, b + start, out + start, end - start);
+      return;
+    case BROADCAST_SCALAR_B:
+      loop.ScalarB(a + start, b, out + start, end - start);
+      return;
+    case BROADCAST_GENERAL: {
+      BroadcastIterator iter(pattern.shape_a, pattern.shape_b, pattern.output_shape);
+      iter.SetPos(start);
+      for (size_t i = start; i < end; ++i) {
+        out[i] = loop(a[iter.GetInputPosA()], b[iter.GetInputPosB()]);
+        iter.GenNextPos();
+      }
+      return;
+    }
+    default:
+      break;
+  }
+  // Row and column patterns, walk the range one output row segment at a time.
+  for (size_t i = start; i < end;) {
+    size_t row = i / inner;
+    size_t col = i % inner;
+    size_t size = std::min(inner - col, end - i);
+    switch (pattern.type) {
+      case BROADCAST_ROW_A:
+        loop.Vector(a + col, b + i, out + i, size);
+        break;
+      case BROADCAST_ROW_B:
+        loop.Vector(a + i, b + col, out + i, size);
+        break;
+      case BROADCAST_COLUMN_A:
+        loop.ScalarA(a + row, b + i, out + i, size);
+        break;
+      default:
+        loop.ScalarB(a + i, b + row, out + i, size);
+        break;
+    }
+    i += size;
+  }
+}
+
 class TransposeIterator {
  public:
   TransposeIterator(std::vector<size_t> output_shape, std::vector<size_t> axes, const std::vector<size_t> &input_shape);
@@ -36,43 +36,18 @@ class MinimumCPUKernel : public CPUKernel {
  private:
   void CheckParam(const CNodePtr &kernel_node);
 
-  bool IsBroadcast();
-
-  size_t Index(const size_t &index, const size_t &dim);
-
-  void InitTensorBroadcastShape();
-
   void InitInputTensorAndScalar(size_t max_input_shape_size);
 
   void InitInputTensors(TypeId input_x_dtype, TypeId input_y_dtype);
 
-  // Broadcast Arithmetic
-  void BroadcastArithKernel(const size_t l0, const size_t l1, const size_t l2, const size_t l3, const size_t l4,
-                            const size_t l5, const size_t l6, const size_t r0, const size_t r1, const size_t r2,
-                            const size_t r3, const size_t r4, const size_t r5, const size_t r6, const size_t d0,
-                            const size_t d1, const size_t d2, const size_t d3, const size_t d4, const size_t d5,
-                            const size_t d6, const T *input_x, const T *input_y, T *output);
-
-  T MinimumFunc(const T &lhs, const T &rhs) { return lhs < rhs ? lhs : rhs; }
-
-  void BroadcastArithOneScalarOneTensor(const T *input_x, const T *input_y, T *output);
-
-  void BroadcastArithTensors(const T *input_x, const T *input_y, T *output);
-
   void BroadcastArith(const T *input_x, const T *input_y, T *output);
 
  private:
-  bool need_broadcast_{false};
-  size_t input_x_num_{1};
-  size_t input_y_num_{1};
   size_t output_num_{1};
   std::vector<size_t> input_x_shape_;
   std::vector<size_t> input_y_shape_;
   std::vector<size_t> output_shape_;
-  std::vector<size_t> broadcast_input_x_shape_;
-  std::vector<size_t> broadcast_input_y_shape_;
-  std::vector<size_t> broadcast_output_shape_;
-  const size_t max_dims{7};
+  BroadcastPattern broadcast_pattern_;
 };
 
 MS_REG_CPU_KERNEL_T(Minimum, KernelAttr(), MinimumCPUKernel, int32_t);
@@ -121,6 +121,19 @@ void MinimumGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, c
   auto dx_addr = reinterpret_cast<T *>(outputs[0]->addr);
   auto dy_addr = reinterpret_cast<T *>(outputs[1]->addr);
 
+  if (x_shape_ == dout_shape && y_shape_ == dout_shape) {
+    // No broadcast, every dout element goes to exactly one of dx and dy.
+    auto task = [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; i++) {
+        bool to_x = x_addr[i] <= y_addr[i];
+        dx_addr[i] = to_x ? dout_addr[i] : static_cast<T>(0);
+        dy_addr[i] = to_x ? static_cast<T>(0) : dout_addr[i];
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, GetTensorLen(dout_shape));
+    return;
+  }
+
   size_t x_tensor_len = GetTensorLen(x_shape_);
   size_t y_tensor_len = GetTensorLen(y_shape_);
   if (memset_s(dx_addr, x_tensor_len * sizeof(T), 0x00, x_tensor_len * sizeof(T)) != EOK) {
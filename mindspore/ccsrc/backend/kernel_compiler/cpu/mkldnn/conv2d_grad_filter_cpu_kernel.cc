@@ -42,6 +42,7 @@ void Conv2dGradFilterCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
   dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
   dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc weights_any_desc = GetAnyMemDesc(weight_shape);
   std::vector<int> stride_ori;
   std::vector<int> dilation_ori;
   auto stride_me = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, STRIDE);
@@ -70,22 +71,34 @@ void Conv2dGradFilterCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::convolution_forward::desc forward_desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
-
-  auto forward_prim_desc = dnnl::convolution_forward::primitive_desc(forward_desc, MKLKernelEngine::Get().engine());
-
-  dnnl::convolution_backward_weights::desc backward_desc = dnnl::convolution_backward_weights::desc(
-    dnnl::algorithm::convolution_auto, src_desc, weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
-
-  auto backward_prim_desc = dnnl::convolution_backward_weights::primitive_desc(
-    backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::convolution_backward_weights>(backward_prim_desc);
-
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
-  AddArgument(DNNL_ARG_DIFF_WEIGHTS, weights_desc);
+  auto key = GetPrimitiveKey("conv_backward_weights", {src_desc.dims(), weights_desc.dims(), dst_desc.dims(), strides,
+                                                       dilates, padding_l, padding_r});
+  auto primitive_info = MKLKernelEngine::Get().GetPrimitive(key);
+  if (primitive_info == nullptr) {
+    const auto &engine = MKLKernelEngine::Get().engine();
+    dnnl::convolution_forward::desc forward_desc =
+      dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                      src_desc, weights_any_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    auto forward_prim_desc = dnnl::convolution_forward::primitive_desc(forward_desc, engine);
+    dnnl::convolution_backward_weights::desc backward_desc = dnnl::convolution_backward_weights::desc(
+      dnnl::algorithm::convolution_auto, src_desc, weights_any_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    auto backward_prim_desc =
+      dnnl::convolution_backward_weights::primitive_desc(backward_desc, MKLKernelEngine::CachedPrimitiveAttr(), engine,
+                                                         forward_prim_desc);
+    primitive_info = std::make_shared<MKLPrimitiveInfo>();
+    primitive_info->primitive = std::make_shared<dnnl::convolution_backward_weights>(backward_prim_desc);
+    primitive_info->arg_descs = {{DNNL_ARG_SRC, backward_prim_desc.src_desc()},
+                                 {DNNL_ARG_DIFF_DST, backward_prim_desc.diff_dst_desc()},
+                                 {DNNL_ARG_DIFF_WEIGHTS, backward_prim_desc.diff_weights_desc()},
+                                 {DNNL_ARG_SCRATCHPAD, backward_prim_desc.scratchpad_desc()}};
+    MKLKernelEngine::Get().CachePrimitive(key, primitive_info);
+  }
+  primitive_ = primitive_info->primitive;
+  const auto &arg_descs = primitive_info->arg_descs;
+  AddReorderArgument(DNNL_ARG_SRC, src_desc, arg_descs.at(DNNL_ARG_SRC));
+  AddReorderArgument(DNNL_ARG_DIFF_DST, dst_desc, arg_descs.at(DNNL_ARG_DIFF_DST));
+  AddReorderArgument(DNNL_ARG_DIFF_WEIGHTS, weights_desc, arg_descs.at(DNNL_ARG_DIFF_WEIGHTS), true);
+  AddArgument(DNNL_ARG_SCRATCHPAD, arg_descs.at(DNNL_ARG_SCRATCHPAD), true);
 }
 
 bool Conv2dGradFilterCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -52,6 +52,7 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
   dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
   dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc weights_any_desc = GetAnyMemDesc(weight_shape);
   std::vector<int> stride_ori;
   std::vector<int> dilation_ori;
   auto stride_attr = src_dim == kShapeSize4D ? STRIDE : STRIDES;
@@ -98,15 +99,31 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     padding_l.emplace_back(int_padding_l[i]);
     padding_r.emplace_back(int_padding_r[i]);
   }
-  dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
-
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  auto prop_kind = GetForwardPropKind(kernel_node);
+  auto key =
+    GetPrimitiveKey("conv_forward", {{static_cast<int64_t>(prop_kind)}, src_desc.dims(), weights_desc.dims(),
+                                     dst_desc.dims(), strides, dilates, padding_l, padding_r});
+  auto primitive_info = MKLKernelEngine::Get().GetPrimitive(key);
+  if (primitive_info == nullptr) {
+    dnnl::convolution_forward::desc desc =
+      dnnl::convolution_forward::desc(prop_kind, dnnl::algorithm::convolution_auto, src_desc, weights_any_desc,
+                                      dst_desc, strides, dilates, padding_l, padding_r);
+    auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::CachedPrimitiveAttr(),
+                                                               MKLKernelEngine::Get().engine());
+    primitive_info = std::make_shared<MKLPrimitiveInfo>();
+    primitive_info->primitive = std::make_shared<dnnl::convolution_forward>(prim_desc);
+    primitive_info->arg_descs = {{DNNL_ARG_SRC, prim_desc.src_desc()},
+                                 {DNNL_ARG_WEIGHTS, prim_desc.weights_desc()},
+                                 {DNNL_ARG_DST, prim_desc.dst_desc()},
+                                 {DNNL_ARG_SCRATCHPAD, prim_desc.scratchpad_desc()}};
+    MKLKernelEngine::Get().CachePrimitive(key, primitive_info);
+  }
+  primitive_ = primitive_info->primitive;
+  const auto &arg_descs = primitive_info->arg_descs;
+  AddReorderArgument(DNNL_ARG_SRC, src_desc, arg_descs.at(DNNL_ARG_SRC));
+  AddReorderArgument(DNNL_ARG_WEIGHTS, weights_desc, arg_descs.at(DNNL_ARG_WEIGHTS));
+  AddReorderArgument(DNNL_ARG_DST, dst_desc, arg_descs.at(DNNL_ARG_DST), true);
+  AddArgument(DNNL_ARG_SCRATCHPAD, arg_descs.at(DNNL_ARG_SCRATCHPAD), true);
 }
 
 bool ConvCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
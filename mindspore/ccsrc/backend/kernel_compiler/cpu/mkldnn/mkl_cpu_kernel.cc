@@ -16,9 +16,13 @@
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_cpu_kernel.h"
 #include <vector>
 #include <string>
+#include <sstream>
 #include <algorithm>
 #include "utils/ms_utils.h"
+#include "utils/flags.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
 
 namespace mindspore {
 namespace kernel {
@@ -142,18 +146,112 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+dnnl::memory::desc MKLCPUKernel::GetAnyMemDesc(const std::vector<size_t> &shape) {
+  dnnl::memory::dims dims;
+  if (shape.size() == 0) {
+    dims.insert(dims.end(), 1);
+  } else {
+    dims.insert(dims.end(), shape.begin(), shape.end());
+  }
+  dnnl::memory::desc mem_desc(dims, dnnl::memory::data_type::f32, dnnl::memory::format_tag::any);
+  return mem_desc;
+}
+
+namespace {
+bool HasWrittenWeight(const session::KernelGraph &kernel_graph) {
+  // Optimizers and Assign write the weights they take as input and carry the side_effect_mem flag.
+  for (const auto &node : kernel_graph.execution_order()) {
+    auto prim = AnfAlgo::GetCNodePrimitive(node);
+    if (prim == nullptr || !prim->HasAttr(GRAPH_FLAG_SIDE_EFFECT_MEM)) {
+      continue;
+    }
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(node); ++i) {
+      auto node_input = AnfAlgo::VisitKernel(AnfAlgo::GetInputNode(node, i), 0).first;
+      if (node_input->isa<Parameter>() && AnfAlgo::IsParameterWeight(node_input->cast<ParameterPtr>())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+session::KernelGraph *GetKernelGraph(const CNodePtr &kernel_node) {
+  auto func_graph = kernel_node->func_graph();
+  if (func_graph == nullptr || !func_graph->isa<session::KernelGraph>()) {
+    return nullptr;
+  }
+  return func_graph->cast<KernelGraphPtr>().get();
+}
+}  // namespace
+
+dnnl::prop_kind MKLCPUKernel::GetForwardPropKind(const CNodePtr &kernel_node) const {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto kernel_graph = GetKernelGraph(kernel_node);
+  if (kernel_graph == nullptr || HasWrittenWeight(*kernel_graph)) {
+    return dnnl::prop_kind::forward_training;
+  }
+  return dnnl::prop_kind::forward_inference;
+}
+
+std::string MKLCPUKernel::GetPrimitiveKey(const std::string &name,
+                                          const std::vector<dnnl::memory::dims> &params) const {
+  std::ostringstream key;
+  key << name;
+  for (const auto &param : params) {
+    key << ";";
+    for (auto value : param) {
+      key << value << ",";
+    }
+  }
+  return key.str();
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
 
+void MKLCPUKernel::AddReorderArgument(int arg_key, const dnnl::memory::desc &user_desc,
+                                      const dnnl::memory::desc &prim_desc, bool is_output) {
+  if (user_desc == prim_desc) {
+    AddArgument(arg_key, user_desc);
+    return;
+  }
+  MS_LOG(DEBUG) << "Argument " << arg_key << " of " << parallel_search_info_.kernel_name
+                << " uses the primitive layout and needs a reorder.";
+  AddArgument(arg_key, prim_desc, true);
+  ReorderArgument reorder_argument;
+  reorder_argument.user_mem = MKLKernelEngine::Get().CreateMemory(user_desc);
+  reorder_argument.is_output = is_output;
+  reorder_arguments_[arg_key] = reorder_argument;
+}
+
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  auto reorder_iter = reorder_arguments_.find(arg_key);
+  if (reorder_iter != reorder_arguments_.end()) {
+    reorder_iter->second.user_mem.set_data_handle(ptr);
+    return;
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
   }
 }
 
-void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+void MKLCPUKernel::ExecutePrimitive() {
+  for (auto &item : reorder_arguments_) {
+    auto &reorder_argument = item.second;
+    if (reorder_argument.is_output) {
+      continue;
+    }
+    Reorder(&reorder_argument.user_mem, &arguments_[item.first]);
+  }
+  MKLKernelEngine::Get().Execute(primitive_, arguments_);
+  for (auto &item : reorder_arguments_) {
+    if (item.second.is_output) {
+      Reorder(&arguments_[item.first], &item.second.user_mem);
+    }
+  }
+}
 
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
@@ -38,9 +38,21 @@ class MKLCPUKernel : public CPUKernel {
                   const std::vector<size_t> &kernel_size, const std::vector<int> &stride, std::vector<int> *padding_l,
                   std::vector<int> *padding_r, const std::vector<int> &dilation);
   void AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc = false);
+  // Add an argument whose primitive layout prim_desc may differ from the plain layout user_desc of the kernel address.
+  // Inputs are reordered before and outputs after each execution. Weights are reordered every time too, as the kernel
+  // cannot tell whether another graph updated them in place.
+  void AddReorderArgument(int arg_key, const dnnl::memory::desc &user_desc, const dnnl::memory::desc &prim_desc,
+                          bool is_output = false);
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // Memory desc which lets the primitive choose its preferred, usually blocked, layout. Only used for the weights, the
+  // layout is not propagated between kernels, so blocked activations would be reordered in and out on every launch.
+  dnnl::memory::desc GetAnyMemDesc(const std::vector<size_t> &shape);
+  // forward_inference unless a kernel of the graph updates weights, which skips workspace and statistics outputs.
+  dnnl::prop_kind GetForwardPropKind(const CNodePtr &kernel_node) const;
+  // Key of the primitive cache in MKLKernelEngine: the op name plus the dims and values which define the primitive.
+  std::string GetPrimitiveKey(const std::string &name, const std::vector<dnnl::memory::dims> &params) const;
   void ExecutePrimitive();
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
@@ -48,6 +60,13 @@ class MKLCPUKernel : public CPUKernel {
     return dnnl::memory::desc{{dimensions}, dnnl::memory::data_type::f32, layout};
   }
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
+
+ private:
+  struct ReorderArgument {
+    dnnl::memory user_mem;
+    bool is_output{false};
+  };
+  std::unordered_map<int, ReorderArgument> reorder_arguments_;
 };
 }  // namespace kernel
 }  // namespace mindspore
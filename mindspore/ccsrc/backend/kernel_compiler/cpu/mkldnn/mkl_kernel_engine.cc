@@ -19,6 +19,8 @@
 
 namespace mindspore {
 namespace kernel {
+constexpr size_t kPrimitiveCacheCapacity = 1024;
+
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
@@ -36,5 +38,32 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
 }
+
+MKLPrimitiveInfoPtr MKLKernelEngine::GetPrimitive(const std::string &key) {
+  std::lock_guard<std::mutex> lock(primitive_cache_mutex_);
+  auto iter = primitive_cache_.find(key);
+  if (iter == primitive_cache_.end()) {
+    return nullptr;
+  }
+  primitive_list_.splice(primitive_list_.begin(), primitive_list_, iter->second);
+  return iter->second->second;
+}
+
+void MKLKernelEngine::CachePrimitive(const std::string &key, const MKLPrimitiveInfoPtr &primitive_info) {
+  MS_EXCEPTION_IF_NULL(primitive_info);
+  std::lock_guard<std::mutex> lock(primitive_cache_mutex_);
+  auto iter = primitive_cache_.find(key);
+  if (iter != primitive_cache_.end()) {
+    iter->second->second = primitive_info;
+    primitive_list_.splice(primitive_list_.begin(), primitive_list_, iter->second);
+    return;
+  }
+  primitive_list_.emplace_front(key, primitive_info);
+  primitive_cache_[key] = primitive_list_.begin();
+  if (primitive_list_.size() > kPrimitiveCacheCapacity) {
+    (void)primitive_cache_.erase(primitive_list_.back().first);
+    primitive_list_.pop_back();
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
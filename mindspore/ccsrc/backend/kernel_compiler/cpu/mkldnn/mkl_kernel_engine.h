@@ -18,8 +18,11 @@
 #include <cstdlib>
 #include <algorithm>
 #include <iostream>
+#include <list>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <memory>
 #include "dnnl.hpp"
@@ -27,6 +30,15 @@
 
 namespace mindspore {
 namespace kernel {
+// A primitive shared by all kernels with the same key, with the memory desc it expects for each DNNL_ARG_*. It is
+// created with a user scratchpad, each kernel passes its own DNNL_ARG_SCRATCHPAD memory, so the kernels sharing the
+// primitive can execute it at the same time on different threads.
+struct MKLPrimitiveInfo {
+  std::shared_ptr<dnnl::primitive> primitive;
+  std::unordered_map<int, dnnl::memory::desc> arg_descs;
+};
+using MKLPrimitiveInfoPtr = std::shared_ptr<MKLPrimitiveInfo>;
+
 class MKLKernelEngine {
  public:
   static MKLKernelEngine &Get() {
@@ -43,11 +55,25 @@ class MKLKernelEngine {
                const std::unordered_map<int, dnnl::memory> &arguments);
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
+  // Process wide LRU cache of primitives, so kernels with identical descriptors do not JIT the same code again on
+  // graph compile or dynamic shape re-init. GetPrimitive returns nullptr when the key is not cached.
+  MKLPrimitiveInfoPtr GetPrimitive(const std::string &key);
+  void CachePrimitive(const std::string &key, const MKLPrimitiveInfoPtr &primitive_info);
+  // Attributes of the primitives put in the cache.
+  static dnnl::primitive_attr CachedPrimitiveAttr() {
+    dnnl::primitive_attr attr;
+    attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+    return attr;
+  }
+
  private:
   MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
   ~MKLKernelEngine() = default;
   dnnl::engine engine_;
   dnnl::stream stream_;
+  std::mutex primitive_cache_mutex_;
+  std::list<std::pair<std::string, MKLPrimitiveInfoPtr>> primitive_list_;
+  std::unordered_map<std::string, std::list<std::pair<std::string, MKLPrimitiveInfoPtr>>::iterator> primitive_cache_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -71,20 +71,35 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     padding_l.emplace_back(int_padding_l[i]);
     padding_r.emplace_back(int_padding_r[i]);
   }
-  dnnl::pooling_forward::desc desc =
-    dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_max, src_desc, dst_desc,
-                                strides_dims, kernels_dims, padding_l, padding_r);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  auto algorithm = dnnl::algorithm::pooling_max;
   if (kernel_name == prim::kPrimAvgPool->name() || kernel_name == prim::kPrimAvgPool3D->name()) {
-    desc = dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_avg, src_desc,
-                                       dst_desc, strides_dims, kernels_dims, padding_l, padding_r);
+    algorithm = dnnl::algorithm::pooling_avg;
   }
-  auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  workspace_size_ = prim_desc.workspace_desc().get_size();
-  primitive_ = std::make_shared<dnnl::pooling_forward>(prim_desc);
+  // Max pooling grad computes its own indices, so the workspace of forward_training is never read.
+  auto prop_kind = GetForwardPropKind(kernel_node);
+  auto key = GetPrimitiveKey("pooling_forward",
+                             {{static_cast<int64_t>(prop_kind), static_cast<int64_t>(algorithm)}, src_desc.dims(),
+                              dst_desc.dims(), strides_dims, kernels_dims, padding_l, padding_r});
+  auto primitive_info = MKLKernelEngine::Get().GetPrimitive(key);
+  if (primitive_info == nullptr) {
+    dnnl::pooling_forward::desc desc = dnnl::pooling_forward::desc(prop_kind, algorithm, src_desc, dst_desc,
+                                                                   strides_dims, kernels_dims, padding_l, padding_r);
+    auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::CachedPrimitiveAttr(),
+                                                           MKLKernelEngine::Get().engine());
+    primitive_info = std::make_shared<MKLPrimitiveInfo>();
+    primitive_info->primitive = std::make_shared<dnnl::pooling_forward>(prim_desc);
+    primitive_info->arg_descs = {{DNNL_ARG_WORKSPACE, prim_desc.workspace_desc()},
+                                 {DNNL_ARG_SCRATCHPAD, prim_desc.scratchpad_desc()}};
+    MKLKernelEngine::Get().CachePrimitive(key, primitive_info);
+  }
+  primitive_ = primitive_info->primitive;
+  const auto &workspace_desc = primitive_info->arg_descs.at(DNNL_ARG_WORKSPACE);
+  workspace_size_ = workspace_desc.get_size();
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DST, dst_desc);
-  AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
+  AddArgument(DNNL_ARG_WORKSPACE, workspace_desc);
+  AddArgument(DNNL_ARG_SCRATCHPAD, primitive_info->arg_descs.at(DNNL_ARG_SCRATCHPAD), true);
 }
 
 bool PoolingCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
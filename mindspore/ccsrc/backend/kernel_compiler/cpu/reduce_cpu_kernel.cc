@@ -1,138 +1,300 @@
-/**
- * Copyright 2021 Huawei Technologies Co., Ltd
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
-#include <string>
-#include <vector>
-#include <algorithm>
-#include <utility>
-
-namespace mindspore {
-namespace kernel {
-template <typename T>
-void ReduceCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
-  MS_EXCEPTION_IF_NULL(kernel_node);
-  input_shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  auto axis_addr = AnfAlgo::GetCNodePrimitive(kernel_node)->GetAttr(AXIS);
-  if (axis_addr->isa<ValueTuple>() || axis_addr->isa<ValueList>()) {
-    axis_ = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, AXIS);
-  } else if (axis_addr->isa<Int64Imm>()) {
-    axis_.emplace_back(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, AXIS));
-  } else {
-    MS_LOG(EXCEPTION) << "Attribute is invalid";
-  }
-
-  int dimension = input_shape_.size();
-  std::transform(axis_.begin(), axis_.end(), axis_.begin(),
-                 [dimension](const auto &a) { return a < 0 ? dimension + a : a; });
-  sort(axis_.begin(), axis_.end());
-  // Delete the duplicate axis.
-  auto last = std::unique(axis_.begin(), axis_.end());
-  axis_.erase(last, axis_.end());
-  auto kernel_name = AnfAlgo::GetCNodeName(kernel_node);
-
-  if constexpr (std::is_same<T, bool>::value) {
-    if (kernel_name == "ReduceAll") {
-      reduce_type_ = kReduceAll;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out &= input[pos]; };
-    } else if (kernel_name == "ReduceAny") {
-      reduce_type_ = kReduceAny;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out |= input[pos]; };
-    } else {
-      MS_LOG(EXCEPTION) << "Unsupported reduce operation: " << fullname_ << " for bool.";
-    }
-  } else {
-    if (kernel_name == "ReduceMax") {
-      reduce_type_ = kReduceMax;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out = std::max(input[pos], *out); };
-    } else if (kernel_name == "ReduceMin") {
-      reduce_type_ = kReduceMin;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out = std::min(input[pos], *out); };
-    } else if (kernel_name == "ReduceSum") {
-      reduce_type_ = kReduceSum;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out += input[pos]; };
-    } else if (kernel_name == "ReduceMean") {
-      reduce_type_ = kReduceMean;
-      reduce_func_ = [](const T *input, size_t pos, T *out) { *out += input[pos]; };
-    } else {
-      MS_LOG(EXCEPTION) << "Unsupported reduce operation:  " << kernel_name;
-    }
-  }
-}
-
-template <typename T>
-bool ReduceCPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
-                                const std::vector<kernel::AddressPtr> &outputs) {
-  size_t input_size = inputs[0]->size / sizeof(T);
-  auto input_addr = reinterpret_cast<T *>(inputs[0]->addr);
-  auto output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  if (axis_.empty() || input_shape_.empty() || input_shape_.size() == 1) {
-    // Get one ret
-    *output_addr = input_addr[0];
-    for (size_t i = 1; i < input_size; ++i) {
-      reduce_func_(input_addr, i, output_addr);
-    }
-    if (reduce_type_ == kReduceMean) {
-      *output_addr /= input_size;
-    }
-  } else {
-    // Calculate transpose axes and stride
-    int dimension = input_shape_.size();
-    size_t stride = 1;
-    std::vector<size_t> axes(input_shape_.size());
-    size_t j = 0;
-    size_t k = 0;
-    for (int i = 0; i < dimension; ++i) {
-      if (j == axis_.size() || i != axis_[j]) {
-        axes[k] = i;
-        ++k;
-      } else {
-        stride *= input_shape_[i];
-        ++j;
-      }
-    }
-    for (auto &it : axis_) {
-      axes[k] = it;
-      ++k;
-    }
-    // Calculate transpose shape
-    std::vector<size_t> transpose_shape(input_shape_.size());
-    for (int i = 0; i < dimension; ++i) {
-      transpose_shape[i] = input_shape_[axes[i]];
-    }
-    size_t output_size = outputs[0]->size / sizeof(T);
-    TransposeIterator base_iter(std::move(transpose_shape), std::move(axes), input_shape_);
-    auto task = [this, &base_iter, input_addr, output_addr, stride](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start * stride);
-      for (size_t i = start; i < end; ++i) {
-        output_addr[i] = input_addr[iter.GetPos()];
-        iter.GenNextPos();
-        for (size_t j = 1; j < stride; ++j) {
-          reduce_func_(input_addr, iter.GetPos(), &output_addr[i]);
-          iter.GenNextPos();
-        }
-        if (reduce_type_ == kReduceMean) {
-          output_addr[i] /= stride;
-        }
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size);
-  }
-  return true;
-}
-}  // namespace kernel
-}  // namespace mindspore
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kReduceLanes = 8;
+constexpr size_t kFullReduceBlock = 4096;
+
+// Independent accumulators let the compiler vectorise the loop, and for float sums they lose less precision than one
+// running sum. Element i always goes to lane i % kReduceLanes.
+template <typename T, typename Op>
+T ReduceContiguous(const Op &op, const T *input, size_t size) {
+  if (size < kReduceLanes * 2) {
+    T acc = input[0];
+    for (size_t i = 1; i < size; ++i) {
+      acc = op(acc, input[i]);
+    }
+    return acc;
+  }
+  T acc[kReduceLanes];
+  for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+    acc[lane] = input[lane];
+  }
+  size_t i = kReduceLanes;
+  for (; i + kReduceLanes <= size; i += kReduceLanes) {
+    for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+      acc[lane] = op(acc[lane], input[i + lane]);
+    }
+  }
+  for (size_t lane = 0; i < size; ++i, ++lane) {
+    acc[lane] = op(acc[lane], input[i]);
+  }
+  // Combine the lanes in the order they were last updated, ending with the lane of the last element, so that the max
+  // and min see a NaN in the last element as one running reduction does.
+  size_t last_lane = (size - 1) % kReduceLanes;
+  T result = acc[(last_lane + 1) % kReduceLanes];
+  for (size_t k = 2; k <= kReduceLanes; ++k) {
+    result = op(result, acc[(last_lane + k) % kReduceLanes]);
+  }
+  return result;
+}
+
+template <typename T, typename Op>
+void ReduceRow(const Op &op, const T *input, T *output, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    output[i] = op(output[i], input[i]);
+  }
+}
+}  // namespace
+
+template <typename T>
+void ReduceCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  input_shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  auto axis_addr = AnfAlgo::GetCNodePrimitive(kernel_node)->GetAttr(AXIS);
+  if (axis_addr->isa<ValueTuple>() || axis_addr->isa<ValueList>()) {
+    axis_ = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, AXIS);
+  } else if (axis_addr->isa<Int64Imm>()) {
+    axis_.emplace_back(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, AXIS));
+  } else {
+    MS_LOG(EXCEPTION) << "Attribute is invalid";
+  }
+
+  int dimension = input_shape_.size();
+  std::transform(axis_.begin(), axis_.end(), axis_.begin(),
+                 [dimension](const auto &a) { return a < 0 ? dimension + a : a; });
+  sort(axis_.begin(), axis_.end());
+  // Delete the duplicate axis.
+  auto last = std::unique(axis_.begin(), axis_.end());
+  axis_.erase(last, axis_.end());
+  auto kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+
+  if constexpr (std::is_same<T, bool>::value) {
+    if (kernel_name == "ReduceAll") {
+      reduce_type_ = kReduceAll;
+    } else if (kernel_name == "ReduceAny") {
+      reduce_type_ = kReduceAny;
+    } else {
+      MS_LOG(EXCEPTION) << "Unsupported reduce operation: " << fullname_ << " for bool.";
+    }
+  } else {
+    if (kernel_name == "ReduceMax") {
+      reduce_type_ = kReduceMax;
+    } else if (kernel_name == "ReduceMin") {
+      reduce_type_ = kReduceMin;
+    } else if (kernel_name == "ReduceSum") {
+      reduce_type_ = kReduceSum;
+    } else if (kernel_name == "ReduceMean") {
+      reduce_type_ = kReduceMean;
+    } else {
+      MS_LOG(EXCEPTION) << "Unsupported reduce operation:  " << kernel_name;
+    }
+  }
+  InitReduceShape();
+}
+
+template <typename T>
+void ReduceCPUKernel<T>::InitReduceShape() {
+  reduce_shape_type_ = kReduceFull;
+  if (axis_.empty() || input_shape_.size() <= 1) {
+    return;
+  }
+  // Merge adjacent dimensions which are all reduced or all kept, dimensions of size 1 do not matter.
+  std::vector<std::pair<bool, size_t>> merged_dims;
+  for (size_t i = 0; i < input_shape_.size(); ++i) {
+    if (input_shape_[i] == 1) {
+      continue;
+    }
+    bool reduced = std::binary_search(axis_.begin(), axis_.end(), SizeToLong(i));
+    if (!merged_dims.empty() && merged_dims.back().first == reduced) {
+      merged_dims.back().second *= input_shape_[i];
+    } else {
+      merged_dims.emplace_back(reduced, input_shape_[i]);
+    }
+  }
+  if (merged_dims.empty() || (merged_dims.size() == 1 && merged_dims[0].first)) {
+    return;
+  }
+  outer_size_ = 1;
+  reduce_size_ = 1;
+  inner_size_ = 1;
+  if (merged_dims.size() == 1) {
+    reduce_shape_type_ = kReduceInner;
+    outer_size_ = merged_dims[0].second;
+  } else if (merged_dims.size() == 2 && merged_dims[1].first) {
+    reduce_shape_type_ = kReduceInner;
+    outer_size_ = merged_dims[0].second;
+    reduce_size_ = merged_dims[1].second;
+  } else if (merged_dims.size() == 2) {
+    reduce_shape_type_ = kReduceMiddle;
+    reduce_size_ = merged_dims[0].second;
+    inner_size_ = merged_dims[1].second;
+  } else if (merged_dims.size() == 3 && merged_dims[1].first) {
+    reduce_shape_type_ = kReduceMiddle;
+    outer_size_ = merged_dims[0].second;
+    reduce_size_ = merged_dims[1].second;
+    inner_size_ = merged_dims[2].second;
+  } else {
+    reduce_shape_type_ = kReduceGeneral;
+  }
+}
+
+template <typename T>
+bool ReduceCPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  auto input_addr = reinterpret_cast<T *>(inputs[0]->addr);
+  auto output_addr = reinterpret_cast<T *>(outputs[0]->addr);
+  size_t output_size = outputs[0]->size / sizeof(T);
+  if constexpr (std::is_same<T, bool>::value) {
+    if (reduce_type_ == kReduceAll) {
+      LaunchReduce([](bool a, bool b) { return a && b; }, input_addr, output_addr, output_size);
+    } else {
+      LaunchReduce([](bool a, bool b) { return a || b; }, input_addr, output_addr, output_size);
+    }
+  } else {
+    // The input goes first as in the running reduction before, a NaN input replaces the accumulated value.
+    if (reduce_type_ == kReduceMax) {
+      LaunchReduce([](T acc, T value) { return std::max(value, acc); }, input_addr, output_addr, output_size);
+    } else if (reduce_type_ == kReduceMin) {
+      LaunchReduce([](T acc, T value) { return std::min(value, acc); }, input_addr, output_addr, output_size);
+    } else {
+      LaunchReduce([](T a, T b) { return a + b; }, input_addr, output_addr, output_size);
+    }
+    if (reduce_type_ == kReduceMean) {
+      size_t input_size = inputs[0]->size / sizeof(T);
+      size_t reduce_num = reduce_shape_type_ == kReduceFull ? input_size : input_size / output_size;
+      for (size_t i = 0; i < output_size; ++i) {
+        output_addr[i] /= reduce_num;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+template <typename Op>
+void ReduceCPUKernel<T>::LaunchReduce(const Op &op, const T *input, T *output, size_t output_size) {
+  if (reduce_shape_type_ == kReduceFull) {
+    ReduceFull(op, input, output);
+  } else if (reduce_shape_type_ == kReduceInner) {
+    auto task = [this, &op, input, output](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        output[i] = ReduceContiguous(op, input + i * reduce_size_, reduce_size_);
+      }
+    };
+    CPUKernelUtils::ParallelForWithCost(task, outer_size_, reduce_size_ * kCheapElementCost);
+  } else if (reduce_shape_type_ == kReduceMiddle) {
+    // Accumulate whole rows of the inner dimension, so the loads stay contiguous.
+    auto task = [this, &op, input, output](size_t start, size_t end) {
+      for (size_t i = start; i < end;) {
+        size_t outer = i / inner_size_;
+        size_t inner = i % inner_size_;
+        size_t size = std::min(inner_size_ - inner, end - i);
+        const T *row = input + outer * reduce_size_ * inner_size_ + inner;
+        std::copy(row, row + size, output + i);
+        for (size_t j = 1; j < reduce_size_; ++j) {
+          ReduceRow(op, row + j * inner_size_, output + i, size);
+        }
+        i += size;
+      }
+    };
+    CPUKernelUtils::ParallelForWithCost(task, outer_size_ * inner_size_, reduce_size_ * kCheapElementCost);
+  } else {
+    ReduceGeneral(op, input, output, output_size);
+  }
+}
+
+template <typename T>
+template <typename Op>
+void ReduceCPUKernel<T>::ReduceFull(const Op &op, const T *input, T *output) {
+  size_t input_size = 1;
+  for (auto dim : input_shape_) {
+    input_size *= dim;
+  }
+  size_t block_num = (input_size + kFullReduceBlock - 1) / kFullReduceBlock;
+  if (block_num <= 1) {
+    *output = ReduceContiguous(op, input, input_size);
+    return;
+  }
+  // Reduce each block in parallel, then combine the partial results as a binary tree.
+  std::vector<T> partials(block_num);
+  auto task = [&op, &partials, input, input_size](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      size_t offset = i * kFullReduceBlock;
+      partials[i] = ReduceContiguous(op, input + offset, std::min(kFullReduceBlock, input_size - offset));
+    }
+  };
+  CPUKernelUtils::ParallelForWithCost(task, block_num, kFullReduceBlock * kCheapElementCost);
+  for (size_t width = 1; width < block_num; width *= 2) {
+    for (size_t i = 0; i + width < block_num; i += width * 2) {
+      partials[i] = op(partials[i], partials[i + width]);
+    }
+  }
+  *output = partials[0];
+}
+
+template <typename T>
+template <typename Op>
+void ReduceCPUKernel<T>::ReduceGeneral(const Op &op, const T *input, T *output, size_t output_size) {
+  // Calculate transpose axes and stride
+  int dimension = input_shape_.size();
+  size_t stride = 1;
+  std::vector<size_t> axes(input_shape_.size());
+  size_t j = 0;
+  size_t k = 0;
+  for (int i = 0; i < dimension; ++i) {
+    if (j == axis_.size() || i != axis_[j]) {
+      axes[k] = i;
+      ++k;
+    } else {
+      stride *= input_shape_[i];
+      ++j;
+    }
+  }
+  for (auto &it : axis_) {
+    axes[k] = it;
+    ++k;
+  }
+  // Calculate transpose shape
+  std::vector<size_t> transpose_shape(input_shape_.size());
+  for (int i = 0; i < dimension; ++i) {
+    transpose_shape[i] = input_shape_[axes[i]];
+  }
+  TransposeIterator base_iter(std::move(transpose_shape), std::move(axes), input_shape_);
+  auto task = [&op, &base_iter, input, output, stride](size_t start, size_t end) {
+    auto iter = base_iter;
+    iter.SetPos(start * stride);
+    for (size_t i = start; i < end; ++i) {
+      output[i] = input[iter.GetPos()];
+      iter.GenNextPos();
+      for (size_t j = 1; j < stride; ++j) {
+        output[i] = op(output[i], input[iter.GetPos()]);
+        iter.GenNextPos();
+      }
+    }
+  };
+  CPUKernelUtils::ParallelForWithCost(task, output_size, stride * kCheapElementCost);
+}
+}  // namespace kernel
+}  // namespace mindspore
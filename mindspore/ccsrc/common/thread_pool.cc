@@ -46,61 +46,189 @@ ThreadPool::ThreadPool() {
   }
 }
 
-void ThreadPool::SyncRunLoop() {
-  while (true) {
-    Task task;
-    {
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      task_cond_var_.wait(lock, [this] { return !task_queue_.empty() || exit_run_; });
-      if (exit_run_) {
-        return;
+namespace {
+constexpr size_t kChunkIndexBits = 32;
+constexpr uint64_t kChunkIndexMask = 0xFFFFFFFFu;
+constexpr size_t kMaxChunkNum = kChunkIndexMask;
+// Busy-wait iterations before an idle worker parks, back-to-back kernel launches are picked up without a wakeup.
+constexpr size_t kSpinCount = 20000;
+// Set on pool workers and on a thread that is inside a launch, nested launches are run serially on that thread.
+thread_local bool in_parallel_region = false;
+
+inline uint64_t PackRange(size_t begin, size_t end) { return (static_cast<uint64_t>(begin) << kChunkIndexBits) | end; }
+inline size_t RangeBegin(uint64_t range) { return static_cast<size_t>(range >> kChunkIndexBits); }
+inline size_t RangeEnd(uint64_t range) { return static_cast<size_t>(range & kChunkIndexMask); }
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+}  // namespace
+
+struct ThreadPool::ParallelJob {
+  RangeTask task;
+  const void *closure;
+  size_t count;
+  size_t grain;
+  size_t queue_num;
+  std::atomic<size_t> pending_chunk_num;
+  std::atomic_bool failed;
+};
+
+void ThreadPool::StartWorkers() {
+  exit_run_ = false;
+  if (queues_ == nullptr) {
+    queues_ = std::make_unique<ChunkQueue[]>(max_thread_num_);
+  }
+  // Queue 0 belongs to the calling thread.
+  for (size_t i = 1; i < max_thread_num_; ++i) {
+    sync_run_threads_.emplace_back(std::thread(&ThreadPool::WorkerLoop, this, i, job_epoch_.load()));
+  }
+}
+
+bool ThreadPool::WaitForJob(uint64_t *seen_epoch) {
+  for (size_t i = 0; i < kSpinCount; ++i) {
+    if (exit_run_) {
+      return false;
+    }
+    if (job_epoch_.load() != *seen_epoch) {
+      *seen_epoch = job_epoch_.load();
+      return true;
+    }
+    CpuRelax();
+  }
+  std::unique_lock<std::mutex> lock(wait_mutex_);
+  ++sleeping_worker_num_;
+  wait_cond_var_.wait(lock, [this, seen_epoch] { return exit_run_ || job_epoch_.load() != *seen_epoch; });
+  --sleeping_worker_num_;
+  if (exit_run_) {
+    return false;
+  }
+  *seen_epoch = job_epoch_.load();
+  return true;
+}
+
+void ThreadPool::WorkerLoop(size_t queue_id, uint64_t seen_epoch) {
+  in_parallel_region = true;
+  while (WaitForJob(&seen_epoch)) {
+    // Register before looking at the job, the launching thread waits for all registered workers before returning.
+    ++running_worker_num_;
+    auto job = current_job_.load();
+    if (job != nullptr && queue_id < job->queue_num) {
+      RunJob(job, queue_id);
+    }
+    --running_worker_num_;
+  }
+}
+
+bool ThreadPool::PopChunk(size_t queue_id, size_t *chunk) {
+  auto &range = queues_[queue_id].range;
+  auto current = range.load();
+  while (RangeBegin(current) < RangeEnd(current)) {
+    if (range.compare_exchange_weak(current, PackRange(RangeBegin(current) + 1, RangeEnd(current)))) {
+      *chunk = RangeBegin(current);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::StealChunk(const ParallelJob *job, size_t queue_id, size_t *chunk) {
+  for (size_t i = 1; i < job->queue_num; ++i) {
+    auto &victim = queues_[(queue_id + i) % job->queue_num].range;
+    auto current = victim.load();
+    while (RangeBegin(current) < RangeEnd(current)) {
+      // Take the back half, the victim keeps working on the front of its range.
+      size_t begin = RangeBegin(current);
+      size_t end = RangeEnd(current);
+      size_t mid = end - (end - begin + 1) / 2;
+      if (victim.compare_exchange_weak(current, PackRange(begin, mid))) {
+        // Own queue is drained here, chunk ranges are never handed out twice so no thief can mistake the new value.
+        queues_[queue_id].range.store(PackRange(mid + 1, end));
+        *chunk = mid;
+        return true;
       }
-      task = task_queue_.front();
-      task_queue_.pop();
     }
+  }
+  return false;
+}
+
+void ThreadPool::RunJob(ParallelJob *job, size_t queue_id) {
+  size_t chunk = 0;
+  while (PopChunk(queue_id, &chunk) || StealChunk(job, queue_id, &chunk)) {
+    size_t start = chunk * job->grain;
+    size_t end = std::min(start + job->grain, job->count);
     try {
-      task();
-    } catch (std::exception &e) {
+      if (job->task(job->closure, start, end) != SUCCESS) {
+        job->failed = true;
+      }
+    } catch (...) {
       MsException::Instance().SetException();
+      job->failed = true;
     }
-    {
-      std::unique_lock<std::mutex> task_lock(task_mutex_);
-      task_finished_count_ = task_finished_count_ + 1;
-    }
-    finished_cond_var_.notify_one();
+    job->pending_chunk_num.fetch_sub(1, std::memory_order_release);
   }
 }
 
-bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
-  if (tasks.size() == 1) {
-    auto ret = tasks[0]();
-    return ret == SUCCESS;
+bool ThreadPool::ParallelLaunch(RangeTask task, const void *closure, size_t count, size_t grain, size_t thread_num) {
+  if (count == 0) {
+    return true;
+  }
+  grain = std::max(grain, (count + kMaxChunkNum - 1) / kMaxChunkNum);
+  grain = std::max(grain, static_cast<size_t>(1));
+  size_t chunk_num = (count + grain - 1) / grain;
+  thread_num = std::min(thread_num, max_thread_num_);
+  if (chunk_num == 1 || thread_num <= 1 || in_parallel_region) {
+    return task(closure, 0, count) == SUCCESS;
   }
   std::unique_lock<std::mutex> lock(pool_mtx_);
-  exit_run_ = false;
-  size_t task_num = tasks.size();
-  size_t thread_num = sync_run_threads_.size();
-  if (thread_num < max_thread_num_ && thread_num < task_num) {
-    auto new_thread_num = max_thread_num_;
-    if (task_num < max_thread_num_) {
-      new_thread_num = task_num;
-    }
-    for (size_t i = thread_num; i < new_thread_num; ++i) {
-      sync_run_threads_.emplace_back(std::thread(&ThreadPool::SyncRunLoop, this));
-    }
+  if (sync_run_threads_.empty()) {
+    StartWorkers();
+  }
+  ParallelJob job{task, closure, count, grain, std::min(thread_num, chunk_num), {chunk_num}, {false}};
+  for (size_t i = 0; i < job.queue_num; ++i) {
+    queues_[i].range.store(PackRange(i * chunk_num / job.queue_num, (i + 1) * chunk_num / job.queue_num));
+  }
+  current_job_.store(&job);
+  ++job_epoch_;
+  if (sleeping_worker_num_.load() > 0) {
+    std::lock_guard<std::mutex> wait_lock(wait_mutex_);
+    wait_cond_var_.notify_all();
   }
 
-  for (auto &task : tasks) {
-    std::lock_guard<std::mutex> task_lock(task_mutex_);
-    task_queue_.push(task);
-    task_cond_var_.notify_one();
+  in_parallel_region = true;
+  RunJob(&job, 0);
+  in_parallel_region = false;
+  // Chunks stolen by workers are short, wait for them without going through the kernel.
+  while (job.pending_chunk_num.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
   }
-  {
-    std::unique_lock<std::mutex> task_lock(task_mutex_);
-    finished_cond_var_.wait(task_lock, [this, task_num] { return task_num == task_finished_count_; });
-    task_finished_count_ = 0;
+  current_job_.store(nullptr);
+  while (running_worker_num_.load() != 0) {
+    CpuRelax();
   }
-  return true;
+  return !job.failed;
+}
+
+bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
+  if (tasks.size() == 1) {
+    auto ret = tasks[0]();
+    return ret == SUCCESS;
+  }
+  auto run_tasks = [](const void *closure, size_t start, size_t end) {
+    auto task_list = static_cast<const std::vector<Task> *>(closure);
+    int ret = SUCCESS;
+    for (size_t i = start; i < end; ++i) {
+      if ((*task_list)[i]() != SUCCESS) {
+        ret = FAIL;
+      }
+    }
+    return ret;
+  };
+  return ParallelLaunch(run_tasks, &tasks, tasks.size(), 1, max_thread_num_);
 }
 
 ThreadPool &ThreadPool::GetInstance() {
@@ -114,7 +242,10 @@ void ThreadPool::ClearThreadPool() {
     return;
   }
   exit_run_ = true;
-  task_cond_var_.notify_all();
+  {
+    std::lock_guard<std::mutex> wait_lock(wait_mutex_);
+    wait_cond_var_.notify_all();
+  }
   for (auto &it : sync_run_threads_) {
     if (it.joinable()) {
       it.join();
@@ -21,7 +21,6 @@
 #include <condition_variable>
 #include <thread>
 #include <vector>
-#include <queue>
 #include <string>
 #include <atomic>
 #include <memory>
@@ -34,6 +33,8 @@ namespace mindspore {
 namespace common {
 enum Status { FAIL = -1, SUCCESS = 0 };
 using Task = std::function<int()>;
+// Computes the element range [start, end) of a parallel launch, the closure is passed through untouched.
+using RangeTask = int (*)(const void *closure, size_t start, size_t end);
 
 class ThreadPool {
  public:
@@ -42,21 +43,39 @@ class ThreadPool {
   ThreadPool &operator=(const ThreadPool &) = delete;
   static ThreadPool &GetInstance();
   bool SyncRun(const std::vector<Task> &tasks);
+  // Split [0, count) into chunks of grain elements, deal them out to the queues of at most thread_num threads and let
+  // idle threads steal from busy ones. The calling thread computes chunks as well, and nothing is allocated on the
+  // heap per launch.
+  bool ParallelLaunch(RangeTask task, const void *closure, size_t count, size_t grain, size_t thread_num);
   size_t GetSyncRunThreadNum() { return max_thread_num_; }
   void ClearThreadPool();
 
  private:
+  struct ParallelJob;
+  // Chunk indices [begin, end) owned by one thread, packed as (begin << 32 | end) so that the owner popping from the
+  // front and thieves splitting off the back only need one CAS.
+  struct alignas(64) ChunkQueue {
+    std::atomic<uint64_t> range{0};
+  };
+
   ThreadPool();
-  void SyncRunLoop();
+  void StartWorkers();
+  void WorkerLoop(size_t queue_id, uint64_t seen_epoch);
+  bool WaitForJob(uint64_t *seen_epoch);
+  void RunJob(ParallelJob *job, size_t queue_id);
+  bool PopChunk(size_t queue_id, size_t *chunk);
+  bool StealChunk(const ParallelJob *job, size_t queue_id, size_t *chunk);
 
   size_t max_thread_num_{1};
   std::mutex pool_mtx_;
   std::atomic_bool exit_run_ = {false};
-  std::queue<Task> task_queue_;
-  std::mutex task_mutex_;
-  std::condition_variable task_cond_var_;
-  size_t task_finished_count_{0};
-  std::condition_variable finished_cond_var_;
+  std::unique_ptr<ChunkQueue[]> queues_;
+  std::atomic<ParallelJob *> current_job_{nullptr};
+  std::atomic<uint64_t> job_epoch_{0};
+  std::atomic<size_t> running_worker_num_{0};
+  std::atomic<size_t> sleeping_worker_num_{0};
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cond_var_;
   std::vector<std::thread> sync_run_threads_{};
 };
 }  // namespace common
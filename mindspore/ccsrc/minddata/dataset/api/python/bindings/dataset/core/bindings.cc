@@ -58,6 +58,8 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("set_worker_connector_size", &ConfigManager::set_worker_connector_size)
                     .def("set_enable_shared_mem", &ConfigManager::set_enable_shared_mem)
                     .def("get_enable_shared_mem", &ConfigManager::enable_shared_mem)
+                    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+                    .def("get_enable_autotune", &ConfigManager::enable_autotune)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
@@ -45,7 +45,11 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                     .def(py::init<>())
                     .def_readwrite("avg_cache_sz", &CacheServiceStat::avg_cache_sz)
                     .def_readwrite("num_mem_cached", &CacheServiceStat::num_mem_cached)
-                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached);
+                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached)
+                    .def_readwrite("num_mem_hit", &CacheServiceStat::num_mem_hit)
+                    .def_readwrite("num_disk_hit", &CacheServiceStat::num_disk_hit)
+                    .def_readwrite("num_miss", &CacheServiceStat::num_miss)
+                    .def_readwrite("num_evicted", &CacheServiceStat::num_evicted);
                 }));
 
 }  // namespace dataset
@@ -238,6 +238,14 @@ class ConfigManager {
   // @return - Flag to indicate whether shared memory for multi-processing is enabled
   bool enable_shared_mem() { return enable_shared_mem_; }
 
+  // setter function
+  // @param enable - To let AutoTune adjust the workers and connector sizes of ops while the pipeline is running
+  void set_enable_autotune(bool enable) { enable_autotune_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether AutoTune is enabled
+  bool enable_autotune() const { return enable_autotune_; }
+
  private:
   int32_t num_parallel_workers_;
   int32_t worker_connector_size_;
@@ -262,6 +270,7 @@ class ConfigManager {
   int32_t auto_num_workers_num_shards_;
   uint8_t auto_worker_config_;
   bool enable_shared_mem_;
+  bool enable_autotune_;
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
   Status FromJson(const nlohmann::json &j);
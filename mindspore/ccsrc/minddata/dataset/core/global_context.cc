@@ -25,6 +25,9 @@
 #include "minddata/dataset/core/device_tensor.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/util/allocator.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/util/recycle_pool.h"
+#endif
 #include "minddata/dataset/util/system_pool.h"
 
 namespace mindspore {
@@ -53,7 +56,12 @@ GlobalContext *GlobalContext::Instance() {
 
 Status GlobalContext::Init() {
   config_manager_ = std::make_shared<ConfigManager>();
+#ifndef ENABLE_ANDROID
+  // Tensors are created and dropped at a high rate by different threads, recycle their memory
+  mem_pool_ = std::make_shared<RecyclePool>();
+#else
   mem_pool_ = std::make_shared<SystemPool>();
+#endif
   // For testing we can use Dummy pool instead
 
   // Create some tensor allocators for the different types and hook them into the pool.
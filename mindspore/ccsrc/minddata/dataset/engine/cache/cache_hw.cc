@@ -201,8 +201,19 @@ numa_id_t CacheServerHW::GetMyNode() const {
 #if defined(__APPLE__)
   numa_id_t node_id = -1;
 #else
+  numa_id_t node_id = GetNodeOfCpu(sched_getcpu());
+#endif  // end __APPLE__
+  return node_id;
+}
+
+numa_id_t CacheServerHW::GetNodeOfCpu(cpu_id_t cpu) const {
+#if defined(__APPLE__)
+  numa_id_t node_id = -1;
+#else
+  if (cpu < 0) {
+    return -1;
+  }
   numa_id_t node_id = 0;
-  auto cpu = sched_getcpu();
 #ifdef NUMA_ENABLED
   node_id = numa_node_of_cpu(cpu);
 #else
@@ -77,6 +77,9 @@ class CacheServerHW {
   /// \brief Return the numa the current thread is running on.
   numa_id_t GetMyNode() const;
 
+  /// \brief Return the numa node of a given cpu, -1 if unknown.
+  numa_id_t GetNodeOfCpu(cpu_id_t cpu) const;
+
   /// \brief Interleave a given memory block. Used by shared memory only.
   static void InterleaveMemory(void *ptr, size_t sz);
 
@@ -21,8 +21,18 @@
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, const std::string &subfolder)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(subfolder.empty() ? Services::GetUniqueID() : subfolder),
+      sm_(nullptr),
+      tree_(nullptr),
+      num_mem_hit_(0),
+      num_disk_hit_(0),
+      num_miss_(0),
+      num_evicted_(0),
+      locator_locks_(kNumLocatorLocks),
+      keep_files_(false) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -47,6 +57,9 @@ Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
   if (sm_ != nullptr) {
+    if (keep_files_) {
+      sm_->KeepContainers();
+    }
     rc = sm_->ServiceStop();
     if (rc.IsError()) {
       rc2 = rc;
@@ -60,7 +73,12 @@ Status CachePool::DoServiceStop() {
   // release each buffer in the DataLocator one by one.
 
   tree_.reset();
-  if (!root_.toString().empty()) {
+  {
+    std::unique_lock<std::mutex> lck(clock_mux_);
+    clock_.clear();
+  }
+  // The spill folder of a persisted pool is left for a restarted server to reload.
+  if (!root_.toString().empty() && !keep_files_) {
     Path spill = GetSpillPath();
     auto it = Path::DirIterator::OpenDirectory(&spill);
     while (it->hasNext()) {
@@ -79,6 +97,137 @@ Status CachePool::DoServiceStop() {
 
 CachePool::~CachePool() noexcept { (void)ServiceStop(); }
 
+Status CachePool::AllocateRow(size_t sz, DataLocator *bl) {
+  RETURN_UNEXPECTED_IF_NULL(bl);
+  Status rc;
+  int32_t num_evicted = 0;
+  do {
+    // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got
+    // killed or crashing the machine, set lower bound memory, which means stopping cache once the rest available
+    // memory is less than the lower bound. (The default is 20% of physical RAM)
+    // Written without subtraction so that it doesn't wrap around when concurrent inserts overshoot the limit.
+    if (temp_mem_usage_ + static_cast<uint64_t>(sz) + min_avail_mem_ > soft_mem_limit_) {
+      rc = Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+    } else {
+      rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl->ptr));
+      // Adjust the soft limit and usage counting when every 100M memory are used.
+      if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
+        soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
+        temp_mem_usage_ = 0;
+      }
+    }
+    if (rc != StatusCode::kMDOutOfMemory || !CanEvict() || num_evicted == kMaxEvictionsPerRow) {
+      break;
+    }
+    // Make room by moving the coldest rows in memory to disk.
+    size_t freed = 0;
+    RETURN_IF_NOT_OK(EvictOne(&freed));
+    if (freed == 0) {
+      break;
+    }
+    ++num_evicted;
+  } while (true);
+  if (rc == StatusCode::kMDOutOfMemory && !CanEvict()) {
+    MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
+                    << ". The cache server will not cache any more data.";
+  }
+  RETURN_IF_NOT_OK(rc);
+  temp_mem_usage_ += sz;
+  // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
+  if (CacheServerHW::numa_enabled()) {
+    auto node_id = mp_->GetHWControl()->GetMyNode();
+    bl->node_id = mp_->FindNode(bl->ptr);
+    CHECK_FAIL_RETURN_UNEXPECTED(bl->node_id != -1, "Allocator is not from numa memory pool");
+    bl->node_hit = (bl->node_id == node_id);
+  }
+  return Status::OK();
+}
+
+Status CachePool::EvictOne(size_t *freed) {
+  RETURN_UNEXPECTED_IF_NULL(freed);
+  *freed = 0;
+  size_t num_visited = 0;
+  while (true) {
+    key_type key;
+    {
+      std::unique_lock<std::mutex> lck(clock_mux_);
+      // Every row gets one second chance, so two turns of the hand find a victim if there is one.
+      if (clock_.empty() || num_visited > 2 * clock_.size()) {
+        return Status::OK();
+      }
+      key = clock_.front();
+      clock_.pop_front();
+    }
+    ++num_visited;
+    auto r = tree_->Search(key);
+    if (!r.second) {
+      continue;
+    }
+    auto &bl = r.first.value();
+    UniqueLock lck(LocatorLock(key));
+    if (bl.ptr == nullptr) {
+      // Already on disk.
+      continue;
+    }
+    if (bl.referenced.exchange(false)) {
+      AddToClock(key);
+      continue;
+    }
+    // A row brought back from disk still has its copy there, only a row never spilled is written.
+    if (!bl.on_disk) {
+      Status rc = sm_->Write(&bl.storage_key, {ReadableSlice(bl.ptr, bl.sz)});
+      if (rc.IsError()) {
+        AddToClock(key);
+        return rc;
+      }
+      bl.on_disk = true;
+    }
+    mp_->Deallocate(bl.ptr);
+    bl.ptr = nullptr;
+    bl.node_hit = false;
+    // The memory goes back to the pool and doesn't count towards the soft limit any more.
+    uint64_t usage = temp_mem_usage_;
+    temp_mem_usage_ = usage > bl.sz ? usage - bl.sz : 0;
+    ++num_evicted_;
+    *freed = bl.sz;
+    return Status::OK();
+  }
+}
+
+Status CachePool::Promote(key_type key, const ReadableSlice &src) {
+  DataLocator bl;
+  Status rc = AllocateRow(src.GetSize(), &bl);
+  if (rc == StatusCode::kMDOutOfMemory) {
+    // The row stays on disk.
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(rc);
+  WritableSlice dest(bl.ptr, src.GetSize());
+  rc = WritableSlice::Copy(&dest, src);
+  if (rc.IsOk()) {
+    auto r = tree_->Search(key);
+    if (r.second) {
+      auto &cur = r.first.value();
+      UniqueLock lck(LocatorLock(key));
+      // Someone else may have brought it back already.
+      if (cur.ptr == nullptr) {
+        cur.ptr = bl.ptr;
+        cur.node_id = bl.node_id;
+        cur.node_hit = bl.node_hit;
+        bl.ptr = nullptr;
+        AddToClock(key);
+      }
+    }
+  }
+  if (bl.ptr != nullptr) {
+    mp_->Deallocate(bl.ptr);
+    bl.ptr = nullptr;
+    uint64_t usage = temp_mem_usage_;
+    temp_mem_usage_ = usage > src.GetSize() ? usage - src.GetSize() : 0;
+  }
+  return rc;
+}
+
 Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf) {
   DataLocator bl;
   Status rc;
@@ -88,31 +237,8 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
-  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
-  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
-  // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
-    MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
-                    << ". The cache server will not cache any more data.";
-    rc = Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
-  } else {
-    rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
-    // Adjust the soft limit and usage counting when every 100M memory are used.
-    if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
-      soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
-      temp_mem_usage_ = 0;
-    }
-  }
+  rc = AllocateRow(sz, &bl);
   if (rc.IsOk()) {
-    temp_mem_usage_ += sz;
-    // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
-    if (CacheServerHW::numa_enabled()) {
-      auto &cs = CacheServer::GetInstance();
-      auto node_id = cs.GetHWControl()->GetMyNode();
-      bl.node_id = mp_->FindNode(bl.ptr);
-      CHECK_FAIL_RETURN_UNEXPECTED(bl.node_id != -1, "Allocator is not from numa memory pool");
-      bl.node_hit = (bl.node_id == node_id);
-    }
     // We will do a piecewise copy.
     WritableSlice dest(bl.ptr, bl.sz);
     size_t pos = 0;
@@ -134,6 +260,7 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     if (sm_ != nullptr) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
       RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      bl.on_disk = true;
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
@@ -154,17 +281,28 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     bl.ptr = nullptr;
     return rc;
   }
+  if (rc.IsOk() && bl.ptr != nullptr && CanEvict()) {
+    AddToClock(key);
+  }
   return rc;
 }
 
-Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
+Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) {
   RETURN_UNEXPECTED_IF_NULL(dest);
-  auto r = tree_->Search(key);
-  if (r.second) {
+  bool promote = false;
+  size_t sz = 0;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second) {
+      RETURN_STATUS_UNEXPECTED("Key not found");
+    }
     auto &it = r.first;
+    SharedLock lck(LocatorLock(key));
+    sz = it->sz;
     if (it->ptr != nullptr) {
       ReadableSlice src(it->ptr, it->sz);
       RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      it->referenced = true;
     } else if (sm_ != nullptr) {
       size_t expectedLength = 0;
       RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
@@ -173,12 +311,16 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
                       << " Internal key: " << key << "\n";
         RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
       }
+      promote = true;
     }
     if (bytesRead != nullptr) {
       *bytesRead = it->sz;
     }
-  } else {
-    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  // A row fetched from disk is likely fetched again. Bring it back to memory after letting go of the locks, the
+  // rows evicted to make room need them.
+  if (promote) {
+    RETURN_IF_NOT_OK(Promote(key, ReadableSlice(dest->GetPointer(), sz)));
   }
   return Status::OK();
 }
@@ -197,16 +339,19 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     cs.max_key = cs.min_key;  // will adjust later.
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
-      total_sz += it.value().sz;
-      if (it.value().ptr != nullptr) {
-        ++cs.num_mem_cached;
-      } else {
-        ++cs.num_disk_cached;
-      }
-      if (it.value().node_hit) {
-        ++cs.num_numa_hit;
-      }
       auto cur_key = it.key();
+      {
+        SharedLock lck(LocatorLock(cur_key));
+        total_sz += it.value().sz;
+        if (it.value().ptr != nullptr) {
+          ++cs.num_mem_cached;
+        } else {
+          ++cs.num_disk_cached;
+        }
+        if (it.value().node_hit) {
+          ++cs.num_numa_hit;
+        }
+      }
       if (GetMissingKeys) {
         for (auto i = cs.max_key + 1; i < cur_key; ++i) {
           cs.gap.push_back((i));
@@ -224,6 +369,10 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     }
   }
   tree_->Unlock();
+  cs.num_mem_hit = num_mem_hit_;
+  cs.num_disk_hit = num_disk_hit_;
+  cs.num_miss = num_miss_;
+  cs.num_evicted = num_evicted_;
   return cs;
 }
 
@@ -233,6 +382,7 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
+    SharedLock lck(LocatorLock(key));
     DataLocatorMsgBuilder bld(*fbb);
     bld.add_key(key);
     bld.add_size(it->sz);
@@ -240,12 +390,93 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
     bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
     auto offset = bld.Finish();
     *out = offset;
+    if (it->ptr != nullptr) {
+      ++num_mem_hit_;
+      it->referenced = true;
+    } else {
+      ++num_disk_hit_;
+    }
   } else {
     // Key not in the cache.
+    ++num_miss_;
     auto offset = CreateDataLocatorMsg(*fbb, key, 0, 0, 0);
     *out = offset;
   }
   return Status::OK();
 }
+
+Status CachePool::Persist(flatbuffers::FlatBufferBuilder *fbb, flatbuffers::Offset<CachePoolManifestMsg> *out) {
+  RETURN_UNEXPECTED_IF_NULL(fbb);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(sm_ != nullptr, "Only a cache which spills to disk can be persisted");
+  std::vector<SpilledRowMsg> rows;
+  rows.reserve(tree_->size());
+  tree_->LockShared();  // Prevent any node split while we scan.
+  Status rc;
+  for (auto it = tree_->begin(); it != tree_->end() && rc.IsOk(); ++it) {
+    it.LockShared();
+    auto key = it.key();
+    auto &bl = it.value();
+    UniqueLock lck(LocatorLock(key));
+    if (!bl.on_disk) {
+      rc = sm_->Write(&bl.storage_key, {ReadableSlice(bl.ptr, bl.sz)});
+      bl.on_disk = rc.IsOk();
+    }
+    StorageManager::value_type location;
+    if (rc.IsOk()) {
+      rc = sm_->GetLocation(bl.storage_key, &location);
+    }
+    if (rc.IsOk()) {
+      rows.emplace_back(key, location.first, location.second.first, location.second.second);
+    }
+    lck.Unlock();
+    it.Unlock();
+  }
+  tree_->Unlock();
+  RETURN_IF_NOT_OK(rc);
+  std::vector<flatbuffers::Offset<flatbuffers::String>> containers;
+  for (auto const &name : sm_->GetContainerNames()) {
+    containers.push_back(fbb->CreateString(name));
+  }
+  auto off_containers = fbb->CreateVector(containers);
+  auto off_rows = fbb->CreateVectorOfStructs(rows);
+  *out = CreateCachePoolManifestMsg(*fbb, off_containers, off_rows);
+  keep_files_ = true;
+  return Status::OK();
+}
+
+Status CachePool::Restore(const CachePoolManifestMsg *manifest) {
+  RETURN_UNEXPECTED_IF_NULL(manifest);
+  CHECK_FAIL_RETURN_UNEXPECTED(sm_ != nullptr, "A cache which doesn't spill to disk can't be restored");
+  CHECK_FAIL_RETURN_UNEXPECTED(manifest->containers() != nullptr && manifest->rows() != nullptr,
+                               "Incomplete cache manifest");
+  // If we fail half way, the persisted cache must not be removed when the pool stops.
+  keep_files_ = true;
+  std::vector<std::string> names;
+  names.reserve(manifest->containers()->size());
+  for (auto name : *manifest->containers()) {
+    names.push_back(name->str());
+  }
+  auto rows = manifest->rows();
+  std::vector<StorageManager::value_type> locations;
+  locations.reserve(rows->size());
+  for (auto row : *rows) {
+    CHECK_FAIL_RETURN_UNEXPECTED(row->offset() >= 0 && row->size() > 0, "Invalid row in cache manifest");
+    locations.emplace_back(row->container(), std::make_pair(row->offset(), row->size()));
+  }
+  std::vector<StorageManager::key_type> keys;
+  RETURN_IF_NOT_OK(sm_->Restore(names, locations, &keys));
+  for (flatbuffers::uoffset_t i = 0; i < rows->size(); ++i) {
+    DataLocator bl;
+    bl.sz = rows->Get(i)->size();
+    bl.storage_key = keys.at(i);
+    bl.on_disk = true;
+    RETURN_IF_NOT_OK(tree_->DoInsert(rows->Get(i)->key(), bl));
+  }
+  // From now on the files belong to this pool, and are removed with it unless it is persisted again.
+  keep_files_ = false;
+  MS_LOG(INFO) << "Reloaded " << rows->size() << " rows from " << GetSpillPath();
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
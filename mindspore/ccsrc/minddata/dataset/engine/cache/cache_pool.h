@@ -16,6 +16,8 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -29,12 +31,15 @@
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/util/btree.h"
+#include "minddata/dataset/util/lock.h"
 
 namespace mindspore {
 namespace dataset {
 /// \brief A CachePool provides service for backup/restore a buffer. A buffer can be represented in a form of vector of
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). User must provide a key to insert the buffer.
+/// If a disk directory is provided, memory and disk form two tiers. When memory runs out, the rows not fetched
+/// recently are evicted to disk by a clock algorithm, and a row read back from disk is brought back to memory.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -45,22 +50,45 @@ class CachePool : public Service {
   using const_reference = const base_type &;
   using value_allocator = Allocator<base_type>;
 
-  // An internal class to locate the whereabouts of a backed up buffer which can be either in
+  // An internal class to locate the whereabouts of a backed up buffer which can be either in memory, on disk, or both
+  // when a row spilled to disk has been brought back to memory.
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator()
+        : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0), on_disk(false), referenced(false) {}
     ~DataLocator() = default;
-    DataLocator(const DataLocator &other) = default;
-    DataLocator &operator=(const DataLocator &other) = default;
+    DataLocator(const DataLocator &other)
+        : ptr(other.ptr),
+          sz(other.sz),
+          node_id(other.node_id),
+          node_hit(other.node_hit),
+          storage_key(other.storage_key),
+          on_disk(other.on_disk),
+          referenced(other.referenced.load()) {}
+    DataLocator &operator=(const DataLocator &other) {
+      if (&other != this) {
+        ptr = other.ptr;
+        sz = other.sz;
+        node_id = other.node_id;
+        node_hit = other.node_hit;
+        storage_key = other.storage_key;
+        on_disk = other.on_disk;
+        referenced = other.referenced.load();
+      }
+      return *this;
+    }
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
       storage_key = other.storage_key;
+      on_disk = other.on_disk;
+      referenced = other.referenced.load();
       other.ptr = nullptr;
       other.sz = 0;
       other.storage_key = 0;
+      other.on_disk = false;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
@@ -69,9 +97,12 @@ class CachePool : public Service {
         node_id = other.node_id;
         node_hit = other.node_hit;
         storage_key = other.storage_key;
+        on_disk = other.on_disk;
+        referenced = other.referenced.load();
         other.ptr = nullptr;
         other.sz = 0;
         other.storage_key = 0;
+        other.on_disk = false;
       }
       return *this;
     }
@@ -80,6 +111,8 @@ class CachePool : public Service {
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
     StorageManager::key_type storage_key;
+    bool on_disk;                  // storage_key refers to a copy on disk
+    std::atomic<bool> referenced;  // fetched since the clock hand last passed this row
   };
 
   using data_index = BPlusTree<int64_t, DataLocator>;
@@ -95,13 +128,19 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_mem_hit;   // fetches of rows cached in memory
+    int64_t num_disk_hit;  // fetches of rows spilled to disk
+    int64_t num_miss;      // fetches of rows not in the cache
+    int64_t num_evicted;   // rows moved from memory to disk to make room
     std::vector<key_type> gap;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param subfolder Optional name of the folder under root to spill to. A unique name is generated by default.
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "",
+                     const std::string &subfolder = "");
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -123,16 +162,34 @@ class CachePool : public Service {
   Status Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf);
 
   /// \brief Restore a cached buffer (from memory or disk)
+  /// \note A buffer read from disk is brought back to memory if memory can be found.
   /// \param[in] key A previous key returned from Insert
   /// \param[out] dest The cached buffer will be copied to this destination represented by a WritableSlice
   /// \param[out] bytesRead Optional. Number of bytes read.
   /// \return Error code
-  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
+  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr);
 
   /// \brief Serialize a DataLocator
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
                         flatbuffers::Offset<DataLocatorMsg> *) const;
 
+  /// \brief Check if a row may be evicted from memory. If so, its memory address is only valid while the row is
+  /// locked, and it must be fetched through Read.
+  bool CanEvict() const { return sm_ != nullptr; }
+
+  /// \brief Write every row that is only in memory to disk and describe where all the rows are on disk. The spill
+  /// folder is kept when the pool stops, so Restore can reload it in a new pool.
+  /// \param[in] fbb The builder of the manifest
+  /// \param[out] out The offset of the description in fbb
+  /// \return Status object
+  Status Persist(flatbuffers::FlatBufferBuilder *fbb, flatbuffers::Offset<CachePoolManifestMsg> *out);
+
+  /// \brief Reload the rows persisted by Persist. The pool must have been started on the same spill folder.
+  /// \note The rows stay on disk until they are read.
+  /// \param[in] manifest The description written by Persist
+  /// \return Status object
+  Status Restore(const CachePoolManifestMsg *manifest);
+
   /// \brief Get statistics.
   /// \return CacheStat object
   CacheStat GetStat(bool GetMissingKeys = false) const;
@@ -144,6 +201,11 @@ class CachePool : public Service {
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
 
  private:
+  // Number of locks protecting the locators of the rows. A row is locked by its key modulo this number.
+  static constexpr int32_t kNumLocatorLocks = 256;
+  // Number of rows evicted at most to find room for one row
+  static constexpr int32_t kMaxEvictionsPerRow = 8;
+
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
   const std::string subfolder_;
@@ -154,6 +216,37 @@ class CachePool : public Service {
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
   const int kMemoryCapAdjustInterval = 104857600;
+  // Counted when the locators of rows are looked up for a fetch
+  mutable std::atomic<int64_t> num_mem_hit_;
+  mutable std::atomic<int64_t> num_disk_hit_;
+  mutable std::atomic<int64_t> num_miss_;
+  std::atomic<int64_t> num_evicted_;
+  // The clock of the rows in memory. The hand is the front, a row with its reference bit set gets a second chance
+  // and moves to the back.
+  std::mutex clock_mux_;
+  std::deque<key_type> clock_;
+  // The pointer and the storage key of a DataLocator change when the row moves between memory and disk. Readers
+  // hold the lock of the row shared, whoever moves it holds it exclusive.
+  mutable std::vector<RWLock> locator_locks_;
+  bool keep_files_;
+
+  RWLock *LocatorLock(key_type key) const { return &locator_locks_[static_cast<uint64_t>(key) % kNumLocatorLocks]; }
+
+  /// \brief Allocate the memory of a row. If the memory is used up and the pool spills to disk, rows are evicted to
+  /// make room.
+  Status AllocateRow(size_t sz, DataLocator *bl);
+
+  /// \brief Move the next victim of the clock from memory to disk.
+  /// \param[out] freed The size of memory released, 0 if no row can be evicted
+  Status EvictOne(size_t *freed);
+
+  /// \brief Bring a row just read from disk back to memory. Nothing is done if there is no memory for it.
+  Status Promote(key_type key, const ReadableSlice &src);
+
+  void AddToClock(key_type key) {
+    std::unique_lock<std::mutex> lck(clock_mux_);
+    clock_.push_back(key);
+  }
 };
 }  // namespace dataset
 }  // namespace mindspore
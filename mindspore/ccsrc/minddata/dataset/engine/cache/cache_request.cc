@@ -147,6 +147,10 @@ BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<ro
   auto off_t = fbb.CreateVector(row_id);
   TensorRowIdsBuilder bld(fbb);
   bld.add_row_id(off_t);
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__ANDROID__) && !defined(ANDROID) && !defined(__APPLE__)
+  // The server reads the rows on disk next to the cpu which consumes them.
+  bld.add_cpu_id(sched_getcpu());
+#endif
   auto off = bld.Finish();
   fbb.Finish(off);
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
@@ -303,6 +307,10 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_mem_hit = msg->num_mem_hit();
+  stat_.num_disk_hit = msg->num_disk_hit();
+  stat_.num_miss = msg->num_miss();
+  stat_.num_evicted = msg->num_evicted();
   return Status::OK();
 }
 
@@ -331,6 +339,10 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.num_mem_hit = current_session_info->stats()->num_mem_hit();
+    stats.num_disk_hit = current_session_info->stats()->num_disk_hit();
+    stats.num_miss = current_session_info->stats()->num_miss();
+    stats.num_evicted = current_session_info->stats()->num_evicted();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
@@ -45,6 +45,10 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_mem_hit;
+  int64_t num_disk_hit;
+  int64_t num_miss;
+  int64_t num_evicted;
 };
 
 struct CacheServerCfgInfo {
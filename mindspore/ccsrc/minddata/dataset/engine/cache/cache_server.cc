@@ -52,6 +52,8 @@ Status CacheServer::DoServiceStart() {
     CacheServerHW::SetDefaultMemoryPolicy(numa_affinity_ ? CachePoolPolicy::kLocal : CachePoolPolicy::kInterleave));
   auto my_node = hw_info_->GetMyNode();
   MS_LOG(DEBUG) << "Cache server is running on numa node " << my_node;
+  // Bring back the caches of the previous server before any client can connect.
+  RETURN_IF_NOT_OK(RestoreCaches());
   // There will be some threads working on the grpc queue and
   // some number of threads working on the CacheServerRequest queue.
   // Like a connector object we will set up the same number of queues but
@@ -118,6 +120,11 @@ Status CacheServer::DoServiceStop() {
   auto it = all_caches_.begin();
   while (it != all_caches_.end()) {
     auto cs = std::move(it->second);
+    // Keep the cache on disk for the next server. It is only dropped by destroying the cache or its session.
+    rc2 = cs->Persist(it->first);
+    if (rc2.IsError()) {
+      MS_LOG(WARNING) << "Unable to persist cache " << it->first << ". " << rc2;
+    }
     rc2 = cs->ServiceStop();
     if (rc2.IsError()) {
       rc = rc2;
@@ -289,6 +296,39 @@ Status CacheServer::DestroyCache(CacheRequest *rq) {
   return Status::OK();
 }
 
+Status CacheServer::RestoreCaches() {
+  if (top_.empty()) {
+    return Status::OK();
+  }
+  Path spill(top_);
+  auto it = Path::DirIterator::OpenDirectory(&spill);
+  RETURN_UNEXPECTED_IF_NULL(it);
+  UniqueLock sess_lck(&sessions_lock_);
+  UniqueLock lck(&rwLock_);
+  while (it->hasNext()) {
+    auto manifest = it->next() / CacheService::kManifestName;
+    if (!manifest.Exists()) {
+      continue;
+    }
+    connection_id_type connection_id;
+    std::unique_ptr<CacheService> cs;
+    Status rc = CacheService::Restore(manifest, &connection_id, &cs);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Unable to reload the cache persisted in " << manifest << ". " << rc;
+      continue;
+    }
+    if (GetService(connection_id) != nullptr) {
+      // Left behind by an earlier server. Stopping the one reloaded last removes its files.
+      MS_LOG(WARNING) << "Cache " << connection_id << " is persisted more than once. Dropping " << manifest;
+      continue;
+    }
+    (void)active_sessions_.insert(GetSessionID(connection_id));
+    MS_LOG(INFO) << "Reloaded cache " << connection_id << " of session " << GetSessionID(connection_id);
+    all_caches_.emplace(connection_id, std::move(cs));
+  }
+  return Status::OK();
+}
+
 Status CacheServer::CacheRow(CacheRequest *rq, CacheReply *reply) {
   auto connection_id = rq->connection_id();
   // Hold the shared lock to prevent the cache from being dropped.
@@ -429,7 +469,8 @@ Status CacheServer::InternalFetchRow(CacheRequest *rq) {
   return rc;
 }
 
-Status CacheServer::BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, WritableSlice *out) {
+Status CacheServer::BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, WritableSlice *out,
+                               numa_id_t client_node) {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto p = flatbuffers::GetRoot<BatchDataLocatorMsg>(fbb->GetBufferPointer());
   const auto num_elements = p->rows()->size();
@@ -451,7 +492,11 @@ Status CacheServer::BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuil
     offset_array[i + 1] = offset_array[i] + sz_4k;
     if (sz > 0) {
       WritableSlice row_data(*out, offset_array[i], sz);
-      // Get a request and send to the proper worker (at some numa node) to do the fetch.
+      // Get a request and send to the proper worker (at some numa node) to do the fetch. A row on disk is read by
+      // a worker on the node of the client, so it is brought back to memory next to the cpu consuming it.
+      if (source_addr == nullptr && client_node >= 0) {
+        node_id = client_node;
+      }
       worker_id_t worker_id = IsNumaAffinityOn() ? GetWorkerByNumaId(node_id) : GetRandomWorker();
       CacheServerRequest *cache_rq;
       RETURN_IF_NOT_OK(GetFreeRequestTag(&cache_rq));
@@ -520,6 +565,8 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
     }
     auto client_flag = rq->flag();
     bool local_client = BitTest(client_flag, kLocalClientSupport);
+    // The cpu id only makes sense if the client runs on this machine.
+    numa_id_t client_node = local_client ? hw_info_->GetNodeOfCpu(p->cpu_id()) : -1;
     // For large amount data to be sent back, we will use shared memory provided it is a local
     // client that has local bypass support
     bool local_bypass = local_client ? (mem_sz >= kLocalByPassThreshold) : false;
@@ -530,7 +577,7 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
       void *q = nullptr;
       RETURN_IF_NOT_OK(AllocateSharedMemory(client_id, mem_sz, &q));
       WritableSlice dest(q, mem_sz);
-      Status rc = BatchFetch(fbb, &dest);
+      Status rc = BatchFetch(fbb, &dest, client_node);
       if (rc.IsError()) {
         DeallocateSharedMemory(client_id, q);
         return rc;
@@ -551,7 +598,7 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
         return Status(StatusCode::kMDOutOfMemory);
       }
       WritableSlice dest(mem.data(), mem_sz);
-      RETURN_IF_NOT_OK(BatchFetch(fbb, &dest));
+      RETURN_IF_NOT_OK(BatchFetch(fbb, &dest, client_node));
       reply->set_result(std::move(mem));
     }
   }
@@ -578,6 +625,10 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_mem_hit(svc_stat.stat_.num_mem_hit);
+    bld.add_num_disk_hit(svc_stat.stat_.num_disk_hit);
+    bld.add_num_miss(svc_stat.stat_.num_miss);
+    bld.add_num_evicted(svc_stat.stat_.num_evicted);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -711,7 +762,9 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
         auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
                                                   svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
+                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+                                                  svc_stat.stat_.num_mem_hit, svc_stat.stat_.num_disk_hit,
+                                                  svc_stat.stat_.num_miss, svc_stat.stat_.num_evicted);
         auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
         session_msgs_vector.push_back(current_session_info);
       }
@@ -326,6 +326,11 @@ class CacheServer : public Service {
   /// \return Status object
   Status DestroyCache(CacheRequest *rq);
 
+  /// \brief Reload the caches persisted in the spill path by a previous server, and reopen their sessions.
+  /// A cache which can't be reloaded is skipped and its folder is left alone.
+  /// \return Status object
+  Status RestoreCaches();
+
   /// \brief Entry point for all internal server threads.
   Status ServerRequest(worker_id_t worker_id);
 
@@ -473,8 +478,10 @@ class CacheServer : public Service {
   /// by the CacheClient. Cache miss is not an error, and will be coded in the output to mark an empty row.
   /// \param[in] v A vector of row id.
   /// \param[out] out A contiguous memory buffer that holds the requested rows.
+  /// \param[in] client_node The numa node of the client cpu, -1 if unknown
   /// \return Status object
-  Status BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, WritableSlice *out);
+  Status BatchFetch(const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, WritableSlice *out,
+                    numa_id_t client_node = -1);
   Status BatchCacheRows(CacheRequest *rq);
 
   Status InternalFetchRow(CacheRequest *rq);
@@ -13,6 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
 */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <random>
 #include "minddata/dataset/engine/cache/cache_service.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
@@ -22,8 +26,9 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, const std::string &subfolder)
     : root_(root),
+      subfolder_(subfolder),
       cache_mem_sz_(mem_sz * 1048576L),  // mem_sz is in MB unit
       cp_(nullptr),
       next_id_(0),
@@ -53,7 +58,7 @@ Status CacheService::DoServiceStart() {
     RETURN_STATUS_UNEXPECTED("Unable to bring up numa memory pool");
   }
   // Put together a CachePool for backing up the Tensor.
-  cp_ = std::make_shared<CachePool>(numa_pool_, root_);
+  cp_ = std::make_shared<CachePool>(numa_pool_, root_, subfolder_);
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name.
   cookie_ = cp_->MyName();
@@ -265,7 +270,8 @@ Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
   void *source_addr = reinterpret_cast<void *>(p->source_addr());
   void *dest_addr = reinterpret_cast<void *>(p->dest_addr());
   WritableSlice dest(dest_addr, sz);
-  if (source_addr != nullptr) {
+  // A row which can be evicted may be gone from source_addr by now. Read it with the row locked.
+  if (source_addr != nullptr && !cp_->CanEvict()) {
     // We are not checking if the row is still present but simply use the information passed in.
     // This saves another tree lookup and is faster.
     ReadableSlice src(source_addr, sz);
@@ -345,5 +351,78 @@ Status CacheService::ToggleWriteMode(bool on_off) {
   }
   return Status::OK();
 }
+
+Status CacheService::Persist(connection_id_type connection_id) {
+  UniqueLock rw(&rw_lock_);
+  auto st = st_.load();
+  bool complete = st == CacheServiceState::kNone || st == CacheServiceState::kNoLocking ||
+                  st == CacheServiceState::kFetchPhase;
+  if (cp_ == nullptr || !cp_->CanEvict() || !complete) {
+    return Status::OK();
+  }
+  flatbuffers::FlatBufferBuilder fbb;
+  flatbuffers::Offset<CachePoolManifestMsg> off_pool;
+  RETURN_IF_NOT_OK(cp_->Persist(&fbb, &off_pool));
+  auto off_schema = fbb.CreateVector(reinterpret_cast<const uint8_t *>(schema_.data()), schema_.size());
+  CacheServiceManifestMsgBuilder bld(fbb);
+  bld.add_version(kManifestVersion);
+  bld.add_connection_id(connection_id);
+  bld.add_cache_mem_sz(cache_mem_sz_ / 1048576L);  // In MB unit, like the constructor takes it.
+  bld.add_generate_id(generate_id_);
+  bld.add_state(static_cast<int8_t>(st));
+  bld.add_next_row_id(next_id_);
+  bld.add_schema(off_schema);
+  bld.add_pool(off_pool);
+  auto off = bld.Finish();
+  fbb.Finish(off);
+  // Write a temporary file and rename it, so a restarted server never picks up half a manifest.
+  auto spill = GetSpillPath();
+  auto manifest = (spill / kManifestName).toString();
+  auto tmp = manifest + ".tmp";
+  std::ofstream ofs(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+  ofs.write(reinterpret_cast<const char *>(fbb.GetBufferPointer()), fbb.GetSize());
+  ofs.close();
+  CHECK_FAIL_RETURN_UNEXPECTED(ofs.good(), "Failed to write " + tmp);
+  if (rename(tmp.data(), manifest.data()) != 0) {
+    RETURN_STATUS_UNEXPECTED("Failed to rename " + tmp + ": " + strerror(errno));
+  }
+  MS_LOG(INFO) << "Cache " << connection_id << " is persisted in " << spill;
+  return Status::OK();
+}
+
+Status CacheService::Restore(Path manifest, connection_id_type *connection_id, std::unique_ptr<CacheService> *out) {
+  RETURN_UNEXPECTED_IF_NULL(connection_id);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  std::ifstream ifs(manifest.toString(), std::ios::in | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(ifs.is_open(), "Failed to open " + manifest.toString());
+  std::string buf((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t *>(buf.data()), buf.size());
+  CHECK_FAIL_RETURN_UNEXPECTED(verifier.VerifyBuffer<CacheServiceManifestMsg>(nullptr),
+                               "Corrupted cache manifest " + manifest.toString());
+  auto msg = flatbuffers::GetRoot<CacheServiceManifestMsg>(buf.data());
+  CHECK_FAIL_RETURN_UNEXPECTED(msg->version() == kManifestVersion,
+                               "Unsupported cache manifest version " + std::to_string(msg->version()));
+  CHECK_FAIL_RETURN_UNEXPECTED(msg->pool() != nullptr, "Incomplete cache manifest " + manifest.toString());
+  // The manifest is in the spill folder of the cache, which is under the spill path of the server.
+  Path spill(manifest.ParentPath());
+  auto subfolder = spill.Basename();
+  auto cs = std::make_unique<CacheService>(msg->cache_mem_sz(), spill.ParentPath(), msg->generate_id(), subfolder);
+  RETURN_IF_NOT_OK(cs->ServiceStart());
+  CHECK_FAIL_RETURN_UNEXPECTED(cs->cp_->CanEvict(), "Cache " + spill.toString() + " doesn't spill to disk");
+  RETURN_IF_NOT_OK(cs->cp_->Restore(msg->pool()));
+  cs->next_id_ = msg->next_row_id();
+  if (msg->schema() != nullptr) {
+    cs->schema_.assign(reinterpret_cast<const char *>(msg->schema()->data()), msg->schema()->size());
+  }
+  auto st = static_cast<CacheServiceState>(msg->state());
+  cs->st_ = st;
+  // Same as after BuildPhaseDone or ToggleWriteMode, no more rows are inserted.
+  if (st == CacheServiceState::kFetchPhase || st == CacheServiceState::kNoLocking) {
+    cs->cp_->SetLocking(false);
+  }
+  *connection_id = msg->connection_id();
+  *out = std::move(cs);
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -49,9 +49,14 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param subfolder Optional folder under the spill path, used to reload a persisted cache
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, const std::string &subfolder = "");
   ~CacheService() override;
 
+  /// Name of the file describing a persisted cache in its spill folder
+  static constexpr char kManifestName[] = "CACHE.MF";
+  static constexpr int32_t kManifestVersion = 1;
+
   Status DoServiceStart() override;
   Status DoServiceStop() override;
 
@@ -123,10 +128,22 @@ class CacheService : public Service {
   Status BuildPhaseDone();
   /// \brief For kToggleWriteMode request
   Status ToggleWriteMode(bool on_off);
+  /// \brief Keep the rows of a cache which spills to disk in its spill folder when it stops, with a manifest to
+  /// reload it. A cache still in its build phase or out of space is not persisted.
+  /// \param connection_id The connection id of this cache, the clients get it back after a restart
+  /// \return Status object
+  Status Persist(connection_id_type connection_id);
+  /// \brief Reload a cache persisted by a previous server.
+  /// \param[in] manifest Path to the manifest in the spill folder of the cache
+  /// \param[out] connection_id The connection id of the cache
+  /// \param[out] out The started cache service
+  /// \return Status object
+  static Status Restore(Path manifest, connection_id_type *connection_id, std::unique_ptr<CacheService> *out);
 
  private:
   mutable RWLock rw_lock_;
   std::string root_;
+  std::string subfolder_;
   uint64_t cache_mem_sz_;
   std::shared_ptr<CachePool> cp_;
   std::atomic<row_id_type> next_id_;
@@ -118,6 +118,7 @@ Status StorageContainer::Insert(const std::vector<ReadableSlice> &buf, off64_t *
   if (sz == 0) {
     RETURN_STATUS_UNEXPECTED("Unexpected 0 length");
   }
+  CHECK_FAIL_RETURN_UNEXPECTED(bs_ != nullptr, "Container " + cont_.toString() + " is read only");
   if (sz > bs_->GetMaxSize()) {
     RETURN_STATUS_UNEXPECTED("Request size too big");
   }
@@ -154,12 +155,17 @@ Status StorageContainer::Truncate() const noexcept {
 }
 
 StorageContainer::~StorageContainer() noexcept {
-  (void)Truncate();
+  if (!keep_) {
+    (void)Truncate();
+  }
   (void)Close();
 }
 
 std::ostream &operator<<(std::ostream &os, const StorageContainer &s) {
-  os << "File path : " << s.cont_ << "\n" << *(s.bs_.get());
+  os << "File path : " << s.cont_ << "\n";
+  if (s.bs_ != nullptr) {
+    os << *(s.bs_.get());
+  }
   return os;
 }
 
@@ -177,5 +183,22 @@ Status StorageContainer::CreateStorageContainer(std::shared_ptr<StorageContainer
   }
   return rc;
 }
+
+Status StorageContainer::OpenStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path) {
+  RETURN_UNEXPECTED_IF_NULL(out_sc);
+  auto sc = new (std::nothrow) StorageContainer(path);
+  if (sc == nullptr) {
+    return Status(StatusCode::kMDOutOfMemory);
+  }
+  // No BuddySpace, nothing is inserted into a container we reopen.
+  Status rc = sc->Open();
+  if (rc.IsOk()) {
+    (*out_sc).reset(sc);
+    MS_LOG(INFO) << "Container " << path << " reopened";
+  } else {
+    delete sc;
+  }
+  return rc;
+}
 }  // namespace dataset
 }  // namespace mindspore
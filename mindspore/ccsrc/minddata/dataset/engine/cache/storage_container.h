@@ -60,16 +60,21 @@ class StorageContainer {
 
   static Status CreateStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path);
 
+  /// \brief Open a container kept by a previous server. Its content is read only.
+  static Status OpenStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path);
+
  private:
   mutable std::mutex mutex_;
   Path cont_;
   int fd_;
   bool is_open_;
+  bool keep_;  // the file is not truncated on destruction
   std::unique_ptr<BuddySpace> bs_;
 
   // Use the default value of BuddySpace
   // which can map upto 4G of space.
-  explicit StorageContainer(const std::string &path) : cont_(path), fd_(-1), is_open_(false), bs_(nullptr) {}
+  explicit StorageContainer(const std::string &path)
+      : cont_(path), fd_(-1), is_open_(false), keep_(false), bs_(nullptr) {}
 
   Status Create();
 };
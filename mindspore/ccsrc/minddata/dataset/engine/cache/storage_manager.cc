@@ -42,6 +42,11 @@ Status StorageManager::AddOneContainer(int replaced_container_pos) {
   const std::string kPrefix = "IMG";
   const std::string kSuffix = "LB";
   Path container_name = root_ / ConstructFileName(kPrefix, file_id_, kSuffix);
+  // Don't overwrite the containers restored from a previous server.
+  while (container_name.Exists()) {
+    file_id_++;
+    container_name = root_ / ConstructFileName(kPrefix, file_id_, kSuffix);
+  }
   std::shared_ptr<StorageContainer> sc;
   RETURN_IF_NOT_OK(StorageContainer::CreateStorageContainer(&sc, container_name.toString()));
   containers_.push_back(sc);
@@ -155,10 +160,60 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   return Status::OK();
 }
 
+Status StorageManager::GetLocation(key_type key, value_type *out) const {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto r = index_.Search(key);
+  if (r.second) {
+    *out = *(r.first);
+  } else {
+    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  return Status::OK();
+}
+
+std::vector<std::string> StorageManager::GetContainerNames() const {
+  std::vector<std::string> names;
+  names.reserve(containers_.size());
+  for (auto const &p : containers_) {
+    names.push_back(p->cont_.Basename());
+  }
+  return names;
+}
+
+Status StorageManager::Restore(const std::vector<std::string> &names, const std::vector<value_type> &locations,
+                               std::vector<key_type> *keys) {
+  RETURN_UNEXPECTED_IF_NULL(keys);
+  UniqueLock lck(&rw_lock_);
+  CHECK_FAIL_RETURN_UNEXPECTED(containers_.size() + names.size() <= kMaxNumContainers, "Too many containers");
+  // The restored containers are appended after the writable ones, their index changes.
+  std::vector<int> container_index;
+  container_index.reserve(names.size());
+  for (auto const &name : names) {
+    std::shared_ptr<StorageContainer> sc;
+    RETURN_IF_NOT_OK(StorageContainer::OpenStorageContainer(&sc, (root_ / name).toString()));
+    containers_.push_back(sc);
+    container_index.push_back(containers_.size() - 1);
+  }
+  keys->clear();
+  keys->reserve(locations.size());
+  for (auto const &v : locations) {
+    CHECK_FAIL_RETURN_UNEXPECTED(v.first >= 0 && static_cast<size_t>(v.first) < container_index.size(),
+                                 "Invalid container index " + std::to_string(v.first));
+    key_type key;
+    RETURN_IF_NOT_OK(index_.insert(std::make_pair(container_index[v.first], v.second), &key));
+    keys->push_back(key);
+  }
+  return Status::OK();
+}
+
 Status StorageManager::DoServiceStop() noexcept {
   Status rc;
   Status rc1;
   for (auto const &p : containers_) {
+    if (keep_containers_) {
+      p->keep_ = true;
+      continue;
+    }
     // The destructor of StorageContainer is not called automatically until the use
     // count drops to 0. But it is not always the case. We will do it ourselves.
     rc = p.get()->Truncate();
@@ -172,10 +227,11 @@ Status StorageManager::DoServiceStop() noexcept {
   return rc1;
 }
 
-StorageManager::StorageManager(const Path &root) : root_(root), pool_size_(1), file_id_(0), index_() {}
+StorageManager::StorageManager(const Path &root)
+    : root_(root), pool_size_(1), file_id_(0), index_(), keep_containers_(false) {}
 
 StorageManager::StorageManager(const Path &root, int pool_size)
-    : root_(root), pool_size_(pool_size), file_id_(0), index_() {}
+    : root_(root), pool_size_(pool_size), file_id_(0), index_(), keep_containers_(false) {}
 
 StorageManager::~StorageManager() { (void)StorageManager::DoServiceStop(); }
 
@@ -63,6 +63,26 @@ class StorageManager : public Service {
 
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Find the container and the offset of a buffer written by Write.
+  /// \param[in] key The key returned by Write
+  /// \param[out] out Index of the container in GetContainerNames, and the offset and size in the container
+  /// \return Status object
+  Status GetLocation(key_type key, value_type *out) const;
+
+  /// \return The base names of all the containers, in the order of their index
+  std::vector<std::string> GetContainerNames() const;
+
+  /// \brief Reopen the containers of a previous StorageManager on the same directory and index the buffers in them.
+  /// \param[in] names The base names of the containers, as returned by GetContainerNames
+  /// \param[in] locations Index of the container in names, offset and size of each buffer
+  /// \param[out] keys The new key of each buffer, which can be passed to Read
+  /// \return Status object
+  Status Restore(const std::vector<std::string> &names, const std::vector<value_type> &locations,
+                 std::vector<key_type> *keys);
+
+  /// \brief Leave the container files on disk when the service stops, so they can be restored.
+  void KeepContainers() { keep_containers_ = true; }
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
@@ -77,6 +97,7 @@ class StorageManager : public Service {
   storage_index index_;
   std::vector<int> writable_containers_pool_;
   int pool_size_;
+  bool keep_containers_;
 
   std::string GetBaseName(const std::string &prefix, int32_t file_id);
 
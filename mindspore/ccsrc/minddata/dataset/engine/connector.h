@@ -16,12 +16,15 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_queue.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
 
@@ -72,7 +75,12 @@ class Connector {
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element for each queue.
   Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+      : num_producers_(n_producers),
+        num_consumers_(n_consumers),
+        launch_producers_(n_producers),
+        active_producers_(n_producers),
+        popped_rows_(0),
+        num_pending_producers_(0) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -101,7 +109,7 @@ class Connector {
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
       RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
-      pop_from_ = (pop_from_ + 1) % num_producers_;
+      AdvancePopFrom();
       out_buffers_count_++;
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
     }
@@ -135,7 +143,8 @@ class Connector {
   }
 
   // Resets the internal index tracking of the queue so that it can be used again with new inputs,
-  // starting from the beginning.
+  // starting from the beginning. The producers restart their roundrobin from producer 0 with the number of
+  // active producers the connector was launched with.
   void Reset() {
     for (int i = 0; i < queues_.size(); ++i) {
       queues_[i]->ResetQue();
@@ -143,9 +152,47 @@ class Connector {
     expect_consumer_ = 0;
     pop_from_ = 0;
     out_buffers_count_ = 0;
+    active_producers_ = launch_producers_;
+    popped_rows_ = 0;
+    {
+      std::unique_lock<std::mutex> lk(pending_mux_);
+      pending_producers_.clear();
+      num_pending_producers_ = 0;
+    }
     MS_LOG(DEBUG) << "Connector counters reset.";
   }
 
+  // Set the number of producers taking part in the roundrobin from the first row, and again after Reset().
+  // Must be called before any row is pushed.
+  // @param n_producers The number of producers, starting from id 0, taking part in the roundrobin.
+  void SetLaunchProducers(int32_t n_producers) {
+    MS_ASSERT(n_producers > 0 && n_producers <= num_producers_);
+    launch_producers_ = n_producers;
+    active_producers_ = n_producers;
+  }
+
+  // Change the number of producers taking part in the roundrobin, so that a ParallelOp can run with fewer
+  // workers than it has launched. The rows from the after_rows-th row onwards are pushed in the new roundrobin
+  // order. It must be called before that row is pushed, and at a point where the previous roundrobin order
+  // wraps around to producer 0, so the consumer can follow the change whenever it sees it.
+  // @param n_producers The number of producers, starting from id 0, taking part in the roundrobin.
+  // @param after_rows The number of rows pushed in the previous roundrobin order.
+  void SetActiveProducers(int32_t n_producers, int64_t after_rows) {
+    MS_ASSERT(n_producers > 0 && n_producers <= num_producers_);
+    std::unique_lock<std::mutex> lk(pending_mux_);
+    pending_producers_.emplace_back(after_rows, n_producers);
+    num_pending_producers_++;
+  }
+
+  // Change the capacity of each internal queue while the connector is in use.
+  // @param queue_capacity The number of element for each queue.
+  Status Resize(int32_t queue_capacity) {
+    for (int32_t i = 0; i < queues_.size(); ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    return Status::OK();
+  }
+
   void Print(std::ostream &out, bool showAll) const {
     out << "\n--------- Connector ------------"
         << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
@@ -166,14 +213,18 @@ class Connector {
     return size;
   }
 
+  // Get the capacity of the queues taking part in the roundrobin.
   int32_t capacity() const {
     int32_t capacity = 0;
-    for (int32_t i = 0; i < queues_.size(); ++i) {
+    for (int32_t i = 0; i < active_producers_; ++i) {
       capacity += queues_[i]->capacity();
     }
     return capacity;
   }
 
+  // Get the capacity of each internal queue.
+  int32_t queue_capacity() const { return queues_.size() > 0 ? queues_[0]->capacity() : 0; }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
@@ -186,10 +237,27 @@ class Connector {
   }
 
  protected:
+  // Move pop_from_ to the queue of the next row, once a row is popped. Must be called with m_ locked.
+  void AdvancePopFrom() {
+    ++popped_rows_;
+    // The first row of a new roundrobin order comes from producer 0 in either order, so a change is applied
+    // once that row is popped.
+    if (num_pending_producers_ > 0) {
+      std::unique_lock<std::mutex> lk(pending_mux_);
+      while (!pending_producers_.empty() && pending_producers_.front().first < popped_rows_) {
+        active_producers_ = pending_producers_.front().second;
+        pending_producers_.pop_front();
+        num_pending_producers_--;
+      }
+    }
+    pop_from_ = (pop_from_ + 1) % active_producers_;
+  }
+
   std::string my_name_;
 
-  // A list of Queues that are thread safe.
-  QueueList<T> queues_;
+  // A list of Queues that are thread safe. A queue may be pushed by another producer than its own, e.g. the
+  // worker which sends the EOE of RandomDataOp, and popped by any consumer, so they are MPMC rings.
+  QueueList<T, MpmcQueue<T>> queues_;
 
   // The consumer that we allow to get the next data from pop()
   int32_t expect_consumer_;
@@ -200,6 +268,15 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  // The number of producers taking part in the roundrobin at launch and now, and the pending changes of it as
+  // (number of rows pushed before the change, number of producers) pairs.
+  int32_t launch_producers_;
+  std::atomic<int32_t> active_producers_;
+  int64_t popped_rows_;
+  std::mutex pending_mux_;
+  std::deque<std::pair<int64_t, int32_t>> pending_producers_;
+  std::atomic<int32_t> num_pending_producers_;
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
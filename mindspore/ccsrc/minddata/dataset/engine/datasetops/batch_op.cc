@@ -24,6 +24,9 @@
 
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/util/recycle_pool.h"
+#endif
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -70,7 +73,8 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
     queue_size = std::max(2, queue_size);
   }
 
-  worker_queues_.Init(num_workers, queue_size);
+  ReserveTunableWorkers();
+  worker_queues_.Init(num_workers_, queue_size);
 }
 // if PYTHON is disabled. per_batch_map can't be used
 #else
@@ -90,7 +94,8 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
     // ensure there is at least 2 queue slots for whole operation..  If only 1 worker, incrase it to 2
     queue_size = std::max(2, queue_size);
   }
-  worker_queues_.Init(num_workers, queue_size);
+  ReserveTunableWorkers();
+  worker_queues_.Init(num_workers_, queue_size);
 }
 #endif
 
@@ -111,7 +116,7 @@ Status BatchOp::operator()() {
       table->emplace_back(new_row);
       // if # of rows is enough to make 1 batch, send it to worker_queue
       if (table->size() == static_cast<size_t>(cur_batch_size)) {
-        RETURN_IF_NOT_OK(worker_queues_[cnt % num_workers_]->EmplaceBack(
+        RETURN_IF_NOT_OK(worker_queues_[NextWorkerId()]->EmplaceBack(
           std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
         cnt++;
         table = std::make_unique<TensorQTable>();
@@ -121,7 +126,7 @@ Status BatchOp::operator()() {
     }
     // Reminder logic, execute only when there is a remainder (table is non empty) and don't drop
     if (drop_ == false && table->empty() == false) {
-      RETURN_IF_NOT_OK(worker_queues_[cnt % num_workers_]->EmplaceBack(
+      RETURN_IF_NOT_OK(worker_queues_[NextWorkerId()]->EmplaceBack(
         std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
       cnt++;
     }
@@ -130,7 +135,8 @@ Status BatchOp::operator()() {
     batch_num = 0;
     epoch_num++;
     RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
+      worker_queues_[NextWorkerId()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
+    cnt++;
     RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
 
@@ -144,11 +150,10 @@ Status BatchOp::operator()() {
 #endif
   }  // end of eof_handled() == false
   RETURN_IF_NOT_OK(
-    worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOF))));
+    worker_queues_[NextWorkerId()]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOF))));
   // EOF received, send quit signal to all workers
   for (int32_t ind = 0; ind < num_workers_; ind++) {
-    RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
+    RETURN_IF_NOT_OK(worker_queues_[ind]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
   }
   return Status::OK();
 }
@@ -228,6 +233,7 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *d
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
+  bool memory_reserved = false;
   RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
   while (table_pair.second.ctrl_ != batchCtrl::kQuit) {
     if (table_pair.second.ctrl_ == batchCtrl::kEOE) {
@@ -237,6 +243,10 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       TensorRow new_row;
       RETURN_IF_NOT_OK(MakeBatchedRow(std::move(table_pair), &new_row));
+      if (!memory_reserved) {
+        RETURN_IF_NOT_OK(ReserveBatchMemory(new_row));
+        memory_reserved = true;
+      }
       RETURN_IF_NOT_OK(out_connector_->Add(std::move(new_row), workerId));
     }
     RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
@@ -254,6 +264,22 @@ Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchIn
   return Status::OK();
 }
 
+Status BatchOp::ReserveBatchMemory(const TensorRow &row) {
+#ifndef ENABLE_ANDROID
+  auto pool = std::dynamic_pointer_cast<RecyclePool>(GlobalContext::Instance()->mem_pool());
+  RETURN_OK_IF_TRUE(pool == nullptr);
+  // A worker has at most its queue of the out connector, the batch it builds and the batch the consumer holds
+  // in flight, the batches it made before come back to it
+  int32_t num_batches = oc_queue_size_ + 2;
+  for (const auto &tensor : row) {
+    if (tensor->type().IsNumeric() && tensor->SizeInBytes() > 0) {
+      RETURN_IF_NOT_OK(pool->Reserve(tensor->SizeInBytes(), num_batches));
+    }
+  }
+#endif
+  return Status::OK();
+}
+
 Status BatchOp::LaunchThreadsAndInitOp() {
   if (tree_ == nullptr) {
     return Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__,
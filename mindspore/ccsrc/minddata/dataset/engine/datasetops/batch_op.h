@@ -30,6 +30,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/util/ring_queue.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -222,6 +223,12 @@ class BatchOp : public ParallelOp {
   // @return Status The status code returned
   Status MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair, TensorRow *new_row);
 
+  // Reserve the memory of the batches like the given one for the calling worker, so it allocates its first batches
+  // from the recycled memory pool as well, instead of waiting for them to be dropped by the consumer
+  // @param const TensorRow &row - a batched row
+  // @return Status The status code returned
+  Status ReserveBatchMemory(const TensorRow &row);
+
 #ifdef ENABLE_PYTHON
   // Function that calls pyfunc to perform map on batch
   // @param (std::pair<std::unique_ptr<TensorQTable>, batch_stats> *table_pair - contains un-batched tensor
@@ -275,7 +282,8 @@ class BatchOp : public ParallelOp {
   PadInfo pad_info_;                                    // column names to perform padding on
   std::unique_ptr<ChildIterator> child_iterator_;       // child iterator for fetching TensorRows 1 by 1
   std::unordered_map<std::string, int32_t> child_map_;  // col_name_id_map of the child node
-  QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;  // internal queue for syncing worker
+  using BatchJob = std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>;
+  QueueList<BatchJob, SpscQueue<BatchJob>> worker_queues_;  // internal queue for syncing worker
   int64_t batch_num_;
   int64_t batch_cnt_;
 #ifdef ENABLE_PYTHON
@@ -223,6 +223,14 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   }
 }
 
+// Changes the capacity of each queue of the output connector while the op is running
+Status DatasetOp::SetConnectorQueueCapacity(int32_t queue_capacity) {
+  CHECK_FAIL_RETURN_UNEXPECTED(out_connector_ != nullptr, NameWithID() + " does not have an output connector.");
+  CHECK_FAIL_RETURN_UNEXPECTED(queue_capacity > 0,
+                               "Invalid connector queue capacity: " + std::to_string(queue_capacity) + ".");
+  return out_connector_->Resize(queue_capacity);
+}
+
 // A print method typically used for debugging.  showAll of true will recursively descend to child prints
 void DatasetOp::Print(std::ostream &out, bool show_all) const {
   // When show_all is false, we display a 1 liner piece of text for the op.
@@ -278,6 +278,15 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  // \brief Getter function
+  // \return capacity of each queue of the output connector, 0 for an inlined op
+  int32_t ConnectorQueueCapacity() const { return inlined() ? 0 : out_connector_->queue_capacity(); }
+
+  // \brief Change the capacity of each queue of the output connector while the op is running
+  // \param queue_capacity - The number of rows each queue can hold
+  // \return Status The status code returned
+  Status SetConnectorQueueCapacity(int32_t queue_capacity);
+
   // \brief Getter function
   // \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
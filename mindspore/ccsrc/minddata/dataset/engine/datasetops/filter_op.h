@@ -25,6 +25,7 @@
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_queue.h"
 
 namespace mindspore {
 namespace dataset {
@@ -81,7 +82,7 @@ class FilterOp : public ParallelOp {
   // Internal queue for filter.
   QueueList<std::pair<TensorRow, filterCtrl>> filter_queues_;
 
-  QueueList<TensorRow> worker_queues_;  // internal queue for syncing worker
+  QueueList<TensorRow, SpscQueue<TensorRow>> worker_queues_;  // internal queue for syncing worker
 
   std::unique_ptr<ChildIterator> child_iterator_;
 
@@ -30,6 +30,9 @@ CpuMapJob::CpuMapJob() = default;
 // Constructor
 CpuMapJob::CpuMapJob(std::vector<std::shared_ptr<TensorOp>> operations) : MapJob(std::move(operations)) {}
 
+// Constructor
+CpuMapJob::CpuMapJob(bool run_on_batch) : run_on_batch_(run_on_batch) {}
+
 // Destructor
 CpuMapJob::~CpuMapJob() = default;
 
@@ -41,7 +44,8 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
       // Call compute function for cpu
-      Status rc = ops_[i]->Compute(input_row, &result_row);
+      Status rc =
+        run_on_batch_ ? ops_[i]->BatchCompute(input_row, &result_row) : ops_[i]->Compute(input_row, &result_row);
       if (rc.IsError()) {
         std::string err_msg = "";
         std::string op_name = ops_[i]->Name();
@@ -30,11 +30,18 @@ class CpuMapJob : public MapJob {
   // Constructor
   explicit CpuMapJob(std::vector<std::shared_ptr<TensorOp>> operations);
 
+  // Constructor
+  // @param run_on_batch true if each input row holds a batch of rows and is computed with BatchCompute()
+  explicit CpuMapJob(bool run_on_batch);
+
   // Destructor
   ~CpuMapJob();
 
   // A pure virtual run function to execute a cpu map job
   Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) override;
+
+ private:
+  bool run_on_batch_ = false;
 };
 
 }  // namespace dataset
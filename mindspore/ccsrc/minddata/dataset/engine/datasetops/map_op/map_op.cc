@@ -36,6 +36,7 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
              std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size)
     : ParallelOp(num_workers, op_connector_size),
       tfuncs_(std::move(tensor_funcs)),
+      run_on_batch_(false),
       in_columns_(in_col_names),
       out_columns_(out_col_names) {
   // Set connector size via config.
@@ -43,6 +44,7 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
   if (out_columns_.empty() || out_columns_[0].empty()) {
     out_columns_ = in_columns_;
   }
+  ReserveTunableWorkers();
 }
 
 // The number of threads consuming data from previous op's output Connector.
@@ -98,7 +100,7 @@ Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job)
     // map_job could be nullptr when we are at the first tensor op or when the target device of the prev op
     // is different with that of the current op.
     if (map_job == nullptr) {
-      map_job = std::make_shared<CpuMapJob>();
+      map_job = std::make_shared<CpuMapJob>(run_on_batch_);
     }
     RETURN_IF_NOT_OK(map_job->AddOperation(tfuncs_[i]));
 
@@ -134,8 +136,8 @@ Status MapOp::operator()() {
   // Synchronize with TaskManager
   TaskManager::FindMe()->Post();
   RETURN_IF_NOT_OK(rc);
-  // num_rows received, including eoe, num_epoch, num_step of current epoch
-  int64_t num_rows = 0, ep_step = 0, total_step = 0;
+  // num_step of current epoch, total num_step
+  int64_t ep_step = 0, total_step = 0;
 
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
@@ -160,7 +162,7 @@ Status MapOp::operator()() {
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
 
       // Push map worker job to the corresponding worker's queue
-      RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
+      RETURN_IF_NOT_OK(local_queues_[NextWorkerId()]->Add(std::move(worker_job)));
 
       RETURN_IF_NOT_OK(callback_manager_.StepEnd(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
@@ -175,20 +177,20 @@ Status MapOp::operator()() {
     }
     // Propagate the eoe row to worker
     std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-    RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
+    RETURN_IF_NOT_OK(local_queues_[NextWorkerId()]->Add(std::move(worker_job)));
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
   std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-  RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
+  RETURN_IF_NOT_OK(local_queues_[NextWorkerId()]->Add(std::move(worker_job)));
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
   for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
     TensorRow quit_flag(TensorRow::kFlagQuit);
     auto quit = std::make_unique<MapWorkerJob>(quit_flag);
-    RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(quit)));
+    RETURN_IF_NOT_OK(local_queues_[wkr_id]->Add(std::move(quit)));
   }
 
   return Status::OK();
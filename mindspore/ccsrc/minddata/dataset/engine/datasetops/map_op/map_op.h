@@ -29,6 +29,7 @@
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_queue.h"
 #include "minddata/dataset/util/wait_post.h"
 
 namespace mindspore {
@@ -114,6 +115,14 @@ class MapOp : public ParallelOp {
 
   const auto &TFuncs() const { return tfuncs_; }
 
+  // Setter
+  // @param run_on_batch true if the rows from the child are batches and the TensorOps run on them with BatchCompute()
+  void SetRunOnBatch(bool run_on_batch) { run_on_batch_ = run_on_batch; }
+
+  // Getter
+  // @return true if the TensorOps run on batches of rows
+  bool RunOnBatch() const { return run_on_batch_; }
+
  private:
   // A unit of job for map worker thread.
   // MapWorkerJob holds a list of MapJob where each MapJob can be a CpuMapJob, GpuMapJob or DvppMapJob.
@@ -130,11 +139,14 @@ class MapOp : public ParallelOp {
   Status FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list);
 
   // Local queues where worker threads get a job from
-  QueueList<std::unique_ptr<MapWorkerJob>> local_queues_;
+  QueueList<std::unique_ptr<MapWorkerJob>, SpscQueue<std::unique_ptr<MapWorkerJob>>> local_queues_;
 
   //  Tensorops to be read and applied by worker threads
   std::vector<std::shared_ptr<TensorOp>> tfuncs_;
 
+  // Whether the Tensorops are applied to batches of rows, see BatchMapFusionPass
+  bool run_on_batch_;
+
   // Variable to store the column name that the tensorOps are consuming
   std::vector<std::string> in_columns_;
 
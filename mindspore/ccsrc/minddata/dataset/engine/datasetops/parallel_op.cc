@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/db_connector.h"
@@ -32,7 +34,12 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size, std::shar
       worker_connector_size_(1),
       worker_connector_(nullptr),
       num_workers_paused_(0),
-      epoch_sync_flag_(false) {
+      epoch_sync_flag_(false),
+      workers_tunable_(false),
+      target_workers_(num_workers),
+      active_workers_(num_workers),
+      next_worker_(0),
+      scheduled_rows_(0) {
   // reduce excessive memory usage with high parallelism
   // when num_workers > 4, reduce op_connector_size to have similar total size if there were only 4 workers
   constexpr int32_t worker_limit = 4;
@@ -56,10 +63,48 @@ Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
   return Status::OK();
 }
 
+void ParallelOp::ReserveTunableWorkers() {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  if (!cfg->enable_autotune()) {
+    return;
+  }
+  workers_tunable_ = true;
+  num_workers_ = std::max(num_workers_, std::min(cfg->num_cpu_threads(), num_workers_ * kAutoTuneWorkerHeadroom));
+  num_producers_ = num_workers_;
+}
+
+Status ParallelOp::SetNumActiveWorkers(int32_t num_workers) {
+  CHECK_FAIL_RETURN_UNEXPECTED(workers_tunable_, "The number of active workers of " + NameWithID() +
+                                                   " can not be changed while it is running.");
+  CHECK_FAIL_RETURN_UNEXPECTED(num_workers > 0 && num_workers <= num_workers_,
+                               "Invalid number of active workers: " + std::to_string(num_workers) +
+                                 ", it should be between 1 and " + std::to_string(num_workers_) + ".");
+  target_workers_ = num_workers;
+  return Status::OK();
+}
+
+int32_t ParallelOp::NextWorkerId() {
+  // The number of active workers only changes when the roundrobin wraps around to worker 0, where the consumer
+  // of the output connector is at worker 0 in both the previous and the new order.
+  int32_t target_workers = target_workers_;
+  if (next_worker_ == 0 && target_workers != active_workers_) {
+    active_workers_ = target_workers;
+    out_connector_->SetActiveProducers(active_workers_, scheduled_rows_);
+  }
+  int32_t worker_id = next_worker_;
+  next_worker_ = (next_worker_ + 1) % active_workers_;
+  scheduled_rows_++;
+  return worker_id;
+}
+
 // A print method typically used for debugging
 void ParallelOp::Print(std::ostream &out, bool show_all) const {
   DatasetOp::Print(out, show_all);
-  out << " [workers: " << num_workers_ << "]";
+  out << " [workers: " << num_workers_;
+  if (workers_tunable_) {
+    out << ", active: " << target_workers_;
+  }
+  out << "]";
 }
 
 // Override base class reset to provide reset actions specific to the ParallelOp class.
@@ -75,6 +120,16 @@ Status ParallelOp::Reset() {
   return Status::OK();
 }
 
+Status ParallelOp::PrepareOperator() {
+  RETURN_IF_NOT_OK(DatasetOp::PrepareOperator());
+  // The spare workers of AutoTune are producers of the output connector, but only the configured ones get rows
+  // until NextWorkerId() activates more.
+  if (workers_tunable_ && out_connector_) {
+    out_connector_->SetLaunchProducers(active_workers_);
+  }
+  return Status::OK();
+}
+
 // Register the internal worker connectors
 Status ParallelOp::RegisterWorkerConnectors() {
   if (worker_connector_) {
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +29,8 @@ namespace mindspore {
 namespace dataset {
 // global const in our namespace
 constexpr int32_t kEndOfActions = -1;
+// With AutoTune, an op launches up to this many times its configured workers so that more can be activated later
+constexpr int32_t kAutoTuneWorkerHeadroom = 4;
 
 // Forward declares
 class DbConnector;
@@ -90,6 +93,24 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  // Creates the output connector, in which only the workers active at launch take part in the roundrobin.
+  // @return Status The status code returned
+  Status PrepareOperator() override;
+
+  // Getter
+  // @return whether the number of active workers can be changed while the op is running
+  bool IsWorkersTunable() const { return workers_tunable_; }
+
+  // Getter
+  // @return the number of workers the rows are distributed to, at most num_workers()
+  int32_t NumActiveWorkers() const { return target_workers_; }
+
+  // Change the number of workers the rows are distributed to. The change takes effect from the next row
+  // the master distributes, the other launched workers stay idle on their queues.
+  // @param num_workers - The number of active workers, between 1 and num_workers()
+  // @return Status The status code returned
+  Status SetNumActiveWorkers(int32_t num_workers);
+
  protected:
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
@@ -103,6 +124,17 @@ class ParallelOp : public DatasetOp {
   // \return Status
   Status WaitForWorkers() override;
 
+  // Launch extra workers which can be activated while the op is running, if AutoTune is enabled. Derived
+  // classes which distribute their rows with NextWorkerId() call this from their constructor, before anything
+  // is sized by num_workers_. The configured number of workers stays active at the beginning.
+  void ReserveTunableWorkers();
+
+  // Get the worker the next row (including eoe and eof) goes to, in the roundrobin order of the active workers.
+  // Every row distributed this way must produce exactly one row in the output connector.
+  // Only intended to be called by the master thread.
+  // @return the id of the worker
+  int32_t NextWorkerId();
+
   // Wait post used to perform the pausing logic
   WaitPost wait_for_workers_post_;
 
@@ -117,6 +149,13 @@ class ParallelOp : public DatasetOp {
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;        // The internal connector for worker threads
   QueueList<std::unique_ptr<IOBlock>> io_block_queues_;  // queues of IOBlocks
+
+ private:
+  bool workers_tunable_;                 // If the active workers can be changed by SetNumActiveWorkers()
+  std::atomic<int32_t> target_workers_;  // The number of active workers requested
+  int32_t active_workers_;               // The number of active workers used by the master
+  int32_t next_worker_;                  // The worker the next row goes to
+  int64_t scheduled_rows_;               // The number of rows distributed by the master
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -15,7 +15,15 @@
  */
 #include "minddata/dataset/engine/datasetops/source/csv_op.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(ENABLE_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <stdexcept>
@@ -25,6 +33,7 @@
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/util/random.h"
+#include "./securec.h"
 
 namespace mindspore {
 namespace dataset {
@@ -34,8 +43,8 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
              const std::vector<std::string> &column_name, int32_t num_workers, int64_t num_samples,
              int32_t worker_connector_size, int32_t op_connector_size, bool shuffle_files, int32_t num_devices,
              int32_t device_id)
-    : NonMappableLeafOp(std::min(num_workers, static_cast<int32_t>(csv_files_list.size())), worker_connector_size,
-                        num_samples, op_connector_size, shuffle_files, num_devices, device_id),
+    : NonMappableLeafOp(num_workers, worker_connector_size, num_samples, op_connector_size, shuffle_files,
+                        num_devices, device_id),
       csv_files_list_(std::move(csv_files_list)),
       field_delim_(field_delim),
       column_default_list_(column_default),
@@ -74,71 +83,246 @@ void CsvOp::CsvParser::Reset() {
   cur_col_ = 0;
 }
 
-CsvOp::CsvParser::Message CsvOp::CsvParser::GetMessage(int c) {
+CsvOp::CsvParser::Message CsvOp::CsvParser::GetMessage(char c) const {
   if (c == csv_field_delim_) {
     return Message::MS_DELIM;
   } else if (c == '"') {
     return Message::MS_QUOTE;
   } else if (c == '\r' || c == '\n') {
     return Message::MS_END_OF_LINE;
-  } else if (c == std::char_traits<char>::eof()) {
-    return Message::MS_END_OF_FILE;
   } else {
     return Message::MS_NORMAL;
   }
 }
 
-int CsvOp::CsvParser::ProcessMessage(int c) {
+const char *CsvOp::CsvParser::FindSpecialChar(const char *p, const char *end) const {
+#if defined(__SSE2__)
+  const __m128i delim = _mm_set1_epi8(csv_field_delim_);
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  while (end - p >= static_cast<ptrdiff_t>(sizeof(__m128i))) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, delim), _mm_cmpeq_epi8(chars, quote)),
+                                _mm_or_si128(_mm_cmpeq_epi8(chars, cr), _mm_cmpeq_epi8(chars, lf)));
+    int mask = _mm_movemask_epi8(hits);
+    if (mask != 0) {
+      return p + __builtin_ctz(static_cast<unsigned int>(mask));
+    }
+    p += sizeof(__m128i);
+  }
+#elif defined(ENABLE_NEON) && defined(__aarch64__)
+  const uint8x16_t delim = vdupq_n_u8(static_cast<uint8_t>(csv_field_delim_));
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t cr = vdupq_n_u8('\r');
+  const uint8x16_t lf = vdupq_n_u8('\n');
+  while (end - p >= static_cast<ptrdiff_t>(sizeof(uint8x16_t))) {
+    uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(chars, delim), vceqq_u8(chars, quote)),
+                               vorrq_u8(vceqq_u8(chars, cr), vceqq_u8(chars, lf)));
+    if (vmaxvq_u8(hits) != 0) {
+      break;
+    }
+    p += sizeof(uint8x16_t);
+  }
+#endif
+  while (p < end && GetMessage(*p) == Message::MS_NORMAL) {
+    p++;
+  }
+  return p;
+}
+
+int CsvOp::CsvParser::ProcessBuffer(const char *buf, size_t len) {
+  const char *p = buf;
+  const char *end = buf + len;
+  while (p < end && !Finished()) {
+    // The plain chars of a field do not change the state, copy them in one go
+    if (cur_state_ == State::UNQUOTE || cur_state_ == State::QUOTE) {
+      const char *field_end = nullptr;
+      if (cur_state_ == State::UNQUOTE) {
+        field_end = FindSpecialChar(p, end);
+      } else {
+        field_end = static_cast<const char *>(memchr(p, '"', end - p));
+        field_end = field_end == nullptr ? end : field_end;
+      }
+      int ret = PutChars(p, field_end - p);
+      if (ret != 0) {
+        return ret;
+      }
+      p = field_end;
+      if (p == end) {
+        break;
+      }
+    }
+    int ret = ProcessChar(*p++);
+    if (ret != 0) {
+      return ret;
+    }
+  }
+  return 0;
+}
+
+int CsvOp::CsvParser::ProcessChar(char c) {
   Message m = GetMessage(c);
-  StateDiagram::iterator it = sd.find({cur_state_, m});
-  if (it == sd.end()) {
-    return -1;
+  switch (cur_state_) {
+    case State::START_OF_FILE:
+    case State::END_OF_LINE:
+      if (m == Message::MS_END_OF_LINE) {
+        return 0;
+      }
+      StartRow();
+      if (m == Message::MS_QUOTE) {
+        cur_state_ = State::QUOTE;
+        return 0;
+      } else if (m == Message::MS_DELIM) {
+        cur_state_ = State::DELIM;
+        return PutRecord();
+      }
+      cur_state_ = State::UNQUOTE;
+      return PutChars(&c, 1);
+    case State::UNQUOTE:
+    case State::DELIM:
+      if (m == Message::MS_DELIM) {
+        cur_state_ = State::DELIM;
+        return PutRecord();
+      } else if (m == Message::MS_END_OF_LINE) {
+        cur_state_ = State::END_OF_LINE;
+        return PutRow();
+      } else if (m == Message::MS_QUOTE) {
+        if (cur_state_ == State::DELIM) {
+          cur_state_ = State::QUOTE;
+          return 0;
+        }
+        cur_state_ = State::EXCEPTION;
+        err_message_ = "Invalid quote in unquote field.";
+        return -1;
+      }
+      cur_state_ = State::UNQUOTE;
+      return PutChars(&c, 1);
+    case State::QUOTE:
+      if (m == Message::MS_QUOTE) {
+        cur_state_ = State::SECOND_QUOTE;
+        return 0;
+      }
+      return PutChars(&c, 1);
+    case State::SECOND_QUOTE:
+      if (m == Message::MS_QUOTE) {
+        cur_state_ = State::QUOTE;
+        return PutChars(&c, 1);
+      } else if (m == Message::MS_DELIM) {
+        cur_state_ = State::DELIM;
+        return PutRecord();
+      } else if (m == Message::MS_END_OF_LINE) {
+        cur_state_ = State::END_OF_LINE;
+        return PutRow();
+      }
+      cur_state_ = State::EXCEPTION;
+      err_message_ = "Receive unquote char in quote field.";
+      return -1;
+    default:
+      return -1;
+  }
+}
+
+int CsvOp::CsvParser::ProcessEndOfFile() {
+  switch (cur_state_) {
+    case State::UNQUOTE:
+    case State::DELIM:
+    case State::SECOND_QUOTE:
+      cur_state_ = State::END_OF_FILE;
+      return EndFile();
+    case State::QUOTE:
+      cur_state_ = State::EXCEPTION;
+      err_message_ = "Reach the end of file in quote field.";
+      return -1;
+    case State::EXCEPTION:
+      return -1;
+    default:
+      cur_state_ = State::END_OF_FILE;
+      return 0;
+  }
+}
+
+void CsvOp::CsvParser::StartRow() {
+  pos_ = 0;
+  if (RowInRange()) {
+    TensorRow row(column_default_.size(), nullptr);
+    std::vector<std::string> file_path(column_default_.size(), file_path_);
+    row.setPath(file_path);
+    cur_row_ = std::move(row);
   }
-  int ret = it->second.second(*this, c);
-  cur_state_ = it->second.first;
-  return ret;
 }
 
-int CsvOp::CsvParser::PutChar(int c) {
-  if (pos_ >= str_buf_.size()) {
-    str_buf_.resize(str_buf_.size() * 2);
+int CsvOp::CsvParser::PutChars(const char *p, size_t n) {
+  // The fields of the rows out of range are not needed, only their line ends are
+  if (n == 0 || !RowInRange()) {
+    return 0;
+  }
+  // Leave room for the terminating null the numeric conversion needs
+  if (pos_ + n >= str_buf_.size()) {
+    str_buf_.resize(std::max(str_buf_.size() * 2, pos_ + n + 1));
   }
-  str_buf_[pos_] = c;
-  pos_++;
+  int ret = memcpy_s(str_buf_.data() + pos_, str_buf_.size() - pos_, p, n);
+  if (ret != 0) {
+    err_message_ = "memcpy_s failed when copying the field.";
+    return -1;
+  }
+  pos_ += n;
   return 0;
 }
 
-int CsvOp::CsvParser::PutRecord(int c) {
-  std::string s = std::string(str_buf_.begin(), str_buf_.begin() + pos_);
-  std::shared_ptr<Tensor> t;
+int CsvOp::CsvParser::PutRecord() {
   if (cur_col_ >= column_default_.size()) {
     err_message_ = "Number of file columns does not match the default records";
     return -1;
   }
+  if (!RowInRange()) {
+    pos_ = 0;
+    cur_col_++;
+    return 0;
+  }
+  str_buf_[pos_] = '\0';
+  const char *field = str_buf_.data();
+  char *field_end = nullptr;
+  std::shared_ptr<Tensor> t;
   Status rc;
+  errno = 0;
   switch (column_default_[cur_col_]->type) {
-    case CsvOp::INT:
-      rc = Tensor::CreateScalar(std::stoi(s), &t);
-      if (rc.IsError()) {
-        err_message_ = rc.ToString();
-        return -1;
+    case CsvOp::INT: {
+      int64_t value = std::strtoll(field, &field_end, 10);
+      if (field_end == field) {
+        err_message_ = "type does not match.";
+        return -3;
+      }
+      if (errno == ERANGE || value > std::numeric_limits<int32_t>::max() ||
+          value < std::numeric_limits<int32_t>::min()) {
+        err_message_ = "value out of range.";
+        return -3;
       }
+      rc = Tensor::CreateScalar(static_cast<int32_t>(value), &t);
       break;
-    case CsvOp::FLOAT:
-      rc = Tensor::CreateScalar(std::stof(s), &t);
-      if (rc.IsError()) {
-        err_message_ = rc.ToString();
-        return -1;
+    }
+    case CsvOp::FLOAT: {
+      float value = std::strtof(field, &field_end);
+      if (field_end == field) {
+        err_message_ = "type does not match.";
+        return -3;
+      }
+      if (errno == ERANGE) {
+        err_message_ = "value out of range.";
+        return -3;
       }
+      rc = Tensor::CreateScalar(value, &t);
       break;
+    }
     default:
-      rc = Tensor::CreateScalar(s, &t);
-      if (rc.IsError()) {
-        err_message_ = rc.ToString();
-        return -1;
-      }
+      rc = Tensor::CreateScalar(std::string(field, pos_), &t);
       break;
   }
+  if (rc.IsError()) {
+    err_message_ = rc.ToString();
+    return -1;
+  }
   if (cur_col_ >= cur_row_.size()) {
     err_message_ = "Number of file columns does not match the tensor table";
     return -1;
@@ -149,19 +333,15 @@ int CsvOp::CsvParser::PutRecord(int c) {
   return 0;
 }
 
-int CsvOp::CsvParser::PutRow(int c) {
-  if (total_rows_ < start_offset_) {
+int CsvOp::CsvParser::PutRow() {
+  if (!RowInRange()) {
     total_rows_++;
     cur_col_ = 0;
+    pos_ = 0;
     return 0;
   }
 
-  if (total_rows_ >= end_offset_) {
-    cur_col_ = 0;
-    return 0;
-  }
-
-  int ret = PutRecord(c);
+  int ret = PutRecord();
   if (ret < 0) {
     return ret;
   }
@@ -184,264 +364,62 @@ int CsvOp::CsvParser::PutRow(int c) {
   return 0;
 }
 
-int CsvOp::CsvParser::AddRow(int c) {
-  total_rows_++;
-  return 0;
+int CsvOp::CsvParser::EndFile() {
+  // The last row of the file may have no line end
+  return PutRow();
 }
 
-int CsvOp::CsvParser::EndFile(int c) {
-  if (cur_col_ > 0) {
-    int ret = PutRow(c);
-    if (ret < 0) {
-      return ret;
+void CsvOp::CsvParser::CountRows(const char *buf, size_t len, int64_t file_offset,
+                                 std::vector<int64_t> *row_offsets) {
+  const char *p = buf;
+  const char *end = buf + len;
+  while (p < end) {
+    if (cur_state_ == State::UNQUOTE) {
+      p = FindSpecialChar(p, end);
+    } else if (cur_state_ == State::QUOTE) {
+      p = static_cast<const char *>(memchr(p, '"', end - p));
+      p = p == nullptr ? end : p;
+    }
+    if (p == end) {
+      break;
+    }
+    char c = *p++;
+    bool end_of_line = c == '\r' || c == '\n';
+    switch (cur_state_) {
+      case State::QUOTE:
+        // line ends in a quoted field are part of the field
+        cur_state_ = c == '"' ? State::SECOND_QUOTE : State::QUOTE;
+        break;
+      case State::UNQUOTE:
+      case State::SECOND_QUOTE:
+        if (end_of_line) {
+          cur_state_ = State::END_OF_LINE;
+          total_rows_++;
+          if (row_offsets != nullptr && total_rows_ % CSV_ROWS_PER_BLOCK == 0) {
+            row_offsets->push_back(file_offset + (p - buf));
+          }
+        } else {
+          cur_state_ = c == '"' ? State::QUOTE : State::UNQUOTE;
+        }
+        break;
+      default:
+        if (!end_of_line) {
+          cur_state_ = c == '"' ? State::QUOTE : State::UNQUOTE;
+        }
+        break;
     }
   }
-  return 0;
-}
-
-int CsvOp::CsvParser::CatchException(int c) {
-  if (GetMessage(c) == Message::MS_QUOTE && cur_state_ == State::UNQUOTE) {
-    err_message_ = "Invalid quote in unquote field.";
-  } else if (GetMessage(c) == Message::MS_END_OF_FILE && cur_state_ == State::QUOTE) {
-    err_message_ = "Reach the end of file in quote field.";
-  } else if (GetMessage(c) == Message::MS_NORMAL && cur_state_ == State::SECOND_QUOTE) {
-    err_message_ = "Receive unquote char in quote field.";
-  }
-  return -1;
 }
 
-int CsvOp::CsvParser::CountRows(int c) {
-  Message m;
-  if (c == '"') {
-    m = Message::MS_QUOTE;
-  } else if (c == '\r' || c == '\n' || c == std::char_traits<char>::eof()) {
-    m = Message::MS_END_OF_LINE;
-  } else {
-    m = Message::MS_NORMAL;
-  }
-  StateDiagram::iterator it = sdl.find({cur_state_, m});
-  if (it == sdl.end()) {
-    return -1;
+void CsvOp::CsvParser::CountEndOfFile() {
+  if (cur_state_ == State::UNQUOTE || cur_state_ == State::SECOND_QUOTE) {
+    total_rows_++;
   }
-  cur_state_ = it->second.first;
-  return it->second.second(*this, c);
+  cur_state_ = State::END_OF_FILE;
 }
 
 Status CsvOp::CsvParser::InitCsvParser() {
   str_buf_.resize(CSV_BUFFER_SIZE);
-
-  // State diagram for counting rows
-  sdl = {// START_OF_FILE
-         // |---------------------------------------|
-         // |    abc    |    "      |      \n       |
-         // |---------------------------------------|
-         // | UNQUOTE   |   QUOTE   | START_OF_FILE |
-         // |---------------------------------------|
-         // |  NullFunc |  NullFunc |    NullFunc   |
-         // |---------------------------------------|
-         {{State::START_OF_FILE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::START_OF_FILE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::START_OF_FILE, Message::MS_END_OF_LINE}, {State::START_OF_FILE, &CsvParser::NullFunc}},
-
-         // UNQUOTE
-         // |-------------------------------------|
-         // |    abc    |    "      |    \n       |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // |  NullFunc | NullFunc  |  AddRow     |
-         // |-------------------------------------|
-         {{State::UNQUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::UNQUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::UNQUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::AddRow}},
-
-         // QUOTE
-         // |--------------------------------------|
-         // |    abc    |      "       |    \n     |
-         // |--------------------------------------|
-         // | QUOTE     | SECOND_QUOTE |   QUOTE   |
-         // |--------------------------------------|
-         // |  NullFunc |  NullFunc    | NullFunc  |
-         // |--------------------------------------|
-         {{State::QUOTE, Message::MS_NORMAL}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::QUOTE, Message::MS_QUOTE}, {State::SECOND_QUOTE, &CsvParser::NullFunc}},
-         {{State::QUOTE, Message::MS_END_OF_LINE}, {State::QUOTE, &CsvParser::NullFunc}},
-
-         // SECOND_QUOTE
-         // |-------------------------------------|
-         // |    abc    |     "     |     \n      |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // |  NullFunc | NullFunc  | AddRow      |
-         // |-------------------------------------|
-         {{State::SECOND_QUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::SECOND_QUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::SECOND_QUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::AddRow}},
-
-         // END_OF_LINE
-         // |-------------------------------------|
-         // |    abc    |     "     |     \n      |
-         // |-------------------------------------|
-         // | UNQUOTE   | QUOTE     | END_OF_LINE |
-         // |-------------------------------------|
-         // | NullFunc  |  NullFunc | NullFunc    |
-         // |-------------------------------------|
-         {{State::END_OF_LINE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::NullFunc}},
-         {{State::END_OF_LINE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::NullFunc}},
-         {{State::END_OF_LINE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::NullFunc}}};
-
-  // State diagram for CSV parser
-  sd = {// START_OF_FILE
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,     |    "     |      \n        |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM    | QUOTE    | START_OF_FILE  | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | lambda    | lambda   | lambda   | NullFunc       |  NullFunc      |
-        // |-------------------------------------------------------------------|
-        {{State::START_OF_FILE, Message::MS_NORMAL},
-         {State::UNQUOTE,
-          [this](CsvParser &, char c) -> int {
-            TensorRow row(column_default_.size(), nullptr);
-            std::vector<std::string> file_path(column_default_.size(), file_path_);
-            row.setPath(file_path);
-            this->cur_row_ = std::move(row);
-            this->str_buf_[0] = c;
-            this->pos_ = 1;
-            return 0;
-          }}},
-        {{State::START_OF_FILE, Message::MS_DELIM},
-         {State::DELIM,
-          [this](CsvParser &, char c) -> int {
-            TensorRow row(column_default_.size(), nullptr);
-            std::vector<std::string> file_path(column_default_.size(), file_path_);
-            row.setPath(file_path);
-            this->cur_row_ = std::move(row);
-            return this->PutRecord(c);
-          }}},
-        {{State::START_OF_FILE, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            TensorRow row(column_default_.size(), nullptr);
-            std::vector<std::string> file_path(column_default_.size(), file_path_);
-            row.setPath(file_path);
-            this->cur_row_ = std::move(row);
-            this->pos_ = 0;
-            return 0;
-          }}},
-        {{State::START_OF_FILE, Message::MS_END_OF_LINE}, {State::START_OF_FILE, &CsvParser::NullFunc}},
-        {{State::START_OF_FILE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::NullFunc}},
-
-        // UNQUOTE
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,       |     "     |      \n     |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM      | EXCEPTION | END_OF_LINE | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | PutChar   | PutRecord  | exception | PutRow      | EndFile        |
-        // |-------------------------------------------------------------------|
-        {{State::UNQUOTE, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::PutChar}},
-        {{State::UNQUOTE, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::UNQUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::UNQUOTE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-        // UNQUOTE-Exception
-        {{State::UNQUOTE, Message::MS_QUOTE}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // DELIM
-        // |-------------------------------------------------------------------|
-        // |    abc    |    ,       |     "     |      \n     |       EOF      |
-        // |-------------------------------------------------------------------|
-        // | UNQUOTE   | DELIM      | QUOTE     | END_OF_LINE | END_OF_FILE    |
-        // |-------------------------------------------------------------------|
-        // | PutChar   | PutRecord  | lambda    | PutRow      | EndFile        |
-        // |-------------------------------------------------------------------|
-        {{State::DELIM, Message::MS_NORMAL}, {State::UNQUOTE, &CsvParser::PutChar}},
-        {{State::DELIM, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::DELIM, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            this->pos_ = 0;
-            return 0;
-          }}},
-        {{State::DELIM, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::DELIM, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-
-        // QUOTE
-        // |-----------------------------------------------------------------|
-        // |    abc    |    ,     |     "        |    \n    |       EOF      |
-        // |-----------------------------------------------------------------|
-        // | QUOTE     | QUOTE    | SECOND_QUOTE | QUOTE    | EXCEPTION      |
-        // |-----------------------------------------------------------------|
-        // | PutChar   | PutChar  |  NullFunc    | PutChar  | exception      |
-        // |-----------------------------------------------------------------|
-        {{State::QUOTE, Message::MS_NORMAL}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::QUOTE, Message::MS_DELIM}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::QUOTE, Message::MS_QUOTE}, {State::SECOND_QUOTE, &CsvParser::NullFunc}},
-        {{State::QUOTE, Message::MS_END_OF_LINE}, {State::QUOTE, &CsvParser::PutChar}},
-        // QUOTE-Exception
-        {{State::QUOTE, Message::MS_END_OF_FILE}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // SECOND_QUOTE
-        // |------------------------------------------------------------------|
-        // |    abc    |     ,      |    "     |    \n       |       EOF      |
-        // |------------------------------------------------------------------|
-        // | EXCEPTION | DELIM      | QUOTE    | END_OF_LINE | END_OF_FILE    |
-        // |------------------------------------------------------------------|
-        // | exception | PutRecord | PutChar   | PutRow      | EndFile        |
-        // |------------------------------------------------------------------|
-        {{State::SECOND_QUOTE, Message::MS_QUOTE}, {State::QUOTE, &CsvParser::PutChar}},
-        {{State::SECOND_QUOTE, Message::MS_DELIM}, {State::DELIM, &CsvParser::PutRecord}},
-        {{State::SECOND_QUOTE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::PutRow}},
-        {{State::SECOND_QUOTE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}},
-        // SECOND_QUOTE-Exception
-        {{State::SECOND_QUOTE, Message::MS_NORMAL}, {State::EXCEPTION, &CsvParser::CatchException}},
-
-        // END_OF_LINE
-        // |-------------------------------------------------------|
-        // |   abc   |   ,    |   "    |      \n     |     EOF     |
-        // |-------------------------------------------------------|
-        // | UNQUOTE | DELIM  | QUOTE  | END_OF_LINE | END_OF_FILE |
-        // |-------------------------------------------------------|
-        // | lambda  | lambda | lambda |  NullFunc   | EndFile     |
-        // |-------------------------------------------------------|
-        {{State::END_OF_LINE, Message::MS_NORMAL},
-         {State::UNQUOTE,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              TensorRow row(column_default_.size(), nullptr);
-              std::vector<std::string> file_path(column_default_.size(), file_path_);
-              row.setPath(file_path);
-              this->cur_row_ = std::move(row);
-            }
-            this->str_buf_[0] = c;
-            this->pos_ = 1;
-            return 0;
-          }}},
-        {{State::END_OF_LINE, Message::MS_DELIM},
-         {State::DELIM,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              TensorRow row(column_default_.size(), nullptr);
-              std::vector<std::string> file_path(column_default_.size(), file_path_);
-              row.setPath(file_path);
-              this->cur_row_ = std::move(row);
-            }
-            return this->PutRecord(c);
-          }}},
-        {{State::END_OF_LINE, Message::MS_QUOTE},
-         {State::QUOTE,
-          [this](CsvParser &, char c) -> int {
-            if (this->total_rows_ > this->start_offset_ && this->total_rows_ <= this->end_offset_) {
-              TensorRow row(column_default_.size(), nullptr);
-              std::vector<std::string> file_path(column_default_.size(), file_path_);
-              row.setPath(file_path);
-              this->cur_row_ = std::move(row);
-            }
-            return 0;
-          }}},
-        {{State::END_OF_LINE, Message::MS_END_OF_LINE}, {State::END_OF_LINE, &CsvParser::NullFunc}},
-        {{State::END_OF_LINE, Message::MS_END_OF_FILE}, {State::END_OF_FILE, &CsvParser::EndFile}}};
   return Status::OK();
 }
 
@@ -458,35 +436,45 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
   }
 
   std::ifstream ifs;
-  ifs.open(realpath.value(), std::ifstream::in);
+  ifs.open(realpath.value(), std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + file);
   }
-  if (column_name_list_.empty()) {
+  // Start from the nearest row before the block whose offset in the file is known
+  auto row_offsets = filename_row_offsets_.find(file);
+  if (row_offsets != filename_row_offsets_.end() && !row_offsets->second.empty()) {
+    size_t block = std::min(static_cast<size_t>(start_offset / CSV_ROWS_PER_BLOCK), row_offsets->second.size() - 1);
+    (void)ifs.seekg(row_offsets->second[block], std::ios::beg);
+    csv_parser.SetRowsBefore(static_cast<int64_t>(block) * CSV_ROWS_PER_BLOCK);
+  } else if (column_name_list_.empty()) {
     std::string tmp;
     getline(ifs, tmp);
   }
   csv_parser.Reset();
-  try {
-    while (ifs.good()) {
-      // when ifstream reaches the end of file, the function get() return std::char_traits<char>::eof()
-      // which is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS. So instead of char, we use
-      // int to receive its return value.
-      int chr = ifs.get();
-      int err = csv_parser.ProcessMessage(chr);
-      if (err != 0) {
-        if (err == -2) return Status(kMDInterrupted);
-        RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file + ": line " +
-                                 std::to_string(csv_parser.GetTotalRows() + 1) +
-                                 ". Error message: " + csv_parser.GetErrorMessage());
-      }
-    }
-  } catch (std::invalid_argument &ia) {
-    std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
-    RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ": line " + err_row + ", type does not match.");
-  } catch (std::out_of_range &oor) {
+
+  auto parse_error = [&file, &csv_parser](int err) -> Status {
+    if (err == -2) return Status(kMDInterrupted);
     std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
-    RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ": line " + err_row + ", value out of range.");
+    if (err == -3) {
+      RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ": line " + err_row + ", " + csv_parser.GetErrorMessage());
+    }
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file + ": line " + err_row +
+                             ". Error message: " + csv_parser.GetErrorMessage());
+  };
+
+  std::vector<char> buffer(CSV_READ_CHUNK_SIZE);
+  while (ifs.good() && !csv_parser.Finished()) {
+    (void)ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    int err = csv_parser.ProcessBuffer(buffer.data(), static_cast<size_t>(ifs.gcount()));
+    if (err != 0) {
+      return parse_error(err);
+    }
+  }
+  if (!csv_parser.Finished()) {
+    int err = csv_parser.ProcessEndOfFile();
+    if (err != 0) {
+      return parse_error(err);
+    }
   }
   return Status::OK();
 }
@@ -512,7 +500,7 @@ void CsvOp::Print(std::ostream &out, bool show_all) const {
 }
 
 Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
-  int32_t queue_index = 0;
+  std::vector<RowRange> ranges;
   int64_t pre_count = 0;
   int64_t start_offset = 0;
   int64_t end_offset = 0;
@@ -540,10 +528,7 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        ranges.push_back({file_info.second, start_offset, end_offset});
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -556,14 +541,16 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
   }
 
-  RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
+  RETURN_IF_NOT_OK(PushEpochBlocks(ranges, CSV_ROWS_PER_BLOCK));
   return Status::OK();
 }
 
 Status CsvOp::CalculateNumRowsPerShard() {
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    int64_t count = CountTotalRows(it.value());
+    std::vector<int64_t> row_offsets;
+    int64_t count = CountTotalRows(it.value(), &row_offsets);
     filename_numrows_[it.value()] = count;
+    filename_row_offsets_[it.value()] = std::move(row_offsets);
     num_rows_ += count;
   }
   if (num_rows_ == 0) {
@@ -581,7 +568,7 @@ Status CsvOp::CalculateNumRowsPerShard() {
   return Status::OK();
 }
 
-int64_t CsvOp::CountTotalRows(const std::string &file) {
+int64_t CsvOp::CountTotalRows(const std::string &file, std::vector<int64_t> *row_offsets) {
   CsvParser csv_parser(0, jagged_rows_connector_.get(), field_delim_, column_default_list_, file);
   Status rc = csv_parser.InitCsvParser();
   if (rc.IsError()) {
@@ -596,7 +583,7 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
   }
 
   std::ifstream ifs;
-  ifs.open(realpath.value(), std::ifstream::in);
+  ifs.open(realpath.value(), std::ifstream::in | std::ifstream::binary);
   if (!ifs.is_open()) {
     return 0;
   }
@@ -604,13 +591,18 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
     std::string tmp;
     getline(ifs, tmp);
   }
+  int64_t file_offset = ifs.good() ? static_cast<int64_t>(ifs.tellg()) : 0;
+  if (row_offsets != nullptr && ifs.good()) {
+    row_offsets->push_back(file_offset);
+  }
   csv_parser.Reset();
+  std::vector<char> buffer(CSV_READ_CHUNK_SIZE);
   while (ifs.good()) {
-    int chr = ifs.get();
-    if (csv_parser.CountRows(chr) != 0) {
-      break;
-    }
+    (void)ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    csv_parser.CountRows(buffer.data(), static_cast<size_t>(ifs.gcount()), file_offset, row_offsets);
+    file_offset += ifs.gcount();
   }
+  csv_parser.CountEndOfFile();
 
   return csv_parser.GetTotalRows();
 }
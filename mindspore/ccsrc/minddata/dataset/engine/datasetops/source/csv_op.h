@@ -33,6 +33,10 @@ namespace mindspore {
 namespace dataset {
 
 const size_t CSV_BUFFER_SIZE = 4096;
+// Size of the chunks a CSV file is read in
+const size_t CSV_READ_CHUNK_SIZE = 1024 * 1024;
+// Maximum number of rows of an IO block, the rows of a larger file are read by several workers
+const int64_t CSV_ROWS_PER_BLOCK = 4096;
 using StringIndex = AutoIndexObj<std::string>;
 class JaggedConnector;
 
@@ -58,9 +62,9 @@ class CsvOp : public NonMappableLeafOp {
   };
 
   /// CsvParser is a class that parsing CSV file.
-  /// We design a state machine to implement CSV syntactic analysis. It contains two state diagram,'sd' and 'sdl'.
-  /// The 'sd' is used for parsing CSV syntactic, it's complete and complicate.
-  /// The 'sdl' is used for counting the record rows, it's concise and it runs fast.
+  /// We design a state machine to implement CSV syntactic analysis. The file is fed to it in large chunks, the plain
+  /// chars of a field are found with a vectorised scan and copied in bulk, and only the delimiters, quotes and line
+  /// ends step the state machine. CountRows runs a concise version of it which only tracks quotes and line ends.
   struct CsvParser {
    public:
     CsvParser() = delete;
@@ -76,9 +80,29 @@ class CsvOp : public NonMappableLeafOp {
 
     void SetEndOffset(int64_t end_offset) { end_offset_ = end_offset; }
 
-    int ProcessMessage(int c);
+    /// Set the number of rows before the first byte fed to the parser, when it starts in the middle of a file
+    void SetRowsBefore(int64_t rows) { total_rows_ = rows; }
 
-    int CountRows(int c);
+    /// Parse the next chunk of the file
+    /// @return 0 on success, -1 if the file is malformed, -2 if interrupted, -3 if a field does not match its type
+    int ProcessBuffer(const char *buf, size_t len);
+
+    /// Parse the end of the file
+    /// @return the same as ProcessBuffer
+    int ProcessEndOfFile();
+
+    /// All the rows up to the end offset are parsed, the rest of the file need not be read
+    bool Finished() const { return total_rows_ >= end_offset_; }
+
+    /// Count the rows in the next chunk of the file
+    /// @param buf - the chunk.
+    /// @param len - the size of the chunk.
+    /// @param file_offset - the offset of the chunk in the file.
+    /// @param row_offsets - if not null, the file offset of every CSV_ROWS_PER_BLOCK-th row is appended to it.
+    void CountRows(const char *buf, size_t len, int64_t file_offset, std::vector<int64_t> *row_offsets);
+
+    /// Count the row ended by the end of the file
+    void CountEndOfFile();
 
     Status InitCsvParser();
 
@@ -106,25 +130,25 @@ class CsvOp : public NonMappableLeafOp {
       MS_END_OF_FILE,
     };
 
-    typedef std::pair<State, Message> StateMessagePair;
-    typedef std::pair<State, std::function<int(CsvParser &, int)>> StateActionPair;
-    typedef std::map<StateMessagePair, StateActionPair> StateDiagram;
+    Message GetMessage(char c) const;
 
-    Message GetMessage(int c);
+    /// Find the first delimiter, quote or line end in [p, end), end if there is none
+    const char *FindSpecialChar(const char *p, const char *end) const;
 
-    int NullFunc(int c) { return 0; }
+    /// Step the state machine with a char which is not a plain char of an unquoted or quoted field
+    int ProcessChar(char c);
 
-    int PutChar(int c);
+    bool RowInRange() const { return total_rows_ >= start_offset_ && total_rows_ < end_offset_; }
 
-    int PutRecord(int c);
+    void StartRow();
 
-    int PutRow(int c);
+    int PutChars(const char *p, size_t n);
 
-    int EndFile(int c);
+    int PutRecord();
 
-    int AddRow(int c);
+    int PutRow();
 
-    int CatchException(int c);
+    int EndFile();
 
     int32_t worker_id_;
     JaggedConnector *rows_connector_;
@@ -136,8 +160,6 @@ class CsvOp : public NonMappableLeafOp {
     int64_t total_rows_;
     int64_t start_offset_;
     int64_t end_offset_;
-    StateDiagram sd;
-    StateDiagram sdl;
     std::vector<char> str_buf_;
     TensorRow cur_row_;
     std::string err_message_;
@@ -189,8 +211,8 @@ class CsvOp : public NonMappableLeafOp {
 
   // Reads a csv file and loads the data into multiple tensors.
   // @param file - the file to read.
-  // @param start_offset - the start offset of file.
-  // @param end_offset - the end offset of file.
+  // @param start_offset - the index of the first row to read.
+  // @param end_offset - one greater than the index of the last row to read.
   // @param worker_id - the id of the worker that is executing this function.
   // @return Status - the error code returned.
   Status LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
@@ -206,8 +228,9 @@ class CsvOp : public NonMappableLeafOp {
 
   /// Count number of rows in each file.
   /// @param filename - csv file name.
+  /// @param row_offsets - if not null, the file offset of every CSV_ROWS_PER_BLOCK-th row, from row 0 on.
   /// @return int64_t - the total number of rows in file.
-  int64_t CountTotalRows(const std::string &file);
+  int64_t CountTotalRows(const std::string &file, std::vector<int64_t> *row_offsets = nullptr);
 
   // Private function for computing the assignment of the column name map.
   // @return - Status
@@ -232,6 +255,7 @@ class CsvOp : public NonMappableLeafOp {
   std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list_;
   std::vector<std::string> column_name_list_;
   bool check_flag_ = false;
+  std::map<std::string, std::vector<int64_t>> filename_row_offsets_;  // where to start reading each block of a file
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -199,11 +199,11 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
 
 Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, int64_t row_id, int32_t worker_id) {
   *fetched_row = {};
-  auto rc = shard_reader_->GetNextById(row_id, worker_id);
+  auto rc = shard_reader_->GetNextRowById(row_id, worker_id);
   auto task_type = rc.first;
-  auto tupled_buffer = rc.second;
+  const auto &tupled_buffer = rc.second;
   if (task_type == mindrecord::TaskType::kPaddedTask) {
-    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::ScalarRow(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
     fetched_row->setPath(file_path);
     fetched_row->setId(row_id);
@@ -211,9 +211,9 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, int64_t row_id, in
   if (tupled_buffer.empty()) return Status::OK();
   if (task_type == mindrecord::TaskType::kCommonTask) {
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
-      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type));
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+      const mindrecord::ScalarRow &scalar_row = std::get<1>(tupled_row);
+      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, scalar_row, task_type));
       std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
       fetched_row->setPath(file_path);
       fetched_row->setId(row_id);
@@ -224,7 +224,7 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, int64_t row_id, in
 }
 
 Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
-                                   const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
+                                   const mindrecord::ScalarRow &scalar_row, const mindrecord::TaskType task_type) {
   for (uint32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
 
@@ -265,8 +265,8 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
       }
     } else {
       auto has_column =
-        shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr, &n_bytes,
-                                           &column_data_type, &column_data_type_size, &column_shape);
+        shard_column->GetColumnValueFromRow(column_name, columns_blob, scalar_row, &data, &data_ptr, &n_bytes,
+                                            &column_data_type, &column_data_type_size, &column_shape);
       if (has_column == MSRStatus::FAILED) {
         RETURN_STATUS_UNEXPECTED("Invalid data, failed to retrieve data from mindrecord reader.");
       }
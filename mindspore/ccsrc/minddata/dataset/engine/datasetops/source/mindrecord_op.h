@@ -46,7 +46,8 @@ class Queue;
 
 using mindrecord::ShardOperator;
 using mindrecord::ShardReader;
-using ShardTuple = std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>;  /// Row of data from ShardReader
+/// Row of data from ShardReader
+using ShardTuple = std::vector<std::tuple<std::vector<uint8_t>, mindrecord::ScalarRow>>;
 
 const int32_t LOG_INTERVAL = 19;
 
@@ -123,9 +124,9 @@ class MindRecordOp : public MappableLeafOp {
   /// Parses a single cell and puts the data into a tensor
   /// @param tensor_row - the tensor row to put the parsed data in
   /// @param columns_blob - the blob data received from the reader
-  /// @param columns_json - the data for fields received from the reader
+  /// @param scalar_row - the data for fields received from the reader, packed by its ShardColumn
   Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
-                       const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
+                       const mindrecord::ScalarRow &scalar_row, const mindrecord::TaskType task_type);
 
   Status LoadTensorRow(row_id_type row_id, TensorRow *row) override {
     return Status(StatusCode::kMDSyntaxError, "Cannot call this method.");
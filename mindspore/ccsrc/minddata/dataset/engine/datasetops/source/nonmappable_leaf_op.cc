@@ -202,6 +202,43 @@ Status NonMappableLeafOp::PushIoBlockQueue(int32_t index, std::unique_ptr<Filena
   return Status::OK();
 }
 
+Status NonMappableLeafOp::PushEpochBlocks(const std::vector<RowRange> &ranges, int64_t rows_per_block) {
+  int64_t num_blocks = 0;
+  for (const auto &range : ranges) {
+    // An empty range still makes one block, see PushRowBlocks
+    num_blocks += range.end_offset > range.start_offset
+                    ? (range.end_offset - 1) / rows_per_block - range.start_offset / rows_per_block + 1
+                    : 1;
+  }
+  // Blocks go round robin from the first queue, each queue also gets an end of epoch block
+  auto queue_size = static_cast<size_t>((num_blocks + num_workers_ - 1) / num_workers_ + 1);
+  for (int32_t i = 0; i < num_workers_; ++i) {
+    if (io_block_queues_[i]->capacity() < queue_size) {
+      RETURN_IF_NOT_OK(io_block_queues_[i]->Resize(queue_size));
+    }
+  }
+  int32_t queue_index = 0;
+  for (const auto &range : ranges) {
+    RETURN_IF_NOT_OK(PushRowBlocks(range.key, range.start_offset, range.end_offset, rows_per_block, &queue_index));
+  }
+  RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
+  return Status::OK();
+}
+
+Status NonMappableLeafOp::PushRowBlocks(int64_t key, int64_t start_offset, int64_t end_offset, int64_t rows_per_block,
+                                        int32_t *queue_index) {
+  // Aligned blocks let a reader start from a row whose position in the file is known
+  int64_t begin = start_offset;
+  do {
+    int64_t end = std::min(end_offset, (begin / rows_per_block + 1) * rows_per_block);
+    auto io_block = std::make_unique<FilenameBlock>(key, begin, end, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(io_block)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+    begin = end;
+  } while (begin < end_offset);
+  return Status::OK();
+}
+
 // Overrides base class reset method. Cleans up any state info from it's previous execution and
 // reinitializes itself so that it can be executed again, as if it was just created.
 Status NonMappableLeafOp::Reset() {
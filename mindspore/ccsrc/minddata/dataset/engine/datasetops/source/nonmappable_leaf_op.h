@@ -115,6 +115,33 @@ class NonMappableLeafOp : public ParallelOp {
   // @return Status - the error code returned.
   Status PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock> &&io_block);
 
+  // A range of rows of a file, pushed as blocks by PushEpochBlocks.
+  struct RowRange {
+    int64_t key;
+    int64_t start_offset;
+    int64_t end_offset;
+  };
+
+  // Push the row ranges of an epoch as blocks, followed by the end of epoch blocks. The master pulls rows from the
+  // workers in turn, so the filler must never wait on the full queue of one worker while another worker waits for
+  // its next block. The queues are grown up front to hold all the blocks of the epoch, as they are sized to hold
+  // all the files of an epoch when each file is a single block.
+  // @param ranges - the row ranges of the epoch, in the order they are read.
+  // @param rows_per_block - the maximum number of rows of a block.
+  // @return Status - the error code returned.
+  Status PushEpochBlocks(const std::vector<RowRange> &ranges, int64_t rows_per_block);
+
+  // Push the rows [start_offset, end_offset) of a file as blocks of at most rows_per_block rows, so the rows of a
+  // large file are read by all the workers rather than by one. Blocks start at multiples of rows_per_block.
+  // @param key - the key of the file.
+  // @param start_offset - the index of the first row.
+  // @param end_offset - one greater than the index of the last row.
+  // @param rows_per_block - the maximum number of rows of a block.
+  // @param queue_index - the queue to push the first block to, updated to the queue of the next block.
+  // @return Status - the error code returned.
+  Status PushRowBlocks(int64_t key, int64_t start_offset, int64_t end_offset, int64_t rows_per_block,
+                       int32_t *queue_index);
+
   // Reads a tf_file file and loads the data into multiple TensorRows.
   // @param filename - the tf_file file to read.
   // @param start_offset - the start offset of file.
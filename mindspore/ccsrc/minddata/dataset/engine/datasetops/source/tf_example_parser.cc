@@ -0,0 +1,199 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
+
+#include <utility>
+
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Field numbers of example.proto and feature.proto
+constexpr uint32_t kExampleFeaturesField = 1;
+constexpr uint32_t kFeaturesFeatureField = 1;
+constexpr uint32_t kMapKeyField = 1;
+constexpr uint32_t kMapValueField = 2;
+constexpr uint32_t kFeatureBytesListField = 1;
+constexpr uint32_t kFeatureFloatListField = 2;
+constexpr uint32_t kFeatureInt64ListField = 3;
+}  // namespace
+
+constexpr char TFExampleParser::kErrMsg[];
+
+TFExampleParser::TFExampleParser(std::vector<std::string> columns)
+    : columns_(std::move(columns)), features_(columns_.size()) {}
+
+Status TFExampleParser::Parse(const unsigned char *data, size_t size) {
+  for (auto &feature : features_) {
+    feature = {false, FeatureKind::kNotSet, nullptr, 0};
+  }
+  Reader example(data, size);
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  while (example.ReadTag(&field, &wire_type)) {
+    if (field != kExampleFeaturesField || wire_type != kWireLength) {
+      CHECK_FAIL_RETURN_UNEXPECTED(example.Skip(wire_type), kErrMsg);
+      continue;
+    }
+    // Features, the same message may occur more than once, their fields are merged
+    Reader features(nullptr, 0);
+    CHECK_FAIL_RETURN_UNEXPECTED(example.ReadLengthDelimited(&features), kErrMsg);
+    while (features.ReadTag(&field, &wire_type)) {
+      if (field == kFeaturesFeatureField && wire_type == kWireLength) {
+        Reader entry(nullptr, 0);
+        CHECK_FAIL_RETURN_UNEXPECTED(features.ReadLengthDelimited(&entry), kErrMsg);
+        RETURN_IF_NOT_OK(ParseFeatureEntry(&entry));
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(features.Skip(wire_type), kErrMsg);
+      }
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(features.done(), kErrMsg);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(example.done(), kErrMsg);
+  return Status::OK();
+}
+
+Status TFExampleParser::ParseFeatureEntry(Reader *entry) {
+  std::string_view key;
+  Reader value(nullptr, 0);
+  bool has_value = false;
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  while (entry->ReadTag(&field, &wire_type)) {
+    if (field == kMapKeyField && wire_type == kWireLength) {
+      Reader key_reader(nullptr, 0);
+      CHECK_FAIL_RETURN_UNEXPECTED(entry->ReadLengthDelimited(&key_reader), kErrMsg);
+      key = std::string_view(reinterpret_cast<const char *>(key_reader.pos()), key_reader.remaining());
+    } else if (field == kMapValueField && wire_type == kWireLength) {
+      CHECK_FAIL_RETURN_UNEXPECTED(entry->ReadLengthDelimited(&value), kErrMsg);
+      has_value = true;
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(entry->Skip(wire_type), kErrMsg);
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(entry->done(), kErrMsg);
+
+  // Only a few columns are loaded, a linear search beats hashing the key
+  size_t col = 0;
+  while (col < columns_.size() && columns_[col] != key) {
+    col++;
+  }
+  RETURN_OK_IF_TRUE(col == columns_.size());
+
+  // A later entry of the same key replaces the earlier one, as in a protobuf map
+  Feature &feature = features_[col];
+  feature = {true, FeatureKind::kNotSet, nullptr, 0};
+  RETURN_OK_IF_TRUE(!has_value);
+  // Feature is a oneof, the last list in it wins
+  while (value.ReadTag(&field, &wire_type)) {
+    if (wire_type == kWireLength &&
+        (field == kFeatureBytesListField || field == kFeatureFloatListField || field == kFeatureInt64ListField)) {
+      Reader list(nullptr, 0);
+      CHECK_FAIL_RETURN_UNEXPECTED(value.ReadLengthDelimited(&list), kErrMsg);
+      feature.kind = field == kFeatureBytesListField
+                       ? FeatureKind::kBytesList
+                       : (field == kFeatureFloatListField ? FeatureKind::kFloatList : FeatureKind::kInt64List);
+      feature.data = list.pos();
+      feature.size = list.remaining();
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(value.Skip(wire_type), kErrMsg);
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(value.done(), kErrMsg);
+  return Status::OK();
+}
+
+Status TFExampleParser::GetBytes(const Feature &feature, std::vector<std::string_view> *values) {
+  RETURN_UNEXPECTED_IF_NULL(values);
+  values->clear();
+  Reader reader(feature.data, feature.size);
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  while (reader.ReadTag(&field, &wire_type)) {
+    if (field == kValueField && wire_type == kWireLength) {
+      Reader value(nullptr, 0);
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&value), kErrMsg);
+      values->emplace_back(reinterpret_cast<const char *>(value.pos()), value.remaining());
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kErrMsg);
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(reader.done(), kErrMsg);
+  return Status::OK();
+}
+
+Status TFExampleParser::CountValues(const Feature &feature, int64_t *count) {
+  RETURN_UNEXPECTED_IF_NULL(count);
+  *count = 0;
+  Reader reader(feature.data, feature.size);
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  while (reader.ReadTag(&field, &wire_type)) {
+    if (field == kValueField && wire_type == kWireLength) {
+      Reader packed(nullptr, 0);
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&packed), kErrMsg);
+      if (feature.kind == FeatureKind::kFloatList) {
+        CHECK_FAIL_RETURN_UNEXPECTED(packed.remaining() % sizeof(float) == 0, kErrMsg);
+        *count += static_cast<int64_t>(packed.remaining() / sizeof(float));
+      } else {
+        // Every varint ends with a byte below 0x80
+        for (const unsigned char *p = packed.pos(); p < packed.pos() + packed.remaining(); ++p) {
+          *count += (*p & 0x80) == 0 ? 1 : 0;
+        }
+      }
+    } else if (field == kValueField && (wire_type == kWireFixed32 || wire_type == kWireVarint)) {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kErrMsg);
+      (*count)++;
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kErrMsg);
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(reader.done(), kErrMsg);
+  return Status::OK();
+}
+
+Status TFExampleParser::GetFloats(const Feature &feature, float *out, int64_t count) {
+  Reader reader(feature.data, feature.size);
+  int64_t i = 0;
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  // Floats are little endian fixed32 on the wire, as on all the platforms we run on
+  while (reader.ReadTag(&field, &wire_type)) {
+    if (field == kValueField && wire_type == kWireFixed32) {
+      CHECK_FAIL_RETURN_UNEXPECTED(i < count && reader.remaining() >= sizeof(float), kErrMsg);
+      int ret = memcpy_s(out + i, (count - i) * sizeof(float), reader.pos(), sizeof(float));
+      CHECK_FAIL_RETURN_UNEXPECTED(ret == 0 && reader.Advance(sizeof(float)), kErrMsg);
+      i++;
+    } else if (field == kValueField && wire_type == kWireLength) {
+      Reader packed(nullptr, 0);
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&packed), kErrMsg);
+      int64_t n = static_cast<int64_t>(packed.remaining() / sizeof(float));
+      CHECK_FAIL_RETURN_UNEXPECTED(i + n <= count, kErrMsg);
+      if (n > 0) {
+        int ret = memcpy_s(out + i, (count - i) * sizeof(float), packed.pos(), n * sizeof(float));
+        CHECK_FAIL_RETURN_UNEXPECTED(ret == 0, kErrMsg);
+      }
+      i += n;
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kErrMsg);
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(reader.done() && i == count, kErrMsg);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,195 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Reads the features of some columns from a serialized dataengine::Example, straight from the protobuf wire format.
+// The features of the other columns are skipped without being decoded, and the values of a feature are decoded
+// straight into the buffer of a tensor instead of into protobuf messages first.
+class TFExampleParser {
+ public:
+  enum class FeatureKind { kNotSet, kBytesList, kFloatList, kInt64List };
+
+  // A feature of the Example being parsed, pointing into its serialized value list
+  struct Feature {
+    bool found;
+    FeatureKind kind;
+    const unsigned char *data;
+    size_t size;
+  };
+
+  // Constructor
+  // @param columns the names of the features to read, feature(i) is the feature of columns[i].
+  explicit TFExampleParser(std::vector<std::string> columns);
+
+  ~TFExampleParser() = default;
+
+  // Find the features of the columns in a serialized Example, which must outlive the use of the features.
+  // @param data the serialized Example.
+  // @param size the size of the serialized Example.
+  // @return Status
+  Status Parse(const unsigned char *data, size_t size);
+
+  const Feature &feature(int32_t col) const { return features_[col]; }
+
+  // Get the values of a bytes list feature
+  static Status GetBytes(const Feature &feature, std::vector<std::string_view> *values);
+
+  // Get the number of values of a float list or int64 list feature
+  static Status CountValues(const Feature &feature, int64_t *count);
+
+  // Decode the values of a float list feature.
+  // @param feature the feature.
+  // @param out the buffer to decode into, which holds count values.
+  // @param count the number of values of the feature.
+  // @return Status
+  static Status GetFloats(const Feature &feature, float *out, int64_t count);
+
+  // Decode the values of an int64 list feature, each value cast to T.
+  // @param feature the feature.
+  // @param out the buffer to decode into, which holds count values.
+  // @param count the number of values of the feature.
+  // @return Status
+  template <typename T>
+  static Status GetInts(const Feature &feature, T *out, int64_t count) {
+    Reader reader(feature.data, feature.size);
+    int64_t i = 0;
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    while (reader.ReadTag(&field, &wire_type)) {
+      if (field == kValueField && wire_type == kWireVarint) {
+        uint64_t value = 0;
+        CHECK_FAIL_RETURN_UNEXPECTED(i < count && reader.ReadVarint(&value), kErrMsg);
+        out[i++] = static_cast<T>(static_cast<int64_t>(value));
+      } else if (field == kValueField && wire_type == kWireLength) {
+        Reader packed(nullptr, 0);
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.ReadLengthDelimited(&packed), kErrMsg);
+        uint64_t value = 0;
+        while (!packed.done()) {
+          CHECK_FAIL_RETURN_UNEXPECTED(i < count && packed.ReadVarint(&value), kErrMsg);
+          out[i++] = static_cast<T>(static_cast<int64_t>(value));
+        }
+      } else {
+        CHECK_FAIL_RETURN_UNEXPECTED(reader.Skip(wire_type), kErrMsg);
+      }
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.done() && i == count, kErrMsg);
+    return Status::OK();
+  }
+
+ private:
+  static constexpr uint32_t kWireVarint = 0;
+  static constexpr uint32_t kWireFixed64 = 1;
+  static constexpr uint32_t kWireLength = 2;
+  static constexpr uint32_t kWireFixed32 = 5;
+  static constexpr uint32_t kValueField = 1;
+  static constexpr char kErrMsg[] = "Invalid data, failed to parse tfrecord: the Example is malformed.";
+
+  // Reads fields of a protobuf message from a buffer
+  class Reader {
+   public:
+    Reader(const unsigned char *data, size_t size) : pos_(data), end_(data + size) {}
+
+    bool done() const { return pos_ == end_; }
+
+    const unsigned char *pos() const { return pos_; }
+
+    size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+    bool ReadVarint(uint64_t *value) {
+      uint64_t result = 0;
+      for (int shift = 0; shift < 64 && pos_ < end_; shift += 7) {
+        uint8_t byte = *pos_++;
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+          *value = result;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // @return false at the end of the message, or if the tag is malformed.
+    bool ReadTag(uint32_t *field, uint32_t *wire_type) {
+      uint64_t tag = 0;
+      if (done() || !ReadVarint(&tag)) {
+        return false;
+      }
+      *field = static_cast<uint32_t>(tag >> 3);
+      *wire_type = static_cast<uint32_t>(tag & 0x7);
+      return *field != 0;
+    }
+
+    // Take a length delimited field as a reader of its own
+    bool ReadLengthDelimited(Reader *field) {
+      uint64_t len = 0;
+      if (!ReadVarint(&len) || len > remaining()) {
+        return false;
+      }
+      *field = Reader(pos_, static_cast<size_t>(len));
+      pos_ += len;
+      return true;
+    }
+
+    bool Skip(uint32_t wire_type) {
+      uint64_t value = 0;
+      Reader field(nullptr, 0);
+      switch (wire_type) {
+        case kWireVarint:
+          return ReadVarint(&value);
+        case kWireLength:
+          return ReadLengthDelimited(&field);
+        case kWireFixed64:
+          return Advance(sizeof(uint64_t));
+        case kWireFixed32:
+          return Advance(sizeof(uint32_t));
+        default:
+          return false;
+      }
+    }
+
+    bool Advance(size_t n) {
+      if (n > remaining()) {
+        return false;
+      }
+      pos_ += n;
+      return true;
+    }
+
+   private:
+    const unsigned char *pos_;
+    const unsigned char *end_;
+  };
+
+  // Parse a map entry of Features, keep it if it is the feature of a column
+  Status ParseFeatureEntry(Reader *entry);
+
+  std::vector<std::string> columns_;
+  std::vector<Feature> features_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_EXAMPLE_PARSER_H_
@@ -30,6 +30,7 @@
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_index.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -37,10 +38,13 @@
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/wait_post.h"
 #include "utils/system/crc32c.h"
+#include "./securec.h"
 
 namespace mindspore {
 namespace dataset {
 const int64_t kTFRecordFileLimit = 0x140000000;
+// Files with more records than this are split into blocks read by different workers
+const int64_t kRowsPerBlock = 1024;
 
 bool TFReaderOp::ValidateFirstRowCrc(const std::string &filename) {
   auto realpath = Common::GetRealPath(filename);
@@ -154,10 +158,10 @@ Status TFReaderOp::CalculateNumRowsPerShard() {
   }
 
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
-    filename_numrows_[it.value()] = num;
-    num_rows_ += num;
+    std::shared_ptr<TFRecordIndex> index;
+    RETURN_IF_NOT_OK(GetRecordIndex(it.value(), &index));
+    filename_numrows_[it.value()] = index->NumRecords();
+    num_rows_ += index->NumRecords();
   }
   num_rows_per_shard_ = static_cast<int64_t>(std::ceil(num_rows_ * 1.0 / num_devices_));
   if (num_rows_per_shard_ == 0) {
@@ -173,7 +177,7 @@ Status TFReaderOp::CalculateNumRowsPerShard() {
 }
 
 Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
-  int32_t queue_index = 0;
+  std::vector<RowRange> ranges;
   int32_t key_index = 0;
   int64_t pre_count = 0;
   int64_t start_offset = 0;
@@ -191,18 +195,16 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          std::shared_ptr<TFRecordIndex> index;
+          RETURN_IF_NOT_OK(GetRecordIndex((*filename_index_)[*it], &index));
+          ranges.push_back({*it, 0, index->NumRecords()});
         }
       } else {
         // Do an index lookup using that key to get the filename.
         std::string file_name = (*filename_index_)[*it];
         if (NeedPushFileToBlockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          ranges.push_back({*it, start_offset, end_offset});
           MS_LOG(DEBUG) << "File name " << *it << " start offset " << start_offset << " end_offset " << end_offset;
-          queue_index = (queue_index + 1) % num_workers_;
         }
 
         pre_count += filename_numrows_[file_name];
@@ -215,12 +217,12 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       finish = true;
     }
   }
-  RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
+  RETURN_IF_NOT_OK(PushEpochBlocks(ranges, kRowsPerBlock));
   return Status::OK();
 }
 
 Status TFReaderOp::FillIOBlockNoShuffle() {
-  int32_t queue_index = 0;
+  std::vector<RowRange> ranges;
   int32_t key_index = 0;
   int64_t pre_count = 0;
   int64_t start_offset = 0;
@@ -239,17 +241,14 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock =
-            std::make_unique<FilenameBlock>(it.key(), kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          std::shared_ptr<TFRecordIndex> index;
+          RETURN_IF_NOT_OK(GetRecordIndex(it.value(), &index));
+          ranges.push_back({it.key(), 0, index->NumRecords()});
         }
       } else {
         std::string file_name = it.value();
         if (NeedPushFileToBlockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = std::make_unique<FilenameBlock>(it.key(), start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          ranges.push_back({it.key(), start_offset, end_offset});
         }
 
         pre_count += filename_numrows_[file_name];
@@ -263,11 +262,25 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
     }
   }
 
-  RETURN_IF_NOT_OK(PostEndOfEpoch(queue_index));
+  RETURN_IF_NOT_OK(PushEpochBlocks(ranges, kRowsPerBlock));
   return Status::OK();
 }
 
-// Reads a tf_file file and loads the data into multiple TensorRows.
+Status TFReaderOp::GetRecordIndex(const std::string &filename, std::shared_ptr<TFRecordIndex> *index) {
+  std::unique_lock<std::mutex> lock(record_index_mutex_);
+  auto it = record_indexes_.find(filename);
+  if (it == record_indexes_.end()) {
+    auto realpath = Common::GetRealPath(filename);
+    CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Get real path failed, path=" + filename);
+    std::shared_ptr<TFRecordIndex> new_index;
+    RETURN_IF_NOT_OK(TFRecordIndex::Load(realpath.value(), &new_index));
+    it = record_indexes_.emplace(filename, std::move(new_index)).first;
+  }
+  *index = it->second;
+  return Status::OK();
+}
+
+// Reads the records of a tf_file file and loads the data into multiple TensorRows.
 Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) {
   auto realpath = Common::GetRealPath(filename);
   if (!realpath.has_value()) {
@@ -275,71 +288,80 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     RETURN_STATUS_UNEXPECTED("Get real path failed, path=" + filename);
   }
 
+  std::shared_ptr<TFRecordIndex> index;
+  RETURN_IF_NOT_OK(GetRecordIndex(filename, &index));
+  if (start_offset == kInvalidOffset) {
+    start_offset = 0;
+    end_offset = index->NumRecords();
+  }
+  end_offset = std::min(end_offset, index->NumRecords());
+
+  // Parse the records where they lie in the mapped file, or read them one by one if the file can not be mapped
+  MappedFile mapped_file;
+  bool mapped = mapped_file.Map(realpath.value());
   std::ifstream reader;
-  reader.open(realpath.value());
-  if (!reader) {
-    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+  std::string serialized_example;
+  if (mapped) {
+    CHECK_FAIL_RETURN_UNEXPECTED(mapped_file.size() == index->file_size(),
+                                 "Invalid file, tfrecord file is modified while being read: " + filename);
+  } else {
+    reader.open(realpath.value(), std::ios::in | std::ios::binary);
+    if (!reader) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+    }
   }
 
-  int64_t rows_read = 0;
-  int64_t rows_total = 0;
+  int32_t num_columns = data_schema_->NumColumns();
+  std::vector<std::string> column_names;
+  for (int32_t col = 0; col < num_columns; ++col) {
+    column_names.push_back(data_schema_->column(col).name());
+  }
+  TFExampleParser parser(std::move(column_names));
+  std::vector<std::string> file_path(num_columns, filename);
 
-  while (reader.peek() != EOF) {
+  for (int64_t record = start_offset; record < end_offset; record++) {
     if (!load_jagged_connector_) {
       break;
     }
     RETURN_IF_INTERRUPTED();
 
-    // read length
-    int64_t record_length = 0;
-    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-    // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
-
-    int32_t num_columns = data_schema_->NumColumns();
-    TensorRow newRow(num_columns, nullptr);
-
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Invalid file, failed to parse tfrecord file : " + filename;
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
+    uint64_t record_length = index->DataLength(record);
+    const unsigned char *data = nullptr;
+    if (mapped) {
+      data = mapped_file.data() + index->DataOffset(record);
+    } else {
+      serialized_example.resize(record_length);
+      (void)reader.seekg(static_cast<std::streamoff>(index->DataOffset(record)), std::ios::beg);
+      (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
+      CHECK_FAIL_RETURN_UNEXPECTED(reader.good(), "Invalid file, failed to read tfrecord file : " + filename);
+      data = reinterpret_cast<const unsigned char *>(serialized_example.data());
+    }
 
-      std::vector<std::string> file_path(num_columns, filename);
-      newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
-      rows_read++;
-      RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+    Status rc = parser.Parse(data, record_length);
+    if (rc.IsError()) {
+      std::string errMsg = "Invalid file, failed to parse tfrecord file : " + filename;
+      MS_LOG(DEBUG) << errMsg + ", details: " << rc.GetErrDescription();
+      RETURN_STATUS_UNEXPECTED(errMsg);
     }
 
-    // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-    rows_total++;
+    TensorRow newRow(num_columns, nullptr);
+    newRow.setPath(file_path);
+    RETURN_IF_NOT_OK(LoadExample(parser, &newRow));
+    RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
   }
 
   return Status::OK();
 }
 
-// Parses a single row and puts the data into a tensor table.
-Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, TensorRow *out_row) {
+// Puts the features of a parsed row into a tensor table.
+Status TFReaderOp::LoadExample(const TFExampleParser &parser, TensorRow *out_row) {
   int32_t num_columns = data_schema_->NumColumns();
   for (int32_t col = 0; col < num_columns; ++col) {
     const ColDescriptor current_col = data_schema_->column(col);
-    const dataengine::Features &example_features = tf_file->features();
-    const google::protobuf::Map<std::string, dataengine::Feature> &feature_map = example_features.feature();
-    auto iter_column = feature_map.find(current_col.name());
-    if (iter_column == feature_map.end()) {
+    const TFExampleParser::Feature &column_values_list = parser.feature(col);
+    if (!column_values_list.found) {
       RETURN_STATUS_UNEXPECTED("Invalid parameter, column name: " + current_col.name() + " does not exist.");
     }
-    const dataengine::Feature &column_values_list = iter_column->second;
     RETURN_IF_NOT_OK(LoadFeature(out_row, column_values_list, current_col, col));
   }
 
@@ -347,49 +369,27 @@ Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, TensorRow *ou
 }
 
 // Parses a single cell and puts the data into a tensor table.
-Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
+Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const TFExampleParser::Feature &column_values_list,
                                const ColDescriptor &current_col, int32_t col) {
-  const dataengine::Feature::KindCase column_list_type = column_values_list.kind_case();
-  std::unique_ptr<float[]> float_array;     // For staging data from protobuf deserialization
-  const unsigned char *data_ptr = nullptr;  // Generic pointer used for populating the Tensor
-
-  // This variable will point into the above staging variables.
-  // Also used for creating shape attributes.
+  // This variable is used for creating shape attributes.
   int32_t num_elements = 0;
 
-  // we build a tensor first a read directly into it if we need to cast
+  // The values of every list are decoded straight into the tensor
   std::shared_ptr<Tensor> ts;
 
-  // Depending on the type of data from the tf_file, we want to extract 2 things:
-  // 1) A pointer to the data as a const unsigned char *
-  // 2) The number of elements of the data
-  // After those are determined, we can then build the tensor to represent this data.
-  switch (column_list_type) {
-    case dataengine::Feature::KindCase::kBytesList: {
+  switch (column_values_list.kind) {
+    case TFExampleParser::FeatureKind::kBytesList: {
       RETURN_IF_NOT_OK(LoadBytesList(current_col, column_values_list, &num_elements, &ts));
-
       break;
     }
-    case dataengine::Feature::KindCase::kFloatList: {
-      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &float_array));
-
-      data_ptr = reinterpret_cast<const unsigned char *>(float_array.get());
-
-      // only floatList needs to create the tensor here, other two lists read directly
-      // into the tensor
-      TensorShape current_shape = TensorShape::CreateUnknownRankShape();
-      RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(num_elements, &current_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(current_shape, current_col.type(), data_ptr, &ts));
+    case TFExampleParser::FeatureKind::kFloatList: {
+      RETURN_IF_NOT_OK(LoadFloatList(current_col, column_values_list, &num_elements, &ts));
       break;
     }
-    case dataengine::Feature::KindCase::kInt64List: {
+    case TFExampleParser::FeatureKind::kInt64List: {
       RETURN_IF_NOT_OK(LoadIntListSwitch(current_col, column_values_list, &num_elements, &ts));
       break;
     }
-    case dataengine::Feature::KindCase::KIND_NOT_SET: {
-      std::string err_msg = "Invalid data, column type in tf record file must be uint8, int64 or float32.";
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    }
     default: {
       std::string err_msg = "Invalid data, column type in tf record file must be uint8, int64 or float32.";
       RETURN_STATUS_UNEXPECTED(err_msg);
@@ -401,7 +401,7 @@ Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const dataengine::Feature
   return Status::OK();
 }
 
-Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                                  int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   // kBytesList can map to the following DE types ONLY!
   // DE_UINT8, DE_INT8
@@ -413,24 +413,22 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::BytesList &bytes_list = column_values_list.bytes_list();
+  std::vector<std::string_view> bytes_list;
+  RETURN_IF_NOT_OK(TFExampleParser::GetBytes(column_values_list, &bytes_list));
 
-  *num_elements = bytes_list.value_size();
+  *num_elements = bytes_list.size();
 
   if (current_col.type() == DataType::DE_STRING) {
     TensorShape shape = TensorShape::CreateScalar();
     RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &shape));
-    RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, shape, tensor));
+    std::vector<std::string> strings(bytes_list.begin(), bytes_list.end());
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(strings, shape, tensor));
     return Status::OK();
   }
 
   uint64_t max_size = 0;
-  for (uint32_t i = 0; i < bytes_list.value_size(); ++i) {
-#if defined(__APPLE__)
-    max_size = fmax(max_size, bytes_list.value(i).size());
-#else
-    max_size = std::max(max_size, bytes_list.value(i).size());
-#endif
+  for (const auto &value : bytes_list) {
+    max_size = std::max(max_size, static_cast<uint64_t>(value.size()));
   }
 
   int64_t pad_size = max_size;
@@ -460,16 +458,36 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
     }
   }
 
-  // know how many elements there are and the total bytes, create tensor here:
+  // know how many elements there are and the total bytes, create tensor here and copy the values into it,
+  // each one padded with ' ' to pad_size:
   TensorShape current_shape = TensorShape::CreateScalar();
   RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, current_shape, current_col.type(), pad_size, tensor));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+  RETURN_OK_IF_TRUE((*num_elements) * pad_size == 0);
+  unsigned char *current_tensor_addr = &(*(*tensor)->begin<uint8_t>());
+  int64_t tensor_bytes_remaining = (*num_elements) * pad_size;
+  for (const auto &value : bytes_list) {
+    CHECK_FAIL_RETURN_UNEXPECTED(static_cast<int64_t>(value.size()) <= pad_size,
+                                 "Invalid data, bytes of column " + current_col.name() + " exceed its shape.");
+    if (!value.empty()) {
+      int return_code = memcpy_s(current_tensor_addr, tensor_bytes_remaining, value.data(), value.size());
+      CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memcpy_s failed when reading bytesList element into Tensor");
+    }
+    int64_t chars_to_pad = pad_size - value.size();
+    if (chars_to_pad > 0) {
+      int return_code = memset_s(current_tensor_addr + value.size(), tensor_bytes_remaining - value.size(),
+                                 static_cast<int>(' '), chars_to_pad);
+      CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memcpy_s failed when padding Tensor");
+    }
+    current_tensor_addr += pad_size;
+    tensor_bytes_remaining -= pad_size;
+  }
 
   return Status::OK();
 }
 
-Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                 int32_t *num_elements, std::unique_ptr<float[]> *float_array) {
+Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
+                                 int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   // KFloatList can only map to DE types:
   // DE_FLOAT32
   if (current_col.type() != DataType::DE_FLOAT32) {
@@ -478,22 +496,24 @@ Status TFReaderOp::LoadFloatList(const ColDescriptor &current_col, const dataeng
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::FloatList &float_list = column_values_list.float_list();
+  // Identify how many values we have and then create the tensor to deserialize into
+  int64_t count = 0;
+  RETURN_IF_NOT_OK(TFExampleParser::CountValues(column_values_list, &count));
+  *num_elements = count;
 
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = float_list.value_size();
-  *float_array = std::make_unique<float[]>(*num_elements);
-  for (int i = 0; i < float_list.value_size(); ++i) {
-    (*float_array)[i] = float_list.value(i);
-  }
+  TensorShape current_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
+  RETURN_OK_IF_TRUE(count == 0);
+  RETURN_IF_NOT_OK(TFExampleParser::GetFloats(column_values_list, &(*(*tensor)->begin<float>()), count));
 
   return Status::OK();
 }
 
 // Determines which template type to use and calls LoadIntList
-Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                                     int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
+Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col,
+                                     const TFExampleParser::Feature &column_values_list, int32_t *num_elements,
+                                     std::shared_ptr<Tensor> *tensor) {
   if (current_col.type() == DataType::DE_UINT64) {
     RETURN_IF_NOT_OK(LoadIntList<uint64_t>(current_col, column_values_list, num_elements, tensor));
   } else if (current_col.type() == DataType::DE_INT64) {
@@ -520,10 +540,10 @@ Status TFReaderOp::LoadIntListSwitch(const ColDescriptor &current_col, const dat
   return Status::OK();
 }
 
-// Reads values from a bytes list and casts the value to type T, must be an integral type
+// Reads values from an int64 list and casts the value to type T, must be an integral type
 // compatible with int64_t
 template <typename T>
-Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                                int32_t *num_elements, std::shared_ptr<Tensor> *tensor) {
   if (!(current_col.type().IsInt())) {
     std::string err_msg = "Invalid data, invalid data type for Tensor at column: " + current_col.name() +
@@ -531,23 +551,17 @@ Status TFReaderOp::LoadIntList(const ColDescriptor &current_col, const dataengin
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
 
-  const dataengine::Int64List &int64_list = column_values_list.int64_list();
-
-  // Identify how many values we have and then create a local array of these
-  // to deserialize into
-  *num_elements = int64_list.value_size();
+  // Identify how many values we have
+  int64_t count = 0;
+  RETURN_IF_NOT_OK(TFExampleParser::CountValues(column_values_list, &count));
+  *num_elements = count;
 
-  // know how many elements there are, create tensor here:
+  // know how many elements there are, create tensor here and decode into it:
   TensorShape current_shape = TensorShape::CreateUnknownRankShape();
   RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(*num_elements, &current_shape));
   RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.type(), tensor));
-
-  int64_t i = 0;
-  auto it = (*tensor)->begin<T>();
-  for (; it != (*tensor)->end<T>(); i++, ++it) {
-    T element = static_cast<T>(int64_list.value(i));
-    *it = element;
-  }
+  RETURN_OK_IF_TRUE(count == 0);
+  RETURN_IF_NOT_OK(TFExampleParser::GetInts(column_values_list, &(*(*tensor)->begin<T>()), count));
 
   return Status::OK();
 }
@@ -688,28 +702,15 @@ int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &file
       continue;
     }
 
-    std::ifstream reader;
-    reader.open(realpath.value());
-    if (!reader) {
-      MS_LOG(DEBUG) << "TFReader operator failed to open file " << filenames[i] << ".";
-    }
-
-    while (reader.peek() != EOF) {
-      // read length
-      int64_t record_length = 0;
-      (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
-
-      // ignore crc header
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      // ignore tf_file contents
-      (void)reader.ignore(static_cast<std::streamsize>(record_length));
-
-      // ignore crc footer
-      (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
-
-      rows_read++;
+    // The sidecar index of a file holds its number of records. Counting rows only reads sidecar files, it does not
+    // write next to the dataset, reading the dataset does
+    std::shared_ptr<TFRecordIndex> index;
+    Status rc = TFRecordIndex::Load(realpath.value(), &index, TFRecordIndex::kNoCache);
+    if (rc.IsError()) {
+      MS_LOG(DEBUG) << "TFReader operator failed to index file " << filenames[i] << ": " << rc.GetErrDescription();
+      continue;
     }
+    rows_read += index->NumRecords();
   }
 
   return rows_read;
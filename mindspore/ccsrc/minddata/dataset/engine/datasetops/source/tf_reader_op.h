@@ -32,14 +32,9 @@
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
+#include "minddata/dataset/engine/datasetops/source/tf_example_parser.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 
-namespace dataengine {
-class Example;
-class Feature;
-class BytesList;
-}  // namespace dataengine
-
 namespace mindspore {
 namespace dataset {
 template <typename T>
@@ -50,6 +45,7 @@ class Connector;
 
 class JaggedConnector;
 class FilenameBlock;
+class TFRecordIndex;
 
 using StringIndex = AutoIndexObj<std::string>;
 
@@ -83,8 +79,8 @@ class TFReaderOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status Init() override;
 
-  /// Reads all the provided tf_file files and counts the total number of rows. filenames will
-  /// first be sectioned into equal parts, then sections are read in parallel. If threads is
+  /// Counts the total number of rows of all the provided tf_file files from their record indexes. filenames will
+  /// first be sectioned into equal parts, then sections are indexed in parallel. If threads is
   /// greater than the number of files, threads will be clamped to the number of files.
   /// @param out_total_tows - output parameter which contains the total number of rows
   /// @param filenames - a list of tf_file filenames.
@@ -105,27 +101,26 @@ class TFReaderOp : public NonMappableLeafOp {
   static bool ValidateFirstRowCrc(const std::string &filename);
 
  private:
-  // Reads a tf_file file and loads the data into multiple TensorRows.
+  // Reads the records of a tf_file file and loads the data into multiple TensorRows.
   // @param filename - the tf_file file to read.
-  // @param start_offset - the start offset of file.
-  // @param end_offset - the end offset of file.
+  // @param start_offset - the index of the first record to read, kInvalidOffset to read the whole file.
+  // @param end_offset - one greater than the index of the last record to read.
   // @param worker_id - the id of the worker that is executing this function.
   // @return Status - the error code returned.
   Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
-  // Parses a single row and puts the data into a tensor table.
-  // @param tf_file - the row to be parsed.
-  // @param tensor_table - the tensor table to put the parsed data in.
-  // @param row - the id of the row filled in the tensor table.
+  // Puts the features of a parsed row into a tensor table.
+  // @param parser - the parser holding the features of the row.
+  // @param out_row - the tensor row to put the parsed data in.
   // @return Status - the error code returned.
-  Status LoadExample(const dataengine::Example *tf_file, TensorRow *out_row);
+  Status LoadExample(const TFExampleParser &parser, TensorRow *out_row);
 
   // Parses a single cell and puts the data into a tensor table.
   // @param tensor_table - the tensor table to put the parsed data in.
   // @param column_values_list - the cell to parse.
   // @param current_col - the column descriptor containing the expected shape and type of the data.
   // @return Status - the error code returned.
-  Status LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
+  Status LoadFeature(TensorRow *tensor_row, const TFExampleParser::Feature &column_values_list,
                      const ColDescriptor &current_col, int32_t col);
 
   /// Reads values from a bytes list
@@ -133,17 +128,17 @@ class TFReaderOp : public NonMappableLeafOp {
   /// @param column_values_list - the cell that contains the bytes list to read from.
   /// @param elementStr - the string we read the value into.
   /// @return Status - the error code returned.
-  static Status LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  static Status LoadBytesList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                               int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   /// Reads values from a float list
   /// @param current_col - the column descriptor containing the expected shape and type of the data.
   /// @param column_values_list - the cell that contains the float list to read from.
   /// @Param numElements - number of values in the float list.
-  /// @param float_array - the array we read the values into.
+  /// @param tensor - the tensor we read the values into.
   /// @return Status - the error code returned.
-  Status LoadFloatList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
-                       int32_t *num_elements, std::unique_ptr<float[]> *float_array);
+  Status LoadFloatList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
+                       int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   /// Reads values from a bytes list and casts the value to type T, must be an integral
   /// type compatible with int64_t
@@ -153,7 +148,7 @@ class TFReaderOp : public NonMappableLeafOp {
   /// @param tensor - the tensor we read the values into.
   /// @return Status - the error code returned.
   template <typename T>
-  Status LoadIntList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  Status LoadIntList(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                      int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   /// Determines which template type to use and calls LoadIntList
@@ -162,14 +157,14 @@ class TFReaderOp : public NonMappableLeafOp {
   /// @Param numElements - number of values in the int list.
   /// @param tensor - the tensor we read the values into.
   /// @return Status - the error code returned.
-  Status LoadIntListSwitch(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
+  Status LoadIntListSwitch(const ColDescriptor &current_col, const TFExampleParser::Feature &column_values_list,
                            int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
   /// Reads one row of data from a tf file and creates a schema based on that row
   /// @return Status - the error code returned.
   Status CreateSchema(const std::string tf_file, std::vector<std::string> columns_to_load);
 
-  /// Meant to be called async. Will read files in the range [begin, end) and return the total rows
+  /// Meant to be called async. Will index files in the range [begin, end) and return the total rows
   /// @param filenames - a list of tf data filenames.
   /// @param begin - index of first file to read.
   /// @param end - one greater than the index of the last file to read.
@@ -193,6 +188,12 @@ class TFReaderOp : public NonMappableLeafOp {
    */
   Status FillIOBlockNoShuffle();
 
+  // Get the record index of a file, which is loaded once and shared by the workers.
+  // @param filename - the tf_file file.
+  // @param index - the record index of the file.
+  // @return Status - the error code returned.
+  Status GetRecordIndex(const std::string &filename, std::shared_ptr<TFRecordIndex> *index);
+
   // Calculate number of rows in each shard.
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard() override;
@@ -206,6 +207,9 @@ class TFReaderOp : public NonMappableLeafOp {
   std::unique_ptr<DataSchema> data_schema_;
 
   bool equal_rows_per_shard_;
+
+  std::mutex record_index_mutex_;
+  std::map<std::string, std::shared_ptr<TFRecordIndex>> record_indexes_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,237 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/tf_record_index.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <cstdio>
+#include <fstream>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+const uint64_t kTFRecordIndexMagic = 0x315844494654534DULL;  // "MSTFIDX1"
+const uint64_t kTFRecordIndexVersion = 2;
+const uint64_t kFnvOffsetBasis = 0xCBF29CE484222325ULL;
+const uint64_t kFnvPrime = 0x100000001B3ULL;
+
+// FNV-1a over the words of the sidecar file, so a partial or corrupt sidecar file is never used
+uint64_t Checksum(uint64_t file_size, uint64_t mtime, const std::vector<uint64_t> &offsets) {
+  uint64_t hash = kFnvOffsetBasis;
+  auto add = [&hash](uint64_t word) {
+    for (size_t i = 0; i < sizeof(word); i++) {
+      hash = (hash ^ ((word >> (i * 8)) & 0xFF)) * kFnvPrime;
+    }
+  };
+  add(file_size);
+  add(mtime);
+  add(offsets.size());
+  for (uint64_t offset : offsets) {
+    add(offset);
+  }
+  return hash;
+}
+
+void WriteWord(std::ofstream *out, uint64_t value) {
+  (void)out->write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+bool ReadWord(std::ifstream *in, uint64_t *value) {
+  (void)in->read(reinterpret_cast<char *>(value), sizeof(*value));
+  return in->good();
+}
+}  // namespace
+
+constexpr char TFRecordIndex::kSuffix[];
+
+Status TFRecordIndex::Load(const std::string &file_path, std::shared_ptr<TFRecordIndex> *out,
+                           int64_t min_records_to_cache) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  uint64_t file_size = 0;
+  uint64_t mtime = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED(GetFileStat(file_path, &file_size, &mtime),
+                               "Invalid file, failed to open file: " + file_path);
+  auto index = std::make_shared<TFRecordIndex>();
+  if (!index->ReadSidecar(file_path, file_size, mtime)) {
+    RETURN_IF_NOT_OK(index->Build(file_path));
+    if (index->NumRecords() >= min_records_to_cache) {
+      index->WriteSidecar(file_path, mtime);
+    }
+  }
+  *out = std::move(index);
+  return Status::OK();
+}
+
+Status TFRecordIndex::Build(const std::string &file_path) {
+  std::ifstream reader(file_path, std::ios::in | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(reader.good(), "Invalid file, failed to open file: " + file_path);
+  file_size_ = static_cast<uint64_t>(reader.seekg(0, std::ios::end).tellg());
+  offsets_.clear();
+  uint64_t offset = 0;
+  while (offset < file_size_) {
+    uint64_t record_length = 0;
+    (void)reader.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(record_length)));
+    uint64_t next = offset + kHeaderSize + record_length + kFooterSize;
+    // A record past the end of the file, or a length overflowing the offset, means a truncated or corrupt file
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.good() && next > offset && next <= file_size_,
+                                 "Invalid file, record " + std::to_string(offsets_.size()) +
+                                   " of tfrecord file is truncated: " + file_path);
+    offsets_.push_back(offset);
+    offset = next;
+  }
+  return Status::OK();
+}
+
+bool TFRecordIndex::ReadSidecar(const std::string &file_path, uint64_t file_size, uint64_t mtime) {
+  std::ifstream in(file_path + kSuffix, std::ios::in | std::ios::binary);
+  if (!in.good()) {
+    return false;
+  }
+  uint64_t magic = 0;
+  uint64_t version = 0;
+  uint64_t indexed_size = 0;
+  uint64_t indexed_mtime = 0;
+  uint64_t num_records = 0;
+  uint64_t checksum = 0;
+  if (!ReadWord(&in, &magic) || !ReadWord(&in, &version) || !ReadWord(&in, &indexed_size) ||
+      !ReadWord(&in, &indexed_mtime) || !ReadWord(&in, &num_records) || !ReadWord(&in, &checksum)) {
+    return false;
+  }
+  if (magic != kTFRecordIndexMagic || version != kTFRecordIndexVersion || indexed_size != file_size ||
+      indexed_mtime != mtime || num_records > file_size / (kHeaderSize + kFooterSize)) {
+    MS_LOG(INFO) << "Index of tfrecord file " << file_path << " is stale, index the file again.";
+    return false;
+  }
+  offsets_.resize(num_records);
+  (void)in.read(reinterpret_cast<char *>(offsets_.data()),
+                static_cast<std::streamsize>(num_records * sizeof(uint64_t)));
+  if (!in.good() || Checksum(indexed_size, indexed_mtime, offsets_) != checksum) {
+    MS_LOG(INFO) << "Index file of tfrecord file " << file_path << " is corrupt, index the file again.";
+    offsets_.clear();
+    return false;
+  }
+  file_size_ = file_size;
+  // The offsets must increase, frame by frame, up to the end of the file
+  for (int64_t i = 0; i < NumRecords(); i++) {
+    uint64_t end = i + 1 < NumRecords() ? offsets_[i + 1] : file_size_;
+    if (end < offsets_[i] + kHeaderSize + kFooterSize || (i == 0 && offsets_[i] != 0)) {
+      offsets_.clear();
+      return false;
+    }
+  }
+  if (offsets_.empty()) {
+    return file_size_ == 0;
+  }
+  // The last frame must still end the file, which catches a file rewritten with its size and mtime kept
+  std::ifstream reader(file_path, std::ios::in | std::ios::binary);
+  uint64_t record_length = 0;
+  (void)reader.seekg(static_cast<std::streamoff>(offsets_.back()), std::ios::beg);
+  (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(record_length)));
+  if (!reader.good() || offsets_.back() + kHeaderSize + record_length + kFooterSize != file_size_) {
+    MS_LOG(INFO) << "Index of tfrecord file " << file_path << " does not match the file, index the file again.";
+    offsets_.clear();
+    return false;
+  }
+  return true;
+}
+
+void TFRecordIndex::WriteSidecar(const std::string &file_path, uint64_t mtime) const {
+  // Write to a file of our own and rename it, so processes indexing the same file never see a partial sidecar
+  std::string sidecar = file_path + kSuffix;
+  std::string temp_file = sidecar + "." + Services::GetUniqueID();
+  {
+    std::ofstream out(temp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.good()) {
+      MS_LOG(INFO) << "Failed to create index file " << sidecar << ", the tfrecord file will be indexed again.";
+      return;
+    }
+    WriteWord(&out, kTFRecordIndexMagic);
+    WriteWord(&out, kTFRecordIndexVersion);
+    WriteWord(&out, file_size_);
+    WriteWord(&out, mtime);
+    WriteWord(&out, offsets_.size());
+    WriteWord(&out, Checksum(file_size_, mtime, offsets_));
+    (void)out.write(reinterpret_cast<const char *>(offsets_.data()),
+                    static_cast<std::streamsize>(offsets_.size() * sizeof(uint64_t)));
+    if (!out.good()) {
+      out.close();
+      (void)remove(temp_file.c_str());
+      MS_LOG(INFO) << "Failed to write index file " << sidecar << ", the tfrecord file will be indexed again.";
+      return;
+    }
+  }
+  if (rename(temp_file.c_str(), sidecar.c_str()) != 0) {
+    (void)remove(temp_file.c_str());
+    MS_LOG(INFO) << "Failed to create index file " << sidecar << ", the tfrecord file will be indexed again.";
+  }
+}
+
+bool GetFileStat(const std::string &file_path, uint64_t *file_size, uint64_t *mtime) {
+  struct stat file_stat;
+  if (stat(file_path.c_str(), &file_stat) != 0) {
+    return false;
+  }
+  *file_size = static_cast<uint64_t>(file_stat.st_size);
+#if defined(__APPLE__)
+  const struct timespec &file_mtime = file_stat.st_mtimespec;
+#elif defined(_WIN32) || defined(_WIN64)
+  struct timespec file_mtime = {file_stat.st_mtime, 0};
+#else
+  const struct timespec &file_mtime = file_stat.st_mtim;
+#endif
+  *mtime = static_cast<uint64_t>(file_mtime.tv_sec) * 1000000000ULL + static_cast<uint64_t>(file_mtime.tv_nsec);
+  return true;
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    (void)munmap(const_cast<unsigned char *>(data_), static_cast<size_t>(size_));
+  }
+#endif
+}
+
+bool MappedFile::Map(const std::string &file_path, bool sequential) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    void *addr = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    if (addr != MAP_FAILED) {
+      (void)madvise(addr, static_cast<size_t>(file_stat.st_size), sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+      data_ = static_cast<const unsigned char *>(addr);
+      size_ = static_cast<uint64_t>(file_stat.st_size);
+    }
+  }
+  (void)close(fd);
+  return data_ != nullptr;
+#else
+  return false;
+#endif
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_INDEX_H_
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The offsets of the records of a TFRecord file. A record is framed as
+//   uint64 length | uint32 masked crc of length | data[length] | uint32 masked crc of data
+// Building the index only reads the frame headers. The index of a large file is cached in a sidecar file next to
+// it, so later runs find any record of it without scanning the file. The sidecar file holds the size and the
+// modification time of the file and a checksum of its own contents, and is only used if all of them match and the
+// last indexed frame still ends the file.
+class TFRecordIndex {
+ public:
+  // Files with fewer records than this are cheap to index again, so they get no sidecar file
+  static constexpr int64_t kMinRecordsToCache = 1024;
+
+  // Only read a sidecar file, never write one
+  static constexpr int64_t kNoCache = std::numeric_limits<int64_t>::max();
+
+  // Suffix of the sidecar file of a TFRecord file
+  static constexpr char kSuffix[] = ".msidx";
+
+  // Load the index of a file from its sidecar file, or build it if the sidecar file is missing or stale.
+  // @param file_path the real path of the TFRecord file.
+  // @param out the index.
+  // @param min_records_to_cache write a sidecar file if the file has at least this many records, kNoCache for
+  //     callers that must not write next to the dataset.
+  // @return Status
+  static Status Load(const std::string &file_path, std::shared_ptr<TFRecordIndex> *out,
+                     int64_t min_records_to_cache = kMinRecordsToCache);
+
+  TFRecordIndex() : file_size_(0) {}
+
+  ~TFRecordIndex() = default;
+
+  int64_t NumRecords() const { return static_cast<int64_t>(offsets_.size()); }
+
+  uint64_t file_size() const { return file_size_; }
+
+  // @return the offset of the data of a record in the file.
+  uint64_t DataOffset(int64_t record) const { return offsets_[record] + kHeaderSize; }
+
+  // @return the length of the data of a record.
+  uint64_t DataLength(int64_t record) const {
+    uint64_t end = record + 1 < NumRecords() ? offsets_[record + 1] : file_size_;
+    return end - offsets_[record] - kHeaderSize - kFooterSize;
+  }
+
+ private:
+  static constexpr uint64_t kHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+  static constexpr uint64_t kFooterSize = sizeof(uint32_t);
+
+  // Read the frame headers of a file
+  Status Build(const std::string &file_path);
+
+  // Read the sidecar file, false if it is missing or does not match the file
+  bool ReadSidecar(const std::string &file_path, uint64_t file_size, uint64_t mtime);
+
+  // Write the sidecar file, a failure only costs building the index again next time
+  void WriteSidecar(const std::string &file_path, uint64_t mtime) const;
+
+  uint64_t file_size_;
+  std::vector<uint64_t> offsets_;  // offset of the frame of each record
+};
+
+// A read only memory mapping of a whole file. Records are parsed where they lie in the page cache, without being
+// copied into a buffer first.
+class MappedFile {
+ public:
+  MappedFile() : data_(nullptr), size_(0) {}
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // Map a file.
+  // @param file_path the real path of the file.
+  // @param sequential whether the file is read from start to end, or at random places.
+  // @return false if the file can not be mapped, e.g. on a platform without mmap, the caller reads it instead.
+  bool Map(const std::string &file_path, bool sequential = true);
+
+  const unsigned char *data() const { return data_; }
+
+  uint64_t size() const { return size_; }
+
+ private:
+  const unsigned char *data_;
+  uint64_t size_;
+};
+
+// Get the size and the modification time in nanoseconds of a file, a rewrite within the same second changes the latter.
+// @return false if the file can not be found.
+bool GetFileStat(const std::string &file_path, uint64_t *file_size, uint64_t *mtime);
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TF_RECORD_INDEX_H_
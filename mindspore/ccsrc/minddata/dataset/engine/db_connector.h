@@ -82,7 +82,7 @@ class DbConnector : public Connector<TensorRow> {
         if (result->eof()) {
           end_of_file_ = true;
         }
-        pop_from_ = (pop_from_ + 1) % num_producers_;
+        AdvancePopFrom();
       }
       // Do not increment expect_consumer_ when result is eoe and retry_if_eoe is set.
       if (!(result->eoe() && retry_if_eoe)) {
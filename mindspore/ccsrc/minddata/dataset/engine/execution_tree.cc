@@ -21,6 +21,7 @@
 #include "minddata/dataset/engine/datasetops/device_queue_op.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
 #include "minddata/dataset/util/numa_interface.h"
 #endif
@@ -185,6 +186,12 @@ Status ExecutionTree::Launch() {
     RETURN_IF_NOT_OK(profiling_manager_->LaunchMonitor());
   }
 
+  // AutoTune adjusts the workers and connectors of the ops while they are running
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    autotune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune Thread launched", std::ref(*autotune_)));
+  }
+
   std::ostringstream ss;
   ss << *this;
   MS_LOG(DEBUG) << "Printing the tree before launch tasks:\n" << ss.str();
@@ -36,6 +36,7 @@ namespace dataset {
 class TaskGroup;
 class DatasetOp;
 class Pass;
+class AutoTune;
 using OptPass = std::vector<std::unique_ptr<Pass>>;
 class ExecutionTree {
  public:
@@ -207,6 +208,7 @@ class ExecutionTree {
   uint32_t prepare_flags_;                               // Flags used during tree prepare
   TreeState tree_state_;                                 // Tracking the current tree state
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::unique_ptr<AutoTune> autotune_;                   // Tunes the pipeline while it is running
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
   // This rank_id is for numa and device_queue, one process work with only one rank_id,
   // for standalone scenario, this rank_id may come from env 'CUDA_VISIBLE_DEVICES',
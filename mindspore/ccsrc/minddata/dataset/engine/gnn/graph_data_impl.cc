@@ -41,12 +41,17 @@ GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool
 GraphDataImpl::~GraphDataImpl() {}
 
 Status GraphDataImpl::GetAllNodes(NodeType node_type, std::shared_ptr<Tensor> *out) {
-  auto itr = node_type_map_.find(node_type);
-  if (itr == node_type_map_.end()) {
+  int32_t begin = 0;
+  int32_t end = 0;
+  if (!graph_storage_->GetNodeRange(node_type, &begin, &end)) {
     std::string err_msg = "Invalid node type:" + std::to_string(node_type);
     RETURN_STATUS_UNEXPECTED(err_msg);
   } else {
-    RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({itr->second}, DataType(DataType::DE_INT32), out));
+    std::vector<NodeIdType> nodes(end - begin);
+    for (int32_t i = begin; i < end; ++i) {
+      nodes[i - begin] = graph_storage_->NodeId(i);
+    }
+    RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({nodes}, DataType(DataType::DE_INT32), out));
   }
   return Status::OK();
 }
@@ -96,12 +101,17 @@ Status GraphDataImpl::ComplementVector(std::vector<std::vector<T>> *data, size_t
 }
 
 Status GraphDataImpl::GetAllEdges(EdgeType edge_type, std::shared_ptr<Tensor> *out) {
-  auto itr = edge_type_map_.find(edge_type);
-  if (itr == edge_type_map_.end()) {
+  int32_t begin = 0;
+  int32_t end = 0;
+  if (!graph_storage_->GetEdgeRange(edge_type, &begin, &end)) {
     std::string err_msg = "Invalid edge type:" + std::to_string(edge_type);
     RETURN_STATUS_UNEXPECTED(err_msg);
   } else {
-    RETURN_IF_NOT_OK(CreateTensorByVector<EdgeIdType>({itr->second}, DataType(DataType::DE_INT32), out));
+    std::vector<EdgeIdType> edges(end - begin);
+    for (int32_t i = begin; i < end; ++i) {
+      edges[i - begin] = graph_storage_->EdgeId(i);
+    }
+    RETURN_IF_NOT_OK(CreateTensorByVector<EdgeIdType>({edges}, DataType(DataType::DE_INT32), out));
   }
   return Status::OK();
 }
@@ -114,15 +124,10 @@ Status GraphDataImpl::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
   for (const auto &edge_id : edge_list) {
-    auto itr = edge_id_map_.find(edge_id);
-    if (itr == edge_id_map_.end()) {
-      std::string err_msg = "Invalid edge id:" + std::to_string(edge_id);
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    } else {
-      std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> nodes;
-      RETURN_IF_NOT_OK(itr->second->GetNode(&nodes));
-      node_list.push_back({nodes.first->id(), nodes.second->id()});
-    }
+    int32_t edge = 0;
+    RETURN_IF_NOT_OK(GetEdgeIndex(edge_id, &edge));
+    node_list.push_back({graph_storage_->NodeId(graph_storage_->EdgeSrc(edge)),
+                         graph_storage_->NodeId(graph_storage_->EdgeDst(edge))});
   }
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(node_list, DataType(DataType::DE_INT32), out));
   return Status::OK();
@@ -138,11 +143,10 @@ Status GraphDataImpl::GetEdgesFromNodes(const std::vector<std::pair<NodeIdType,
   edge_list.reserve(node_list.size());
 
   for (const auto &node_id : node_list) {
-    std::shared_ptr<Node> src_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_id.first, &src_node));
+    int32_t src_node = 0;
+    RETURN_IF_NOT_OK(GetNodeIndex(node_id.first, &src_node));
 
-    EdgeIdType edge_id;
-    src_node->GetEdgeByAdjNodeId(node_id.second, &edge_id);
+    EdgeIdType edge_id = graph_storage_->FindEdgeBetween(src_node, node_id.second);
 
     std::vector<EdgeIdType> connection_edge = {edge_id};
     edge_list.emplace_back(std::move(connection_edge));
@@ -166,16 +170,14 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   // Collect information of adjacent table
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
     if (format == OutputFormat::kNormal) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+      RETURN_IF_NOT_OK(GetNeighbors(node_list[i], neighbor_type, &neighbors[i]));
       max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
     } else if (format == OutputFormat::kCoo) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
     } else {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
       if (i < node_list.size() - 1) {
         offset_table[i + 1] = total_edge_num;
@@ -219,9 +221,7 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
 }
 
 Status GraphDataImpl::CheckSamplesNum(NodeIdType samples_num) {
-  NodeIdType all_nodes_number =
-    std::accumulate(node_type_map_.begin(), node_type_map_.end(), 0,
-                    [](NodeIdType t1, const auto &t2) -> NodeIdType { return t1 + t2.second.size(); });
+  NodeIdType all_nodes_number = static_cast<NodeIdType>(graph_storage_->NumNodes());
   if ((samples_num < 1) || (samples_num > all_nodes_number)) {
     std::string err_msg = "Wrong samples number, should be between 1 and " + std::to_string(all_nodes_number) +
                           ", got " + std::to_string(samples_num);
@@ -231,7 +231,9 @@ Status GraphDataImpl::CheckSamplesNum(NodeIdType samples_num) {
 }
 
 Status GraphDataImpl::CheckNeighborType(NodeType neighbor_type) {
-  if (node_type_map_.find(neighbor_type) == node_type_map_.end()) {
+  int32_t begin = 0;
+  int32_t end = 0;
+  if (!graph_storage_->GetNodeRange(neighbor_type, &begin, &end)) {
     std::string err_msg = "Invalid neighbor type:" + std::to_string(neighbor_type);
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
@@ -253,8 +255,8 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   }
   std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
+    int32_t input_node = 0;
+    RETURN_IF_NOT_OK(GetNodeIndex(node_list[node_idx], &input_node));
     neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
     std::vector<NodeIdType> input_list = {node_list[node_idx]};
     for (size_t i = 0; i < neighbor_nums.size(); ++i) {
@@ -266,11 +268,10 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
             neighbors.emplace_back(kDefaultNodeId);
           }
         } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], strategy, &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
+          int32_t node = 0;
+          RETURN_IF_NOT_OK(GetNodeIndex(node_id, &node));
+          RETURN_IF_NOT_OK(
+            graph_storage_->SampleNeighbors(node, neighbor_types[i], neighbor_nums[i], strategy, &rnd_, &neighbors));
         }
       }
       neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
@@ -281,7 +282,7 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   return Status::OK();
 }
 
-Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
+Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> &shuffled_ids,
                                      size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
                                      int32_t samples_num, std::vector<NodeIdType> *out_samples) {
   CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
@@ -306,7 +307,13 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   RETURN_IF_NOT_OK(CheckSamplesNum(samples_num));
   RETURN_IF_NOT_OK(CheckNeighborType(neg_neighbor_type));
 
-  const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
+  int32_t begin = 0;
+  int32_t end = 0;
+  (void)graph_storage_->GetNodeRange(neg_neighbor_type, &begin, &end);
+  std::vector<NodeIdType> all_nodes(end - begin);
+  for (int32_t i = begin; i < end; ++i) {
+    all_nodes[i - begin] = graph_storage_->NodeId(i);
+  }
   std::vector<NodeIdType> shuffled_id(all_nodes.size());
   std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
   std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
@@ -316,15 +323,13 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
   neg_neighbors_vec.resize(node_list.size());
   for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
     std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
+    RETURN_IF_NOT_OK(GetNeighbors(node_list[node_idx], neg_neighbor_type, &neighbors));
     std::unordered_set<NodeIdType> exclude_nodes;
     std::transform(neighbors.begin(), neighbors.end(),
                    std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
                    [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
+    neg_neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
     if (all_nodes.size() > exclude_nodes.size()) {
       while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
         RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
@@ -335,7 +340,7 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
         }
       }
     } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
+      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_list[node_idx]
                     << " neg_neighbor_type:" << neg_neighbor_type;
       // If there are no negative neighbors, they are filled with kDefaultNodeId
       for (int32_t i = 0; i < samples_num; ++i) {
@@ -405,17 +410,22 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
 
     dsize_t index = 0;
     for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
+      const GraphStorage::FeatureMatrix *matrix = nullptr;
+      int32_t node = 0;
+      int64_t row = 0;
+      if (*node_itr != kDefaultNodeId && graph_storage_->FindNode(*node_itr, &node)) {
+        matrix = graph_storage_->FindNodeFeature(node, f_type, &row);
+      }
+      if (matrix == nullptr || matrix->row_bytes == 0) {
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, default_feature->Value()));
       } else {
-        std::shared_ptr<Node> node;
-
-        if (!GetNodeByNodeId(*node_itr, &node).IsOk() || !node->GetFeatures(f_type, &feature).IsOk()) {
-          feature = default_feature;
-        }
+        uchar *start_addr_of_index = nullptr;
+        TensorShape remaining({-1});
+        RETURN_IF_NOT_OK(fea_tensor->StartAddrOfIndex({index}, &start_addr_of_index, &remaining));
+        CHECK_FAIL_RETURN_UNEXPECTED(
+          memcpy_s(start_addr_of_index, matrix->row_bytes, matrix->Row(row), matrix->row_bytes) == EOK,
+          "Failed to copy the feature of node:" + std::to_string(*node_itr));
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
       index++;
     }
 
@@ -448,20 +458,21 @@ Status GraphDataImpl::GetNodeFeatureSharedMemory(const std::shared_ptr<Tensor> &
       *out_fea_itr = -1;
       ++out_fea_itr;
     } else {
-      std::shared_ptr<Node> node;
-      RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
-      std::shared_ptr<Feature> feature;
-      if (!node->GetFeatures(type, &feature).IsOk()) {
+      int32_t node = 0;
+      RETURN_IF_NOT_OK(GetNodeIndex(*node_itr, &node));
+      int64_t row = 0;
+      const GraphStorage::FeatureMatrix *matrix = graph_storage_->FindNodeFeature(node, type, &row);
+      if (matrix == nullptr || matrix->shared_memory_offset < 0) {
         *out_fea_itr = -1;
         ++out_fea_itr;
         *out_fea_itr = -1;
         ++out_fea_itr;
       } else {
-        for (auto fea_itr = feature->Value()->begin<int64_t>(); fea_itr != feature->Value()->end<int64_t>();
-             ++fea_itr) {
-          *out_fea_itr = *fea_itr;
-          ++out_fea_itr;
-        }
+        // The offset and the size of the row of the node in the shared memory
+        *out_fea_itr = matrix->shared_memory_offset + row * matrix->row_bytes;
+        ++out_fea_itr;
+        *out_fea_itr = matrix->row_bytes;
+        ++out_fea_itr;
       }
     }
   }
@@ -493,13 +504,22 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
 
     dsize_t index = 0;
     for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
-      std::shared_ptr<Edge> edge;
-      std::shared_ptr<Feature> feature;
-
-      if (!GetEdgeByEdgeId(*edge_itr, &edge).IsOk() || !edge->GetFeatures(f_type, &feature).IsOk()) {
-        feature = default_feature;
+      const GraphStorage::FeatureMatrix *matrix = nullptr;
+      int32_t edge = 0;
+      int64_t row = 0;
+      if (graph_storage_->FindEdge(*edge_itr, &edge)) {
+        matrix = graph_storage_->FindEdgeFeature(edge, f_type, &row);
+      }
+      if (matrix == nullptr || matrix->row_bytes == 0) {
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, default_feature->Value()));
+      } else {
+        uchar *start_addr_of_index = nullptr;
+        TensorShape remaining({-1});
+        RETURN_IF_NOT_OK(fea_tensor->StartAddrOfIndex({index}, &start_addr_of_index, &remaining));
+        CHECK_FAIL_RETURN_UNEXPECTED(
+          memcpy_s(start_addr_of_index, matrix->row_bytes, matrix->Row(row), matrix->row_bytes) == EOK,
+          "Failed to copy the feature of edge:" + std::to_string(*edge_itr));
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
       index++;
     }
 
@@ -526,19 +546,21 @@ Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &
 
   auto out_fea_itr = fea_tensor->begin<int64_t>();
   for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
-    std::shared_ptr<Edge> edge;
-    RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
-    std::shared_ptr<Feature> feature;
-    if (!edge->GetFeatures(type, &feature).IsOk()) {
+    int32_t edge = 0;
+    RETURN_IF_NOT_OK(GetEdgeIndex(*edge_itr, &edge));
+    int64_t row = 0;
+    const GraphStorage::FeatureMatrix *matrix = graph_storage_->FindEdgeFeature(edge, type, &row);
+    if (matrix == nullptr || matrix->shared_memory_offset < 0) {
       *out_fea_itr = -1;
       ++out_fea_itr;
       *out_fea_itr = -1;
       ++out_fea_itr;
     } else {
-      for (auto fea_itr = feature->Value()->begin<int64_t>(); fea_itr != feature->Value()->end<int64_t>(); ++fea_itr) {
-        *out_fea_itr = *fea_itr;
-        ++out_fea_itr;
-      }
+      // The offset and the size of the row of the edge in the shared memory
+      *out_fea_itr = matrix->shared_memory_offset + row * matrix->row_bytes;
+      ++out_fea_itr;
+      *out_fea_itr = matrix->row_bytes;
+      ++out_fea_itr;
     }
   }
 
@@ -554,37 +576,33 @@ Status GraphDataImpl::Init() {
 }
 
 Status GraphDataImpl::GetMetaInfo(MetaInfo *meta_info) {
-  meta_info->node_type.resize(node_type_map_.size());
-  std::transform(node_type_map_.begin(), node_type_map_.end(), meta_info->node_type.begin(),
-                 [](auto itr) { return itr.first; });
-  std::sort(meta_info->node_type.begin(), meta_info->node_type.end());
+  // The types are kept in ascending order by the graph storage
+  meta_info->node_type = graph_storage_->NodeTypes();
+  meta_info->edge_type = graph_storage_->EdgeTypes();
 
-  meta_info->edge_type.resize(edge_type_map_.size());
-  std::transform(edge_type_map_.begin(), edge_type_map_.end(), meta_info->edge_type.begin(),
-                 [](auto itr) { return itr.first; });
-  std::sort(meta_info->edge_type.begin(), meta_info->edge_type.end());
-
-  for (const auto &node : node_type_map_) {
-    meta_info->node_num[node.first] = node.second.size();
+  for (const auto &node_type : meta_info->node_type) {
+    int32_t begin = 0;
+    int32_t end = 0;
+    (void)graph_storage_->GetNodeRange(node_type, &begin, &end);
+    meta_info->node_num[node_type] = end - begin;
   }
 
-  for (const auto &edge : edge_type_map_) {
-    meta_info->edge_num[edge.first] = edge.second.size();
+  for (const auto &edge_type : meta_info->edge_type) {
+    int32_t begin = 0;
+    int32_t end = 0;
+    (void)graph_storage_->GetEdgeRange(edge_type, &begin, &end);
+    meta_info->edge_num[edge_type] = end - begin;
   }
 
-  for (const auto &node_feature : node_feature_map_) {
-    for (auto type : node_feature.second) {
-      meta_info->node_feature_type.emplace_back(type);
-    }
+  for (const auto &node_feature : graph_storage_->node_features()) {
+    meta_info->node_feature_type.emplace_back(node_feature.feature_type);
   }
   std::sort(meta_info->node_feature_type.begin(), meta_info->node_feature_type.end());
   auto unique_node = std::unique(meta_info->node_feature_type.begin(), meta_info->node_feature_type.end());
   meta_info->node_feature_type.erase(unique_node, meta_info->node_feature_type.end());
 
-  for (const auto &edge_feature : edge_feature_map_) {
-    for (const auto &type : edge_feature.second) {
-      meta_info->edge_feature_type.emplace_back(type);
-    }
+  for (const auto &edge_feature : graph_storage_->edge_features()) {
+    meta_info->edge_feature_type.emplace_back(edge_feature.feature_type);
   }
   std::sort(meta_info->edge_feature_type.begin(), meta_info->edge_feature_type.end());
   auto unique_edge = std::unique(meta_info->edge_feature_type.begin(), meta_info->edge_feature_type.end());
@@ -615,28 +633,35 @@ Status GraphDataImpl::LoadNodeAndEdge() {
   return Status::OK();
 }
 
-Status GraphDataImpl::GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node) {
-  auto itr = node_id_map_.find(id);
-  if (itr == node_id_map_.end()) {
+Status GraphDataImpl::GetNodeIndex(NodeIdType id, int32_t *index) {
+  if (!graph_storage_->FindNode(id, index)) {
     std::string err_msg = "Invalid node id:" + std::to_string(id);
     RETURN_STATUS_UNEXPECTED(err_msg);
-  } else {
-    *node = itr->second;
   }
   return Status::OK();
 }
 
-Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge) {
-  auto itr = edge_id_map_.find(id);
-  if (itr == edge_id_map_.end()) {
+Status GraphDataImpl::GetEdgeIndex(EdgeIdType id, int32_t *index) {
+  if (!graph_storage_->FindEdge(id, index)) {
     std::string err_msg = "Invalid edge id:" + std::to_string(id);
     RETURN_STATUS_UNEXPECTED(err_msg);
-  } else {
-    *edge = itr->second;
   }
   return Status::OK();
 }
 
+Status GraphDataImpl::GetNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out,
+                                   bool exclude_itself) {
+  int32_t node = 0;
+  RETURN_IF_NOT_OK(GetNodeIndex(id, &node));
+  std::vector<NodeIdType> neighbors;
+  if (!exclude_itself) {
+    neighbors.emplace_back(id);
+  }
+  graph_storage_->GetNeighbors(node, neighbor_type, EdgeDirection::kOut, &neighbors);
+  *out = std::move(neighbors);
+  return Status::OK();
+}
+
 GraphDataImpl::RandomWalkBase::RandomWalkBase(GraphDataImpl *graph)
     : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
 
@@ -688,12 +713,10 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
   while (walk.size() - 1 < meta_path_.size()) {
     // current nodE
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
 
     // current neighbors
     std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
+    RETURN_IF_NOT_OK(graph_->GetNeighbors(cur_node_id, meta_path_[walk.size() - 1], &cur_neighbors, true));
     std::sort(cur_neighbors.begin(), cur_neighbors.end());
 
     // break if no neighbors
@@ -735,10 +758,8 @@ Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeI
 Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
                                                          std::shared_ptr<StochasticIndex> *node_probability) {
   // Generate alias nodes
-  std::shared_ptr<Node> node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(node_id, &node));
   std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighbors(node_id, node_type, &neighbors, true));
   std::sort(neighbors.begin(), neighbors.end());
   auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
   *node_probability =
@@ -750,15 +771,12 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
                                                          uint32_t meta_path_index,
                                                          std::shared_ptr<StochasticIndex> *edge_probability) {
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(src, &src_node));
   std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighbors(src, meta_path_[meta_path_index], &src_neighbors, true));
+  std::sort(src_neighbors.begin(), src_neighbors.end());
 
-  std::shared_ptr<Node> dst_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(dst, &dst_node));
   std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNeighbors(dst, meta_path_[meta_path_index + 1], &dst_neighbors, true));
 
   std::sort(dst_neighbors.begin(), dst_neighbors.end());
   std::vector<float> non_normalized_probability;
@@ -767,8 +785,7 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
       non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
       continue;
     }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    if (std::binary_search(src_neighbors.begin(), src_neighbors.end(), dst_nbr)) {
       // stay close, this node connect both src and dst
       non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
     } else {
@@ -811,8 +828,8 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
 }
 
 uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
   auto random_device = GetRandomDevice();
@@ -29,6 +29,7 @@
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
 #endif
+#include "minddata/dataset/engine/gnn/graph_storage.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
 
 namespace mindspore {
@@ -243,17 +244,25 @@ class GraphDataImpl : public GraphData {
   // @return Status The status code returned
   Status GetEdgeDefaultFeature(FeatureType feature_type, std::shared_ptr<Feature> *out_feature);
 
-  // Find node object using node id
+  // Find the index of a node in the graph storage using node id
   // @param NodeIdType id -
-  // @param std::shared_ptr<Node> *node - Returned node object
+  // @param int32_t *index - Returned index of the node
   // @return Status The status code returned
-  Status GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node);
+  Status GetNodeIndex(NodeIdType id, int32_t *index);
 
-  // Find edge object using edge id
+  // Find the index of an edge in the graph storage using edge id
   // @param EdgeIdType id -
-  // @param std::shared_ptr<Node> *edge - Returned edge object
+  // @param int32_t *index - Returned index of the edge
   // @return Status The status code returned
-  Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
+  Status GetEdgeIndex(EdgeIdType id, int32_t *index);
+
+  // Get the neighbors of one type of a node, in the order their edges are read
+  // @param NodeIdType id - id of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param std::vector<NodeIdType> *out - Returned neighbors
+  // @param bool exclude_itself - the node itself comes first unless it is excluded
+  // @return Status The status code returned
+  Status GetNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out, bool exclude_itself = false);
 
   // Negative sampling
   // @param std::vector<NodeIdType> &input_data - The data set to be sampled
@@ -261,7 +270,7 @@ class GraphDataImpl : public GraphData {
   // @param int32_t samples_num -
   // @param std::vector<NodeIdType> *out_samples - Sampling results returned
   // @return Status The status code returned
-  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
+  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> &shuffled_ids,
                         size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
                         std::vector<NodeIdType> *out_samples);
 
@@ -278,14 +287,7 @@ class GraphDataImpl : public GraphData {
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
 #endif
-  std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
-  std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
-
-  std::unordered_map<EdgeType, std::vector<EdgeIdType>> edge_type_map_;
-  std::unordered_map<EdgeIdType, std::shared_ptr<Edge>> edge_id_map_;
-
-  std::unordered_map<NodeType, std::unordered_set<FeatureType>> node_feature_map_;
-  std::unordered_map<EdgeType, std::unordered_set<FeatureType>> edge_feature_map_;
+  std::unique_ptr<GraphStorage> graph_storage_;
 
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_node_feature_map_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> default_edge_feature_map_;
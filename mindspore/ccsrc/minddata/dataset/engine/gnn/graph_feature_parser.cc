@@ -48,32 +48,6 @@ Status GraphFeatureParser::LoadFeatureTensor(const std::string &key, const std::
   return Status::OK();
 }
 
-#if !defined(_WIN32) && !defined(_WIN64)
-Status GraphFeatureParser::LoadFeatureToSharedMemory(const std::string &key, const std::vector<uint8_t> &col_blob,
-                                                     GraphSharedMemory *shared_memory,
-                                                     std::shared_ptr<Tensor> *out_tensor) {
-  const unsigned char *data = nullptr;
-  std::unique_ptr<unsigned char[]> data_ptr;
-  uint64_t n_bytes = 0, col_type_size = 1;
-  mindrecord::ColumnDataType col_type = mindrecord::ColumnNoDataType;
-  std::vector<int64_t> column_shape;
-  MSRStatus rs = shard_column_->GetColumnValueByName(key, col_blob, {}, &data, &data_ptr, &n_bytes, &col_type,
-                                                     &col_type_size, &column_shape);
-  CHECK_FAIL_RETURN_UNEXPECTED(rs == mindrecord::SUCCESS, "fail to load column" + key);
-  if (data == nullptr) data = reinterpret_cast<const unsigned char *>(&data_ptr[0]);
-  std::shared_ptr<Tensor> tensor;
-  RETURN_IF_NOT_OK(Tensor::CreateEmpty(std::move(TensorShape({2})), std::move(DataType(DataType::DE_INT64)), &tensor));
-  auto fea_itr = tensor->begin<int64_t>();
-  int64_t offset = 0;
-  RETURN_IF_NOT_OK(shared_memory->InsertData(data, n_bytes, &offset));
-  *fea_itr = offset;
-  ++fea_itr;
-  *fea_itr = n_bytes;
-  *out_tensor = std::move(tensor);
-  return Status::OK();
-}
-#endif
-
 Status GraphFeatureParser::LoadFeatureIndex(const std::string &key, const std::vector<uint8_t> &col_blob,
                                             std::vector<int32_t> *indices) {
   const unsigned char *data = nullptr;
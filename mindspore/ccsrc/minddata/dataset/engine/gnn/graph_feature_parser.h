@@ -24,9 +24,6 @@
 
 #include "minddata/dataset/core/data_type.h"
 #include "minddata/dataset/core/tensor.h"
-#if !defined(_WIN32) && !defined(_WIN64)
-#include "minddata/dataset/engine/gnn/graph_shared_memory.h"
-#endif
 #include "minddata/dataset/engine/gnn/feature.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/mindrecord/include/shard_column.h"
@@ -54,10 +51,7 @@ class GraphFeatureParser {
   // @param std::shared_ptr<Tensor> *tensor - return value feature tensor
   // @return Status - the status code
   Status LoadFeatureTensor(const std::string &key, const std::vector<uint8_t> &blob, std::shared_ptr<Tensor> *tensor);
-#if !defined(_WIN32) && !defined(_WIN64)
-  Status LoadFeatureToSharedMemory(const std::string &key, const std::vector<uint8_t> &col_blob,
-                                   GraphSharedMemory *shared_memory, std::shared_ptr<Tensor> *out_tensor);
-#endif
+
  private:
   std::unique_ptr<ShardColumn> shard_column_;
 };
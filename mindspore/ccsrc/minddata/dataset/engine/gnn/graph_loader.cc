@@ -15,13 +15,12 @@
  */
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 
+#include <algorithm>
 #include <future>
 #include <tuple>
 #include <utility>
 
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
-#include "minddata/dataset/engine/gnn/local_edge.h"
-#include "minddata/dataset/engine/gnn/local_node.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/mindrecord/include/shard_error.h"
 
@@ -32,65 +31,68 @@ namespace gnn {
 
 using mindrecord::MSRStatus;
 
-GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int32_t num_workers, bool server_mode)
+GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int32_t num_workers, bool server_mode,
+                         int64_t min_rows_to_cache)
     : graph_impl_(graph_impl),
       mr_path_(mr_filepath),
       num_workers_(num_workers),
+      min_rows_to_cache_(min_rows_to_cache),
       row_id_(0),
       shard_reader_(nullptr),
       graph_feature_parser_(nullptr),
+      graph_storage_(nullptr),
+      graph_file_loaded_(false),
       required_key_(
         {"first_id", "second_id", "third_id", "attribute", "type", "node_feature_index", "edge_feature_index"}),
       optional_key_({{"weight", false}}) {}
 
 Status GraphLoader::GetNodesAndEdges() {
-  NodeIdMap *n_id_map = &graph_impl_->node_id_map_;
-  EdgeIdMap *e_id_map = &graph_impl_->edge_id_map_;
-  for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
-    while (dq.empty() == false) {
-      std::shared_ptr<Node> node_ptr = dq.front();
-      n_id_map->insert({node_ptr->id(), node_ptr});
-      graph_impl_->node_type_map_[node_ptr->type()].push_back(node_ptr->id());
-      dq.pop_front();
+  RETURN_UNEXPECTED_IF_NULL(graph_storage_);
+  if (!graph_file_loaded_) {
+    RETURN_IF_NOT_OK(graph_storage_->Build(&node_rows_, &edge_rows_));
+    auto files = mindrecord::GetDatasetFiles(
+      mr_path_, mindrecord::json(shard_reader_->GetShardHeader()->GetShardAddresses()));
+    CHECK_FAIL_RETURN_UNEXPECTED(files.first == MSRStatus::SUCCESS, "Fail to get the files of " + mr_path_);
+    RETURN_IF_NOT_OK(graph_storage_->SetSource(graph_impl_->data_schema_.dump(), files.second));
+    if (graph_storage_->NumNodes() + graph_storage_->NumEdges() >= min_rows_to_cache_) {
+      graph_storage_->Save(mr_path_ + GraphStorage::kSuffix);
     }
   }
 
-  for (std::deque<std::shared_ptr<Edge>> &dq : e_deques_) {
-    while (dq.empty() == false) {
-      std::shared_ptr<Edge> edge_ptr = dq.front();
-      std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> p;
-      RETURN_IF_NOT_OK(edge_ptr->GetNode(&p));
-      auto src_itr = n_id_map->find(p.first->id()), dst_itr = n_id_map->find(p.second->id());
-
-      CHECK_FAIL_RETURN_UNEXPECTED(src_itr != n_id_map->end(), "invalid src_id:" + std::to_string(src_itr->first));
-      CHECK_FAIL_RETURN_UNEXPECTED(dst_itr != n_id_map->end(), "invalid src_id:" + std::to_string(dst_itr->first));
-
-      RETURN_IF_NOT_OK(edge_ptr->SetNode({src_itr->second, dst_itr->second}));
-      RETURN_IF_NOT_OK(src_itr->second->AddNeighbor(dst_itr->second, edge_ptr->weight()));
-      RETURN_IF_NOT_OK(src_itr->second->AddAdjacent(dst_itr->second, edge_ptr));
-
-      e_id_map->insert({edge_ptr->id(), edge_ptr});  // add edge to edge_id_map_
-      graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
-      dq.pop_front();
-    }
+  if (graph_impl_->server_mode_) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    // The clients read the features from the shared memory, the rest of the graph stays in the server
+    graph_impl_->graph_shared_memory_ =
+      std::make_unique<GraphSharedMemory>(std::max(graph_storage_->FeatureBytes(), static_cast<int64_t>(1)), mr_path_);
+    RETURN_IF_NOT_OK(graph_impl_->graph_shared_memory_->CreateSharedMemory());
+    RETURN_IF_NOT_OK(graph_storage_->MoveFeaturesTo(graph_impl_->graph_shared_memory_.get()));
+#endif
   }
 
-  for (auto &itr : graph_impl_->node_type_map_) itr.second.shrink_to_fit();
-  for (auto &itr : graph_impl_->edge_type_map_) itr.second.shrink_to_fit();
-
-  MergeFeatureMaps();
+  RETURN_IF_NOT_OK(CreateDefaultFeatures());
+  graph_impl_->graph_storage_ = std::move(graph_storage_);
   return Status::OK();
 }
 
 Status GraphLoader::InitAndLoad() {
   CHECK_FAIL_RETURN_UNEXPECTED(num_workers_ > 0, "num_reader can't be < 1\n");
-  CHECK_FAIL_RETURN_UNEXPECTED(row_id_ == 0, "InitAndLoad Can only be called once!\n");
-  n_deques_.resize(num_workers_);
-  e_deques_.resize(num_workers_);
-  n_feature_maps_.resize(num_workers_);
-  e_feature_maps_.resize(num_workers_);
-  default_node_feature_maps_.resize(num_workers_);
-  default_edge_feature_maps_.resize(num_workers_);
+  CHECK_FAIL_RETURN_UNEXPECTED(graph_storage_ == nullptr, "InitAndLoad Can only be called once!\n");
+
+  // A graph file saved by an earlier load of the same dataset files is mapped instead of reading them
+  std::string graph_file = mr_path_ + GraphStorage::kSuffix;
+  graph_storage_ = std::make_unique<GraphStorage>();
+  Status rc = graph_storage_->Load(graph_file);
+  if (rc.IsOk()) {
+    MS_LOG(INFO) << "Graph is loaded from graph file " << graph_file;
+    graph_impl_->data_schema_ = mindrecord::json::parse(graph_storage_->schema());
+    graph_file_loaded_ = true;
+    return Status::OK();
+  }
+  MS_LOG(INFO) << "Graph file is not loaded, load the graph from " << mr_path_ << ". " << rc.ToString();
+  graph_storage_ = std::make_unique<GraphStorage>();
+
+  node_rows_.resize(num_workers_);
+  edge_rows_.resize(num_workers_);
   TaskGroup vg;
 
   shard_reader_ = std::make_unique<ShardReader>();
@@ -113,16 +115,6 @@ Status GraphLoader::InitAndLoad() {
     }
   }
 
-  if (graph_impl_->server_mode_) {
-#if !defined(_WIN32) && !defined(_WIN64)
-    int64_t total_blob_size = 0;
-    CHECK_FAIL_RETURN_UNEXPECTED(shard_reader_->GetTotalBlobSize(&total_blob_size) == MSRStatus::SUCCESS,
-                                 "failed to get total blob size");
-    graph_impl_->graph_shared_memory_ = std::make_unique<GraphSharedMemory>(total_blob_size, mr_path_);
-    RETURN_IF_NOT_OK(graph_impl_->graph_shared_memory_->CreateSharedMemory());
-#endif
-  }
-
   graph_feature_parser_ = std::make_unique<GraphFeatureParser>(*shard_reader_->GetShardColumn());
 
   // launching worker threads
@@ -136,57 +128,26 @@ Status GraphLoader::InitAndLoad() {
 }
 
 Status GraphLoader::LoadNode(const std::vector<uint8_t> &col_blob, const mindrecord::json &col_jsn,
-                             std::shared_ptr<Node> *node, NodeFeatureMap *feature_map,
-                             DefaultNodeFeatureMap *default_feature) {
+                             GraphStorage::NodeRows *nodes) {
+  int32_t row = static_cast<int32_t>(nodes->ids.size());
   NodeIdType node_id = col_jsn["first_id"];
   NodeType node_type = static_cast<NodeType>(col_jsn["type"]);
-  WeightType weight = 1;
-  if (optional_key_["weight"]) {
-    weight = col_jsn["weight"];
-  }
-  (*node) = std::make_shared<LocalNode>(node_id, node_type, weight);
+  nodes->ids.push_back(node_id);
+  nodes->types.push_back(node_type);
   std::vector<int32_t> indices;
   RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureIndex("node_feature_index", col_blob, &indices));
-  if (graph_impl_->server_mode_) {
-#if !defined(_WIN32) && !defined(_WIN64)
-    for (int32_t ind : indices) {
-      std::shared_ptr<Tensor> tensor_sm;
-      RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureToSharedMemory(
-        "node_feature_" + std::to_string(ind), col_blob, graph_impl_->graph_shared_memory_.get(), &tensor_sm));
-      RETURN_IF_NOT_OK((*node)->UpdateFeature(std::make_shared<Feature>(ind, tensor_sm, true)));
-      (*feature_map)[node_type].insert(ind);
-      if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> tensor;
-        RETURN_IF_NOT_OK(
-          graph_feature_parser_->LoadFeatureTensor("node_feature_" + std::to_string(ind), col_blob, &tensor));
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
-      }
-    }
-#endif
-  } else {
-    for (int32_t ind : indices) {
-      std::shared_ptr<Tensor> tensor;
-      RETURN_IF_NOT_OK(
-        graph_feature_parser_->LoadFeatureTensor("node_feature_" + std::to_string(ind), col_blob, &tensor));
-      RETURN_IF_NOT_OK((*node)->UpdateFeature(std::make_shared<Feature>(ind, tensor)));
-      (*feature_map)[node_type].insert(ind);
-      if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
-      }
-    }
+  for (int32_t ind : indices) {
+    std::shared_ptr<Tensor> tensor;
+    RETURN_IF_NOT_OK(
+      graph_feature_parser_->LoadFeatureTensor("node_feature_" + std::to_string(ind), col_blob, &tensor));
+    RETURN_IF_NOT_OK(GraphStorage::AddFeature(row, ind, tensor, &nodes->features));
   }
   return Status::OK();
 }
 
 Status GraphLoader::LoadEdge(const std::vector<uint8_t> &col_blob, const mindrecord::json &col_jsn,
-                             std::shared_ptr<Edge> *edge, EdgeFeatureMap *feature_map,
-                             DefaultEdgeFeatureMap *default_feature) {
+                             GraphStorage::EdgeRows *edges) {
+  int32_t row = static_cast<int32_t>(edges->ids.size());
   EdgeIdType edge_id = col_jsn["first_id"];
   EdgeType edge_type = static_cast<EdgeType>(col_jsn["type"]);
   NodeIdType src_id = col_jsn["second_id"], dst_id = col_jsn["third_id"];
@@ -194,46 +155,19 @@ Status GraphLoader::LoadEdge(const std::vector<uint8_t> &col_blob, const mindrec
   if (optional_key_["weight"]) {
     edge_weight = col_jsn["weight"];
   }
-  std::shared_ptr<Node> src = std::make_shared<LocalNode>(src_id, -1, 1);
-  std::shared_ptr<Node> dst = std::make_shared<LocalNode>(dst_id, -1, 1);
-  (*edge) = std::make_shared<LocalEdge>(edge_id, edge_type, edge_weight, src, dst);
+  edges->ids.push_back(edge_id);
+  edges->types.push_back(edge_type);
+  edges->src_ids.push_back(src_id);
+  edges->dst_ids.push_back(dst_id);
+  edges->weights.push_back(edge_weight);
   std::vector<int32_t> indices;
   RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureIndex("edge_feature_index", col_blob, &indices));
-  if (graph_impl_->server_mode_) {
-#if !defined(_WIN32) && !defined(_WIN64)
-    for (int32_t ind : indices) {
-      std::shared_ptr<Tensor> tensor_sm;
-      RETURN_IF_NOT_OK(graph_feature_parser_->LoadFeatureToSharedMemory(
-        "edge_feature_" + std::to_string(ind), col_blob, graph_impl_->graph_shared_memory_.get(), &tensor_sm));
-      RETURN_IF_NOT_OK((*edge)->UpdateFeature(std::make_shared<Feature>(ind, tensor_sm, true)));
-      (*feature_map)[edge_type].insert(ind);
-      if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> tensor;
-        RETURN_IF_NOT_OK(
-          graph_feature_parser_->LoadFeatureTensor("edge_feature_" + std::to_string(ind), col_blob, &tensor));
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
-      }
-    }
-#endif
-  } else {
-    for (int32_t ind : indices) {
-      std::shared_ptr<Tensor> tensor;
-      RETURN_IF_NOT_OK(
-        graph_feature_parser_->LoadFeatureTensor("edge_feature_" + std::to_string(ind), col_blob, &tensor));
-      RETURN_IF_NOT_OK((*edge)->UpdateFeature(std::make_shared<Feature>(ind, tensor)));
-      (*feature_map)[edge_type].insert(ind);
-      if ((*default_feature)[ind] == nullptr) {
-        std::shared_ptr<Tensor> zero_tensor;
-        RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &zero_tensor));
-        RETURN_IF_NOT_OK(zero_tensor->Zero());
-        (*default_feature)[ind] = std::make_shared<Feature>(ind, zero_tensor);
-      }
-    }
+  for (int32_t ind : indices) {
+    std::shared_ptr<Tensor> tensor;
+    RETURN_IF_NOT_OK(
+      graph_feature_parser_->LoadFeatureTensor("edge_feature_" + std::to_string(ind), col_blob, &tensor));
+    RETURN_IF_NOT_OK(GraphStorage::AddFeature(row, ind, tensor, &edges->features));
   }
-
   return Status::OK();
 }
 
@@ -249,15 +183,9 @@ Status GraphLoader::WorkerEntry(int32_t worker_id) {
       mindrecord::json col_jsn = std::get<1>(tupled_row);
       std::string attr = col_jsn["attribute"];
       if (attr == "n") {
-        std::shared_ptr<Node> node_ptr;
-        RETURN_IF_NOT_OK(LoadNode(col_blob, col_jsn, &node_ptr, &(n_feature_maps_[worker_id]),
-                                  &default_node_feature_maps_[worker_id]));
-        n_deques_[worker_id].emplace_back(node_ptr);
+        RETURN_IF_NOT_OK(LoadNode(col_blob, col_jsn, &node_rows_[worker_id]));
       } else if (attr == "e") {
-        std::shared_ptr<Edge> edge_ptr;
-        RETURN_IF_NOT_OK(LoadEdge(col_blob, col_jsn, &edge_ptr, &(e_feature_maps_[worker_id]),
-                                  &default_edge_feature_maps_[worker_id]));
-        e_deques_[worker_id].emplace_back(edge_ptr);
+        RETURN_IF_NOT_OK(LoadEdge(col_blob, col_jsn, &edge_rows_[worker_id]));
       } else {
         MS_LOG(WARNING) << "attribute:" << attr << " is neither edge nor node.";
       }
@@ -268,23 +196,24 @@ Status GraphLoader::WorkerEntry(int32_t worker_id) {
   return Status::OK();
 }
 
-void GraphLoader::MergeFeatureMaps() {
-  for (int wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
-    for (auto &m : n_feature_maps_[wkr_id]) {
-      for (auto &n : m.second) graph_impl_->node_feature_map_[m.first].insert(n);
-    }
-    for (auto &m : e_feature_maps_[wkr_id]) {
-      for (auto &n : m.second) graph_impl_->edge_feature_map_[m.first].insert(n);
-    }
-    for (auto &m : default_node_feature_maps_[wkr_id]) {
-      graph_impl_->default_node_feature_map_[m.first] = m.second;
-    }
-    for (auto &m : default_edge_feature_maps_[wkr_id]) {
-      graph_impl_->default_edge_feature_map_[m.first] = m.second;
+Status GraphLoader::CreateDefaultFeatures() {
+  std::vector<std::pair<const std::vector<GraphStorage::FeatureMatrix> *,
+                        std::unordered_map<FeatureType, std::shared_ptr<Feature>> *>>
+    features = {{&graph_storage_->node_features(), &graph_impl_->default_node_feature_map_},
+                {&graph_storage_->edge_features(), &graph_impl_->default_edge_feature_map_}};
+  for (auto &feature : features) {
+    for (const auto &matrix : *feature.first) {
+      if ((*feature.second)[matrix.feature_type] != nullptr) {
+        continue;
+      }
+      std::shared_ptr<Tensor> zero_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(std::vector<dsize_t>(matrix.shape.begin(), matrix.shape.end())),
+                                           DataType(matrix.data_type), &zero_tensor));
+      RETURN_IF_NOT_OK(zero_tensor->Zero());
+      (*feature.second)[matrix.feature_type] = std::make_shared<Feature>(matrix.feature_type, zero_tensor);
     }
   }
-  n_feature_maps_.clear();
-  e_feature_maps_.clear();
+  return Status::OK();
 }
 
 }  // namespace gnn
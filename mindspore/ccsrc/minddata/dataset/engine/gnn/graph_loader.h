@@ -16,13 +16,10 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_LOADER_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_LOADER_H_
 
-#include <deque>
 #include <memory>
-#include <queue>
 #include <string>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 
 #include "minddata/dataset/core/data_type.h"
 #include "minddata/dataset/core/tensor.h"
@@ -32,6 +29,7 @@
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
 #endif
+#include "minddata/dataset/engine/gnn/graph_storage.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -41,32 +39,24 @@ namespace dataset {
 namespace gnn {
 
 using mindrecord::ShardReader;
-using NodeIdMap = std::unordered_map<NodeIdType, std::shared_ptr<Node>>;
-using EdgeIdMap = std::unordered_map<EdgeIdType, std::shared_ptr<Edge>>;
-using NodeTypeMap = std::unordered_map<NodeType, std::vector<NodeIdType>>;
-using EdgeTypeMap = std::unordered_map<EdgeType, std::vector<EdgeIdType>>;
-using NodeFeatureMap = std::unordered_map<NodeType, std::unordered_set<FeatureType>>;
-using EdgeFeatureMap = std::unordered_map<EdgeType, std::unordered_set<FeatureType>>;
-using DefaultNodeFeatureMap = std::unordered_map<FeatureType, std::shared_ptr<Feature>>;
-using DefaultEdgeFeatureMap = std::unordered_map<FeatureType, std::shared_ptr<Feature>>;
 
 // this class interfaces with the underlying storage format (mindrecord)
-// it returns raw nodes and edges via GetNodesAndEdges
-// it is then the responsibility of graph to construct itself based on the nodes and edges
+// it reads the raw nodes and edges, and builds the graph storage of graph_impl from them via GetNodesAndEdges
+// a large graph is saved to a graph file next to the mindrecord, which is mapped instead of read the next time
 // if needed, this class could become a base where each derived class handles a specific storage format
 class GraphLoader {
  public:
-  GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int32_t num_workers = 4, bool server_mode = false);
+  GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int32_t num_workers = 4, bool server_mode = false,
+              int64_t min_rows_to_cache = GraphStorage::kMinRowsToCache);
 
   ~GraphLoader() = default;
-  // Init mindrecord and load everything into memory multi-threaded
+  // Map the graph file, or init mindrecord and load everything into memory multi-threaded
   // @return Status - the status code
   Status InitAndLoad();
 
-  // this function will query mindrecord and construct all nodes and edges
-  // nodes and edges are added to map without any connection. That's because there nodes and edges are read in
-  // random order. src_node and dst_node in Edge are node_id only with -1 as type.
-  // features attached to each node and edge are expected to be filled correctly
+  // this function builds the graph storage from the nodes and edges read, and hands it to graph_impl
+  // nodes and edges are read in random order, so edges refer to their nodes by id until all nodes are read.
+  // the features of the nodes and edges of each type are gathered in one matrix per feature type
   Status GetNodesAndEdges();
 
  private:
@@ -76,40 +66,35 @@ class GraphLoader {
   // @return Status - the status code
   Status WorkerEntry(int32_t worker_id);
 
-  // Load a node based on 1 row of mindrecord, returns a shared_ptr<Node>
+  // Load a node based on 1 row of mindrecord
   // @param std::vector<uint8_t> &blob - contains data in blob field in mindrecord
   // @param mindrecord::json &jsn - contains raw data
-  // @param std::shared_ptr<Node> *node - return value
-  // @param NodeFeatureMap *feature_map -
-  // @param DefaultNodeFeatureMap *default_feature -
+  // @param GraphStorage::NodeRows *nodes - the node is appended to it
   // @return Status - the status code
-  Status LoadNode(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, std::shared_ptr<Node> *node,
-                  NodeFeatureMap *feature_map, DefaultNodeFeatureMap *default_feature);
+  Status LoadNode(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, GraphStorage::NodeRows *nodes);
 
+  // Load an edge based on 1 row of mindrecord
   // @param std::vector<uint8_t> &blob - contains data in blob field in mindrecord
   // @param mindrecord::json &jsn - contains raw data
-  // @param std::shared_ptr<Edge> *edge - return value, the edge ptr, edge is not yet connected
-  // @param FeatureMap *feature_map
-  // @param DefaultEdgeFeatureMap *default_feature -
+  // @param GraphStorage::EdgeRows *edges - the edge is appended to it, it refers to its nodes by id
   // @return Status - the status code
-  Status LoadEdge(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, std::shared_ptr<Edge> *edge,
-                  EdgeFeatureMap *feature_map, DefaultEdgeFeatureMap *default_feature);
+  Status LoadEdge(const std::vector<uint8_t> &blob, const mindrecord::json &jsn, GraphStorage::EdgeRows *edges);
 
-  // merge NodeFeatureMap and EdgeFeatureMap of each worker into 1
-  void MergeFeatureMaps();
+  // Create the zero features used for the nodes and edges without a feature
+  // @return Status - the status code
+  Status CreateDefaultFeatures();
 
   GraphDataImpl *graph_impl_;
   std::string mr_path_;
   const int32_t num_workers_;
+  const int64_t min_rows_to_cache_;
   std::atomic_int row_id_;
   std::unique_ptr<ShardReader> shard_reader_;
   std::unique_ptr<GraphFeatureParser> graph_feature_parser_;
-  std::vector<std::deque<std::shared_ptr<Node>>> n_deques_;
-  std::vector<std::deque<std::shared_ptr<Edge>>> e_deques_;
-  std::vector<NodeFeatureMap> n_feature_maps_;
-  std::vector<EdgeFeatureMap> e_feature_maps_;
-  std::vector<DefaultNodeFeatureMap> default_node_feature_maps_;
-  std::vector<DefaultEdgeFeatureMap> default_edge_feature_maps_;
+  std::unique_ptr<GraphStorage> graph_storage_;
+  bool graph_file_loaded_;
+  std::vector<GraphStorage::NodeRows> node_rows_;
+  std::vector<GraphStorage::EdgeRows> edge_rows_;
   const std::vector<std::string> required_key_;
   std::unordered_map<std::string, bool> optional_key_;
 };
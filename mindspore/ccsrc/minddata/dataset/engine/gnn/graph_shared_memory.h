@@ -54,6 +54,8 @@ class GraphSharedMemory {
 
   int64_t memory_size() { return memory_size_; }
 
+  uint8_t *memory_ptr() { return memory_ptr_; }
+
  private:
   Status SharedMemoryImpl(const int &shmflg);
 
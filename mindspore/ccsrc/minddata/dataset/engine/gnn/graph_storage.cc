@@ -0,0 +1,861 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_storage.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/services.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+const uint64_t kGraphFileMagic = 0x314850415247534DULL;  // "MSGRAPH1"
+const uint64_t kGraphFileVersion = 1;
+const uint64_t kGraphFileAlignment = 8;
+
+// Writes the arrays of a storage one after the other, each of them prefixed by its size and aligned to 8 bytes
+class GraphFileWriter {
+ public:
+  explicit GraphFileWriter(std::ofstream *out) : out_(out), offset_(0) {}
+
+  template <typename T>
+  Status Value(T *value) {
+    Write(value, sizeof(T));
+    return Status::OK();
+  }
+
+  Status Count(uint64_t *count) { return Value(count); }
+
+  template <typename T>
+  Status Array(GraphArray<T> *array) {
+    uint64_t size = array->size();
+    Write(&size, sizeof(size));
+    Write(array->data(), size * sizeof(T));
+    return Status::OK();
+  }
+
+  Status String(std::string *value) {
+    uint64_t size = value->size();
+    Write(&size, sizeof(size));
+    Write(value->data(), size);
+    return Status::OK();
+  }
+
+ private:
+  void Write(const void *data, uint64_t size) {
+    const char padding[kGraphFileAlignment] = {0};
+    if (size > 0) {
+      (void)out_->write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    }
+    offset_ += size;
+    uint64_t padding_size = (kGraphFileAlignment - offset_ % kGraphFileAlignment) % kGraphFileAlignment;
+    (void)out_->write(padding, static_cast<std::streamsize>(padding_size));
+    offset_ += padding_size;
+  }
+
+  std::ofstream *out_;
+  uint64_t offset_;
+};
+
+// Reads the arrays written by GraphFileWriter as views of the mapped file, nothing is copied
+class GraphFileReader {
+ public:
+  GraphFileReader(const uint8_t *data, uint64_t size) : data_(data), size_(size), offset_(0) {}
+
+  template <typename T>
+  Status Value(T *value) {
+    CHECK_FAIL_RETURN_UNEXPECTED(size_ - offset_ >= sizeof(T), "Invalid graph file, it is truncated.");
+    (void)memcpy(value, data_ + offset_, sizeof(T));
+    Skip(sizeof(T));
+    return Status::OK();
+  }
+
+  // A count of items of at least 8 bytes each, which must fit in the rest of the file
+  Status Count(uint64_t *count) {
+    RETURN_IF_NOT_OK(Value(count));
+    CHECK_FAIL_RETURN_UNEXPECTED(*count <= (size_ - offset_) / kGraphFileAlignment,
+                                 "Invalid graph file, it is truncated.");
+    return Status::OK();
+  }
+
+  template <typename T>
+  Status Array(GraphArray<T> *array) {
+    uint64_t size = 0;
+    RETURN_IF_NOT_OK(Value(&size));
+    CHECK_FAIL_RETURN_UNEXPECTED(size <= (size_ - offset_) / sizeof(T), "Invalid graph file, it is truncated.");
+    array->View(reinterpret_cast<const T *>(data_ + offset_), size);
+    Skip(size * sizeof(T));
+    return Status::OK();
+  }
+
+  Status String(std::string *value) {
+    uint64_t size = 0;
+    RETURN_IF_NOT_OK(Value(&size));
+    CHECK_FAIL_RETURN_UNEXPECTED(size <= size_ - offset_, "Invalid graph file, it is truncated.");
+    value->assign(reinterpret_cast<const char *>(data_ + offset_), size);
+    Skip(size);
+    return Status::OK();
+  }
+
+ private:
+  // The mapping starts on a page, so the aligned offsets keep every array aligned
+  void Skip(uint64_t size) {
+    offset_ += size;
+    offset_ = std::min(size_, (offset_ + kGraphFileAlignment - 1) / kGraphFileAlignment * kGraphFileAlignment);
+  }
+
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t offset_;
+};
+
+// The order of a stable sort by type, and the first position of each type
+template <typename T>
+void GroupByType(const std::vector<T> &row_types, std::vector<T> *types, std::vector<int64_t> *type_offsets,
+                 std::vector<int32_t> *order) {
+  std::map<T, int64_t> counts;
+  for (auto type : row_types) {
+    counts[type]++;
+  }
+  std::map<T, int64_t> next;
+  int64_t offset = 0;
+  for (const auto &count : counts) {
+    types->push_back(count.first);
+    type_offsets->push_back(offset);
+    next[count.first] = offset;
+    offset += count.second;
+  }
+  type_offsets->push_back(offset);
+  order->resize(row_types.size());
+  for (size_t i = 0; i < row_types.size(); ++i) {
+    (*order)[next[row_types[i]]++] = static_cast<int32_t>(i);
+  }
+}
+
+// Ids in ascending order and the index of each of them, the first index of an id comes first
+template <typename T>
+void BuildLookup(const std::vector<T> &ids, GraphArray<T> *lookup_ids, GraphArray<int32_t> *lookup_index) {
+  std::vector<int32_t> index(ids.size());
+  std::iota(index.begin(), index.end(), 0);
+  std::stable_sort(index.begin(), index.end(), [&ids](int32_t a, int32_t b) { return ids[a] < ids[b]; });
+  std::vector<T> sorted_ids(ids.size());
+  for (size_t i = 0; i < index.size(); ++i) {
+    sorted_ids[i] = ids[index[i]];
+  }
+  lookup_ids->Assign(std::move(sorted_ids));
+  lookup_index->Assign(std::move(index));
+}
+
+template <typename T>
+bool Lookup(const GraphArray<T> &lookup_ids, const GraphArray<int32_t> &lookup_index, T id, int32_t *index) {
+  auto itr = std::lower_bound(lookup_ids.begin(), lookup_ids.end(), id);
+  if (itr == lookup_ids.end() || *itr != id) {
+    return false;
+  }
+  *index = lookup_index[itr - lookup_ids.begin()];
+  return true;
+}
+
+template <typename T>
+bool FindRange(const GraphArray<T> &types, const GraphArray<int64_t> &type_offsets, T type, int32_t *begin,
+               int32_t *end) {
+  auto itr = std::lower_bound(types.begin(), types.end(), type);
+  if (itr == types.end() || *itr != type) {
+    return false;
+  }
+  *begin = static_cast<int32_t>(type_offsets[itr - types.begin()]);
+  *end = static_cast<int32_t>(type_offsets[itr - types.begin() + 1]);
+  return true;
+}
+
+template <typename T>
+T TypeOf(const GraphArray<T> &types, const GraphArray<int64_t> &type_offsets, int32_t index) {
+  auto itr = std::upper_bound(type_offsets.begin(), type_offsets.end(), static_cast<int64_t>(index));
+  return types[itr - type_offsets.begin() - 1];
+}
+
+// Vose's alias method. Each slot holds the probability mass 1 / size, split between its own entry and an alias.
+// Slots keep their own entry if the weights are equal or all zero.
+void BuildAliasTable(const std::vector<double> &weights, double sum, float *alias_prob, int32_t *alias_index) {
+  size_t size = weights.size();
+  std::fill(alias_prob, alias_prob + size, 1.0);
+  std::iota(alias_index, alias_index + size, 0);
+  if (sum <= 0.0 || std::all_of(weights.begin(), weights.end(), [&weights](double w) { return w == weights[0]; })) {
+    return;
+  }
+  std::vector<double> scaled(size);
+  std::vector<int32_t> smaller;
+  std::vector<int32_t> larger;
+  for (size_t i = 0; i < size; ++i) {
+    scaled[i] = weights[i] * size / sum;
+    scaled[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
+  }
+  while (!smaller.empty() && !larger.empty()) {
+    int32_t small = smaller.back();
+    smaller.pop_back();
+    int32_t large = larger.back();
+    alias_prob[small] = static_cast<float>(scaled[small]);
+    alias_index[small] = large;
+    scaled[large] -= 1.0 - scaled[small];
+    if (scaled[large] < 1.0) {
+      larger.pop_back();
+      smaller.push_back(large);
+    }
+  }
+}
+}  // namespace
+
+constexpr char GraphStorage::kSuffix[];
+constexpr int64_t GraphStorage::kMinRowsToCache;
+
+Status GraphStorage::AddFeature(int32_t row, FeatureType type, const std::shared_ptr<Tensor> &tensor,
+                                FeatureColumns *columns) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  FeatureColumn &column = (*columns)[type];
+  if (column.row_bytes < 0) {
+    CHECK_FAIL_RETURN_UNEXPECTED(tensor->type().IsNumeric(), "Feature " + std::to_string(type) + " is not numeric.");
+    column.type = tensor->type();
+    column.shape = tensor->shape().AsVector();
+    column.row_bytes = tensor->SizeInBytes();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(column.rows.empty() || column.rows.back() != row, "Feature already exists");
+  CHECK_FAIL_RETURN_UNEXPECTED(tensor->type() == column.type && tensor->SizeInBytes() == column.row_bytes,
+                               "The type or size of feature " + std::to_string(type) + " is not the same in each row.");
+  column.rows.push_back(row);
+  column.data.insert(column.data.end(), tensor->GetBuffer(), tensor->GetBuffer() + column.row_bytes);
+  return Status::OK();
+}
+
+Status GraphStorage::Build(std::vector<NodeRows> *nodes, std::vector<EdgeRows> *edges) {
+  RETURN_UNEXPECTED_IF_NULL(nodes);
+  RETURN_UNEXPECTED_IF_NULL(edges);
+  RETURN_IF_NOT_OK(BuildNodes(nodes));
+  RETURN_IF_NOT_OK(BuildEdges(edges));
+  RETURN_IF_NOT_OK(BuildAdjacency(EdgeDirection::kOut));
+  RETURN_IF_NOT_OK(BuildAdjacency(EdgeDirection::kIn));
+  return Status::OK();
+}
+
+Status GraphStorage::BuildNodes(std::vector<NodeRows> *nodes) {
+  std::vector<NodeIdType> ids;
+  std::vector<NodeType> types;
+  std::vector<int64_t> first_rows;
+  std::vector<FeatureColumns *> columns;
+  for (auto &worker_nodes : *nodes) {
+    first_rows.push_back(static_cast<int64_t>(ids.size()));
+    columns.push_back(&worker_nodes.features);
+    ids.insert(ids.end(), worker_nodes.ids.begin(), worker_nodes.ids.end());
+    types.insert(types.end(), worker_nodes.types.begin(), worker_nodes.types.end());
+    worker_nodes.ids = std::vector<NodeIdType>();
+    worker_nodes.types = std::vector<NodeType>();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(ids.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                               "The number of nodes is too large: " + std::to_string(ids.size()));
+
+  std::vector<NodeType> node_types;
+  std::vector<int64_t> type_offsets;
+  std::vector<int32_t> order;
+  GroupByType(types, &node_types, &type_offsets, &order);
+  std::vector<NodeIdType> node_ids(ids.size());
+  std::vector<int32_t> index(ids.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    node_ids[i] = ids[order[i]];
+    index[order[i]] = static_cast<int32_t>(i);
+  }
+  node_types_.Assign(std::move(node_types));
+  node_type_offsets_.Assign(std::move(type_offsets));
+  BuildLookup(node_ids, &node_lookup_ids_, &node_lookup_index_);
+  node_ids_.Assign(std::move(node_ids));
+  RETURN_IF_NOT_OK(BuildFeatures(columns, first_rows, index, node_types_, node_type_offsets_, &node_features_));
+  nodes->clear();
+  return Status::OK();
+}
+
+Status GraphStorage::BuildEdges(std::vector<EdgeRows> *edges) {
+  std::vector<EdgeIdType> ids;
+  std::vector<EdgeType> types;
+  std::vector<int32_t> src;
+  std::vector<int32_t> dst;
+  std::vector<WeightType> weights;
+  std::vector<int64_t> first_rows;
+  std::vector<FeatureColumns *> columns;
+  for (auto &worker_edges : *edges) {
+    first_rows.push_back(static_cast<int64_t>(ids.size()));
+    columns.push_back(&worker_edges.features);
+    ids.insert(ids.end(), worker_edges.ids.begin(), worker_edges.ids.end());
+    types.insert(types.end(), worker_edges.types.begin(), worker_edges.types.end());
+    weights.insert(weights.end(), worker_edges.weights.begin(), worker_edges.weights.end());
+    for (size_t i = 0; i < worker_edges.src_ids.size(); ++i) {
+      int32_t src_index = -1;
+      int32_t dst_index = -1;
+      CHECK_FAIL_RETURN_UNEXPECTED(FindNode(worker_edges.src_ids[i], &src_index),
+                                   "invalid src_id:" + std::to_string(worker_edges.src_ids[i]));
+      CHECK_FAIL_RETURN_UNEXPECTED(FindNode(worker_edges.dst_ids[i], &dst_index),
+                                   "invalid dst_id:" + std::to_string(worker_edges.dst_ids[i]));
+      src.push_back(src_index);
+      dst.push_back(dst_index);
+    }
+    worker_edges.ids = std::vector<EdgeIdType>();
+    worker_edges.types = std::vector<EdgeType>();
+    worker_edges.src_ids = std::vector<NodeIdType>();
+    worker_edges.dst_ids = std::vector<NodeIdType>();
+    worker_edges.weights = std::vector<WeightType>();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(ids.size() < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                               "The number of edges is too large: " + std::to_string(ids.size()));
+
+  std::vector<EdgeType> edge_types;
+  std::vector<int64_t> type_offsets;
+  std::vector<int32_t> order;
+  GroupByType(types, &edge_types, &type_offsets, &order);
+  std::vector<EdgeIdType> edge_ids(ids.size());
+  std::vector<int32_t> edge_src(ids.size());
+  std::vector<int32_t> edge_dst(ids.size());
+  std::vector<WeightType> edge_weights(ids.size());
+  std::vector<int32_t> index(ids.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    edge_ids[i] = ids[order[i]];
+    edge_src[i] = src[order[i]];
+    edge_dst[i] = dst[order[i]];
+    edge_weights[i] = weights[order[i]];
+    index[order[i]] = static_cast<int32_t>(i);
+  }
+  edge_types_.Assign(std::move(edge_types));
+  edge_type_offsets_.Assign(std::move(type_offsets));
+  BuildLookup(edge_ids, &edge_lookup_ids_, &edge_lookup_index_);
+  edge_ids_.Assign(std::move(edge_ids));
+  edge_src_.Assign(std::move(edge_src));
+  edge_dst_.Assign(std::move(edge_dst));
+  edge_weights_.Assign(std::move(edge_weights));
+  RETURN_IF_NOT_OK(BuildFeatures(columns, first_rows, index, edge_types_, edge_type_offsets_, &edge_features_));
+  edges->clear();
+  return Status::OK();
+}
+
+Status GraphStorage::BuildFeatures(const std::vector<FeatureColumns *> &columns, const std::vector<int64_t> &first_rows,
+                                   const std::vector<int32_t> &index, const GraphArray<int8_t> &types,
+                                   const GraphArray<int64_t> &type_offsets, std::vector<FeatureMatrix> *out) {
+  // The matrix of each owner type and feature type, and the row data of each of them
+  std::map<std::pair<int8_t, FeatureType>, std::vector<uint8_t>> matrix_data;
+  std::map<FeatureType, std::pair<DataType, int64_t>> feature_sizes;
+  std::map<FeatureType, std::vector<dsize_t>> feature_shapes;
+  for (size_t worker = 0; worker < columns.size(); ++worker) {
+    for (auto &feature : *columns[worker]) {
+      FeatureType feature_type = feature.first;
+      FeatureColumn &column = feature.second;
+      auto size_itr = feature_sizes.emplace(feature_type, std::make_pair(column.type, column.row_bytes)).first;
+      CHECK_FAIL_RETURN_UNEXPECTED(size_itr->second.first == column.type && size_itr->second.second == column.row_bytes,
+                                   "The type or size of feature " + std::to_string(feature_type) +
+                                     " is not the same in each row.");
+      (void)feature_shapes.emplace(feature_type, column.shape);
+      for (size_t i = 0; i < column.rows.size(); ++i) {
+        int32_t row_index = index[first_rows[worker] + column.rows[i]];
+        int8_t type = TypeOf(types, type_offsets, row_index);
+        int32_t begin = 0;
+        int32_t end = 0;
+        (void)FindRange(types, type_offsets, type, &begin, &end);
+        std::vector<uint8_t> &data = matrix_data[{type, feature_type}];
+        // A row without the feature keeps zeros
+        data.resize(static_cast<size_t>(end - begin) * column.row_bytes, 0);
+        if (column.row_bytes > 0) {
+          (void)memcpy(data.data() + static_cast<size_t>(row_index - begin) * column.row_bytes,
+                       column.data.data() + i * column.row_bytes, column.row_bytes);
+        }
+      }
+      column = FeatureColumn();
+    }
+  }
+  out->clear();
+  for (auto &matrix : matrix_data) {
+    const auto &size = feature_sizes[matrix.first.second];
+    int32_t begin = 0;
+    int32_t end = 0;
+    (void)FindRange(types, type_offsets, matrix.first.first, &begin, &end);
+    FeatureMatrix feature_matrix;
+    feature_matrix.owner_type = matrix.first.first;
+    feature_matrix.feature_type = matrix.first.second;
+    feature_matrix.data_type = size.first.value();
+    feature_matrix.shape.Assign(std::vector<dsize_t>(feature_shapes[matrix.first.second]));
+    feature_matrix.row_bytes = size.second;
+    feature_matrix.rows = end - begin;
+    feature_matrix.data.Assign(std::move(matrix.second));
+    out->push_back(std::move(feature_matrix));
+  }
+  return Status::OK();
+}
+
+Status GraphStorage::BuildAdjacency(EdgeDirection direction) {
+  const GraphArray<int32_t> &from = direction == EdgeDirection::kOut ? edge_src_ : edge_dst_;
+  const GraphArray<int32_t> &to = direction == EdgeDirection::kOut ? edge_dst_ : edge_src_;
+  // The edges of each block in the order they are stored, which is the order they are read within an edge type
+  std::map<std::pair<NodeType, EdgeType>, std::vector<int32_t>> block_edges;
+  for (size_t type_index = 0; type_index < edge_types_.size(); ++type_index) {
+    for (int64_t e = edge_type_offsets_[type_index]; e < edge_type_offsets_[type_index + 1]; ++e) {
+      block_edges[{NodeTypeOf(from[e]), edge_types_[type_index]}].push_back(static_cast<int32_t>(e));
+    }
+  }
+
+  std::vector<AdjacencyBlock> &blocks = adjacency_[static_cast<int>(direction)];
+  blocks.clear();
+  for (auto &block_itr : block_edges) {
+    const std::vector<int32_t> &block_edge_list = block_itr.second;
+    AdjacencyBlock block;
+    block.node_type = block_itr.first.first;
+    block.edge_type = block_itr.first.second;
+    int32_t row_begin = 0;
+    int32_t row_end = 0;
+    (void)GetNodeRange(block.node_type, &row_begin, &row_end);
+    std::vector<NodeType> neighbor_types;
+    for (auto e : block_edge_list) {
+      neighbor_types.push_back(NodeTypeOf(to[e]));
+    }
+    std::sort(neighbor_types.begin(), neighbor_types.end());
+    neighbor_types.erase(std::unique(neighbor_types.begin(), neighbor_types.end()), neighbor_types.end());
+    size_t k = neighbor_types.size();
+    auto segment_of = [&](int32_t e) {
+      size_t j = std::lower_bound(neighbor_types.begin(), neighbor_types.end(), NodeTypeOf(to[e])) -
+                 neighbor_types.begin();
+      return static_cast<size_t>(from[e] - row_begin) * k + j;
+    };
+
+    // Counting sort of the edges by segment, stable so a segment keeps the order the edges are read
+    size_t num_segments = static_cast<size_t>(row_end - row_begin) * k;
+    std::vector<int64_t> offsets(num_segments + 1, 0);
+    for (auto e : block_edge_list) {
+      offsets[segment_of(e) + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int64_t> next(offsets.begin(), offsets.end() - 1);
+    std::vector<int32_t> neighbors(block_edge_list.size());
+    std::vector<int32_t> entry_edges(block_edge_list.size());
+    for (auto e : block_edge_list) {
+      int64_t pos = next[segment_of(e)]++;
+      neighbors[pos] = to[e];
+      entry_edges[pos] = e;
+    }
+
+    std::vector<float> weight_sums(num_segments, 0.0);
+    std::vector<float> alias_prob(block_edge_list.size());
+    std::vector<int32_t> alias_index(block_edge_list.size());
+    bool weighted = false;
+    std::vector<double> weights;
+    for (size_t s = 0; s < num_segments; ++s) {
+      weights.clear();
+      double sum = 0.0;
+      for (int64_t pos = offsets[s]; pos < offsets[s + 1]; ++pos) {
+        double weight = std::max(edge_weights_[entry_edges[pos]], static_cast<WeightType>(0));
+        weights.push_back(weight);
+        sum += weight;
+      }
+      weight_sums[s] = static_cast<float>(sum);
+      BuildAliasTable(weights, sum, alias_prob.data() + offsets[s], alias_index.data() + offsets[s]);
+      weighted = weighted || std::any_of(alias_prob.begin() + offsets[s], alias_prob.begin() + offsets[s + 1],
+                                         [](float prob) { return prob < 1.0; });
+    }
+    block.neighbor_types.Assign(std::move(neighbor_types));
+    block.offsets.Assign(std::move(offsets));
+    block.neighbors.Assign(std::move(neighbors));
+    block.edges.Assign(std::move(entry_edges));
+    block.weight_sums.Assign(std::move(weight_sums));
+    if (weighted) {
+      block.alias_prob.Assign(std::move(alias_prob));
+      block.alias_index.Assign(std::move(alias_index));
+    }
+    blocks.push_back(std::move(block));
+  }
+  return Status::OK();
+}
+
+bool GraphStorage::GetNodeRange(NodeType type, int32_t *begin, int32_t *end) const {
+  return FindRange(node_types_, node_type_offsets_, type, begin, end);
+}
+
+bool GraphStorage::GetEdgeRange(EdgeType type, int32_t *begin, int32_t *end) const {
+  return FindRange(edge_types_, edge_type_offsets_, type, begin, end);
+}
+
+bool GraphStorage::FindNode(NodeIdType id, int32_t *index) const {
+  return Lookup(node_lookup_ids_, node_lookup_index_, id, index);
+}
+
+bool GraphStorage::FindEdge(EdgeIdType id, int32_t *index) const {
+  return Lookup(edge_lookup_ids_, edge_lookup_index_, id, index);
+}
+
+NodeType GraphStorage::NodeTypeOf(int32_t index) const { return TypeOf(node_types_, node_type_offsets_, index); }
+
+EdgeType GraphStorage::EdgeTypeOf(int32_t index) const { return TypeOf(edge_types_, edge_type_offsets_, index); }
+
+void GraphStorage::GetSegments(int32_t node, NodeType neighbor_type, EdgeDirection direction,
+                               std::vector<Segment> *out) const {
+  NodeType node_type = NodeTypeOf(node);
+  int32_t row_begin = 0;
+  int32_t row_end = 0;
+  (void)GetNodeRange(node_type, &row_begin, &row_end);
+  for (const auto &block : adjacency_[static_cast<int>(direction)]) {
+    if (block.node_type != node_type) {
+      continue;
+    }
+    auto type_itr = std::lower_bound(block.neighbor_types.begin(), block.neighbor_types.end(), neighbor_type);
+    if (type_itr == block.neighbor_types.end() || *type_itr != neighbor_type) {
+      continue;
+    }
+    size_t segment = static_cast<size_t>(node - row_begin) * block.neighbor_types.size() +
+                     (type_itr - block.neighbor_types.begin());
+    if (block.offsets[segment] < block.offsets[segment + 1]) {
+      out->push_back({&block, segment, block.offsets[segment], block.offsets[segment + 1]});
+    }
+  }
+}
+
+void GraphStorage::GetNeighbors(int32_t node, NodeType neighbor_type, EdgeDirection direction,
+                                std::vector<NodeIdType> *out) const {
+  std::vector<Segment> segments;
+  GetSegments(node, neighbor_type, direction, &segments);
+  for (const auto &segment : segments) {
+    for (int64_t pos = segment.begin; pos < segment.end; ++pos) {
+      out->push_back(node_ids_[segment.block->neighbors[pos]]);
+    }
+  }
+}
+
+Status GraphStorage::SampleNeighbors(int32_t node, NodeType neighbor_type, int32_t samples_num,
+                                     SamplingStrategy strategy, std::mt19937 *rnd,
+                                     std::vector<NodeIdType> *out) const {
+  std::vector<Segment> segments;
+  GetSegments(node, neighbor_type, EdgeDirection::kOut, &segments);
+  if (segments.empty()) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << node_ids_[node] << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    out->insert(out->end(), samples_num, kDefaultNodeId);
+    return Status::OK();
+  }
+  if (strategy == SamplingStrategy::kRandom) {
+    std::vector<NodeIdType> shuffled_id;
+    for (const auto &segment : segments) {
+      for (int64_t pos = segment.begin; pos < segment.end; ++pos) {
+        shuffled_id.push_back(node_ids_[segment.block->neighbors[pos]]);
+      }
+    }
+    // Shuffle only the first samples_num positions, the rest of the neighbors are never looked at
+    int32_t size = static_cast<int32_t>(shuffled_id.size());
+    int32_t remaining = samples_num;
+    while (remaining > 0) {
+      int32_t num = std::min(remaining, size);
+      for (int32_t i = 0; i < num; ++i) {
+        std::uniform_int_distribution<int32_t> distribution(i, size - 1);
+        std::swap(shuffled_id[i], shuffled_id[distribution(*rnd)]);
+        out->push_back(shuffled_id[i]);
+      }
+      remaining -= num;
+    }
+  } else if (strategy == SamplingStrategy::kEdgeWeight) {
+    // Take a segment by the sum of its weights, or by its size if there are no weights, then an entry of it
+    std::vector<double> segment_weights;
+    double total = 0.0;
+    for (const auto &segment : segments) {
+      segment_weights.push_back(segment.block->weight_sums[segment.segment]);
+      total += segment_weights.back();
+    }
+    if (total <= 0.0) {
+      std::transform(segments.begin(), segments.end(), segment_weights.begin(),
+                     [](const Segment &segment) { return static_cast<double>(segment.end - segment.begin); });
+      total = std::accumulate(segment_weights.begin(), segment_weights.end(), 0.0);
+    }
+    std::uniform_real_distribution<double> segment_distribution(0.0, total);
+    std::uniform_real_distribution<float> prob_distribution(0.0, 1.0);
+    for (int32_t i = 0; i < samples_num; ++i) {
+      size_t s = 0;
+      if (segments.size() > 1) {
+        double value = segment_distribution(*rnd);
+        while (s + 1 < segments.size() && value >= segment_weights[s]) {
+          value -= segment_weights[s];
+          ++s;
+        }
+      }
+      const Segment &segment = segments[s];
+      std::uniform_int_distribution<int64_t> slot_distribution(segment.begin, segment.end - 1);
+      int64_t slot = slot_distribution(*rnd);
+      const AdjacencyBlock *block = segment.block;
+      if (!block->alias_prob.empty() && prob_distribution(*rnd) >= block->alias_prob[slot]) {
+        slot = segment.begin + block->alias_index[slot];
+      }
+      out->push_back(node_ids_[block->neighbors[slot]]);
+    }
+  } else {
+    RETURN_STATUS_UNEXPECTED("Invalid strategy");
+  }
+  return Status::OK();
+}
+
+EdgeIdType GraphStorage::FindEdgeBetween(int32_t src, NodeIdType dst_id) const {
+  int32_t dst = -1;
+  if (FindNode(dst_id, &dst)) {
+    std::vector<Segment> segments;
+    GetSegments(src, NodeTypeOf(dst), EdgeDirection::kOut, &segments);
+    for (const auto &segment : segments) {
+      for (int64_t pos = segment.begin; pos < segment.end; ++pos) {
+        if (segment.block->neighbors[pos] == dst) {
+          return edge_ids_[segment.block->edges[pos]];
+        }
+      }
+    }
+  }
+  MS_LOG(WARNING) << "Number " << dst_id << " node is not adjacent to number " << node_ids_[src] << " node.";
+  return -1;
+}
+
+const GraphStorage::FeatureMatrix *GraphStorage::FindFeature(const std::vector<FeatureMatrix> &features,
+                                                             int8_t owner_type, FeatureType feature_type) {
+  for (const auto &matrix : features) {
+    if (matrix.owner_type == owner_type && matrix.feature_type == feature_type) {
+      return &matrix;
+    }
+  }
+  return nullptr;
+}
+
+const GraphStorage::FeatureMatrix *GraphStorage::FindNodeFeature(int32_t node, FeatureType feature_type,
+                                                                 int64_t *row) const {
+  NodeType type = NodeTypeOf(node);
+  int32_t begin = 0;
+  int32_t end = 0;
+  (void)GetNodeRange(type, &begin, &end);
+  *row = node - begin;
+  return GetNodeFeature(type, feature_type);
+}
+
+const GraphStorage::FeatureMatrix *GraphStorage::FindEdgeFeature(int32_t edge, FeatureType feature_type,
+                                                                 int64_t *row) const {
+  EdgeType type = EdgeTypeOf(edge);
+  int32_t begin = 0;
+  int32_t end = 0;
+  (void)GetEdgeRange(type, &begin, &end);
+  *row = edge - begin;
+  return GetEdgeFeature(type, feature_type);
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+int64_t GraphStorage::FeatureBytes() const {
+  int64_t size = 0;
+  for (const auto *features : {&node_features_, &edge_features_}) {
+    for (const auto &matrix : *features) {
+      size += static_cast<int64_t>(matrix.data.size());
+    }
+  }
+  return size;
+}
+
+Status GraphStorage::MoveFeaturesTo(GraphSharedMemory *shared_memory) {
+  RETURN_UNEXPECTED_IF_NULL(shared_memory);
+  for (auto *features : {&node_features_, &edge_features_}) {
+    for (auto &matrix : *features) {
+      if (matrix.data.empty()) {
+        continue;
+      }
+      int64_t offset = 0;
+      RETURN_IF_NOT_OK(shared_memory->InsertData(matrix.data.data(), matrix.data.size(), &offset));
+      matrix.shared_memory_offset = offset;
+      matrix.data.View(shared_memory->memory_ptr() + offset, matrix.data.size());
+    }
+  }
+  return Status::OK();
+}
+#endif
+
+Status GraphStorage::SetSource(const std::string &schema, const std::vector<std::string> &files) {
+  schema_ = schema;
+  sources_.clear();
+  for (const auto &file : files) {
+    SourceFile source{file, 0, 0};
+    CHECK_FAIL_RETURN_UNEXPECTED(GetFileStat(file, &source.size, &source.mtime), "Failed to find file: " + file);
+    sources_.push_back(source);
+  }
+  return Status::OK();
+}
+
+template <typename Archive>
+Status GraphStorage::Serialize(Archive *archive) {
+  RETURN_IF_NOT_OK(archive->String(&schema_));
+  uint64_t count = sources_.size();
+  RETURN_IF_NOT_OK(archive->Count(&count));
+  sources_.resize(count);
+  for (auto &source : sources_) {
+    RETURN_IF_NOT_OK(archive->String(&source.path));
+    RETURN_IF_NOT_OK(archive->Value(&source.size));
+    RETURN_IF_NOT_OK(archive->Value(&source.mtime));
+  }
+
+  RETURN_IF_NOT_OK(archive->Array(&node_types_));
+  RETURN_IF_NOT_OK(archive->Array(&node_type_offsets_));
+  RETURN_IF_NOT_OK(archive->Array(&node_ids_));
+  RETURN_IF_NOT_OK(archive->Array(&node_lookup_ids_));
+  RETURN_IF_NOT_OK(archive->Array(&node_lookup_index_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_types_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_type_offsets_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_ids_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_lookup_ids_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_lookup_index_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_src_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_dst_));
+  RETURN_IF_NOT_OK(archive->Array(&edge_weights_));
+
+  for (auto &blocks : adjacency_) {
+    count = blocks.size();
+    RETURN_IF_NOT_OK(archive->Count(&count));
+    blocks.resize(count);
+    for (auto &block : blocks) {
+      RETURN_IF_NOT_OK(archive->Value(&block.node_type));
+      RETURN_IF_NOT_OK(archive->Value(&block.edge_type));
+      RETURN_IF_NOT_OK(archive->Array(&block.neighbor_types));
+      RETURN_IF_NOT_OK(archive->Array(&block.offsets));
+      RETURN_IF_NOT_OK(archive->Array(&block.neighbors));
+      RETURN_IF_NOT_OK(archive->Array(&block.edges));
+      RETURN_IF_NOT_OK(archive->Array(&block.weight_sums));
+      RETURN_IF_NOT_OK(archive->Array(&block.alias_prob));
+      RETURN_IF_NOT_OK(archive->Array(&block.alias_index));
+    }
+  }
+
+  for (auto *features : {&node_features_, &edge_features_}) {
+    count = features->size();
+    RETURN_IF_NOT_OK(archive->Count(&count));
+    features->resize(count);
+    for (auto &matrix : *features) {
+      RETURN_IF_NOT_OK(archive->Value(&matrix.owner_type));
+      RETURN_IF_NOT_OK(archive->Value(&matrix.feature_type));
+      RETURN_IF_NOT_OK(archive->Value(&matrix.data_type));
+      RETURN_IF_NOT_OK(archive->Array(&matrix.shape));
+      RETURN_IF_NOT_OK(archive->Value(&matrix.row_bytes));
+      RETURN_IF_NOT_OK(archive->Value(&matrix.rows));
+      RETURN_IF_NOT_OK(archive->Array(&matrix.data));
+    }
+  }
+  return Status::OK();
+}
+
+void GraphStorage::Save(const std::string &file_path) {
+  // Write to a file of our own and rename it, so processes loading the same dataset never see a partial graph file
+  std::string temp_file = file_path + "." + Services::GetUniqueID();
+  {
+    std::ofstream out(temp_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.good()) {
+      MS_LOG(INFO) << "Failed to create graph file " << file_path << ", the dataset will be loaded again next time.";
+      return;
+    }
+    GraphFileWriter writer(&out);
+    uint64_t magic = kGraphFileMagic;
+    uint64_t version = kGraphFileVersion;
+    (void)writer.Value(&magic);
+    (void)writer.Value(&version);
+    Status rc = Serialize(&writer);
+    if (rc.IsError() || !out.good()) {
+      out.close();
+      (void)remove(temp_file.c_str());
+      MS_LOG(INFO) << "Failed to write graph file " << file_path << ", the dataset will be loaded again next time.";
+      return;
+    }
+  }
+  if (rename(temp_file.c_str(), file_path.c_str()) != 0) {
+    (void)remove(temp_file.c_str());
+    MS_LOG(INFO) << "Failed to create graph file " << file_path << ", the dataset will be loaded again next time.";
+  }
+}
+
+Status GraphStorage::Load(const std::string &file_path) {
+  auto file = std::make_unique<MappedFile>();
+  CHECK_FAIL_RETURN_UNEXPECTED(file->Map(file_path, false), "Failed to map graph file: " + file_path);
+  GraphFileReader reader(file->data(), file->size());
+  uint64_t magic = 0;
+  uint64_t version = 0;
+  RETURN_IF_NOT_OK(reader.Value(&magic));
+  RETURN_IF_NOT_OK(reader.Value(&version));
+  CHECK_FAIL_RETURN_UNEXPECTED(magic == kGraphFileMagic && version == kGraphFileVersion,
+                               "Invalid graph file, wrong magic number or version: " + file_path);
+  RETURN_IF_NOT_OK(Serialize(&reader));
+  for (const auto &source : sources_) {
+    uint64_t size = 0;
+    uint64_t mtime = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED(GetFileStat(source.path, &size, &mtime) && size == source.size &&
+                                   mtime == source.mtime,
+                                 "Graph file is stale, the dataset file has changed: " + source.path);
+  }
+
+  // The file is renamed into place once complete, so only the sizes of the arrays are checked, not every index
+  auto check_types = [](const auto &types, const GraphArray<int64_t> &type_offsets, size_t size) {
+    return type_offsets.size() == types.size() + 1 && type_offsets[0] == 0 &&
+           std::is_sorted(type_offsets.begin(), type_offsets.end()) &&
+           type_offsets[types.size()] == static_cast<int64_t>(size);
+  };
+  size_t num_nodes = node_ids_.size();
+  size_t num_edges = edge_ids_.size();
+  CHECK_FAIL_RETURN_UNEXPECTED(check_types(node_types_, node_type_offsets_, num_nodes) &&
+                                 node_lookup_ids_.size() == num_nodes && node_lookup_index_.size() == num_nodes &&
+                                 check_types(edge_types_, edge_type_offsets_, num_edges) &&
+                                 edge_lookup_ids_.size() == num_edges && edge_lookup_index_.size() == num_edges &&
+                                 edge_src_.size() == num_edges && edge_dst_.size() == num_edges &&
+                                 edge_weights_.size() == num_edges,
+                               "Invalid graph file, the sizes of the nodes and edges do not match: " + file_path);
+  for (const auto &blocks : adjacency_) {
+    for (const auto &block : blocks) {
+      int32_t begin = 0;
+      int32_t end = 0;
+      size_t num_segments = GetNodeRange(block.node_type, &begin, &end)
+                              ? static_cast<size_t>(end - begin) * block.neighbor_types.size()
+                              : 0;
+      size_t num_entries = block.neighbors.size();
+      CHECK_FAIL_RETURN_UNEXPECTED(
+        num_segments > 0 && block.offsets.size() == num_segments + 1 && block.offsets[0] == 0 &&
+          block.offsets[num_segments] == static_cast<int64_t>(num_entries) && block.edges.size() == num_entries &&
+          block.weight_sums.size() == num_segments &&
+          (block.alias_prob.empty() || block.alias_prob.size() == num_entries) &&
+          block.alias_index.size() == block.alias_prob.size(),
+        "Invalid graph file, the sizes of an adjacency block do not match: " + file_path);
+    }
+  }
+  auto check_features = [](const std::vector<FeatureMatrix> &features, const GraphArray<int8_t> &types,
+                           const GraphArray<int64_t> &type_offsets) {
+    return std::all_of(features.begin(), features.end(), [&types, &type_offsets](const FeatureMatrix &matrix) {
+      int32_t begin = 0;
+      int32_t end = 0;
+      return FindRange(types, type_offsets, matrix.owner_type, &begin, &end) && matrix.rows == end - begin &&
+             matrix.data_type > DataType::DE_UNKNOWN && matrix.data_type < DataType::DE_STRING &&
+             matrix.row_bytes >= 0 &&
+             std::accumulate(matrix.shape.begin(), matrix.shape.end(), static_cast<int64_t>(1),
+                             std::multiplies<int64_t>()) *
+                 DataType(matrix.data_type).SizeInBytes() ==
+               matrix.row_bytes &&
+             static_cast<uint64_t>(matrix.data.size()) ==
+               static_cast<uint64_t>(matrix.rows) * static_cast<uint64_t>(matrix.row_bytes);
+    });
+  };
+  CHECK_FAIL_RETURN_UNEXPECTED(check_features(node_features_, node_types_, node_type_offsets_) &&
+                                 check_features(edge_features_, edge_types_, edge_type_offsets_),
+                               "Invalid graph file, the size of a feature does not match: " + file_path);
+  file_ = std::move(file);
+  return Status::OK();
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
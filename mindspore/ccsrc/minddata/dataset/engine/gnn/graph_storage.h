@@ -0,0 +1,361 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_STORAGE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_STORAGE_H_
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_index.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include "minddata/dataset/engine/gnn/graph_shared_memory.h"
+#endif
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// A read only array of the graph storage. It either holds its values or views them in a memory mapped graph file.
+template <typename T>
+class GraphArray {
+ public:
+  GraphArray() : data_(nullptr), size_(0) {}
+
+  ~GraphArray() = default;
+
+  // Moving a vector keeps its buffer, so the view stays valid
+  GraphArray(GraphArray &&) = default;
+
+  GraphArray &operator=(GraphArray &&) = default;
+
+  GraphArray(const GraphArray &) = delete;
+
+  GraphArray &operator=(const GraphArray &) = delete;
+
+  void Assign(std::vector<T> &&values) {
+    values_ = std::move(values);
+    data_ = values_.data();
+    size_ = values_.size();
+  }
+
+  void View(const T *data, size_t size) {
+    values_ = std::vector<T>();
+    data_ = data;
+    size_ = size;
+  }
+
+  const T *data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  const T &operator[](size_t i) const { return data_[i]; }
+
+  const T *begin() const { return data_; }
+
+  const T *end() const { return data_ + size_; }
+
+ private:
+  std::vector<T> values_;
+  const T *data_;
+  size_t size_;
+};
+
+enum class EdgeDirection { kOut = 0, kIn = 1 };
+
+// The nodes, edges and features of a graph in flat arrays, instead of an object per node and per edge.
+// Nodes and edges are grouped by type and keep the order they are read in within a type. They are referred to by
+// their index in these arrays, ids are looked up by binary search.
+// The edges of one type leaving the nodes of one type are kept in CSR form, the edges entering them in CSC form.
+// The features of the nodes of one type are kept in one matrix per feature type, a row per node. A node without
+// the feature has a row of zeros, the same as the default feature.
+// The arrays can be saved to a graph file next to the dataset and memory mapped again, so a large graph loads
+// without reading the dataset and its pages are shared by the processes using it.
+class GraphStorage {
+ public:
+  // Suffix of the graph file of a dataset
+  static constexpr char kSuffix[] = ".graph";
+
+  // Graphs with fewer nodes and edges than this are cheap to load again, so they get no graph file
+  static constexpr int64_t kMinRowsToCache = 1 << 16;
+
+  // The features of one type of the rows read by a loader worker
+  struct FeatureColumn {
+    DataType type;
+    std::vector<dsize_t> shape;  // shape of the feature of the first row
+    int64_t row_bytes = -1;
+    std::vector<int32_t> rows;  // the row of each feature
+    std::vector<uint8_t> data;
+  };
+  using FeatureColumns = std::map<FeatureType, FeatureColumn>;
+
+  // The nodes read by a loader worker, in the order they are read
+  struct NodeRows {
+    std::vector<NodeIdType> ids;
+    std::vector<NodeType> types;
+    FeatureColumns features;
+  };
+
+  // The edges read by a loader worker, in the order they are read
+  struct EdgeRows {
+    std::vector<EdgeIdType> ids;
+    std::vector<EdgeType> types;
+    std::vector<NodeIdType> src_ids;
+    std::vector<NodeIdType> dst_ids;
+    std::vector<WeightType> weights;
+    FeatureColumns features;
+  };
+
+  // The features of one type of the nodes or edges of one type, a row per node or edge
+  struct FeatureMatrix {
+    int8_t owner_type;  // node or edge type
+    FeatureType feature_type;
+    DataType::Type data_type;
+    GraphArray<dsize_t> shape;  // shape of the feature of a row
+    int64_t row_bytes;
+    int64_t rows;
+    int64_t shared_memory_offset = -1;  // offset of the matrix in the shared memory in server mode
+    GraphArray<uint8_t> data;
+
+    const uint8_t *Row(int64_t row) const { return data.data() + row * row_bytes; }
+  };
+
+  GraphStorage() = default;
+
+  ~GraphStorage() = default;
+
+  // Add the feature of a row read by a loader worker
+  // @param int32_t row - the row in the worker
+  // @param FeatureType type - type of feature
+  // @param std::shared_ptr<Tensor> &tensor - the feature
+  // @param FeatureColumns *columns - the features of the worker
+  // @return Status The status code returned
+  static Status AddFeature(int32_t row, FeatureType type, const std::shared_ptr<Tensor> &tensor,
+                           FeatureColumns *columns);
+
+  // Build the storage from the rows read by the loader workers, the rows are released as they are used
+  // @param std::vector<NodeRows> *nodes - nodes read by each worker
+  // @param std::vector<EdgeRows> *edges - edges read by each worker
+  // @return Status The status code returned
+  Status Build(std::vector<NodeRows> *nodes, std::vector<EdgeRows> *edges);
+
+  // Record the schema and the files of the dataset, a graph file is only loaded again if the files are unchanged
+  // @param std::string &schema - schema of the dataset
+  // @param std::vector<std::string> &files - the files of the dataset
+  // @return Status The status code returned
+  Status SetSource(const std::string &schema, const std::vector<std::string> &files);
+
+  // Write the graph file, a failure only costs loading the dataset again next time
+  // @param std::string &file_path - path of the graph file
+  void Save(const std::string &file_path);
+
+  // Map a graph file
+  // @param std::string &file_path - path of the graph file
+  // @return Status The status code returned, an error if the file is missing, stale or corrupt, after which the
+  //     storage is not usable
+  Status Load(const std::string &file_path);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  // @return int64_t - the size of all the feature matrices
+  int64_t FeatureBytes() const;
+
+  // Move the feature matrices to shared memory, where the clients read them
+  // @param GraphSharedMemory *shared_memory - shared memory of at least FeatureBytes()
+  // @return Status The status code returned
+  Status MoveFeaturesTo(GraphSharedMemory *shared_memory);
+#endif
+
+  const std::string &schema() const { return schema_; }
+
+  std::vector<NodeType> NodeTypes() const { return {node_types_.begin(), node_types_.end()}; }
+
+  std::vector<EdgeType> EdgeTypes() const { return {edge_types_.begin(), edge_types_.end()}; }
+
+  int64_t NumNodes() const { return static_cast<int64_t>(node_ids_.size()); }
+
+  int64_t NumEdges() const { return static_cast<int64_t>(edge_ids_.size()); }
+
+  // @return bool - false if there is no node of the type
+  bool GetNodeRange(NodeType type, int32_t *begin, int32_t *end) const;
+
+  // @return bool - false if there is no edge of the type
+  bool GetEdgeRange(EdgeType type, int32_t *begin, int32_t *end) const;
+
+  // @return bool - false if there is no node of the id
+  bool FindNode(NodeIdType id, int32_t *index) const;
+
+  // @return bool - false if there is no edge of the id
+  bool FindEdge(EdgeIdType id, int32_t *index) const;
+
+  NodeIdType NodeId(int32_t index) const { return node_ids_[index]; }
+
+  EdgeIdType EdgeId(int32_t index) const { return edge_ids_[index]; }
+
+  NodeType NodeTypeOf(int32_t index) const;
+
+  EdgeType EdgeTypeOf(int32_t index) const;
+
+  int32_t EdgeSrc(int32_t index) const { return edge_src_[index]; }
+
+  int32_t EdgeDst(int32_t index) const { return edge_dst_[index]; }
+
+  // Get the ids of the neighbors of one type of a node, in the order their edges are read
+  // @param int32_t node - index of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param EdgeDirection direction - neighbors at the end of the edges leaving the node, or at the start of the
+  //     edges entering it
+  // @param std::vector<NodeIdType> *out - the neighbors are appended to it
+  void GetNeighbors(int32_t node, NodeType neighbor_type, EdgeDirection direction,
+                    std::vector<NodeIdType> *out) const;
+
+  // Sample the neighbors of one type of a node, filled with kDefaultNodeId if it has none
+  // @param int32_t node - index of the node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param SamplingStrategy strategy - Sampling strategy
+  // @param std::mt19937 *rnd - random generator
+  // @param std::vector<NodeIdType> *out - the neighbors are appended to it
+  // @return Status The status code returned
+  Status SampleNeighbors(int32_t node, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                         std::mt19937 *rnd, std::vector<NodeIdType> *out) const;
+
+  // @return EdgeIdType - the first edge read from a node to another, -1 if there is none
+  EdgeIdType FindEdgeBetween(int32_t src, NodeIdType dst_id) const;
+
+  // @return FeatureMatrix - the features of one type of the nodes of one type, nullptr if none of them has it
+  const FeatureMatrix *GetNodeFeature(NodeType node_type, FeatureType feature_type) const {
+    return FindFeature(node_features_, node_type, feature_type);
+  }
+
+  // @return FeatureMatrix - the features of one type of the edges of one type, nullptr if none of them has it
+  const FeatureMatrix *GetEdgeFeature(EdgeType edge_type, FeatureType feature_type) const {
+    return FindFeature(edge_features_, edge_type, feature_type);
+  }
+
+  // @param int32_t node - index of the node
+  // @param FeatureType feature_type - type of feature
+  // @param int64_t *row - the row of the node in the matrix
+  // @return FeatureMatrix - the features of one type of the nodes of the type of the node, nullptr if none
+  const FeatureMatrix *FindNodeFeature(int32_t node, FeatureType feature_type, int64_t *row) const;
+
+  // @param int32_t edge - index of the edge
+  // @param FeatureType feature_type - type of feature
+  // @param int64_t *row - the row of the edge in the matrix
+  // @return FeatureMatrix - the features of one type of the edges of the type of the edge, nullptr if none
+  const FeatureMatrix *FindEdgeFeature(int32_t edge, FeatureType feature_type, int64_t *row) const;
+
+  const std::vector<FeatureMatrix> &node_features() const { return node_features_; }
+
+  const std::vector<FeatureMatrix> &edge_features() const { return edge_features_; }
+
+ private:
+  // The edges of one type leaving (CSR) or entering (CSC) the nodes of one type. The edges of a node are split in
+  // segments by the type of the node at the other end, segment j of the row of a node holds the entries from
+  // offsets[row * neighbor_types.size() + j] on. The alias table of a segment lets a weighted sample take two
+  // random numbers whatever the number of its edges, there is none if the weights of all the segments are equal.
+  struct AdjacencyBlock {
+    NodeType node_type;
+    EdgeType edge_type;
+    GraphArray<NodeType> neighbor_types;
+    GraphArray<int64_t> offsets;
+    GraphArray<int32_t> neighbors;    // index of the node at the other end
+    GraphArray<int32_t> edges;        // index of the edge
+    GraphArray<float> weight_sums;    // sum of the weights of each segment
+    GraphArray<float> alias_prob;     // probability of taking the entry of a slot rather than its alias
+    GraphArray<int32_t> alias_index;  // the alias of a slot, in its segment
+  };
+
+  // An entry range of an adjacency block
+  struct Segment {
+    const AdjacencyBlock *block;
+    size_t segment;
+    int64_t begin;
+    int64_t end;
+  };
+
+  // The stamp of a file of the dataset
+  struct SourceFile {
+    std::string path;
+    uint64_t size;
+    uint64_t mtime;
+  };
+
+  static const FeatureMatrix *FindFeature(const std::vector<FeatureMatrix> &features, int8_t owner_type,
+                                          FeatureType feature_type);
+
+  // Collect the segments of the neighbors of one type of a node
+  void GetSegments(int32_t node, NodeType neighbor_type, EdgeDirection direction, std::vector<Segment> *out) const;
+
+  Status BuildNodes(std::vector<NodeRows> *nodes);
+
+  Status BuildEdges(std::vector<EdgeRows> *edges);
+
+  Status BuildAdjacency(EdgeDirection direction);
+
+  // Turn the features read by the workers into a matrix per owner type and feature type
+  // @param std::vector<FeatureColumns *> &columns - the features of each worker
+  // @param std::vector<int64_t> &first_rows - the first row of each worker
+  // @param std::vector<int32_t> &index - the index of each row, in the order they are read
+  // @param GraphArray<int8_t> &types - the owner types
+  // @param GraphArray<int64_t> &type_offsets - the first index of each owner type
+  // @param std::vector<FeatureMatrix> *out - the matrices
+  // @return Status The status code returned
+  static Status BuildFeatures(const std::vector<FeatureColumns *> &columns, const std::vector<int64_t> &first_rows,
+                              const std::vector<int32_t> &index, const GraphArray<int8_t> &types,
+                              const GraphArray<int64_t> &type_offsets, std::vector<FeatureMatrix> *out);
+
+  // Write or read every array of the storage, in the same order
+  template <typename Archive>
+  Status Serialize(Archive *archive);
+
+  std::string schema_;
+  std::vector<SourceFile> sources_;
+  std::unique_ptr<MappedFile> file_;
+
+  GraphArray<NodeType> node_types_;
+  GraphArray<int64_t> node_type_offsets_;  // first index of each node type, and the number of nodes
+  GraphArray<NodeIdType> node_ids_;
+  GraphArray<NodeIdType> node_lookup_ids_;  // node ids in ascending order
+  GraphArray<int32_t> node_lookup_index_;   // index of each of them
+
+  GraphArray<EdgeType> edge_types_;
+  GraphArray<int64_t> edge_type_offsets_;
+  GraphArray<EdgeIdType> edge_ids_;
+  GraphArray<EdgeIdType> edge_lookup_ids_;
+  GraphArray<int32_t> edge_lookup_index_;
+  GraphArray<int32_t> edge_src_;  // index of the source node
+  GraphArray<int32_t> edge_dst_;  // index of the destination node
+  GraphArray<WeightType> edge_weights_;
+
+  std::vector<AdjacencyBlock> adjacency_[2];  // by EdgeDirection
+  std::vector<FeatureMatrix> node_features_;
+  std::vector<FeatureMatrix> edge_features_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_STORAGE_H_
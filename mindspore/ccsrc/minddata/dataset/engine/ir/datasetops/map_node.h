@@ -87,6 +87,11 @@ class MapNode : public DatasetNode {
   const std::vector<std::string> &OutputColumns() const { return output_columns_; }
   const std::vector<std::string> &ProjectColumns() const { return project_columns_; }
   const std::vector<std::shared_ptr<DSCallback>> &Callbacks() const { return callbacks_; }
+  bool RunOnBatch() const { return run_on_batch_; }
+
+  /// \brief Setter to make the tensor operations run on batches of rows, used by BatchMapFusionPass
+  /// \param[in] run_on_batch true if the rows from the child are batches of rows
+  void SetRunOnBatch(bool run_on_batch) { run_on_batch_ = run_on_batch; }
 
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
@@ -108,6 +113,7 @@ class MapNode : public DatasetNode {
   std::vector<std::string> output_columns_;
   std::vector<std::string> project_columns_;
   std::vector<std::shared_ptr<DSCallback>> callbacks_;
+  bool run_on_batch_;
 };
 
 }  // namespace dataset
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "minddata/dataset/engine/opt/optional/batch_map_fusion_pass.h"
+
+#include "minddata/dataset/engine/ir/datasetops/batch_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Number of trailing tensor operations of the MapNode that give the same rows when run on a whole batch
+size_t NumBatchComputableOps(const std::shared_ptr<MapNode> &node) {
+  // the MapNode must keep the columns of the rows as they are, since the batch is built from them
+  if (node->RunOnBatch() || node->IsCached() || !node->Callbacks().empty() || !node->ProjectColumns().empty() ||
+      (!node->OutputColumns().empty() && node->OutputColumns() != node->InputColumns())) {
+    return 0;
+  }
+  const auto &operations = node->TensorOperations();
+  size_t num_ops = 0;
+  for (auto itr = operations.rbegin(); itr != operations.rend(); ++itr) {
+    std::shared_ptr<TensorOp> tensor_op = (*itr)->Build();
+    if (tensor_op == nullptr || !tensor_op->OneToOne() || !tensor_op->Deterministic() ||
+        !tensor_op->IsBatchComputable()) {
+      break;
+    }
+    num_ops++;
+  }
+  return num_ops;
+}
+}  // namespace
+
+Status BatchMapFusionPass::Visit(std::shared_ptr<BatchNode> node, bool *const modified) {
+#ifdef ENABLE_PYTHON
+  // padding, column reordering and per batch map all work on the rows of the batch
+  RETURN_OK_IF_TRUE(node->Pad() || !node->ColOrder().empty() || node->BatchMapFunc());
+#endif
+  while (node->Children().size() == 1) {
+    auto map_node = std::dynamic_pointer_cast<MapNode>(node->Children()[0]);
+    RETURN_OK_IF_TRUE(map_node == nullptr);
+    size_t num_ops = NumBatchComputableOps(map_node);
+    RETURN_OK_IF_TRUE(num_ops == 0);
+    *modified = true;
+    std::vector<std::shared_ptr<TensorOperation>> ops = map_node->operations();
+    if (num_ops == ops.size()) {
+      // move the whole MapNode above the batch, then look at the node below the batch again
+      MS_LOG(INFO) << "Moving " << num_ops << " tensor operations of MapNode after BatchNode.";
+      RETURN_IF_NOT_OK(map_node->Drop());
+      RETURN_IF_NOT_OK(node->InsertAbove(map_node));
+      map_node->SetRunOnBatch(true);
+      continue;
+    }
+    // split the MapNode, the leading tensor operations still run on rows
+    MS_LOG(INFO) << "Moving the last " << num_ops << " of " << ops.size() << " tensor operations of MapNode after "
+                 << "BatchNode.";
+    std::vector<std::shared_ptr<TensorOperation>> batch_ops(ops.end() - num_ops, ops.end());
+    ops.erase(ops.end() - num_ops, ops.end());
+    map_node->setOperations(ops);
+    auto batch_map_node =
+      std::make_shared<MapNode>(nullptr, batch_ops, map_node->InputColumns(), map_node->OutputColumns());
+    (void)batch_map_node->SetNumWorkers(map_node->num_workers());
+    batch_map_node->SetRunOnBatch(true);
+    RETURN_IF_NOT_OK(node->InsertAbove(batch_map_node));
+    break;
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_MAP_FUSION_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_MAP_FUSION_PASS_H_
+
+#include <memory>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+
+/// \class BatchMapFusionPass batch_map_fusion_pass.h
+/// \brief An optional optimization pass moving the trailing tensor ops of the MapNode below a BatchNode above it,
+///     so that they run once on each contiguous batch instead of once per row. Only tensor ops which are batch
+///     computable are moved, the others keep running on rows in the original MapNode.
+class BatchMapFusionPass : public IRNodePass {
+  /// \brief Moves the batch computable tensor ops of the MapNodes right below the BatchNode above it
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates whether the node has been visited
+  /// \return Status The status code returned
+  Status Visit(std::shared_ptr<BatchNode> node, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_MAP_FUSION_PASS_H_
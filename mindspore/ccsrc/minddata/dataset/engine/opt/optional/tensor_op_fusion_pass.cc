@@ -21,6 +21,7 @@
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/image/fused_image_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
@@ -33,6 +34,7 @@ namespace dataset {
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  bool fused = false;
 
   // start temporary code, to deal with pre-built TensorOperation
   std::vector<std::string> pattern = {kDecodeOp, kRandomCropAndResizeOp};
@@ -44,25 +46,55 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
     RETURN_UNEXPECTED_IF_NULL(fused_op);
     (*itr) = std::make_shared<transforms::PreBuiltOperation>(std::make_shared<RandomCropDecodeResizeOp>(*fused_op));
     ops.erase(itr + 1);
-    node->setOperations(ops);
-    *modified = true;
-    return Status::OK();
+    fused = true;
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op->Name() == nm; });
+  if (itr != ops.end()) {
+    auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
+    ops.erase(itr + 1);
+    fused = true;
+  }
 
-  // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
-  auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
-  RETURN_UNEXPECTED_IF_NULL(fused_ir);
-  // fuse the two ops
-  (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
-  *modified = true;
+  // fuse each chain of geometric and pixel-wise image ops into one pass over the image
+  std::vector<std::shared_ptr<TensorOperation>> fused_ops;
+  size_t i = 0;
+  while (i < ops.size()) {
+    std::vector<std::shared_ptr<TensorOp>> chain;
+    size_t end = i;
+    while (end < ops.size()) {
+      std::shared_ptr<TensorOp> tensor_op = ops[end]->Build();
+      if (tensor_op == nullptr || tensor_op->FusionType() == ImageFusionType::kNone) {
+        break;
+      }
+      chain.push_back(tensor_op);
+      end++;
+      // HWC2CHW can only end a chain
+      if (tensor_op->FusionType() == ImageFusionType::kHwcToChw) {
+        break;
+      }
+    }
+    if (FusedImageOp::CanFuse(chain)) {
+      MS_LOG(INFO) << "Fusing " << chain.size() << " image ops into one FusedImageOp.";
+      fused_ops.push_back(std::make_shared<transforms::PreBuiltOperation>(std::make_shared<FusedImageOp>(chain)));
+      i = end;
+      fused = true;
+    } else {
+      fused_ops.push_back(ops[i]);
+      i++;
+    }
+  }
+
+  if (fused) {
+    node->setOperations(fused_ops);
+    *modified = true;
+  }
   return Status::OK();
 }
 }  // namespace dataset
@@ -24,7 +24,8 @@ namespace dataset {
 
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
 /// \brief And optional optimization pass identifying and fusing
-///     tensor ops within MapOp
+///     tensor ops within MapOp: Decode followed by RandomResizedCrop, and chains of
+///     geometric and pixel-wise image ops, which are run as one FusedImageOp
 class TensorOpFusionPass : public IRNodePass {
   /// \brief Identifies and fuses tensor ops within MapOp
   /// \param[in] node The node being visited
@@ -0,0 +1,178 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include <algorithm>
+#include <memory>
+#include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kAutoTuneSamplingInterval = 100;  // sampling interval in milliseconds
+constexpr int32_t kAutoTuneWindowSamples = 50;      // number of samples between two adjustments
+constexpr double kAutoTuneLowFill = 0.3;
+constexpr double kAutoTuneHighFill = 0.7;
+constexpr double kAutoTuneFullFill = 0.9;
+constexpr double kAutoTuneJitterRatio = 0.2;    // ratio of the samples both empty and full to call it jitter
+constexpr int32_t kAutoTuneMaxQueueScale = 4;  // a queue grows up to this many times its initial capacity
+constexpr int32_t kAutoTuneWorkerGrowth = 4;   // the bottleneck grows by a quarter of its active workers
+}  // namespace
+
+AutoTune::AutoTune(ExecutionTree *tree) : tree_(tree), window_samples_(0) {}
+
+Status AutoTune::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+  ProfilingManager *profiling_manager = tree_->GetProfilingManager();
+  if (profiling_manager->IsProfilingEnable()) {
+    std::shared_ptr<Tracing> node;
+    if (profiling_manager->GetTracingNode(kAutoTuneTracingName, &node).IsOk()) {
+      tracing_ = std::dynamic_pointer_cast<AutoTuneTracing>(node);
+    }
+  }
+
+  while (!this_thread::is_interrupted() && !(tree_->isFinished())) {
+    Sample();
+    if (window_samples_ >= kAutoTuneWindowSamples) {
+      RETURN_IF_NOT_OK(Tune());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kAutoTuneSamplingInterval));
+  }
+  return Status::OK();
+}
+
+void AutoTune::Sample() {
+  for (auto &op : *tree_) {
+    // DeviceQueueOp is not inlined but its output queue is invalid.
+    if (op.inlined() || op.Name() == kDeviceQueueOp) {
+      continue;
+    }
+    int32_t capacity = op.ConnectorCapacity();
+    if (capacity <= 0) {
+      continue;
+    }
+    int32_t size = op.ConnectorSize();
+    auto &stat = stats_[op.id()];
+    if (stat.init_queue_capacity == 0) {
+      stat.init_queue_capacity = op.ConnectorQueueCapacity();
+    }
+    stat.fill_sum += static_cast<double>(size) / capacity;
+    if (size == 0) {
+      stat.empty_cnt++;
+    } else if (size >= capacity) {
+      stat.full_cnt++;
+    }
+  }
+  window_samples_++;
+}
+
+Status AutoTune::Tune() {
+  RETURN_IF_NOT_OK(TuneWorkers());
+  RETURN_IF_NOT_OK(TuneConnectors());
+  for (auto &stat : stats_) {
+    stat.second.fill_sum = 0;
+    stat.second.empty_cnt = 0;
+    stat.second.full_cnt = 0;
+  }
+  window_samples_ = 0;
+  return Status::OK();
+}
+
+Status AutoTune::TuneWorkers() {
+  ParallelOp *bottleneck = nullptr;
+  double bottleneck_gap = 0;
+  for (auto &op : *tree_) {
+    auto *parallel_op = dynamic_cast<ParallelOp *>(&op);
+    if (parallel_op == nullptr || !parallel_op->IsWorkersTunable() || op.Children().empty()) {
+      continue;
+    }
+    double input_fill = FillRatio(*op.Children()[0]);
+    double output_fill = FillRatio(op);
+    int32_t active_workers = parallel_op->NumActiveWorkers();
+    if (input_fill >= kAutoTuneHighFill && output_fill <= kAutoTuneLowFill) {
+      // Rows pile up in front of the op while the ops after it are starving. Only the widest gap is widened
+      // in a window, since the other ops will see a different input once the bottleneck speeds up.
+      if (active_workers < parallel_op->num_workers() && input_fill - output_fill > bottleneck_gap) {
+        bottleneck = parallel_op;
+        bottleneck_gap = input_fill - output_fill;
+      }
+    } else if (output_fill >= kAutoTuneFullFill && input_fill < kAutoTuneHighFill && active_workers > 1) {
+      // The workers are mostly blocked on the output, give one back to the rest of the pipeline.
+      RETURN_IF_NOT_OK(parallel_op->SetNumActiveWorkers(active_workers - 1));
+      Record(op, AutoTuneTracing::kWorkers, active_workers, active_workers - 1);
+    }
+  }
+  if (bottleneck != nullptr) {
+    int32_t active_workers = bottleneck->NumActiveWorkers();
+    int32_t new_workers =
+      std::min(bottleneck->num_workers(), active_workers + std::max(1, active_workers / kAutoTuneWorkerGrowth));
+    RETURN_IF_NOT_OK(bottleneck->SetNumActiveWorkers(new_workers));
+    Record(*bottleneck, AutoTuneTracing::kWorkers, active_workers, new_workers);
+  }
+  return Status::OK();
+}
+
+Status AutoTune::TuneConnectors() {
+  for (auto &op : *tree_) {
+    auto iter = stats_.find(op.id());
+    if (iter == stats_.end()) {
+      continue;
+    }
+    const ConnectorStat &stat = iter->second;
+    int32_t queue_capacity = op.ConnectorQueueCapacity();
+    int32_t new_queue_capacity = queue_capacity;
+    if (stat.empty_cnt >= window_samples_ * kAutoTuneJitterRatio &&
+        stat.full_cnt >= window_samples_ * kAutoTuneJitterRatio) {
+      // Both sides of the connector wait on each other in turn, a deeper queue smooths it out.
+      new_queue_capacity = std::min(queue_capacity * 2, stat.init_queue_capacity * kAutoTuneMaxQueueScale);
+    } else if (stat.full_cnt == window_samples_ && queue_capacity > stat.init_queue_capacity) {
+      // The consumer is the slower side, the extra capacity only holds memory.
+      new_queue_capacity = std::max(queue_capacity / 2, stat.init_queue_capacity);
+    }
+    if (new_queue_capacity != queue_capacity) {
+      RETURN_IF_NOT_OK(op.SetConnectorQueueCapacity(new_queue_capacity));
+      Record(op, AutoTuneTracing::kConnectorCapacity, queue_capacity, new_queue_capacity);
+    }
+  }
+  return Status::OK();
+}
+
+double AutoTune::FillRatio(const DatasetOp &op) const {
+  // An inlined op has no connector of its own, the rows come from the connector of its child.
+  const DatasetOp *cur = &op;
+  while (cur->inlined() && !cur->Children().empty()) {
+    cur = cur->Children()[0].get();
+  }
+  auto iter = stats_.find(cur->id());
+  if (iter == stats_.end() || window_samples_ == 0) {
+    return 0;
+  }
+  return iter->second.fill_sum / window_samples_;
+}
+
+void AutoTune::Record(const DatasetOp &op, AutoTuneTracing::TuneType type, int32_t old_value, int32_t new_value) {
+  MS_LOG(INFO) << "AutoTune changes the "
+               << (type == AutoTuneTracing::kWorkers ? "active workers" : "output connector queue capacity") << " of "
+               << op.NameWithID() << " from " << old_value << " to " << new_value << ".";
+  if (tracing_ != nullptr) {
+    tracing_->Record(op.id(), type, old_value, new_value, ProfilingTime::GetCurMilliSecond());
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <memory>
+#include <unordered_map>
+#include "minddata/dataset/util/status.h"
+#include "minddata/dataset/engine/perf/auto_tune_tracing.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+class ExecutionTree;
+class ParallelOp;
+
+// AutoTune samples the output connectors of the ops while the pipeline is running, and after every window of
+// samples it adjusts the pipeline towards its bottleneck:
+// 1) A ParallelOp whose input is mostly full while its output is mostly empty is the bottleneck, and gets more
+//    active workers. A ParallelOp whose output is always full while its input is not gives up a worker.
+// 2) An output connector which is found both empty and full within a window gets more capacity to absorb the
+//    jitter, and one which stays full gives back the capacity it got earlier.
+// The changes are applied at row boundaries without restarting the tree. They are logged, and written to the
+// profiling output when profiling is enabled.
+class AutoTune {
+ public:
+  // AutoTune object constructor
+  explicit AutoTune(ExecutionTree *tree);
+
+  ~AutoTune() = default;
+
+  // Functor for AutoTune main loop.
+  // This function will be the entry point of mindspore::Dataset::Task
+  Status operator()();
+
+ private:
+  // Fill level of an output connector within the current window
+  struct ConnectorStat {
+    double fill_sum = 0;              // Sum of size / capacity of the samples
+    int32_t empty_cnt = 0;            // Number of samples where the connector is empty
+    int32_t full_cnt = 0;             // Number of samples where the connector is full
+    int32_t init_queue_capacity = 0;  // Capacity of each queue of the connector when the pipeline is launched
+  };
+
+  // Sample the output connectors of all the ops
+  void Sample();
+
+  // Adjust the pipeline from the samples of the window, and start a new window
+  Status Tune();
+
+  // Adjust the number of active workers of the bottleneck, or of an op blocked by its output
+  Status TuneWorkers();
+
+  // Adjust the capacity of the output connectors
+  Status TuneConnectors();
+
+  // Average fill level of the output connector of an op in the current window, 0 if it is not sampled
+  double FillRatio(const DatasetOp &op) const;
+
+  // Log a change and record it in the profiling output
+  void Record(const DatasetOp &op, AutoTuneTracing::TuneType type, int32_t old_value, int32_t new_value);
+
+  ExecutionTree *tree_;
+  int32_t window_samples_;                            // Number of samples taken in the current window
+  std::unordered_map<int32_t, ConnectorStat> stats_;  // Connector statistics of each op id
+  std::shared_ptr<AutoTuneTracing> tracing_;          // Profiling output, nullptr if profiling is not enabled
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
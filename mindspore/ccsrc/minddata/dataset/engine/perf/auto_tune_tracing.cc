@@ -0,0 +1,53 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/auto_tune_tracing.h"
+#include <sys/stat.h>
+#include <string>
+#include "minddata/dataset/util/path.h"
+#include "mindspore/core/utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+void AutoTuneTracing::Record(const int32_t op_id, const TuneType type, const int32_t old_value,
+                             const int32_t new_value, const uint64_t time_stamp) {
+  // Format: "op-id type old-value new-value time-stamp"
+  // type: 0: number of active workers, 1: capacity of the output connector
+  // Examples:
+  // 3 0 8 10 xxx- The active workers of op 3 are increased from 8 to 10.
+  // 1 1 16 32 xxx- The output connector capacity of op 1 is increased from 16 to 32.
+  std::string data = std::to_string(op_id) + " " + std::to_string(type) + " " + std::to_string(old_value) + " " +
+                     std::to_string(new_value) + " " + std::to_string(time_stamp);
+  value_.emplace_back(data);
+}
+
+Status AutoTuneTracing::Init(const std::string &dir_path, const std::string &device_id) {
+  file_path_ = (Path(dir_path) / Path("autotune_profiling_" + device_id + ".txt")).toString();
+  return Status::OK();
+}
+
+Status AutoTuneTracing::ChangeFileMode() {
+  if (value_.empty()) {
+    return Status::OK();
+  }
+
+  if (chmod(common::SafeCStr(file_path_), S_IRUSR | S_IWUSR) == -1) {
+    std::string err_str = "Change file mode failed," + file_path_;
+    return Status(StatusCode::kMDUnexpectedError, err_str);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_TRACING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_TRACING_H_
+
+#include <string>
+#include "minddata/dataset/engine/perf/profiling.h"
+
+namespace mindspore {
+namespace dataset {
+// Records the changes AutoTune makes to the pipeline while it is running.
+class AutoTuneTracing : public Tracing {
+ public:
+  enum TuneType { kWorkers = 0, kConnectorCapacity = 1 };
+
+  // Constructor
+  AutoTuneTracing() = default;
+
+  // Destructor
+  ~AutoTuneTracing() override = default;
+
+  // Record tracing data
+  // @param op_id - The id of the tuned op
+  // @param type - What is changed
+  // @param old_value - The value before the change
+  // @param new_value - The value after the change
+  // @param time_stamp - Time of the change
+  void Record(const int32_t op_id, const TuneType type, const int32_t old_value, const int32_t new_value,
+              const uint64_t time_stamp);
+
+  std::string Name() const override { return kAutoTuneTracingName; };
+
+  Status Init(const std::string &dir_path, const std::string &device_id) override;
+
+  Status ChangeFileMode() override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_TRACING_H_
@@ -18,11 +18,10 @@
 #include <fstream>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/util/path.h"
-#ifdef ENABLE_GPUQUE
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/global_context.h"
-#endif
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/engine/perf/auto_tune_tracing.h"
 #include "minddata/dataset/engine/perf/device_queue_tracing.h"
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/connector_throughput.h"
@@ -125,6 +124,12 @@ Status ProfilingManager::Initialize() {
   std::shared_ptr<Tracing> dataset_iterator_tracing = std::make_shared<DatasetIteratorTracing>();
   RETURN_IF_NOT_OK(RegisterTracingNode(dataset_iterator_tracing));
 
+  // autotune node records the changes made by AutoTune
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    std::shared_ptr<Tracing> autotune_tracing = std::make_shared<AutoTuneTracing>();
+    RETURN_IF_NOT_OK(RegisterTracingNode(autotune_tracing));
+  }
+
   std::shared_ptr<Sampling> connector_size_sampling = std::make_shared<ConnectorSize>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(connector_size_sampling));
 
@@ -35,6 +35,7 @@ const char kDatasetIteratorTracingName[] = "Dataset_Iterator_Tracing";
 const char kConnectorSizeSamplingName[] = "Connector_Size_Sampling";
 const char kConnectorThroughputSamplingName[] = "Connector_Throughput_Sampling";
 const char kCpuSamplingName[] = "Cpu_Sampling";
+const char kAutoTuneTracingName[] = "AutoTune_Tracing";
 
 // Profiling is a class of basic unit of profiling action
 // This base class encapsulate the serialization output logic
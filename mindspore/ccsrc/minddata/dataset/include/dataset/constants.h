@@ -170,6 +170,7 @@ constexpr char kCfgDefaultCacheHost[] = "127.0.0.1";
 constexpr int32_t kDftPrefetchSize = 20;
 constexpr int32_t kDftNumConnections = 12;
 constexpr int32_t kDftAutoNumWorkers = false;
+constexpr bool kDftEnableAutoTune = false;
 constexpr char kDftMetaColumnPrefix[] = "_meta-";
 constexpr int32_t kDecimal = 10;  // used in strtol() to convert a string value according to decimal numeral system
 constexpr int32_t kMinLegalPort = 1025;
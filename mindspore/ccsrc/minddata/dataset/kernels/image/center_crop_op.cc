@@ -16,6 +16,7 @@
 #include "minddata/dataset/kernels/image/center_crop_op.h"
 #include <string>
 #include "utils/ms_utils.h"
+#include "minddata/dataset/kernels/image/image_geometry.h"
 
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/kernels/image/image_utils.h"
@@ -62,6 +63,15 @@ Status CenterCropOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_p
               crop_het_);
 }
 
+Status CenterCropOp::FuseGeometry(ImageGeometry *geometry) {
+  RETURN_UNEXPECTED_IF_NULL(geometry);
+  // a crop which needs padding is not a window of the source image
+  CHECK_FAIL_RETURN_UNEXPECTED(crop_het_ <= geometry->height() && crop_wid_ <= geometry->width(),
+                               "CenterCrop: crop size is larger than the image, it can not be fused.");
+  return geometry->Crop((geometry->width() - crop_wid_) / 2, (geometry->height() - crop_het_) / 2, crop_het_,
+                        crop_wid_);
+}
+
 void CenterCropOp::Print(std::ostream &out) const {
   out << "CenterCropOp: "
       << "cropWidth: " << crop_wid_ << "cropHeight: " << crop_het_ << "\n";
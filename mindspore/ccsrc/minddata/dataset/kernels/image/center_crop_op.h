@@ -40,6 +40,10 @@ class CenterCropOp : public TensorOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
+  ImageFusionType FusionType() override { return ImageFusionType::kGeometric; }
+
+  Status FuseGeometry(ImageGeometry *geometry) override;
+
   std::string Name() const override { return kCenterCropOp; }
 
  private:
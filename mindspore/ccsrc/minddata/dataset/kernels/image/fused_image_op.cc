@@ -0,0 +1,191 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+
+#include <utility>
+
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Sample each pixel of the image described by the geometry from the <H,W,C> source image with bilinear
+// interpolation, then scale and shift each of its channels and write it in <C,H,W> or <H,W,C> layout.
+template <typename T>
+void FusedImageKernel(const T *src, int32_t src_height, int32_t src_width, int32_t num_channels,
+                      const ImageGeometry &geometry, const std::vector<float> &scale, const std::vector<float> &shift,
+                      bool output_chw, float *dst) {
+  const int32_t height = geometry.height();
+  const int32_t width = geometry.width();
+  const int64_t src_row_size = static_cast<int64_t>(src_width) * num_channels;
+  const int64_t plane_size = static_cast<int64_t>(height) * width;
+
+  // every row samples the same source columns
+  std::vector<int64_t> col_left(width);
+  std::vector<int64_t> col_right(width);
+  std::vector<float> col_weight(width);
+  for (int32_t col = 0; col < width; col++) {
+    double x = geometry.SourceX(col);
+    auto left = static_cast<int64_t>(x);
+    col_weight[col] = static_cast<float>(x - left);
+    col_left[col] = left * num_channels;
+    col_right[col] = col_weight[col] > 0 && left + 1 < src_width ? col_left[col] + num_channels : col_left[col];
+  }
+
+  for (int32_t row = 0; row < height; row++) {
+    double y = geometry.SourceY(row);
+    auto top = static_cast<int64_t>(y);
+    float row_weight = static_cast<float>(y - top);
+    const T *top_row = src + top * src_row_size;
+    const T *bottom_row = row_weight > 0 && top + 1 < src_height ? top_row + src_row_size : top_row;
+    for (int32_t col = 0; col < width; col++) {
+      const T *top_left = top_row + col_left[col];
+      const T *top_right = top_row + col_right[col];
+      const T *bottom_left = bottom_row + col_left[col];
+      const T *bottom_right = bottom_row + col_right[col];
+      for (int32_t c = 0; c < num_channels; c++) {
+        float upper = static_cast<float>(top_left[c]);
+        upper += (static_cast<float>(top_right[c]) - upper) * col_weight[col];
+        float lower = static_cast<float>(bottom_left[c]);
+        lower += (static_cast<float>(bottom_right[c]) - lower) * col_weight[col];
+        float value = (upper + (lower - upper) * row_weight) * scale[c] + shift[c];
+        if (output_chw) {
+          dst[c * plane_size + static_cast<int64_t>(row) * width + col] = value;
+        } else {
+          dst[(static_cast<int64_t>(row) * width + col) * num_channels + c] = value;
+        }
+      }
+    }
+  }
+}
+}  // namespace
+
+FusedImageOp::FusedImageOp(std::vector<std::shared_ptr<TensorOp>> ops) : ops_(std::move(ops)), output_chw_(false) {
+  for (const auto &op : ops_) {
+    if (op->FusionType() == ImageFusionType::kHwcToChw) {
+      output_chw_ = true;
+    }
+    if (!op->Deterministic()) {
+      is_deterministic_ = false;
+    }
+  }
+}
+
+bool FusedImageOp::CanFuse(const std::vector<std::shared_ptr<TensorOp>> &ops) {
+  bool has_geometric = false;
+  bool has_pixelwise = false;
+  for (size_t i = 0; i < ops.size(); i++) {
+    if (ops[i] == nullptr || !ops[i]->OneToOne()) {
+      return false;
+    }
+    ImageFusionType type = ops[i]->FusionType();
+    if (type == ImageFusionType::kGeometric) {
+      has_geometric = true;
+    } else if (type == ImageFusionType::kPixelwise) {
+      has_pixelwise = true;
+    } else if (type == ImageFusionType::kNone || (type == ImageFusionType::kHwcToChw && i + 1 != ops.size())) {
+      return false;
+    }
+  }
+  // a chain without geometric TensorOps is already element-wise, and is left to BatchMapFusionPass
+  return has_geometric && has_pixelwise;
+}
+
+Status FusedImageOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  const TensorShape &shape = input->shape();
+  const DataType type = input->type();
+  int32_t num_channels = shape.Rank() == DEFAULT_IMAGE_RANK ? static_cast<int32_t>(shape[CHANNEL_INDEX]) : 1;
+  if ((shape.Rank() != DEFAULT_IMAGE_RANK && shape.Rank() != MIN_IMAGE_DIMENSION) || shape.NumOfElements() == 0 ||
+      (type != DataType(DataType::DE_UINT8) && type != DataType(DataType::DE_FLOAT32)) ||
+      (output_chw_ && num_channels != MIN_IMAGE_CHANNELS && num_channels != DEFAULT_IMAGE_CHANNELS)) {
+    return ComputeOneByOne(input, output);
+  }
+
+  ImageGeometry geometry(static_cast<int32_t>(shape[0]), static_cast<int32_t>(shape[1]));
+  std::vector<float> scale(num_channels, 1.0);
+  std::vector<float> shift(num_channels, 0.0);
+  for (const auto &op : ops_) {
+    Status rc;
+    if (op->FusionType() == ImageFusionType::kGeometric) {
+      rc = op->FuseGeometry(&geometry);
+    } else if (op->FusionType() == ImageFusionType::kPixelwise) {
+      rc = op->FusePixelwise(&scale, &shift);
+    }
+    if (rc.IsError()) {
+      // let the TensorOps report the error, or handle the image in a way the fused kernel does not support
+      MS_LOG(DEBUG) << "Run " << op->Name() << " unfused: " << rc.GetErrDescription();
+      return ComputeOneByOne(input, output);
+    }
+  }
+
+  TensorShape out_shape{geometry.height(), geometry.width()};
+  if (shape.Rank() == DEFAULT_IMAGE_RANK) {
+    out_shape = output_chw_ ? TensorShape{num_channels, geometry.height(), geometry.width()}
+                            : out_shape.AppendDim(num_channels);
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, DataType(DataType::DE_FLOAT32), output));
+  float *dst = &(*(*output)->begin<float>());
+  if (type == DataType(DataType::DE_UINT8)) {
+    FusedImageKernel(&(*input->begin<uint8_t>()), static_cast<int32_t>(shape[0]), static_cast<int32_t>(shape[1]),
+                     num_channels, geometry, scale, shift, output_chw_, dst);
+  } else {
+    FusedImageKernel(&(*input->begin<float>()), static_cast<int32_t>(shape[0]), static_cast<int32_t>(shape[1]),
+                     num_channels, geometry, scale, shift, output_chw_, dst);
+  }
+  return Status::OK();
+}
+
+Status FusedImageOp::ComputeOneByOne(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> image = input;
+  for (const auto &op : ops_) {
+    std::shared_ptr<Tensor> result;
+    RETURN_IF_NOT_OK(op->Compute(image, &result));
+    image = std::move(result);
+  }
+  *output = std::move(image);
+  return Status::OK();
+}
+
+Status FusedImageOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> shapes = inputs;
+  for (const auto &op : ops_) {
+    RETURN_IF_NOT_OK(op->OutputShape(shapes, outputs));
+    shapes = outputs;
+  }
+  outputs = shapes;
+  return Status::OK();
+}
+
+Status FusedImageOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  std::vector<DataType> types = inputs;
+  for (const auto &op : ops_) {
+    RETURN_IF_NOT_OK(op->OutputType(types, outputs));
+    types = outputs;
+  }
+  outputs = types;
+  return Status::OK();
+}
+
+void FusedImageOp::Print(std::ostream &out) const {
+  out << Name() << ":";
+  for (const auto &op : ops_) {
+    out << " " << op->Name();
+  }
+  out << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
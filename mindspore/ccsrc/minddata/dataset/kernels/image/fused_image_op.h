@@ -0,0 +1,70 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/image_geometry.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// FusedImageOp runs a chain of kGeometric and kPixelwise TensorOps, optionally followed by a kHwcToChw TensorOp, in
+// a single pass over the image. The geometric TensorOps are composed into one ImageGeometry, each output pixel is
+// sampled from the source image with bilinear interpolation, the pixel-wise TensorOps are applied to it as one scale
+// and shift per channel, and it is written to the float32 output in its final layout.
+// Images which the chain can not be fused for run through the TensorOps one by one.
+class FusedImageOp : public TensorOp {
+ public:
+  // Constructor
+  // @param ops the TensorOps to fuse, see TensorOpFusionPass.
+  explicit FusedImageOp(std::vector<std::shared_ptr<TensorOp>> ops);
+
+  ~FusedImageOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kFusedImageOp; }
+
+  // Check if a chain of TensorOps can be fused into a FusedImageOp.
+  // @param ops the TensorOps to fuse.
+  // @return true if the chain is made of geometric and pixel-wise TensorOps with at least one of each,
+  //     and only its last TensorOp turns the layout into <C,H,W>.
+  static bool CanFuse(const std::vector<std::shared_ptr<TensorOp>> &ops);
+
+  const std::vector<std::shared_ptr<TensorOp>> &TensorOps() const { return ops_; }
+
+ private:
+  // Run the TensorOps one by one, for the images the chain can not be fused for
+  Status ComputeOneByOne(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+  bool output_chw_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
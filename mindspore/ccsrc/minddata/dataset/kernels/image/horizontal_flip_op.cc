@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/kernels/image/horizontal_flip_op.h"
 
+#include "minddata/dataset/kernels/image/image_geometry.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 
 namespace mindspore {
@@ -24,5 +25,11 @@ Status HorizontalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::shar
   IO_CHECK(input, output);
   return HorizontalFlip(input, output);
 }
+
+Status HorizontalFlipOp::FuseGeometry(ImageGeometry *geometry) {
+  RETURN_UNEXPECTED_IF_NULL(geometry);
+  geometry->FlipHorizontal();
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -33,6 +33,10 @@ class HorizontalFlipOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  ImageFusionType FusionType() override { return ImageFusionType::kGeometric; }
+
+  Status FuseGeometry(ImageGeometry *geometry) override;
+
   std::string Name() const override { return kHorizontalFlipOp; }
 };
 }  // namespace dataset
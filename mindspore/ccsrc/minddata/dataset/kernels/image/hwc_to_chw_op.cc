@@ -26,6 +26,12 @@ Status HwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr
   // output.shape == CHW
   return HwcToChw(input, output);
 }
+Status HwcToChwOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  // input.shape == NHWC
+  // output.shape == NCHW
+  return BatchHwcToChw(input, output);
+}
 Status HwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
@@ -29,8 +29,12 @@ namespace dataset {
 class HwcToChwOp : public TensorOp {
  public:
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+  bool IsBatchComputable() override { return true; }
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
+  ImageFusionType FusionType() override { return ImageFusionType::kHwcToChw; }
+
   std::string Name() const override { return kHwcToChwOp; }
 };
 }  // namespace dataset
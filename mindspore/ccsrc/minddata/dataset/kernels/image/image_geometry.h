@@ -0,0 +1,140 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_IMAGE_GEOMETRY_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_IMAGE_GEOMETRY_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The geometry of the image which a chain of crops, flips and resizes produces from a source image, without moving
+// any pixel: a window of the source image, resampled to the size of the image and flipped.
+// Like cv::resize, a resize replicates the edge pixels of the image it resizes, so the sampled positions are clamped
+// to the pixels of the image before the last resize, not to the window. A chain with more than one resize samples
+// the source only once, so it is close to, but not the same as, resizing several times.
+class ImageGeometry {
+ public:
+  // Constructor
+  // @param height the height of the source image.
+  // @param width the width of the source image.
+  ImageGeometry(int32_t height, int32_t width)
+      : window_y_(0),
+        window_x_(0),
+        window_height_(height),
+        window_width_(width),
+        height_(height),
+        width_(width),
+        flip_vertical_(false),
+        flip_horizontal_(false),
+        min_y_(0),
+        max_y_(height - 1),
+        min_x_(0),
+        max_x_(width - 1) {}
+
+  ~ImageGeometry() = default;
+
+  int32_t height() const { return height_; }
+
+  int32_t width() const { return width_; }
+
+  // Crop the image, the crop box must be inside of the image.
+  // @param x the column of the top left corner of the crop box.
+  // @param y the row of the top left corner of the crop box.
+  // @param height the height of the crop box.
+  // @param width the width of the crop box.
+  // @return Status
+  Status Crop(int32_t x, int32_t y, int32_t height, int32_t width) {
+    CHECK_FAIL_RETURN_UNEXPECTED(x >= 0 && y >= 0 && height > 0 && width > 0 && y + height <= height_ &&
+                                   x + width <= width_,
+                                 "ImageGeometry: crop box is not inside of the image.");
+    // a flipped image is cropped from the other side of the window
+    int32_t window_x = flip_horizontal_ ? width_ - x - width : x;
+    int32_t window_y = flip_vertical_ ? height_ - y - height : y;
+    double scale_y = window_height_ / height_;
+    double scale_x = window_width_ / width_;
+    window_y_ += window_y * scale_y;
+    window_x_ += window_x * scale_x;
+    window_height_ = height * scale_y;
+    window_width_ = width * scale_x;
+    height_ = height;
+    width_ = width;
+    return Status::OK();
+  }
+
+  // Resize the image with bilinear interpolation.
+  // @param height the height of the resized image.
+  // @param width the width of the resized image.
+  // @return Status
+  Status Resize(int32_t height, int32_t width) {
+    CHECK_FAIL_RETURN_UNEXPECTED(height > 0 && width > 0, "ImageGeometry: the size to resize to is not positive.");
+    // the first and the last pixels of the image being resized are its edges from now on
+    min_y_ = SourceY(flip_vertical_ ? height_ - 1 : 0);
+    max_y_ = SourceY(flip_vertical_ ? 0 : height_ - 1);
+    min_x_ = SourceX(flip_horizontal_ ? width_ - 1 : 0);
+    max_x_ = SourceX(flip_horizontal_ ? 0 : width_ - 1);
+    height_ = height;
+    width_ = width;
+    return Status::OK();
+  }
+
+  void FlipHorizontal() { flip_horizontal_ = !flip_horizontal_; }
+
+  void FlipVertical() { flip_vertical_ = !flip_vertical_; }
+
+  // Get the position in the source image that a row of the image samples, clamped to the edges of the image before
+  // the last resize. Pixel centers are aligned as in cv::resize, so an image which is only cropped and flipped samples
+  // whole pixels.
+  // @param row the row of the image.
+  // @return the row of the source image, with a fractional part between two source rows.
+  double SourceY(int32_t row) const {
+    return SourcePosition(flip_vertical_ ? height_ - 1 - row : row, window_y_, window_height_, height_, min_y_, max_y_);
+  }
+
+  // Get the position in the source image that a column of the image samples, clamped to the edges of the image
+  // before the last resize.
+  // @param col the column of the image.
+  // @return the column of the source image, with a fractional part between two source columns.
+  double SourceX(int32_t col) const {
+    return SourcePosition(flip_horizontal_ ? width_ - 1 - col : col, window_x_, window_width_, width_, min_x_, max_x_);
+  }
+
+ private:
+  static double SourcePosition(int32_t index, double window_start, double window_size, int32_t size, double min,
+                               double max) {
+    double position = window_start + (index + 0.5) * window_size / size - 0.5;
+    return std::min(std::max(position, min), max);
+  }
+
+  double window_y_;
+  double window_x_;
+  double window_height_;
+  double window_width_;
+  int32_t height_;
+  int32_t width_;
+  bool flip_vertical_;
+  bool flip_horizontal_;
+  // the source positions of the edge pixels of the image before the last resize
+  double min_y_;
+  double max_y_;
+  double min_x_;
+  double max_x_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_IMAGE_GEOMETRY_H_
@@ -432,6 +432,64 @@ Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *outpu
   }
 }
 
+template <typename T>
+void BatchHwcToChw(const T *src, T *dst, int64_t num_images, int64_t num_pixels, int64_t num_channels) {
+  for (int64_t n = 0; n < num_images; n++) {
+    for (int64_t c = 0; c < num_channels; c++) {
+      for (int64_t p = 0; p < num_pixels; p++) {
+        *dst++ = src[p * num_channels + c];
+      }
+    }
+    src += num_pixels * num_channels;
+  }
+}
+
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  if (input->Rank() == DEFAULT_IMAGE_RANK) {
+    // If input tensor is 3D, we assume we have a batch of hw images
+    *output = input;
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(input->type().IsNumeric(), "HWC2CHW: batch of images is not of numeric type.");
+  int64_t num_channels = input->shape()[-1];
+  if (input->Rank() != DEFAULT_IMAGE_RANK + 1 ||
+      (num_channels != DEFAULT_IMAGE_CHANNELS && num_channels != MIN_IMAGE_CHANNELS)) {
+    RETURN_STATUS_UNEXPECTED("HWC2CHW: batch of images shape is not <N,H,W,C>.");
+  }
+  int64_t num_images = input->shape()[0];
+  int64_t height = input->shape()[1];
+  int64_t width = input->shape()[2];
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape{num_images, num_channels, height, width}, input->type(), output));
+  if (num_images == 0) {
+    return Status::OK();
+  }
+  uchar *dst = nullptr;
+  TensorShape remaining = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK((*output)->StartAddrOfIndex({0}, &dst, &remaining));
+  const uchar *src = input->GetBuffer();
+  // only the width of the elements matters when moving them around
+  switch (input->type().SizeInBytes()) {
+    case sizeof(uint8_t):
+      BatchHwcToChw(src, dst, num_images, height * width, num_channels);
+      break;
+    case sizeof(uint16_t):
+      BatchHwcToChw(reinterpret_cast<const uint16_t *>(src), reinterpret_cast<uint16_t *>(dst), num_images,
+                    height * width, num_channels);
+      break;
+    case sizeof(uint32_t):
+      BatchHwcToChw(reinterpret_cast<const uint32_t *>(src), reinterpret_cast<uint32_t *>(dst), num_images,
+                    height * width, num_channels);
+      break;
+    case sizeof(uint64_t):
+      BatchHwcToChw(reinterpret_cast<const uint64_t *>(src), reinterpret_cast<uint64_t *>(dst), num_images,
+                    height * width, num_channels);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("HWC2CHW: unsupported type: " + input->type().ToString());
+  }
+  return Status::OK();
+}
+
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
@@ -690,7 +748,7 @@ void Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *ou
   auto itr_out = (*output)->begin<float>();
   auto itr = input->begin<T>();
   auto end = input->end<T>();
-  int64_t num_channels = (*output)->shape()[CHANNEL_INDEX];
+  int64_t num_channels = (*output)->shape()[-1];
 
   while (itr != end) {
     for (int64_t i = 0; i < num_channels; i++) {
@@ -701,25 +759,21 @@ void Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *ou
   }
 }
 
-Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
-                 std::vector<float> std) {
-  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_FLOAT32), output));
-  if (input->Rank() == MIN_IMAGE_DIMENSION) {
-    RETURN_IF_NOT_OK((*output)->ExpandDim(MIN_IMAGE_DIMENSION));
-  }
-
-  CHECK_FAIL_RETURN_UNEXPECTED((*output)->Rank() == DEFAULT_IMAGE_RANK, "Normalize: image shape is not <H,W,C>.");
+// Normalize each element of the input along the channels of the last dimension of the output, which is created
+// by the caller with the shape of the input and type DE_FLOAT32
+Status NormalizeChannels(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         std::vector<float> mean, std::vector<float> std) {
   CHECK_FAIL_RETURN_UNEXPECTED(std.size() == mean.size(), "Normalize: mean and std vectors are not of same size.");
 
   // caller provided 1 mean/std value and there are more than one channel --> duplicate mean/std value
-  if (mean.size() == 1 && (*output)->shape()[CHANNEL_INDEX] != 1) {
+  if (mean.size() == 1 && (*output)->shape()[-1] != 1) {
     std::vector<float> mean_t, std_t;
-    for (int64_t i = 0; i < (*output)->shape()[CHANNEL_INDEX] - 1; i++) {
+    for (int64_t i = 0; i < (*output)->shape()[-1] - 1; i++) {
       mean.push_back(mean[0]);
       std.push_back(std[0]);
     }
   }
-  CHECK_FAIL_RETURN_UNEXPECTED((*output)->shape()[CHANNEL_INDEX] == mean.size(),
+  CHECK_FAIL_RETURN_UNEXPECTED((*output)->shape()[-1] == mean.size(),
                                "Normalize: number of channels does not match the size of mean and std vectors.");
 
   switch (input->type().value()) {
@@ -767,12 +821,39 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
         "[bool,int8_t,uint8_t,int16_t,uint16_t,int32_t,uint32_t,int64_t,uint64_t,float16,float,double].");
   }
 
+  return Status::OK();
+}
+
+Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                 std::vector<float> std) {
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_FLOAT32), output));
+  if (input->Rank() == MIN_IMAGE_DIMENSION) {
+    RETURN_IF_NOT_OK((*output)->ExpandDim(MIN_IMAGE_DIMENSION));
+  }
+
+  CHECK_FAIL_RETURN_UNEXPECTED((*output)->Rank() == DEFAULT_IMAGE_RANK, "Normalize: image shape is not <H,W,C>.");
+  RETURN_IF_NOT_OK(NormalizeChannels(input, output, mean, std));
+
   if (input->Rank() == MIN_IMAGE_DIMENSION) {
     (*output)->Squeeze();
   }
   return Status::OK();
 }
 
+Status BatchNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                      std::vector<float> std) {
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), DataType(DataType::DE_FLOAT32), output));
+  if (input->Rank() == DEFAULT_IMAGE_RANK) {
+    // a batch of <H,W> images has a single channel
+    RETURN_IF_NOT_OK((*output)->ExpandDim(DEFAULT_IMAGE_RANK));
+  }
+
+  CHECK_FAIL_RETURN_UNEXPECTED((*output)->Rank() == DEFAULT_IMAGE_RANK + 1,
+                               "Normalize: batch of images shape is not <N,H,W,C>.");
+  RETURN_IF_NOT_OK(NormalizeChannels(input, output, mean, std));
+  return (*output)->Reshape(input->shape());
+}
+
 Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                     const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std, const std::string &dtype) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
@@ -138,6 +138,11 @@ Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *outpu
 /// \param output: Tensor of shape <C,H,W> or <H,W> and same input type.
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
+/// \brief Swaps the channels of a batch of images, i.e. converts NHWC to NCHW
+/// \param input: Tensor of shape <N,H,W,C> or <N,H,W> and any numeric type.
+/// \param output: Tensor of shape <N,C,H,W> or <N,H,W> and same input type.
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
 /// \brief Masks the given part of the input image with a another image (sub_mat)
 /// \param[in] sub_mat The image we want to mask with
 /// \param[in] input The pointer to the image we want to mask
@@ -199,6 +204,14 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
                  std::vector<float> std);
 
+/// \brief Returns Normalized batch of images, each image is normalized as in Normalize()
+/// \param input: Tensor of shape <N,H,W,C> or <N,H,W> in RGB order and any numeric type.
+/// \param mean: mean of each channel in RGB order
+/// \param std: std of each channel in RGB order
+/// \param output: Normalized Tensor of same input shape and type DE_FLOAT32
+Status BatchNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                      std::vector<float> std);
+
 /// \brief Returns Normalized and paded image
 /// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param mean: Tensor of shape <3> and type DE_FLOAT32 which are mean of each channel in RGB order
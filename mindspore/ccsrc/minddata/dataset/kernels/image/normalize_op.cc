@@ -40,6 +40,27 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   return Normalize(input, output, mean_, std_);
 }
 
+#ifndef ENABLE_ANDROID
+Status NormalizeOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  return BatchNormalize(input, output, mean_, std_);
+}
+#endif
+
+Status NormalizeOp::FusePixelwise(std::vector<float> *scale, std::vector<float> *shift) {
+  RETURN_UNEXPECTED_IF_NULL(scale);
+  RETURN_UNEXPECTED_IF_NULL(shift);
+  CHECK_FAIL_RETURN_UNEXPECTED(mean_.size() == 1 || mean_.size() == scale->size(),
+                               "Normalize: number of channels does not match the size of mean and std vectors.");
+  for (size_t c = 0; c < scale->size(); c++) {
+    size_t i = mean_.size() == 1 ? 0 : c;
+    // mean_ is already divided by std_
+    (*scale)[c] = (*scale)[c] / std_[i];
+    (*shift)[c] = (*shift)[c] / std_[i] - mean_[i];
+  }
+  return Status::OK();
+}
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: ";
   for (const auto &m : mean_) {
@@ -36,6 +36,16 @@ class NormalizeOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+#ifndef ENABLE_ANDROID
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  bool IsBatchComputable() override { return true; }
+#endif
+
+  ImageFusionType FusionType() override { return ImageFusionType::kPixelwise; }
+
+  Status FusePixelwise(std::vector<float> *scale, std::vector<float> *shift) override;
+
   std::string Name() const override { return kNormalizeOp; }
 
  private:
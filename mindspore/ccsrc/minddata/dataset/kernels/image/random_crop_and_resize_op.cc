@@ -16,6 +16,7 @@
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include <random>
 
+#include "minddata/dataset/kernels/image/image_geometry.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/status.h"
@@ -57,6 +58,16 @@ Status RandomCropAndResizeOp::Compute(const std::shared_ptr<Tensor> &input, std:
   (void)GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width);
   return CropAndResize(input, output, x, y, crop_height, crop_width, target_height_, target_width_, interpolation_);
 }
+Status RandomCropAndResizeOp::FuseGeometry(ImageGeometry *geometry) {
+  RETURN_UNEXPECTED_IF_NULL(geometry);
+  int x = 0;
+  int y = 0;
+  int crop_height = 0;
+  int crop_width = 0;
+  RETURN_IF_NOT_OK(GetCropBox(geometry->height(), geometry->width(), &x, &y, &crop_height, &crop_width));
+  RETURN_IF_NOT_OK(geometry->Crop(x, y, crop_height, crop_width));
+  return geometry->Resize(target_height_, target_width_);
+}
 Status RandomCropAndResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
@@ -59,6 +59,12 @@ class RandomCropAndResizeOp : public TensorOp {
 
   Status GetCropBox(int h_in, int w_in, int *x, int *y, int *crop_height, int *crop_width);
 
+  ImageFusionType FusionType() override {
+    return interpolation_ == InterpolationMode::kLinear ? ImageFusionType::kGeometric : ImageFusionType::kNone;
+  }
+
+  Status FuseGeometry(ImageGeometry *geometry) override;
+
   std::string Name() const override { return kRandomCropAndResizeOp; }
 
  protected:
@@ -41,6 +41,8 @@ class RandomCropAndResizeWithBBoxOp : public RandomCropAndResizeOp {
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  ImageFusionType FusionType() override { return ImageFusionType::kNone; }
+
   std::string Name() const override { return kRandomCropAndResizeWithBBoxOp; }
 };
 }  // namespace dataset
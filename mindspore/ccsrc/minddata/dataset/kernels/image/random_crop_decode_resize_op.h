@@ -45,6 +45,9 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  // The input is an encoded image, so the op can not be fused with the image operations
+  ImageFusionType FusionType() override { return ImageFusionType::kNone; }
+
   std::string Name() const override { return kRandomCropDecodeResizeOp; }
 };
 }  // namespace dataset
@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
 
+#include "minddata/dataset/kernels/image/image_geometry.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -30,5 +31,13 @@ Status RandomHorizontalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std
   *output = input;
   return Status::OK();
 }
+
+Status RandomHorizontalFlipOp::FuseGeometry(ImageGeometry *geometry) {
+  RETURN_UNEXPECTED_IF_NULL(geometry);
+  if (distribution_(rnd_)) {
+    geometry->FlipHorizontal();
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
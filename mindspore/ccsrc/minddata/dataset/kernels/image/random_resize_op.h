@@ -45,6 +45,9 @@ class RandomResizeOp : public ResizeOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  // The interpolation is drawn for each image, so the op is not fused
+  ImageFusionType FusionType() override { return ImageFusionType::kNone; }
+
   std::string Name() const override { return kRandomResizeOp; }
 
  private:
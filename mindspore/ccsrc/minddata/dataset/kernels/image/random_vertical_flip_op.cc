@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/kernels/image/random_vertical_flip_op.h"
 
+#include "minddata/dataset/kernels/image/image_geometry.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -31,5 +32,13 @@ Status RandomVerticalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::
   *output = input;
   return Status::OK();
 }
+
+Status RandomVerticalFlipOp::FuseGeometry(ImageGeometry *geometry) {
+  RETURN_UNEXPECTED_IF_NULL(geometry);
+  if (distribution_(rnd_)) {
+    geometry->FlipVertical();
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -41,6 +41,10 @@ class RandomVerticalFlipOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  ImageFusionType FusionType() override { return ImageFusionType::kGeometric; }
+
+  Status FuseGeometry(ImageGeometry *geometry) override;
+
   std::string Name() const override { return kRandomVerticalFlipOp; }
 
  private:
@@ -24,6 +24,20 @@ Status RescaleOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<
   IO_CHECK(input, output);
   return Rescale(input, output, rescale_, shift_);
 }
+Status RescaleOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  // Rescale is element wise, so the batch is rescaled as a whole
+  return Rescale(input, output, rescale_, shift_);
+}
+Status RescaleOp::FusePixelwise(std::vector<float> *scale, std::vector<float> *shift) {
+  RETURN_UNEXPECTED_IF_NULL(scale);
+  RETURN_UNEXPECTED_IF_NULL(shift);
+  for (size_t c = 0; c < scale->size(); c++) {
+    (*scale)[c] = (*scale)[c] * rescale_;
+    (*shift)[c] = (*shift)[c] * rescale_ + shift_;
+  }
+  return Status::OK();
+}
 Status RescaleOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
   outputs[0] = DataType(DataType::DE_FLOAT32);
@@ -37,8 +37,14 @@ class RescaleOp : public TensorOp {
   }
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+  bool IsBatchComputable() override { return true; }
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
+  ImageFusionType FusionType() override { return ImageFusionType::kPixelwise; }
+
+  Status FusePixelwise(std::vector<float> *scale, std::vector<float> *shift) override;
+
   std::string Name() const override { return kRescaleOp; }
 
  private:
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "minddata/dataset/kernels/image/resize_op.h"
+#include "minddata/dataset/kernels/image/image_geometry.h"
 
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/kernels/image/image_utils.h"
@@ -33,21 +34,33 @@ Status ResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   int32_t output_h, output_w = 0;
   int32_t input_h = static_cast<int>(input->shape()[0]);
   int32_t input_w = static_cast<int>(input->shape()[1]);
+  RETURN_IF_NOT_OK(GetOutputSize(input_h, input_w, &output_h, &output_w));
+  return Resize(input, output, output_h, output_w, 0, 0, interpolation_);
+}
+
+Status ResizeOp::FuseGeometry(ImageGeometry *geometry) {
+  RETURN_UNEXPECTED_IF_NULL(geometry);
+  int32_t output_h, output_w = 0;
+  RETURN_IF_NOT_OK(GetOutputSize(geometry->height(), geometry->width(), &output_h, &output_w));
+  return geometry->Resize(output_h, output_w);
+}
+
+Status ResizeOp::GetOutputSize(int32_t input_h, int32_t input_w, int32_t *output_h, int32_t *output_w) {
   if (size2_ == 0) {
     if (input_h < input_w) {
       CHECK_FAIL_RETURN_UNEXPECTED(input_h != 0, "Resize: the input height cannot be 0.");
-      output_h = size1_;
-      output_w = static_cast<int>(std::lround(static_cast<float>(input_w) / input_h * output_h));
+      *output_h = size1_;
+      *output_w = static_cast<int>(std::lround(static_cast<float>(input_w) / input_h * *output_h));
     } else {
       CHECK_FAIL_RETURN_UNEXPECTED(input_w != 0, "Resize: the input width cannot be 0.");
-      output_w = size1_;
-      output_h = static_cast<int>(std::lround(static_cast<float>(input_h) / input_w * output_w));
+      *output_w = size1_;
+      *output_h = static_cast<int>(std::lround(static_cast<float>(input_h) / input_w * *output_w));
     }
   } else {
-    output_h = size1_;
-    output_w = size2_;
+    *output_h = size1_;
+    *output_w = size2_;
   }
-  return Resize(input, output, output_h, output_w, 0, 0, interpolation_);
+  return Status::OK();
 }
 
 Status ResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
@@ -59,9 +59,23 @@ class ResizeOp : public TensorOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
+  ImageFusionType FusionType() override {
+    return interpolation_ == InterpolationMode::kLinear ? ImageFusionType::kGeometric : ImageFusionType::kNone;
+  }
+
+  Status FuseGeometry(ImageGeometry *geometry) override;
+
   std::string Name() const override { return kResizeOp; }
 
  protected:
+  // Get the size of the resized image
+  // @param input_h the height of the input image.
+  // @param input_w the width of the input image.
+  // @param output_h out: the height of the resized image.
+  // @param output_w out: the width of the resized image.
+  // @return Status
+  Status GetOutputSize(int32_t input_h, int32_t input_w, int32_t *output_h, int32_t *output_w);
+
   int32_t size1_;
   int32_t size2_;
   InterpolationMode interpolation_;
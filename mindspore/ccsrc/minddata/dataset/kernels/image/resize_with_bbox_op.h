@@ -47,6 +47,8 @@ class ResizeWithBBoxOp : public ResizeOp {
     return TensorOp::Compute(input, output);
   }
 
+  ImageFusionType FusionType() override { return ImageFusionType::kNone; }
+
   std::string Name() const override { return kResizeWithBBoxOp; }
 
   uint32_t NumInput() override { return 2; }
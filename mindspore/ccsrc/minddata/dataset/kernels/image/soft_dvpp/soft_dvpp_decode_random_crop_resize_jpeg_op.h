@@ -39,6 +39,8 @@ class SoftDvppDecodeRandomCropResizeJpegOp : public RandomCropAndResizeOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  ImageFusionType FusionType() override { return ImageFusionType::kNone; }
+
   std::string Name() const override { return kSoftDvppDecodeRandomCropResizeJpegOp; }
 
  protected:
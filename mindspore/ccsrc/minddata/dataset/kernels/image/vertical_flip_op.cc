@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/kernels/image/vertical_flip_op.h"
 
+#include "minddata/dataset/kernels/image/image_geometry.h"
 #include "minddata/dataset/kernels/image/image_utils.h"
 
 namespace mindspore {
@@ -24,5 +25,11 @@ Status VerticalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::shared
   IO_CHECK(input, output);
   return VerticalFlip(input, output);
 }
+
+Status VerticalFlipOp::FuseGeometry(ImageGeometry *geometry) {
+  RETURN_UNEXPECTED_IF_NULL(geometry);
+  geometry->FlipVertical();
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -47,6 +47,33 @@ Status TensorOp::Compute(const TensorRow &input, TensorRow *output) {
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+// Name: BatchCompute()
+// Description: This BatchCompute() take 1 Tensor holding a batch of rows and produce 1 Tensor.
+//              The derived class which is batch computable should override this function otherwise error.
+Status TensorOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  return Status(StatusCode::kMDUnexpectedError,
+                "Wrong BatchCompute() function is called. " + Name() + " can not run on a batch of rows.");
+}
+
+Status TensorOp::BatchCompute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(OneToOne() && input.size() == 1,
+                               "BatchCompute() can only accept one tensor as input for a OneToOne TensorOp.");
+  output->resize(1);
+  return BatchCompute(input[0], &(*output)[0]);
+}
+
+Status TensorOp::FuseGeometry(ImageGeometry *geometry) {
+  return Status(StatusCode::kMDUnexpectedError,
+                "Wrong FuseGeometry() function is called. " + Name() + " is not a geometric image operation.");
+}
+
+Status TensorOp::FusePixelwise(std::vector<float> *scale, std::vector<float> *shift) {
+  return Status(StatusCode::kMDUnexpectedError,
+                "Wrong FusePixelwise() function is called. " + Name() + " is not a pixel-wise image operation.");
+}
+
 Status TensorOp::Compute(const std::shared_ptr<DeviceTensor> &input, std::shared_ptr<DeviceTensor> *output) {
   IO_CHECK(input, output);
   return Status(StatusCode::kMDUnexpectedError,
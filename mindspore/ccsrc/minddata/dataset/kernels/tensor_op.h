@@ -69,6 +69,7 @@ constexpr char kDvppDecodePngOp[] = "DvppDecodePngOp";
 constexpr char kDvppNormalizeOp[] = "DvppNormalizeOp";
 constexpr char kDvppResizeJpegOp[] = "DvppResizeJpegOp";
 constexpr char kEqualizeOp[] = "EqualizeOp";
+constexpr char kFusedImageOp[] = "FusedImageOp";
 constexpr char kGaussianBlurOp[] = "GaussianBlurOp";
 constexpr char kHorizontalFlipOp[] = "HorizontalFlipOp";
 constexpr char kHwcToChwOp[] = "HWC2CHWOp";
@@ -154,6 +155,16 @@ constexpr char kPyFuncOp[] = "PyFuncOp";
 constexpr char kPluginOp[] = "PluginOp";
 constexpr char kNoOp[] = "NoOp";
 
+class ImageGeometry;
+
+// The part a TensorOp can take in a FusedImageOp, which runs a chain of image TensorOps in a single pass
+enum class ImageFusionType {
+  kNone = 0,   // can not be fused
+  kGeometric,  // moves the pixels of the image, e.g. crop, flip and resize
+  kPixelwise,  // maps each channel of a pixel to in * scale + shift, e.g. normalize and rescale
+  kHwcToChw    // turns the layout of the image from <H,W,C> into <C,H,W>
+};
+
 // A class that does a computation on a Tensor
 class TensorOp {
  public:
@@ -193,6 +204,39 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const std::shared_ptr<DeviceTensor> &input, std::shared_ptr<DeviceTensor> *output);
 
+  // Perform the operation on a batch of rows of one column, stacked along the first dimension as BatchOp does.
+  // The result of each row must be the same as the one of Compute(). Only called when IsBatchComputable().
+  // @param input shares the ownership of the batch Tensor (increase the ref count).
+  // @param output the address to a shared_ptr where the result will be placed.
+  // @return Status
+  virtual Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  // Perform BatchCompute() on a row holding the batch Tensor of one column.
+  // @param input is a vector of shared_ptr to Tensor (pass by const reference).
+  // @param output is the address to an empty vector of shared_ptr to Tensor.
+  // @return Status
+  virtual Status BatchCompute(const TensorRow &input, TensorRow *output);
+
+  // Returns true if the TensorOp can run on a whole batch with BatchCompute() instead of on each row.
+  // @return true/false
+  virtual bool IsBatchComputable() { return false; }
+
+  // Returns how the TensorOp can be fused with its neighbours into a FusedImageOp.
+  // @return ImageFusionType
+  virtual ImageFusionType FusionType() { return ImageFusionType::kNone; }
+
+  // Apply a kGeometric TensorOp to the geometry of an image instead of to its pixels, drawing its random
+  // parameters if any. Fails if the TensorOp can not be expressed on this geometry, e.g. a crop which needs padding.
+  // @param geometry the geometry of the image to update.
+  // @return Status
+  virtual Status FuseGeometry(ImageGeometry *geometry);
+
+  // Compose a kPixelwise TensorOp into the scale and shift of each channel of the pixels.
+  // @param scale in/out: the scale of each channel, sized to the number of channels of the image.
+  // @param shift in/out: the shift of each channel, sized to the number of channels of the image.
+  // @return Status
+  virtual Status FusePixelwise(std::vector<float> *scale, std::vector<float> *shift);
+
   // Returns true oif the TensorOp takes one input and returns one output.
   // @return true/false
   bool OneToOne() { return NumInput() == 1 && NumOutput() == 1; }
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -149,6 +150,29 @@ class Queue {
     tail_ = 0;
   }
 
+  // Change the capacity of the queue while it is in use. Elements in the queue are kept in order, so the
+  // capacity never goes below the number of elements currently in the queue.
+  Status Resize(size_t sz) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    size_t new_sz = std::max(sz, size());
+    if (new_sz == 0 || new_sz == sz_) {
+      return Status::OK();
+    }
+    MemGuard<T, Allocator<T>> new_arr(Services::GetAllocator<T>());
+    RETURN_IF_NOT_OK(new_arr.allocate(new_sz));
+    size_t n = 0;
+    for (auto i = head_; i < tail_; ++i) {
+      *(new_arr[n++]) = std::move(*(arr_[i % sz_]));
+    }
+    arr_ = std::move(new_arr);
+    sz_ = new_sz;
+    head_ = 0;
+    tail_ = n;
+    MS_LOG(DEBUG) << "Resize Q with uuid " << my_name_ << " to size " << sz_ << ".";
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   Status Register(TaskGroup *vg) {
     Status rc1 = empty_cv_.Register(vg->GetIntrpService());
     Status rc2 = full_cv_.Register(vg->GetIntrpService());
@@ -172,7 +196,8 @@ class Queue {
 
 // A container of queues with [] operator accessors.  Basically this is a wrapper over of a vector of queues
 // to help abstract/simplify code that is maintaining multiple queues.
-template <typename T>
+// @tparam Q the type of the queues, Queue<T> or any queue with the same interface, e.g. the ones in ring_queue.h.
+template <typename T, typename Q = Queue<T>>
 class QueueList {
  public:
   QueueList() {}
@@ -180,7 +205,7 @@ class QueueList {
   void Init(int num_queues, int capacity) {
     queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      queue_list_.emplace_back(std::make_unique<Q>(capacity));
     }
   }
 
@@ -197,9 +222,9 @@ class QueueList {
 
   auto size() const { return queue_list_.size(); }
 
-  std::unique_ptr<Queue<T>> &operator[](const int index) { return queue_list_[index]; }
+  std::unique_ptr<Q> &operator[](const int index) { return queue_list_[index]; }
 
-  const std::unique_ptr<Queue<T>> &operator[](const int index) const { return queue_list_[index]; }
+  const std::unique_ptr<Q> &operator[](const int index) const { return queue_list_[index]; }
 
   ~QueueList() = default;
 
@@ -207,7 +232,7 @@ class QueueList {
   // Queue contains non-copyable objects, so it cannot be added to a vector due to the vector
   // requirement that objects must have copy semantics.  To resolve this, we use a vector of unique
   // pointers.  This allows us to provide dynamic creation of queues in a container.
-  std::vector<std::unique_ptr<Queue<T>>> queue_list_;
+  std::vector<std::unique_ptr<Q>> queue_list_;
 };
 }  // namespace dataset
 }  // namespace mindspore
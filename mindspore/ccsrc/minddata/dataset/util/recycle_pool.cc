@@ -0,0 +1,325 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/recycle_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+std::atomic<uint64_t> g_next_pool_id(0);
+std::atomic<size_t> g_process_cached_bytes(0);
+
+// Count a block into the free blocks of the process, unless it would go over the cap
+bool ReserveProcessBytes(size_t n) {
+  size_t cached = g_process_cached_bytes.load(std::memory_order_relaxed);
+  do {
+    if (cached + n > RecyclePool::kMaxProcessCachedBytes) {
+      return false;
+    }
+  } while (!g_process_cached_bytes.compare_exchange_weak(cached, cached + n, std::memory_order_relaxed));
+  return true;
+}
+}  // namespace
+
+// The free blocks of one thread. Only the owner thread touches the free lists, other threads only push to the
+// remote stack, which the owner takes as a whole, so the stack has no ABA problem.
+class RecyclePool::ThreadCache {
+ public:
+  explicit ThreadCache(size_t max_cached_bytes)
+      : free_lists_(kNumSizeClasses, nullptr),
+        counts_(kNumSizeClasses, 0),
+        cached_bytes_(0),
+        max_cached_bytes_(max_cached_bytes),
+        remote_free_(nullptr),
+        owned_(true),
+        retired_(false) {}
+
+  ~ThreadCache() { FreeAll(); }
+
+  // Give all the free blocks back to the system, once the pool is destroyed. The entry of the owner thread is
+  // dropped the next time that thread looks for a cache.
+  void Retire() {
+    FreeAll();
+    retired_.store(true, std::memory_order_release);
+  }
+
+  bool Retired() const { return retired_.load(std::memory_order_acquire); }
+
+  // Take a free block of a size class, null if there is none
+  BlockHeader *Pop(uint32_t size_class) {
+    if (free_lists_[size_class] == nullptr) {
+      DrainRemote();
+    }
+    BlockHeader *block = free_lists_[size_class];
+    if (block != nullptr) {
+      free_lists_[size_class] = Next(block);
+      counts_[size_class]--;
+      cached_bytes_ -= ClassSize(size_class);
+      g_process_cached_bytes.fetch_sub(ClassSize(size_class), std::memory_order_relaxed);
+    }
+    return block;
+  }
+
+  // Keep a free block of the owner thread, or give it back to the system if the cache or the process is full
+  bool Push(BlockHeader *block) {
+    size_t class_size = ClassSize(block->size_class);
+    if (cached_bytes_ + class_size > max_cached_bytes_ || !ReserveProcessBytes(class_size)) {
+      free(block);
+      return false;
+    }
+    Next(block) = free_lists_[block->size_class];
+    free_lists_[block->size_class] = block;
+    counts_[block->size_class]++;
+    cached_bytes_ += class_size;
+    return true;
+  }
+
+  // Return a block freed by another thread
+  void PushRemote(BlockHeader *block) {
+    BlockHeader *head = remote_free_.load(std::memory_order_relaxed);
+    do {
+      Next(block) = head;
+    } while (!remote_free_.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  int64_t Count(uint32_t size_class) const { return counts_[size_class]; }
+
+  // Claim a cache which no thread owns
+  bool Adopt() {
+    bool owned = false;
+    return owned_.compare_exchange_strong(owned, true, std::memory_order_acquire);
+  }
+
+  void Release() { owned_.store(false, std::memory_order_release); }
+
+ private:
+  // The payload of a free block links it to the next free block
+  static BlockHeader *&Next(BlockHeader *block) { return *reinterpret_cast<BlockHeader **>(block + 1); }
+
+  void FreeAll() {
+    DrainRemote();
+    for (uint32_t size_class = 0; size_class < kNumSizeClasses; size_class++) {
+      BlockHeader *block = free_lists_[size_class];
+      while (block != nullptr) {
+        BlockHeader *next = Next(block);
+        free(block);
+        block = next;
+      }
+      free_lists_[size_class] = nullptr;
+      counts_[size_class] = 0;
+    }
+    g_process_cached_bytes.fetch_sub(cached_bytes_, std::memory_order_relaxed);
+    cached_bytes_ = 0;
+  }
+
+  void DrainRemote() {
+    BlockHeader *block = remote_free_.exchange(nullptr, std::memory_order_acquire);
+    while (block != nullptr) {
+      BlockHeader *next = Next(block);
+      (void)Push(block);
+      block = next;
+    }
+  }
+
+  std::vector<BlockHeader *> free_lists_;
+  std::vector<int64_t> counts_;
+  size_t cached_bytes_;
+  size_t max_cached_bytes_;
+  std::atomic<BlockHeader *> remote_free_;
+  std::atomic<bool> owned_;
+  std::atomic<bool> retired_;
+};
+
+size_t RecyclePool::ClassSize(uint32_t size_class) {
+  if (size_class == 0) {
+    return kMinBlockSize;
+  }
+  int shift = kMinBlockShift + static_cast<int>(size_class - 1) / kClassesPerShift;
+  size_t step = static_cast<size_t>(1) << (shift - 2);
+  return (static_cast<size_t>(1) << shift) + ((size_class - 1) % kClassesPerShift + 1) * step;
+}
+
+uint32_t RecyclePool::SizeClass(size_t n, size_t *class_size) {
+  if (n <= kMinBlockSize) {
+    *class_size = kMinBlockSize;
+    return 0;
+  }
+  if (n > (static_cast<size_t>(1) << kMaxBlockShift)) {
+    *class_size = n;
+    return kNumSizeClasses;
+  }
+  // 2^shift < n <= 2^(shift+1), split into kClassesPerShift steps
+  int shift = 63 - __builtin_clzll(static_cast<uint64_t>(n - 1));
+  size_t step = static_cast<size_t>(1) << (shift - 2);
+  size_t sub = (n - 1 - (static_cast<size_t>(1) << shift)) / step;
+  *class_size = (static_cast<size_t>(1) << shift) + (sub + 1) * step;
+  return 1 + static_cast<uint32_t>((shift - kMinBlockShift) * kClassesPerShift + sub);
+}
+
+RecyclePool::RecyclePool(size_t max_cached_bytes)
+    : pool_id_(g_next_pool_id++), max_cached_bytes_(max_cached_bytes), system_allocations_(0) {}
+
+RecyclePool::~RecyclePool() {
+  std::unique_lock<std::mutex> lock(mux_);
+  for (auto &cache : caches_) {
+    cache->Retire();
+  }
+}
+
+size_t RecyclePool::ProcessCachedBytes() { return g_process_cached_bytes.load(std::memory_order_relaxed); }
+
+RecyclePool::ThreadCache *RecyclePool::LocalCache(bool create) {
+  // The caches the calling thread owns, one per pool, given back to their pools when the thread exits.
+  // Each entry shares the cache with its pool, so a pool may go away before the threads which used it.
+  // Memory can still be freed after the caches of the thread are destroyed, e.g. by static destructors.
+  thread_local bool destroyed = false;
+  struct LocalCaches {
+    std::vector<std::pair<uint64_t, std::shared_ptr<ThreadCache>>> caches;
+    ~LocalCaches() {
+      for (auto &cache : caches) {
+        cache.second->Release();
+      }
+      destroyed = true;
+    }
+  };
+  if (destroyed) {
+    return nullptr;
+  }
+  thread_local LocalCaches local;
+  for (auto &cache : local.caches) {
+    if (cache.first == pool_id_) {
+      return cache.second.get();
+    }
+  }
+  // Drop the caches of the pools which are gone, a pool id is never reused
+  local.caches.erase(std::remove_if(local.caches.begin(), local.caches.end(),
+                                    [](const std::pair<uint64_t, std::shared_ptr<ThreadCache>> &cache) {
+                                      return cache.second->Retired();
+                                    }),
+                     local.caches.end());
+  if (!create) {
+    return nullptr;
+  }
+
+  std::shared_ptr<ThreadCache> cache;
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    for (auto &orphan : caches_) {
+      if (orphan->Adopt()) {
+        cache = orphan;
+        break;
+      }
+    }
+    if (cache == nullptr) {
+      cache = std::make_shared<ThreadCache>(max_cached_bytes_);
+      caches_.push_back(cache);
+    }
+  }
+  local.caches.emplace_back(pool_id_, cache);
+  return cache.get();
+}
+
+Status RecyclePool::SystemAllocate(ThreadCache *origin, uint32_t size_class, size_t class_size,
+                                   BlockHeader **block) {
+  void *p = malloc(sizeof(BlockHeader) + class_size);
+  if (p == nullptr) {
+    return Status(StatusCode::kMDOutOfMemory);
+  }
+  system_allocations_++;
+  *block = static_cast<BlockHeader *>(p);
+  (*block)->origin = origin;
+  (*block)->size_class = size_class;
+  (*block)->reserved = 0;
+  return Status::OK();
+}
+
+Status RecyclePool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  size_t class_size = 0;
+  uint32_t size_class = SizeClass(n, &class_size);
+  ThreadCache *cache = nullptr;
+  BlockHeader *block = nullptr;
+  if (size_class < kNumSizeClasses) {
+    cache = LocalCache(true);
+  }
+  if (cache != nullptr) {
+    block = cache->Pop(size_class);
+  }
+  if (block == nullptr) {
+    RETURN_IF_NOT_OK(SystemAllocate(cache, size_class, class_size, &block));
+  }
+  *p = block + 1;
+  return Status::OK();
+}
+
+Status RecyclePool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  BlockHeader *block = static_cast<BlockHeader *>(*p) - 1;
+  // The block may already be large enough
+  if (old_sz >= new_sz || (block->origin != nullptr && ClassSize(block->size_class) >= new_sz)) {
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+  if (err) {
+    Deallocate(q);
+    RETURN_STATUS_UNEXPECTED(std::to_string(err));
+  }
+  Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+void RecyclePool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  BlockHeader *block = static_cast<BlockHeader *>(p) - 1;
+  ThreadCache *origin = block->origin;
+  if (origin == nullptr) {
+    free(block);
+  } else if (origin == LocalCache(false)) {
+    (void)origin->Push(block);
+  } else {
+    origin->PushRemote(block);
+  }
+}
+
+uint64_t RecyclePool::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+
+Status RecyclePool::Reserve(size_t n, int32_t count) {
+  size_t class_size = 0;
+  uint32_t size_class = SizeClass(n, &class_size);
+  // Blocks of this size are not cached
+  RETURN_OK_IF_TRUE(size_class == kNumSizeClasses);
+  ThreadCache *cache = LocalCache(true);
+  RETURN_OK_IF_TRUE(cache == nullptr);
+  while (cache->Count(size_class) < count) {
+    BlockHeader *block = nullptr;
+    RETURN_IF_NOT_OK(SystemAllocate(cache, size_class, class_size, &block));
+    // Stop when the cache is full
+    RETURN_OK_IF_TRUE(!cache->Push(block));
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
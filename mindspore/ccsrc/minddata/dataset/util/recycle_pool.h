@@ -0,0 +1,121 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLE_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLE_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A memory pool which recycles the blocks it gives out instead of returning them to the system.
+// Each thread allocates from its own cache of free blocks, one free list per size class, without locking.
+// A block always goes back to the cache of the thread which allocated it: a block freed by the thread itself is
+// pushed to the free list, a block freed by another thread (e.g. a tensor dropped by the consumer of the pipeline)
+// is pushed to a lock free stack of the cache which its owner drains when the free list runs dry. So a pipeline
+// thread which produces the same sizes over and over reuses its own blocks and does no system allocation in steady
+// state. Blocks larger than the largest size class are not cached.
+// The cache of a thread which exits is adopted by the next thread which needs one, together with its blocks.
+// The free blocks of all the caches of all the pools in the process are capped together as well, and the caches of a
+// pool give their blocks back to the system when the pool is destroyed.
+class RecyclePool : public MemoryPool {
+ public:
+  // Default values
+  static constexpr size_t kDefMaxCachedBytes = 512 * 1024 * 1024;
+
+  // The most bytes of free blocks all the thread caches of the process keep together
+  static constexpr size_t kMaxProcessCachedBytes = static_cast<size_t>(2) * 1024 * 1024 * 1024;
+
+  // Constructor
+  // @param max_cached_bytes the most bytes of free blocks each thread cache keeps, the rest go back to the system.
+  explicit RecyclePool(size_t max_cached_bytes = kDefMaxCachedBytes);
+
+  RecyclePool(const RecyclePool &) = delete;
+
+  RecyclePool &operator=(const RecyclePool &) = delete;
+
+  ~RecyclePool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override { return 100; }
+
+  // Make sure the cache of the calling thread holds a number of free blocks of a given size, so the first
+  // allocations of a known size, e.g. the output tensors of a batch, are not served by the system either.
+  // @param n the size of the blocks.
+  // @param count the number of free blocks to hold.
+  // @return Status
+  Status Reserve(size_t n, int32_t count);
+
+  // @return the number of blocks the pool has obtained from the system so far.
+  uint64_t SystemAllocations() const { return system_allocations_; }
+
+  // @return the bytes of free blocks all the thread caches of the process keep.
+  static size_t ProcessCachedBytes();
+
+ private:
+  class ThreadCache;
+
+  // Every block starts with a header, which keeps the payload 16 bytes aligned as malloc does
+  struct BlockHeader {
+    ThreadCache *origin;  // the cache the block returns to, null for a block which is not cached
+    uint32_t size_class;
+    uint32_t reserved;
+  };
+
+  static constexpr size_t kMinBlockSize = 64;
+  static constexpr int kMinBlockShift = 6;
+  static constexpr int kMaxBlockShift = 30;
+  static constexpr int kClassesPerShift = 4;
+  static constexpr uint32_t kNumSizeClasses = 1 + (kMaxBlockShift - kMinBlockShift) * kClassesPerShift;
+
+  // Get the size class a request falls into, 4 classes between two powers of 2 keep the waste under 25%.
+  // @param n the size of the request.
+  // @param class_size out: the size of the blocks of the class.
+  // @return the size class, kNumSizeClasses if the request is too large to be cached.
+  static uint32_t SizeClass(size_t n, size_t *class_size);
+
+  // @return the size of the blocks of a size class.
+  static size_t ClassSize(uint32_t size_class);
+
+  // Get the cache of the calling thread, adopting or creating one if the thread has none.
+  // @param create false to return null instead of creating a cache.
+  ThreadCache *LocalCache(bool create);
+
+  // Get a block from the system
+  Status SystemAllocate(ThreadCache *origin, uint32_t size_class, size_t class_size, BlockHeader **block);
+
+  uint64_t pool_id_;
+  size_t max_cached_bytes_;
+  std::mutex mux_;  // protects caches_
+  std::vector<std::shared_ptr<ThreadCache>> caches_;
+  std::atomic<uint64_t> system_allocations_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RECYCLE_POOL_H_
@@ -0,0 +1,462 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+constexpr size_t kRingCacheLineSize = 64;
+// Set in the tail of a ring once it is closed, see RingQueue::Resize
+constexpr size_t kRingClosed = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
+// A bounded lock free ring for any number of producers and consumers (D. Vyukov's bounded MPMC queue).
+// Every slot carries a sequence number telling whether it is ready to be written or read in the current lap,
+// so producers only contend on the tail and consumers only on the head.
+template <typename T>
+class MpmcRing {
+ public:
+  // @param sz the number of slots, rounded up to a power of 2.
+  explicit MpmcRing(size_t sz) : mask_(RoundUp(sz) - 1), slots_(new Slot[mask_ + 1]), head_(0), tail_(0) {
+    for (size_t i = 0; i <= mask_; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+  size_t size() const {
+    // The head is loaded first, so it is never ahead of the tail
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire) & ~kRingClosed;
+    return tail - head;
+  }
+
+  // Move an element into the ring, unless the ring holds limit elements or more.
+  // @return false if the ring is full or closed, the element is untouched then.
+  bool TryPush(T *ele, size_t limit) {
+    Slot *slot = nullptr;
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      if ((pos & kRingClosed) != 0) {
+        return false;
+      }
+      size_t head = head_.load(std::memory_order_acquire);
+      // A stale pos may be behind the head, the CAS below sorts it out
+      if (pos >= head && pos - head >= limit) {
+        return false;
+      }
+      slot = &slots_[pos & mask_];
+      auto dif = static_cast<int64_t>(slot->seq.load(std::memory_order_acquire) - pos);
+      if (dif == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(*ele);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Move the oldest element out of the ring.
+  // @return false if the ring is empty.
+  bool TryPop(T *p) {
+    Slot *slot = nullptr;
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      slot = &slots_[pos & mask_];
+      auto dif = static_cast<int64_t>(slot->seq.load(std::memory_order_acquire) - (pos + 1));
+      if (dif == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    *p = std::move(slot->value);
+    slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Fail all the pushes from now on, the elements pushed so far can still be popped.
+  void Close() { (void)tail_.fetch_or(kRingClosed, std::memory_order_acq_rel); }
+
+  bool closed() const { return (tail_.load(std::memory_order_acquire) & kRingClosed) != 0; }
+
+  // Whether the ring is closed and all its elements are popped.
+  bool drained() const {
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return (tail & kRingClosed) != 0 && head_.load(std::memory_order_acquire) == (tail & ~kRingClosed);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    T value;
+  };
+
+  static size_t RoundUp(size_t sz) {
+    size_t n = 1;
+    while (n < sz) {
+      n <<= 1;
+    }
+    return n;
+  }
+
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(kRingCacheLineSize) std::atomic<size_t> head_;
+  alignas(kRingCacheLineSize) std::atomic<size_t> tail_;
+};
+
+// A bounded lock free ring for exactly one producer thread and one consumer thread at a time.
+// Each side keeps a copy of the index of the other side and only reloads it when the ring looks full or empty.
+template <typename T>
+class SpscRing {
+ public:
+  // @param sz the number of slots, rounded up to a power of 2.
+  explicit SpscRing(size_t sz)
+      : mask_(RoundUp(sz) - 1), slots_(new T[mask_ + 1]), head_(0), tail_cache_(0), tail_(0), head_cache_(0) {}
+
+  size_t capacity() const { return mask_ + 1; }
+
+  size_t size() const {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire) & ~kRingClosed;
+    return tail - head;
+  }
+
+  // Move an element into the ring, unless the ring holds limit elements or more. Producer only.
+  // @return false if the ring is full or closed, the element is untouched then.
+  bool TryPush(T *ele, size_t limit) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if ((tail & kRingClosed) != 0) {
+      return false;
+    }
+    limit = std::min(limit, mask_ + 1);
+    if (tail - head_cache_ >= limit) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ >= limit) {
+        return false;
+      }
+    }
+    size_t pos = tail;
+    slots_[pos & mask_] = std::move(*ele);
+    // Close may run on another thread at any time, then the element goes back to the caller
+    if (!tail_.compare_exchange_strong(tail, pos + 1, std::memory_order_release, std::memory_order_relaxed)) {
+      *ele = std::move(slots_[pos & mask_]);
+      return false;
+    }
+    return true;
+  }
+
+  // Move the oldest element out of the ring. Consumer only.
+  // @return false if the ring is empty.
+  bool TryPop(T *p) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire) & ~kRingClosed;
+      if (head == tail_cache_) {
+        return false;
+      }
+    }
+    *p = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Fail all the pushes from now on, the elements pushed so far can still be popped.
+  void Close() { (void)tail_.fetch_or(kRingClosed, std::memory_order_acq_rel); }
+
+  bool closed() const { return (tail_.load(std::memory_order_acquire) & kRingClosed) != 0; }
+
+  // Whether the ring is closed and all its elements are popped.
+  bool drained() const {
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return (tail & kRingClosed) != 0 && head_.load(std::memory_order_acquire) == (tail & ~kRingClosed);
+  }
+
+ private:
+  static size_t RoundUp(size_t sz) {
+    size_t n = 1;
+    while (n < sz) {
+      n <<= 1;
+    }
+    return n;
+  }
+
+  const size_t mask_;
+  std::unique_ptr<T[]> slots_;
+  // consumer side
+  alignas(kRingCacheLineSize) std::atomic<size_t> head_;
+  size_t tail_cache_;
+  // producer side
+  alignas(kRingCacheLineSize) std::atomic<size_t> tail_;
+  size_t head_cache_;
+};
+
+// A thread safe bounded queue over a lock free ring, a drop-in replacement of Queue<T>.
+// Add and PopFront take no lock while the queue is neither full nor empty. A thread which finds the queue full
+// (or empty) spins for a short while, then parks on a CondVar, so it still wakes up on an interrupt of its task
+// group. The other side only takes the lock to wake it up when a thread is parked.
+// The ring only holds the initial capacity. When Resize grows the queue beyond it, the ring is closed and a
+// bigger one is chained after it; the consumers drain the old ring before moving to the new one.
+template <typename T, typename Ring>
+class RingQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+
+  explicit RingQueue(int sz) : sz_(std::max(sz, 1)), full_waiters_(0), empty_waiters_(0) {
+    segments_.push_back(std::make_unique<Segment>(static_cast<size_t>(std::max(sz, 1))));
+    push_seg_.store(segments_.back().get(), std::memory_order_relaxed);
+    pop_seg_.store(segments_.back().get(), std::memory_order_relaxed);
+  }
+
+  virtual ~RingQueue() = default;
+
+  size_t size() const {
+    size_t n = 0;
+    for (Segment *seg = pop_seg_.load(std::memory_order_acquire); seg != nullptr;
+         seg = seg->next.load(std::memory_order_acquire)) {
+      n += seg->ring.size();
+    }
+    return n;
+  }
+
+  size_t capacity() const { return sz_.load(std::memory_order_relaxed); }
+
+  bool empty() const { return size() == 0; }
+
+  void Reset() { ResetQue(); }
+
+  // Producer
+  Status Add(const_reference ele) noexcept {
+    T copy(ele);
+    return WaitAndAdd(&copy);
+  }
+
+  Status Add(T &&ele) noexcept { return WaitAndAdd(&ele); }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    T ele(std::forward<Ts>(args)...);
+    return WaitAndAdd(&ele);
+  }
+
+  // Consumer
+  Status PopFront(pointer p) {
+    if (TryPop(p)) {
+      Wake(&full_waiters_, &full_cv_);
+      return Status::OK();
+    }
+    return WaitAndPop(p);
+  }
+
+  void ResetQue() noexcept {
+    // Drain the elements, their destructors run as they go out of scope
+    T val;
+    while (TryPop(&val)) {
+    }
+    std::unique_lock<std::mutex> _lock(mux_);
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+  }
+
+  // Change the capacity of the queue while it is in use. The capacity never goes below the number of elements
+  // currently in the queue. Growing beyond the ring allocates a new ring, the elements are not moved.
+  Status Resize(size_t sz) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    size_t new_sz = std::max(sz, size());
+    RETURN_OK_IF_TRUE(new_sz == 0 || new_sz == capacity());
+    Segment *tail_seg = push_seg_.load(std::memory_order_relaxed);
+    if (new_sz > tail_seg->ring.capacity()) {
+      segments_.push_back(std::make_unique<Segment>(new_sz));
+      Segment *seg = segments_.back().get();
+      tail_seg->next.store(seg, std::memory_order_release);
+      push_seg_.store(seg, std::memory_order_release);
+      // A producer which finds the old ring closed sees the new one in push_seg_
+      tail_seg->ring.Close();
+    }
+    sz_.store(new_sz, std::memory_order_relaxed);
+    MS_LOG(DEBUG) << "Resize ring queue to size " << new_sz << ".";
+    full_cv_.NotifyAll();
+    empty_cv_.NotifyAll();
+    return Status::OK();
+  }
+
+  Status Register(TaskGroup *vg) {
+    Status rc1 = empty_cv_.Register(vg->GetIntrpService());
+    Status rc2 = full_cv_.Register(vg->GetIntrpService());
+    if (rc1.IsOk()) {
+      return rc2;
+    } else {
+      return rc1;
+    }
+  }
+
+ private:
+  // Number of tries before a thread parks, the later ones yield the cpu
+  static constexpr int32_t kSpinCount = 64;
+  static constexpr int32_t kBusySpinCount = 16;
+
+  // The closed rings are kept until the queue goes away, a consumer may still be reading one
+  struct Segment {
+    explicit Segment(size_t sz) : ring(sz), next(nullptr) {}
+    Ring ring;
+    std::atomic<Segment *> next;
+  };
+
+  bool TryAdd(T *ele) {
+    while (true) {
+      Segment *seg = push_seg_.load(std::memory_order_acquire);
+      size_t limit = capacity();
+      Segment *pop_seg = pop_seg_.load(std::memory_order_acquire);
+      // The elements left in the older rings count against the capacity too
+      for (; pop_seg != seg && pop_seg != nullptr; pop_seg = pop_seg->next.load(std::memory_order_acquire)) {
+        size_t n = pop_seg->ring.size();
+        limit = limit > n ? limit - n : 0;
+      }
+      if (seg->ring.TryPush(ele, limit)) {
+        return true;
+      }
+      if (!seg->ring.closed()) {
+        return false;
+      }
+    }
+  }
+
+  bool TryPop(T *p) {
+    while (true) {
+      Segment *seg = pop_seg_.load(std::memory_order_acquire);
+      if (seg->ring.TryPop(p)) {
+        return true;
+      }
+      Segment *next = seg->next.load(std::memory_order_acquire);
+      if (next == nullptr || !seg->ring.drained()) {
+        return false;
+      }
+      (void)pop_seg_.compare_exchange_strong(seg, next, std::memory_order_acq_rel);
+    }
+  }
+
+  Status WaitAndAdd(T *ele) {
+    bool added = Spin([this, ele]() { return TryAdd(ele); });
+    Status rc;
+    if (!added) {
+      rc = Park(&full_waiters_, &full_cv_, [this, ele]() { return TryAdd(ele); }, &added);
+    }
+    if (added) {
+      Wake(&empty_waiters_, &empty_cv_);
+    } else {
+      empty_cv_.Interrupt();
+    }
+    return rc;
+  }
+
+  Status WaitAndPop(T *p) {
+    bool popped = Spin([this, p]() { return TryPop(p); });
+    Status rc;
+    if (!popped) {
+      rc = Park(&empty_waiters_, &empty_cv_, [this, p]() { return TryPop(p); }, &popped);
+    }
+    if (popped) {
+      Wake(&full_waiters_, &full_cv_);
+    } else {
+      full_cv_.Interrupt();
+    }
+    return rc;
+  }
+
+  template <typename F>
+  static bool Spin(const F &try_op) {
+    for (int32_t i = 0; i < kSpinCount; ++i) {
+      if (try_op()) {
+        return true;
+      }
+      if (i >= kBusySpinCount) {
+        std::this_thread::yield();
+      }
+    }
+    return false;
+  }
+
+  // Wait on a CondVar until the operation succeeds. The fence after announcing the waiter pairs with the one
+  // in Wake, so either the operation sees the change of the other side or the other side sees the waiter.
+  template <typename F>
+  Status Park(std::atomic<int32_t> *waiters, CondVar *cv, const F &try_op, bool *done) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    waiters->fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Status rc = cv->Wait(&_lock, [&try_op, done]() { return *done || (*done = try_op()); });
+    waiters->fetch_sub(1, std::memory_order_relaxed);
+    return rc;
+  }
+
+  // Wake up the threads parked on a CondVar, if there is any.
+  void Wake(std::atomic<int32_t> *waiters, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> _lock(mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  std::vector<std::unique_ptr<Segment>> segments_;  // guarded by mux_
+  std::atomic<Segment *> push_seg_;
+  std::atomic<Segment *> pop_seg_;
+  std::atomic<size_t> sz_;
+  std::atomic<int32_t> full_waiters_;
+  std::atomic<int32_t> empty_waiters_;
+  std::mutex mux_;  // only taken to park, to wake up parked threads and to resize
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+
+// Queues for connectors whose queues may see more than one producer or consumer thread
+template <typename T>
+using MpmcQueue = RingQueue<T, MpmcRing<T>>;
+
+// Queues fed by one thread and drained by another, e.g. the queues from the master thread to each worker
+template <typename T>
+using SpscQueue = RingQueue<T, SpscRing<T>>;
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_QUEUE_H_
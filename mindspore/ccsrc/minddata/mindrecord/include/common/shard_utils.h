@@ -57,6 +57,9 @@ namespace mindspore {
 namespace mindrecord {
 using json = nlohmann::json;
 
+// Scalar (non-blob) fields of one row packed by ShardColumn, the typed alternative to a json object per row
+using ScalarRow = std::vector<uint8_t>;
+
 const int kInt0 = 0;
 const int kInt1 = 1;
 const int kInt2 = 2;
@@ -112,6 +115,9 @@ const int kMaxConsumerCount = 128;
 
 const int kMaxSchemaCount = 1;
 const int kMaxThreadCount = 32;
+const int kMaxStreamBatches = 2;  // batches queued by ShardWriter in streaming mode
+const int kMaxCompressThreads = 4;       // threads compressing the blobs of one batch, the caller included
+const int kMinBlobsPerCompressThread = 64;
 const int kMaxFieldCount = 100;
 
 // Minimum free disk size
@@ -71,6 +71,32 @@ class __attribute__((visibility("default"))) ShardColumn {
                                  ColumnDataType *column_data_type, uint64_t *column_data_type_size,
                                  std::vector<int64_t> *column_shape);
 
+  /// \brief get column value by column name, taking the scalar fields from a ScalarRow instead of json.
+  ///        A scalar value points into scalar_row, so it is valid as long as the row is.
+  MSRStatus GetColumnValueFromRow(const std::string &column_name, const std::vector<uint8_t> &columns_blob,
+                                  const ScalarRow &scalar_row, const unsigned char **data,
+                                  std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
+                                  ColumnDataType *column_data_type, uint64_t *column_data_type_size,
+                                  std::vector<int64_t> *column_shape);
+
+  /// \brief make an empty ScalarRow, in which every column of the schema owns a presence byte and an 8 byte slot
+  void InitScalarRow(ScalarRow *scalar_row) const;
+
+  /// \brief pack the scalar fields of a json row, converted to the column types as GetColumnFromJson does
+  MSRStatus EncodeScalarRow(const json &columns_json, ScalarRow *scalar_row);
+
+  /// \brief unpack a ScalarRow to json, for the python API
+  json DecodeScalarRow(const ScalarRow &scalar_row) const;
+
+  /// \brief set an int32 or int64 column of a ScalarRow
+  MSRStatus SetScalarInt(const std::string &column_name, int64_t value, ScalarRow *scalar_row);
+
+  /// \brief set a float32 or float64 column of a ScalarRow
+  MSRStatus SetScalarFloat(const std::string &column_name, double value, ScalarRow *scalar_row);
+
+  /// \brief set a string column of a ScalarRow
+  MSRStatus SetScalarString(const std::string &column_name, const std::string &value, ScalarRow *scalar_row);
+
   /// \brief compress blob
   std::vector<uint8_t> CompressBlob(const std::vector<uint8_t> &blob, int64_t *compression_size);
 
@@ -123,6 +149,12 @@ class __attribute__((visibility("default"))) ShardColumn {
   /// \brief check if column name is available
   ColumnCategory CheckColumnName(const std::string &column_name);
 
+  /// \brief get id of a scalar column, checking that the row is initialized
+  MSRStatus GetScalarColumnId(const std::string &column_name, const ScalarRow &scalar_row, uint64_t *column_id);
+
+  /// \brief copy the value of a column into its slot, or after the slots for string and bytes
+  void SetScalarBytes(uint64_t column_id, const void *data, uint64_t n_bytes, ScalarRow *scalar_row) const;
+
   /// \brief compress integer column
   static vector<uint8_t> CompressInt(const vector<uint8_t> &src_bytes, const IntegerType &int_type);
 
@@ -169,6 +201,7 @@ class __attribute__((visibility("default"))) ShardColumn {
   std::unordered_map<std::string, uint64_t> blob_column_id_;  // blob column name id map
   bool has_compress_blob_;                                    // if has compress blob
   uint64_t num_blob_column_;                                  // number of blob columns
+  uint64_t scalar_slot_offset_;                               // offset of the first slot in a ScalarRow
 };
 }  // namespace mindrecord
 }  // namespace mindspore
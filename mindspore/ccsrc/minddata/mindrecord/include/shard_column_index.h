@@ -0,0 +1,114 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_INDEX_H_
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+const char kColumnIndexSuffix[] = ".idx";
+
+/// \brief Binary, memory mapped copy of the INDEXES table of one shard, written next to the index database.
+///
+/// A row is resolved with array lookups instead of one sqlite query per sample. All values are 8 bytes wide:
+///   magic, version, size and modification time of the shard file, number of rows, number of index fields
+///   per index field: type, name length, name padded to 8 bytes
+///   ROW_GROUP_ID, PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END arrays
+///   per index field: int64 or float64 array, or string offsets [rows + 1] followed by the padded characters
+class __attribute__((visibility("default"))) ShardColumnIndex {
+ public:
+  enum IndexMeta {
+    kRowGroupId = 0,
+    kPageIdRaw,
+    kPageOffsetRaw,
+    kPageOffsetRawEnd,
+    kPageOffsetBlob,
+    kPageOffsetBlobEnd,
+  };
+  enum ColumnType : uint64_t { kColumnInt64 = 0, kColumnFloat64, kColumnString };
+
+  ShardColumnIndex() = default;
+
+  ~ShardColumnIndex();
+
+  ShardColumnIndex(const ShardColumnIndex &) = delete;
+
+  ShardColumnIndex &operator=(const ShardColumnIndex &) = delete;
+
+  /// \brief declare an index field before rows are added
+  /// \param[in] name field name in the schema
+  /// \param[in] place_holder sqlite place holder of the field, as generated by ShardIndexGenerator
+  /// \param[in] db_type sqlite type of the field
+  void AddColumn(const std::string &name, const std::string &place_holder, const std::string &db_type);
+
+  /// \brief add one row of the INDEXES table, in the (place holder, sqlite type, value) form of ShardIndexGenerator
+  /// \return FAILED if a value does not parse as the type of its field
+  MSRStatus AddRow(const std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
+
+  /// \brief write the index of the rows added so far next to the shard file
+  MSRStatus Save(const std::string &shard_file) const;
+
+  /// \brief map the index next to the shard file, fails if it is missing or was not built for this shard file
+  MSRStatus Load(const std::string &shard_file);
+
+  uint64_t GetRowCount() const { return row_count_; }
+
+  uint64_t GetMeta(IndexMeta meta, uint64_t row_id) const { return meta_[meta][row_id]; }
+
+  /// \brief get position of the index field, -1 if it is not in the index
+  int GetColumnId(const std::string &name) const;
+
+  ColumnType GetColumnType(int column_id) const { return columns_[column_id].type; }
+
+  int64_t GetInt64(int column_id, uint64_t row_id) const;
+
+  double GetFloat64(int column_id, uint64_t row_id) const;
+
+  std::string GetString(int column_id, uint64_t row_id) const;
+
+ private:
+  static constexpr int kIndexMetaCount = 6;
+
+  struct Column {
+    std::string name;
+    std::string place_holder;
+    ColumnType type;
+    std::vector<uint64_t> values;      // int64 or float64 bits of each row, while building
+    std::vector<std::string> strings;  // string of each row, while building
+    const uint64_t *data = nullptr;    // values, or string offsets, of the mapped index
+    const char *chars = nullptr;       // string characters of the mapped index
+  };
+
+  void Unmap();
+
+  uint64_t row_count_ = 0;
+  std::vector<Column> columns_;
+  std::unordered_map<std::string, int> column_ids_;
+  std::vector<uint64_t> meta_values_[kIndexMetaCount];  // meta arrays while building
+  const uint64_t *meta_[kIndexMetaCount] = {nullptr};
+  void *map_addr_ = nullptr;
+  uint64_t map_size_ = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMN_INDEX_H_
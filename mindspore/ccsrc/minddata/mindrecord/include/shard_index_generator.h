@@ -83,13 +83,11 @@ class __attribute__((visibility("default"))) ShardIndexGenerator {
   ROW_DATA GenerateRowData(int shard_no, const std::map<int, int> &blob_id_to_page_id, int raw_page_id,
                            std::fstream &in);
   ///
-  /// \param db
-  /// \param sql
+  /// \param stmt statement prepared once per shard and reused for every raw page
   /// \param data
   /// \return
   MSRStatus BindParameterExecuteSQL(
-    sqlite3 *db, const std::string &sql,
-    const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
+    sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
 
   INDEX_FIELDS GenerateIndexFields(const std::vector<json> &schema_detail);
 
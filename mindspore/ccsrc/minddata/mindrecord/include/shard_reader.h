@@ -45,6 +45,7 @@
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_column_index.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -63,8 +64,8 @@ using ROW_GROUPS =
   std::tuple<MSRStatus, std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
 using ROW_GROUP_BRIEF =
   std::tuple<MSRStatus, std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
-using TASK_RETURN_CONTENT =
-  std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>>;
+using SCALAR_ROW_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, ScalarRow>>>;
+using TASK_RETURN_CONTENT = std::pair<MSRStatus, SCALAR_ROW_CONTENT>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
 class API_PUBLIC ShardReader {
@@ -188,6 +189,10 @@ class API_PUBLIC ShardReader {
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
                                                                                        const int32_t &consumer_id);
 
+  /// \brief return a row by id, with the scalar fields packed by the ShardColumn of the reader
+  /// \return a batch of images and scalar rows
+  SCALAR_ROW_CONTENT GetNextRowById(const int64_t &task_id, const int32_t &consumer_id);
+
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<std::vector<uint8_t>>, pybind11::object>> GetNextPy();
@@ -289,6 +294,31 @@ class API_PUBLIC ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief memory map shard files, so that consumers read blobs without a seek and read syscall per sample
+  void MapFiles();
+
+  /// \brief unmap the shard files mapped by MapFiles
+  void UnmapFiles();
+
+  /// \brief map the binary column index of every shard for lazy load mode, keep none if any shard lacks it
+  void LoadColumnIndexes();
+
+  /// \brief resolve offsets and scalar fields of a sample in lazy load mode from the column index of the shard
+  MSRStatus ReadRowFromColumnIndex(uint32_t shard_id, uint32_t consumer_id, uint32_t sample_id, uint32_t *group_id,
+                                   uint32_t *blob_start, uint32_t *blob_end, ScalarRow *var_fields);
+
+  /// \brief unpack the scalar rows of a task to json for the python and graph APIs
+  std::vector<std::tuple<std::vector<uint8_t>, json>> DecodeScalarRows(
+    std::vector<std::tuple<std::vector<uint8_t>, ScalarRow>> *rows) const;
+
+  /// \brief point to the blob at file_offset in the memory map of the shard, nullptr if the shard is not mapped
+  MSRStatus GetMappedBlob(uint32_t shard_id, uint64_t file_offset, uint64_t length, const uint8_t **blob) const;
+
+  /// \brief copy the blob at file_offset from the memory map of the shard, or read it from the file stream. The rows
+  /// handed to the consumers own their bytes, they outlive the maps which are unmapped on Close
+  MSRStatus ReadBlob(uint32_t shard_id, uint32_t consumer_id, uint64_t file_offset, uint64_t length,
+                     std::vector<uint8_t> *blob);
+
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
@@ -321,6 +351,7 @@ class API_PUBLIC ShardReader {
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::pair<uint8_t *, uint64_t>> file_maps_;                       // read-only maps of shard files
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -353,6 +384,9 @@ class API_PUBLIC ShardReader {
   // all metadata in the index is not loaded during initialization
   bool lazy_load_;
 
+  // column index of each shard, which replaces the per sample query of the index database in lazy load mode
+  std::vector<std::unique_ptr<ShardColumnIndex>> column_indexes_;
+
   // indicate shard_id : inc_count
   // 0 : 15  -  shard0 has 15 samples
   // 1 : 41  -  shard1 has 26 samples
@@ -31,8 +31,8 @@ namespace mindrecord {
 // The data struct is as below:
 // 1. TaskType: kCommonTask / kPaddedTask
 // 2. std::tuple<int, int> : shard_id, group_id(fast load) / sample_id(lazy load)
-// 3. std::vector<uint64_t>, json>> : [blob_start, blob_end], scalar_variable_fields
-using ShardTask = std::tuple<TaskType, std::tuple<int, int>, std::vector<uint64_t>, json>;
+// 3. std::vector<uint64_t>, ScalarRow>> : [blob_start, blob_end], scalar_variable_fields packed by ShardColumn
+using ShardTask = std::tuple<TaskType, std::tuple<int, int>, std::vector<uint64_t>, ScalarRow>;
 
 class __attribute__((visibility("default"))) ShardTaskList {
  public:
@@ -52,10 +52,10 @@ class __attribute__((visibility("default"))) ShardTaskList {
   inline void AssignTask(ShardTaskList &sourceTasks, size_t id);
 
   inline void InsertTask(TaskType task_type, int shard_id, int group_id, const std::vector<uint64_t> &offset,
-                         const json &label);
+                         const ScalarRow &label);
 
   inline void InsertTask(const uint32_t &i, TaskType task_type, int shard_id, int group_id,
-                         const std::vector<uint64_t> &offset, const json &label);
+                         const std::vector<uint64_t> &offset, const ScalarRow &label);
 
   inline void InsertTask(ShardTask task);
 
@@ -102,23 +102,23 @@ inline void ShardTaskList::AssignTask(ShardTaskList &sourceTasks, size_t id) {
 }
 
 inline void ShardTaskList::InsertTask(TaskType task_type, int shard_id, int group_id,
-                                      const std::vector<uint64_t> &offset, const json &label) {
+                                      const std::vector<uint64_t> &offset, const ScalarRow &label) {
   MS_LOG(DEBUG) << "Insert task into task list, shard_id: " << shard_id << ", group_id: " << group_id
-                << ", label: " << label.dump() << ", size of task_list_: " << task_list_.size() << ".";
+                << ", size of task_list_: " << task_list_.size() << ".";
   task_list_.emplace_back(task_type, std::make_tuple(shard_id, group_id), offset, label);
 }
 
 inline void ShardTaskList::InsertTask(const uint32_t &i, TaskType task_type, int shard_id, int group_id,
-                                      const std::vector<uint64_t> &offset, const json &label) {
+                                      const std::vector<uint64_t> &offset, const ScalarRow &label) {
   MS_LOG(DEBUG) << "Insert task into task list, shard_id: " << shard_id << ", group_id: " << group_id
-                << ", label: " << label.dump() << ", size of task_list_: " << task_list_.size() << ".";
+                << ", size of task_list_: " << task_list_.size() << ".";
   task_list_[i] = {task_type, std::make_tuple(shard_id, group_id), offset, label};
 }
 
 inline void ShardTaskList::InsertTask(ShardTask task) {
   MS_LOG(DEBUG) << "Insert task into task list, shard_id: " << std::get<0>(std::get<1>(task))
-                << ", group_id: " << std::get<1>(std::get<1>(task)) << ", label: " << std::get<3>(task).dump()
-                << ", size of task_list_: " << task_list_.size() << ".";
+                << ", group_id: " << std::get<1>(std::get<1>(task)) << ", size of task_list_: " << task_list_.size()
+                << ".";
 
   task_list_.push_back(std::move(task));
 }
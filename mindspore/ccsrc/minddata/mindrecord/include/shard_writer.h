@@ -23,6 +23,8 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -83,6 +85,13 @@ class __attribute__((visibility("default"))) ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   MSRStatus SetShardHeader(std::shared_ptr<ShardHeader> header_data);
 
+  /// \brief Set streaming mode, in which WriteRawData only queues the data and a background thread validates,
+  ///        serializes, compresses and flushes it, while the caller prepares the next batch
+  /// \param[in] streaming write in streaming mode or not, an error of a queued batch is returned by a later
+  ///            WriteRawData or by Commit
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SetStreamingMode(bool streaming);
+
   /// \brief write raw data by group size
   /// \param[in] raw_data the vector of raw json data, vector format
   /// \param[in] blob_data the vector of image data
@@ -141,6 +150,23 @@ class __attribute__((visibility("default"))) ShardWriter {
   MSRStatus SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                              std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count);
 
+  /// \brief validate, serialize and flush one batch of raw data
+  MSRStatus WriteBatch(std::map<uint64_t, std::vector<json>> &raw_data, std::vector<std::vector<uint8_t>> &blob_data,
+                       bool sign);
+
+  /// \brief hand a batch over to the streaming thread, waiting while the queue is full
+  MSRStatus PushStreamBatch(std::map<uint64_t, std::vector<json>> &raw_data,
+                            std::vector<std::vector<uint8_t>> &blob_data, bool sign);
+
+  /// \brief write the queued batches in streaming mode
+  void StreamWriter();
+
+  /// \brief wait until the queued batches are written and stop the streaming thread
+  MSRStatus FinishStreamWrite();
+
+  /// \brief compress blob data in multiple threads
+  void CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data);
+
   /// \brief write all data parallel
   MSRStatus ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
                               const std::vector<std::vector<uint8_t>> &bin_raw_data);
@@ -258,6 +284,20 @@ class __attribute__((visibility("default"))) ShardWriter {
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
   std::atomic<int64_t> compression_size_;
+
+  // batch of raw data queued in streaming mode
+  struct StreamBatch {
+    std::map<uint64_t, std::vector<json>> raw_data;
+    std::vector<std::vector<uint8_t>> blob_data;
+    bool sign;
+  };
+  bool streaming_ = false;
+  std::thread stream_thread_;
+  std::mutex stream_mutex_;
+  std::condition_variable stream_cv_;
+  std::deque<StreamBatch> stream_queue_;
+  bool stream_stop_ = false;
+  MSRStatus stream_status_ = SUCCESS;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
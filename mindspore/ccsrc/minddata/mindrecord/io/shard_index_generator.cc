@@ -18,6 +18,7 @@
 #include "minddata/mindrecord/include/shard_index_generator.h"
 
 #include "debug/common.h"
+#include "minddata/mindrecord/include/shard_column_index.h"
 #include "utils/ms_utils.h"
 
 using mindspore::LogStream;
@@ -25,6 +26,7 @@ using mindspore::ExceptionType::NoExceptionType;
 using mindspore::MsLogLevel::DEBUG;
 using mindspore::MsLogLevel::ERROR;
 using mindspore::MsLogLevel::INFO;
+using mindspore::MsLogLevel::WARNING;
 
 namespace mindspore {
 namespace mindrecord {
@@ -326,13 +328,7 @@ std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
 }
 
 MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
-  sqlite3 *db, const std::string &sql,
-  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
-  sqlite3_stmt *stmt = nullptr;
-  if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
-    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql;
-    return FAILED;
-  }
+  sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
   for (auto &row : data) {
     for (auto &field : row) {
       const auto &place_holder = std::get<0>(field);
@@ -370,7 +366,6 @@ MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
     }
     (void)sqlite3_reset(stmt);
   }
-  (void)sqlite3_finalize(stmt);
   return SUCCESS;
 }
 
@@ -542,26 +537,57 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
     MS_LOG(ERROR) << "Invalid file, failed to open file: " << shard_address;
     return FAILED;
   }
-  (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
-  for (int raw_page_id : raw_page_ids) {
-    auto sql = GenerateRawSQL(fields_);
-    if (sql.first != SUCCESS) {
-      MS_LOG(ERROR) << "Generate raw SQL failed";
+  // The same rows are written to the binary column index, which lazy load mode reads instead of the database
+  ShardColumnIndex column_index;
+  bool column_index_valid = true;
+  for (const auto &field : fields_) {
+    auto result = shard_header_.GetSchemaByID(field.first);
+    auto field_name = GenerateFieldName(field);
+    if (result.second != SUCCESS || field_name.first != SUCCESS) {
       return FAILED;
     }
+    std::string field_type = ConvertJsonToSQL(TakeFieldType(field.second, result.first->GetSchema()["schema"]));
+    column_index.AddColumn(field.second, ":" + field_name.second, field_type);
+  }
+  // The insert statement is the same for every raw page, so prepare it once for the whole transaction
+  auto sql = GenerateRawSQL(fields_);
+  if (sql.first != SUCCESS) {
+    MS_LOG(ERROR) << "Generate raw SQL failed";
+    return FAILED;
+  }
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db.second, common::SafeCStr(sql.second), -1, &stmt, 0) != SQLITE_OK) {
+    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql.second;
+    return FAILED;
+  }
+  (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+  for (int raw_page_id : raw_page_ids) {
     auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in);
     if (data.first != SUCCESS) {
       MS_LOG(ERROR) << "Generate raw data failed";
+      (void)sqlite3_finalize(stmt);
       return FAILED;
     }
-    if (BindParameterExecuteSQL(db.second, sql.second, data.second) == FAILED) {
+    if (BindParameterExecuteSQL(stmt, data.second) == FAILED) {
       MS_LOG(ERROR) << "Execute SQL failed";
+      (void)sqlite3_finalize(stmt);
       return FAILED;
     }
+    // A row the column index can not take only drops the column index, the reader falls back to the database
+    for (auto row = data.second.begin(); column_index_valid && row != data.second.end(); ++row) {
+      column_index_valid = column_index.AddRow(*row) == SUCCESS;
+    }
     MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
   }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
+  (void)sqlite3_finalize(stmt);
   in.close();
+  if (!column_index_valid) {
+    MS_LOG(WARNING) << "Skip the column index of the shard, the index database is used instead: " << shard_address;
+  } else if (column_index.Save(realpath.value()) != SUCCESS) {
+    MS_LOG(ERROR) << "Write column index failed";
+    return FAILED;
+  }
 
   // Close database
   if (sqlite3_close(db.second) != SQLITE_OK) {
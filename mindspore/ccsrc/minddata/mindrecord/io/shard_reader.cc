@@ -16,6 +16,12 @@
 
 #include "minddata/mindrecord/include/shard_reader.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 #include <algorithm>
 #include <thread>
 
@@ -241,7 +247,189 @@ MSRStatus ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Open shard file successfully.";
   }
+  MapFiles();
+  if (lazy_load_) {
+    LoadColumnIndexes();
+  }
+
+  return SUCCESS;
+}
+
+void ShardReader::MapFiles() {
+  // Open may run again on the same reader
+  UnmapFiles();
+  file_maps_ = std::vector<std::pair<uint8_t *, uint64_t>>(file_paths_.size(), {nullptr, 0});
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (common::GetEnv("MS_MINDRECORD_MMAP") == "false") {
+    return;
+  }
+  for (size_t i = 0; i < file_paths_.size(); ++i) {
+    auto realpath = Common::GetRealPath(file_paths_[i]);
+    if (!realpath.has_value()) {
+      continue;
+    }
+    int fd = open(realpath.value().c_str(), O_RDONLY);
+    if (fd < 0) {
+      continue;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      void *addr = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+      if (addr != MAP_FAILED) {
+        file_maps_[i] = {static_cast<uint8_t *>(addr), static_cast<uint64_t>(file_stat.st_size)};
+      }
+    }
+    (void)close(fd);
+    if (file_maps_[i].first == nullptr) {
+      // The file stream is still open, so this shard falls back to seek and read.
+      MS_LOG(WARNING) << "Failed to map shard file: " << file_paths_[i] << ", read it by file stream instead.";
+    }
+  }
+#endif
+}
+
+void ShardReader::UnmapFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto &file_map : file_maps_) {
+    if (file_map.first != nullptr) {
+      (void)munmap(file_map.first, static_cast<size_t>(file_map.second));
+    }
+  }
+#endif
+  file_maps_.clear();
+}
+
+void ShardReader::LoadColumnIndexes() {
+  column_indexes_.clear();
+  for (const auto &file : file_paths_) {
+    auto realpath = Common::GetRealPath(file);
+    auto column_index = std::make_unique<ShardColumnIndex>();
+    if (!realpath.has_value() || column_index->Load(realpath.value()) != SUCCESS) {
+      MS_LOG(INFO) << "Column index of " << file << " is not available, read samples from the index database.";
+      column_indexes_.clear();
+      return;
+    }
+    column_indexes_.push_back(std::move(column_index));
+  }
+}
 
+MSRStatus ShardReader::ReadRowFromColumnIndex(uint32_t shard_id, uint32_t consumer_id, uint32_t sample_id,
+                                              uint32_t *group_id, uint32_t *blob_start, uint32_t *blob_end,
+                                              ScalarRow *var_fields) {
+  const auto &column_index = column_indexes_[shard_id];
+  if (sample_id >= column_index->GetRowCount()) {
+    MS_LOG(ERROR) << "Invalid data, sample id: " << sample_id << " exceeds the column index of shard: " << shard_id;
+    return FAILED;
+  }
+  *group_id = column_index->GetMeta(ShardColumnIndex::kRowGroupId, sample_id);
+  *blob_start = column_index->GetMeta(ShardColumnIndex::kPageOffsetBlob, sample_id) + kInt64Len;
+  *blob_end = column_index->GetMeta(ShardColumnIndex::kPageOffsetBlobEnd, sample_id);
+
+  if (!all_in_index_) {
+    // Some selected field is not an index field, so take the fields from the raw page as ConvertLabelToJson does
+    auto raw_page_id = column_index->GetMeta(ShardColumnIndex::kPageIdRaw, sample_id);
+    auto label_start = column_index->GetMeta(ShardColumnIndex::kPageOffsetRaw, sample_id) + kInt64Len;
+    auto label_end = column_index->GetMeta(ShardColumnIndex::kPageOffsetRawEnd, sample_id);
+    if (label_end < label_start) {
+      MS_LOG(ERROR) << "Invalid data, raw data of sample id: " << sample_id << " is out of range.";
+      return FAILED;
+    }
+    // The scalar fields are parsed right away, so they are read from the memory map in place
+    auto label_offset = page_size_ * raw_page_id + header_size_ + label_start;
+    uint64_t label_len = label_end - label_start;
+    const uint8_t *mapped_label = nullptr;
+    if (GetMappedBlob(shard_id, label_offset, label_len, &mapped_label) != SUCCESS) {
+      return FAILED;
+    }
+    json label_json;
+    if (mapped_label != nullptr) {
+      label_json = json::from_msgpack(mapped_label, mapped_label + label_len);
+    } else {
+      std::vector<uint8_t> label_raw;
+      if (ReadBlob(shard_id, consumer_id, label_offset, label_len, &label_raw) != SUCCESS) {
+        return FAILED;
+      }
+      label_json = json::from_msgpack(label_raw);
+    }
+    if (selected_columns_.empty()) {
+      return shard_column_->EncodeScalarRow(label_json, var_fields);
+    }
+    json selected_json;
+    for (auto &col : selected_columns_) {
+      if (label_json.find(col) != label_json.end()) {
+        selected_json[col] = label_json[col];
+      }
+    }
+    return shard_column_->EncodeScalarRow(selected_json, var_fields);
+  }
+
+  shard_column_->InitScalarRow(var_fields);
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  for (const auto &col : selected_columns_) {
+    int column_id = column_index->GetColumnId(col);
+    if (column_id < 0) {
+      MS_LOG(ERROR) << "Invalid data, field: " << col << " is not found in the column index of shard: " << shard_id;
+      return FAILED;
+    }
+    // convert to the type of the schema, the same as ConvertLabelToJson
+    const auto &type = schema[col]["type"];
+    MSRStatus status = SUCCESS;
+    if (type == "int32" || type == "int64") {
+      status = shard_column_->SetScalarInt(col, column_index->GetInt64(column_id, sample_id), var_fields);
+    } else if (type == "float32" || type == "float64") {
+      status = shard_column_->SetScalarFloat(col, column_index->GetFloat64(column_id, sample_id), var_fields);
+    } else {
+      status = shard_column_->SetScalarString(col, column_index->GetString(column_id, sample_id), var_fields);
+    }
+    if (status != SUCCESS) {
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::GetMappedBlob(uint32_t shard_id, uint64_t file_offset, uint64_t length,
+                                     const uint8_t **blob) const {
+  *blob = nullptr;
+  if (shard_id >= file_maps_.size() || file_maps_[shard_id].first == nullptr) {
+    return SUCCESS;
+  }
+  const auto &file_map = file_maps_[shard_id];
+  if (file_offset > file_map.second || length > file_map.second - file_offset) {
+    MS_LOG(ERROR) << "Invalid data, blob [" << file_offset << ", " << file_offset + length
+                  << ") exceeds the size of shard file: " << file_map.second;
+    return FAILED;
+  }
+  *blob = file_map.first + file_offset;
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::ReadBlob(uint32_t shard_id, uint32_t consumer_id, uint64_t file_offset, uint64_t length,
+                                std::vector<uint8_t> *blob) {
+  const uint8_t *mapped_blob = nullptr;
+  if (GetMappedBlob(shard_id, file_offset, length, &mapped_blob) != SUCCESS) {
+    return FAILED;
+  }
+  if (mapped_blob != nullptr) {
+    // Samples of the same blob page share the mapped pages of the page cache, so no extra read is issued for them.
+    blob->assign(mapped_blob, mapped_blob + length);
+    return SUCCESS;
+  }
+
+  blob->resize(length);
+  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    MS_LOG(ERROR) << "File seekg failed";
+    file_streams_random_[consumer_id][shard_id]->close();
+    return FAILED;
+  }
+
+  auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(blob->data()), length);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    MS_LOG(ERROR) << "File read failed";
+    file_streams_random_[consumer_id][shard_id]->close();
+    return FAILED;
+  }
   return SUCCESS;
 }
 
@@ -258,6 +446,7 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  UnmapFiles();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -1146,8 +1335,12 @@ MSRStatus ShardReader::CreateTasksByCategory(const std::shared_ptr<ShardOperator
         auto number_of_rows = offsets.size();
         for (uint32_t iStart = 0; iStart < number_of_rows; iStart += 1) {
           if (category_index < num_elements) {
+            ScalarRow scalar_row;
+            if (shard_column_->EncodeScalarRow(std::get<5>(details)[iStart], &scalar_row) != SUCCESS) {
+              return FAILED;
+            }
             categoryTasks[categoryNo].InsertTask(TaskType::kCommonTask, shard_id, group_id,
-                                                 std::get<4>(details)[iStart], std::get<5>(details)[iStart]);
+                                                 std::get<4>(details)[iStart], scalar_row);
             category_index++;
           }
         }
@@ -1186,24 +1379,34 @@ MSRStatus ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, i
 
     // Init the task threads, maybe use ThreadPool is better
     std::vector<std::thread> init_tasks_thread(shard_count_);
+    std::vector<MSRStatus> init_tasks_status(shard_count_, SUCCESS);
 
     uint32_t current_offset = 0;
     for (uint32_t shard_id = 0; shard_id < shard_count_; shard_id++) {
-      init_tasks_thread[shard_id] = std::thread([this, &offsets, &local_columns, shard_id, current_offset]() {
-        auto offset = current_offset;
-        for (uint32_t i = 0; i < offsets[shard_id].size(); i += 1) {
-          tasks_.InsertTask(offset, TaskType::kCommonTask, offsets[shard_id][i][0], offsets[shard_id][i][1],
-                            std::vector<uint64_t>{offsets[shard_id][i][2], offsets[shard_id][i][3]},
-                            local_columns[shard_id][i]);
-          offset++;
-        }
-      });
+      init_tasks_thread[shard_id] =
+        std::thread([this, &offsets, &local_columns, &init_tasks_status, shard_id, current_offset]() {
+          auto offset = current_offset;
+          ScalarRow scalar_row;
+          for (uint32_t i = 0; i < offsets[shard_id].size(); i += 1) {
+            // pack the scalar fields once here, so that consumers do not convert json per row
+            if (shard_column_->EncodeScalarRow(local_columns[shard_id][i], &scalar_row) != SUCCESS) {
+              init_tasks_status[shard_id] = FAILED;
+              return;
+            }
+            tasks_.InsertTask(offset, TaskType::kCommonTask, offsets[shard_id][i][0], offsets[shard_id][i][1],
+                              std::vector<uint64_t>{offsets[shard_id][i][2], offsets[shard_id][i][3]}, scalar_row);
+            offset++;
+          }
+        });
       current_offset += offsets[shard_id].size();
     }
 
     for (uint32_t shard_id = 0; shard_id < shard_count_; shard_id++) {
       init_tasks_thread[shard_id].join();
     }
+    if (std::find(init_tasks_status.begin(), init_tasks_status.end(), FAILED) != init_tasks_status.end()) {
+      return FAILED;
+    }
   } else {
     return FAILED;
   }
@@ -1234,7 +1437,7 @@ MSRStatus ShardReader::CreateLazyTasksByRow(const std::vector<std::tuple<int, in
       init_tasks_thread[shard_id] = std::thread([this, shard_id, current_offset, shard_count]() {
         for (uint32_t i = current_offset; i < shard_count + current_offset; ++i) {
           // here "i - current_offset" indicate the sample id in the shard
-          tasks_.InsertTask(i, TaskType::kCommonTask, shard_id, i - current_offset, {}, json());
+          tasks_.InsertTask(i, TaskType::kCommonTask, shard_id, i - current_offset, {}, ScalarRow());
         }
       });
     }
@@ -1273,7 +1476,7 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
     // need padded sample to the task
     if (num_padded_ > 0) {
       for (int i = 0; i < num_padded_; ++i) {
-        tasks_.InsertTask(TaskType::kPaddedTask, 0, 0, {}, json());
+        tasks_.InsertTask(TaskType::kPaddedTask, 0, 0, {}, ScalarRow());
       }
     }
   } else {
@@ -1310,15 +1513,14 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
 TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
   // All tasks are done
   if (task_id >= static_cast<int>(tasks_.Size())) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return std::make_pair(FAILED, SCALAR_ROW_CONTENT(TaskType::kCommonTask, {}));
   }
 
   uint32_t shard_id = 0;
   uint32_t group_id = 0;
   uint32_t blob_start = 0;
   uint32_t blob_end = 0;
-  json var_fields;
+  ScalarRow var_fields;
   // Pick up task from task list
   ShardTask task;
   task = tasks_.GetTaskByID(task_id);
@@ -1326,8 +1528,7 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   // check task type
   auto task_type = std::get<0>(task);
   if (task_type == TaskType::kPaddedTask) {
-    return std::make_pair(SUCCESS,
-                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return std::make_pair(SUCCESS, SCALAR_ROW_CONTENT(TaskType::kPaddedTask, {}));
   }
 
   shard_id = std::get<0>(std::get<1>(task));  // shard id
@@ -1337,6 +1538,12 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
     blob_start = std::get<2>(task)[0];          // blob start
     blob_end = std::get<2>(task)[1];            // blob end
     var_fields = std::get<3>(task);             // scalar variable field
+  } else if (!column_indexes_.empty()) {
+    uint32_t sample_id_in_shard = std::get<1>(std::get<1>(task));
+    if (ReadRowFromColumnIndex(shard_id, consumer_id, sample_id_in_shard, &group_id, &blob_start, &blob_end,
+                               &var_fields) != SUCCESS) {
+      return std::make_pair(FAILED, SCALAR_ROW_CONTENT(TaskType::kCommonTask, {}));
+    }
   } else {
     // get scalar variable fields by sample id
     uint32_t sample_id_in_shard = std::get<1>(std::get<1>(task));
@@ -1344,8 +1551,7 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
     // read the meta from index
     auto row_meta = ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, sample_id_in_shard);
     if (std::get<0>(row_meta) != SUCCESS) {
-      return std::make_pair(
-        FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+      return std::make_pair(FAILED, SCALAR_ROW_CONTENT(TaskType::kCommonTask, {}));
     }
     auto &offsets = std::get<1>(row_meta);
     auto &local_columns = std::get<2>(row_meta);
@@ -1353,40 +1559,27 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
     group_id = offsets[shard_id][0][1];       // group_id
     blob_start = offsets[shard_id][0][2];     // blob start
     blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    if (shard_column_->EncodeScalarRow(local_columns[shard_id][0], &var_fields) != SUCCESS) {
+      return std::make_pair(FAILED, SCALAR_ROW_CONTENT(TaskType::kCommonTask, {}));
+    }
   }
 
   // read the blob from data file
   const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
   if (SUCCESS != ret.first) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return std::make_pair(FAILED, SCALAR_ROW_CONTENT(TaskType::kCommonTask, {}));
   }
   const std::shared_ptr<Page> &page = ret.second;
 
   // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
+  std::vector<uint8_t> images;
   auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + blob_start;
-
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
-  }
-
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  if (ReadBlob(shard_id, consumer_id, file_offset, blob_end - blob_start, &images) != SUCCESS) {
+    return std::make_pair(FAILED, SCALAR_ROW_CONTENT(TaskType::kCommonTask, {}));
   }
 
   // Deliver batch data to output map
-  std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
+  std::vector<std::tuple<std::vector<uint8_t>, ScalarRow>> batch;
   batch.emplace_back(std::move(images), std::move(var_fields));
 
   return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
@@ -1410,11 +1603,11 @@ MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
     if (sample_id_pos >= static_cast<int>(tasks_.sample_ids_.size())) {
       return FAILED;
     }
-    const auto &ret = ConsumerOneTask(tasks_.sample_ids_[sample_id_pos], consumer_id);
+    auto ret = ConsumerOneTask(tasks_.sample_ids_[sample_id_pos], consumer_id);
     if (SUCCESS != ret.first) {
       return FAILED;
     }
-    const auto &batch = (ret.second).second;
+    auto batch = DecodeScalarRows(&(ret.second).second);
     // Hanging if maximum map size exceeded
     //   otherwise, set batch data in map
     {
@@ -1460,13 +1653,34 @@ std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardRe
   if (interrupt_) {
     return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
-  const auto &ret = ConsumerOneTask(task_id, consumer_id);
+  auto ret = ConsumerOneTask(task_id, consumer_id);
   if (SUCCESS != ret.first) {
     return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
+  return std::make_pair(ret.second.first, DecodeScalarRows(&ret.second.second));
+}
+
+SCALAR_ROW_CONTENT ShardReader::GetNextRowById(const int64_t &task_id, const int32_t &consumer_id) {
+  if (interrupt_) {
+    return SCALAR_ROW_CONTENT(TaskType::kCommonTask, {});
+  }
+  auto ret = ConsumerOneTask(task_id, consumer_id);
+  if (SUCCESS != ret.first) {
+    return SCALAR_ROW_CONTENT(TaskType::kCommonTask, {});
+  }
   return std::move(ret.second);
 }
 
+std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::DecodeScalarRows(
+  std::vector<std::tuple<std::vector<uint8_t>, ScalarRow>> *rows) const {
+  std::vector<std::tuple<std::vector<uint8_t>, json>> res;
+  res.reserve(rows->size());
+  for (auto &row : *rows) {
+    res.emplace_back(std::move(std::get<0>(row)), shard_column_->DecodeScalarRow(std::get<1>(row)));
+  }
+  return res;
+}
+
 std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> ShardReader::UnCompressBlob(
   const std::vector<uint8_t> &raw_blob_data) {
   auto loaded_columns = selected_columns_.size() == 0 ? shard_column_->GetColumnName() : selected_columns_;
@@ -35,6 +35,7 @@ ShardWriter::ShardWriter()
 }
 
 ShardWriter::~ShardWriter() {
+  (void)FinishStreamWrite();
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
@@ -214,6 +215,11 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
 }
 
 MSRStatus ShardWriter::Commit() {
+  if (FinishStreamWrite() == FAILED) {
+    MS_LOG(ERROR) << "Write data in streaming mode failed";
+    return FAILED;
+  }
+
   // Read pages file
   std::ifstream page_file(pages_file_.c_str());
   if (page_file.good()) {
@@ -239,6 +245,15 @@ MSRStatus ShardWriter::Commit() {
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::SetStreamingMode(bool streaming) {
+  if (!streaming && FinishStreamWrite() == FAILED) {
+    MS_LOG(ERROR) << "Write data in streaming mode failed";
+    return FAILED;
+  }
+  streaming_ = streaming;
+  return SUCCESS;
+}
+
 MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data) {
   MSRStatus ret = header_data->InitByFiles(file_paths_);
   if (ret == FAILED) {
@@ -622,11 +637,7 @@ MSRStatus ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>
 
   // compress blob
   if (shard_column_->CheckCompressBlob()) {
-    for (auto &blob : blob_data) {
-      int64_t compression_bytes = 0;
-      blob = shard_column_->CompressBlob(blob, &compression_bytes);
-      compression_size_ += compression_bytes;
-    }
+    CompressBlobData(blob_data);
   }
 
   // Add 4-bytes dummy blob data if no any blob fields
@@ -685,8 +696,38 @@ MSRStatus ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
   return SUCCESS;
 }
 
+void ShardWriter::CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data) {
+  // A fixed number of threads per batch, small batches are compressed on the caller alone
+  size_t thread_num = std::min({blob_data.size() / kMinBlobsPerCompressThread, static_cast<size_t>(kMaxCompressThreads),
+                                static_cast<size_t>(std::thread::hardware_concurrency())});
+  thread_num = std::max(thread_num, static_cast<size_t>(1));
+  size_t group_num = (blob_data.size() + thread_num - 1) / thread_num;
+  auto compress = [this, &blob_data](size_t start, size_t end) {
+    int64_t compression_bytes = 0;
+    for (size_t i = start; i < end; ++i) {
+      int64_t blob_compression_bytes = 0;
+      blob_data[i] = shard_column_->CompressBlob(blob_data[i], &blob_compression_bytes);
+      compression_bytes += blob_compression_bytes;
+    }
+    compression_size_ += compression_bytes;
+  };
+  std::vector<std::thread> thread_set;
+  for (size_t start = group_num; start < blob_data.size(); start += group_num) {
+    thread_set.emplace_back(compress, start, std::min(start + group_num, blob_data.size()));
+  }
+  compress(0, std::min(group_num, blob_data.size()));
+  for (auto &thread : thread_set) {
+    thread.join();
+  }
+}
+
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                     std::vector<std::vector<uint8_t>> &blob_data, bool sign, bool parallel_writer) {
+  // Parallel writers share the files through the lock file, so they always write synchronously
+  if (streaming_ && !parallel_writer) {
+    return PushStreamBatch(raw_data, blob_data, sign);
+  }
+
   // Lock Writer if loading data parallel
   int fd = LockWriter(parallel_writer);
   if (fd < 0) {
@@ -694,6 +735,20 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
     return FAILED;
   }
 
+  if (WriteBatch(raw_data, blob_data, sign) == FAILED) {
+    return FAILED;
+  }
+
+  if (UnlockWriter(fd, parallel_writer) == FAILED) {
+    MS_LOG(ERROR) << "Unlock writer failed";
+    return FAILED;
+  }
+
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::WriteBatch(std::map<uint64_t, std::vector<json>> &raw_data,
+                                  std::vector<std::vector<uint8_t>> &blob_data, bool sign) {
   // Get the count of schemas and rows
   int schema_count = 0;
   int row_count = 0;
@@ -735,15 +790,70 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
     return FAILED;
   }
   MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
+  return SUCCESS;
+}
 
-  if (UnlockWriter(fd, parallel_writer) == FAILED) {
-    MS_LOG(ERROR) << "Unlock writer failed";
+MSRStatus ShardWriter::PushStreamBatch(std::map<uint64_t, std::vector<json>> &raw_data,
+                                       std::vector<std::vector<uint8_t>> &blob_data, bool sign) {
+  std::unique_lock<std::mutex> lck(stream_mutex_);
+  if (!stream_thread_.joinable()) {
+    stream_stop_ = false;
+    stream_thread_ = std::thread(&ShardWriter::StreamWriter, this);
+  }
+  // bound the memory held by queued batches
+  stream_cv_.wait(lck, [this] {
+    return stream_status_ == FAILED || static_cast<int>(stream_queue_.size()) < kMaxStreamBatches;
+  });
+  if (stream_status_ == FAILED) {
+    MS_LOG(ERROR) << "Write data in streaming mode failed";
     return FAILED;
   }
-
+  stream_queue_.push_back(StreamBatch{std::move(raw_data), std::move(blob_data), sign});
+  lck.unlock();
+  stream_cv_.notify_all();
   return SUCCESS;
 }
 
+void ShardWriter::StreamWriter() {
+  for (;;) {
+    StreamBatch batch;
+    {
+      std::unique_lock<std::mutex> lck(stream_mutex_);
+      stream_cv_.wait(lck, [this] { return stream_stop_ || !stream_queue_.empty(); });
+      if (stream_queue_.empty()) {
+        return;
+      }
+      batch = std::move(stream_queue_.front());
+      stream_queue_.pop_front();
+    }
+    // a full queue waits for this slot, so the caller prepares the next batch while this one is written
+    stream_cv_.notify_all();
+    auto ret = WriteBatch(batch.raw_data, batch.blob_data, batch.sign);
+    {
+      std::lock_guard<std::mutex> lck(stream_mutex_);
+      if (ret == FAILED) {
+        // drop the rest, the error is reported by the next WriteRawData or Commit
+        stream_status_ = FAILED;
+        stream_queue_.clear();
+      }
+    }
+    stream_cv_.notify_all();
+  }
+}
+
+MSRStatus ShardWriter::FinishStreamWrite() {
+  {
+    std::lock_guard<std::mutex> lck(stream_mutex_);
+    if (!stream_thread_.joinable()) {
+      return stream_status_;
+    }
+    stream_stop_ = true;
+  }
+  stream_cv_.notify_all();
+  stream_thread_.join();
+  return stream_status_;
+}
+
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>> &raw_data,
                                     std::map<uint64_t, std::vector<py::handle>> &blob_data, bool sign,
                                     bool parallel_writer) {
@@ -16,12 +16,17 @@
 
 #include "minddata/mindrecord/include/shard_column.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include "utils/ms_utils.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_error.h"
 
 namespace mindspore {
 namespace mindrecord {
+const uint64_t kScalarSlotLen = 8;
+
 ShardColumn::ShardColumn(const std::shared_ptr<ShardHeader> &shard_header, bool compress_integer) {
   auto first_schema = shard_header->GetSchemas()[0];
   json schema_json = first_schema->GetSchema();
@@ -70,6 +75,8 @@ void ShardColumn::Init(const json &schema_json, bool compress_integer) {
 
   has_compress_blob_ = (compress_integer && has_integer_array);
   num_blob_column_ = blob_column_.size();
+  // presence bytes of all columns, padded so that the slots are 8 byte aligned
+  scalar_slot_offset_ = (column_name_.size() + kScalarSlotLen - 1) / kScalarSlotLen * kScalarSlotLen;
 }
 
 std::pair<MSRStatus, ColumnCategory> ShardColumn::GetColumnTypeByName(const std::string &column_name,
@@ -129,6 +136,206 @@ MSRStatus ShardColumn::GetColumnValueByName(const std::string &column_name, cons
   return SUCCESS;
 }
 
+MSRStatus ShardColumn::GetColumnValueFromRow(const std::string &column_name, const std::vector<uint8_t> &columns_blob,
+                                             const ScalarRow &scalar_row, const unsigned char **data,
+                                             std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
+                                             ColumnDataType *column_data_type, uint64_t *column_data_type_size,
+                                             std::vector<int64_t> *column_shape) {
+  auto column_category = CheckColumnName(column_name);
+  if (column_category == ColumnNotFound) {
+    return FAILED;
+  }
+
+  auto column_id = column_name_id_[column_name];
+  *column_data_type = column_data_type_[column_id];
+  *column_data_type_size = ColumnDataTypeSize[*column_data_type];
+  *column_shape = column_shape_[column_id];
+
+  if (column_category == ColumnInBlob) {
+    if (GetColumnFromBlob(column_name, columns_blob, data, data_ptr, n_bytes) == FAILED) {
+      MS_LOG(ERROR) << "Error when get data from blob, column name is " << column_name << ".";
+      return FAILED;
+    }
+    if (*data == nullptr) {
+      *data = reinterpret_cast<const unsigned char *>(data_ptr->get());
+    }
+    return SUCCESS;
+  }
+
+  if (scalar_row.size() < scalar_slot_offset_ + kScalarSlotLen * column_name_.size() || scalar_row[column_id] == 0) {
+    MS_LOG(ERROR) << "Error when get data from row, column " << column_name << " is not in the row.";
+    return FAILED;
+  }
+  const uint8_t *slot = scalar_row.data() + scalar_slot_offset_ + kScalarSlotLen * column_id;
+  if (*column_data_type == ColumnString || *column_data_type == ColumnBytes) {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    (void)memcpy(&offset, slot, sizeof(offset));
+    (void)memcpy(&length, slot + sizeof(offset), sizeof(length));
+    *data = scalar_row.data() + offset;
+    *n_bytes = length;
+  } else {
+    *data = slot;
+    *n_bytes = *column_data_type_size;
+  }
+  return SUCCESS;
+}
+
+void ShardColumn::InitScalarRow(ScalarRow *scalar_row) const {
+  scalar_row->assign(scalar_slot_offset_ + kScalarSlotLen * column_name_.size(), 0);
+}
+
+void ShardColumn::SetScalarBytes(uint64_t column_id, const void *data, uint64_t n_bytes, ScalarRow *scalar_row) const {
+  (*scalar_row)[column_id] = 1;
+  uint8_t *slot = scalar_row->data() + scalar_slot_offset_ + kScalarSlotLen * column_id;
+  auto column_data_type = column_data_type_[column_id];
+  if (column_data_type != ColumnString && column_data_type != ColumnBytes) {
+    (void)memcpy(slot, data, std::min(n_bytes, kScalarSlotLen));
+    return;
+  }
+  auto offset = static_cast<uint32_t>(scalar_row->size());
+  auto length = static_cast<uint32_t>(n_bytes);
+  (void)memcpy(slot, &offset, sizeof(offset));
+  (void)memcpy(slot + sizeof(offset), &length, sizeof(length));
+  auto chars = static_cast<const uint8_t *>(data);
+  scalar_row->insert(scalar_row->end(), chars, chars + n_bytes);
+}
+
+MSRStatus ShardColumn::GetScalarColumnId(const std::string &column_name, const ScalarRow &scalar_row,
+                                         uint64_t *column_id) {
+  if (CheckColumnName(column_name) != ColumnInRaw) {
+    MS_LOG(ERROR) << "Invalid data, column " << column_name << " is not a scalar field.";
+    return FAILED;
+  }
+  if (scalar_row.size() < scalar_slot_offset_ + kScalarSlotLen * column_name_.size()) {
+    MS_LOG(ERROR) << "Invalid data, scalar row is not initialized.";
+    return FAILED;
+  }
+  *column_id = column_name_id_[column_name];
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::EncodeScalarRow(const json &columns_json, ScalarRow *scalar_row) {
+  InitScalarRow(scalar_row);
+  if (!columns_json.is_object()) {
+    return SUCCESS;
+  }
+  for (auto it = columns_json.begin(); it != columns_json.end(); ++it) {
+    // values which can not be converted are left out, and reported when the column is read
+    if (CheckColumnName(it.key()) != ColumnInRaw || (!it.value().is_string() && !it.value().is_number())) {
+      continue;
+    }
+    std::unique_ptr<unsigned char[]> data_ptr;
+    uint64_t n_bytes = 0;
+    if (GetColumnFromJson(it.key(), columns_json, &data_ptr, &n_bytes) != SUCCESS) {
+      return FAILED;
+    }
+    SetScalarBytes(column_name_id_[it.key()], data_ptr.get(), n_bytes, scalar_row);
+  }
+  return SUCCESS;
+}
+
+json ShardColumn::DecodeScalarRow(const ScalarRow &scalar_row) const {
+  json columns_json;
+  if (scalar_row.size() < scalar_slot_offset_ + kScalarSlotLen * column_name_.size()) {
+    return columns_json;
+  }
+  for (uint64_t column_id = 0; column_id < column_name_.size(); ++column_id) {
+    if (scalar_row[column_id] == 0) {
+      continue;
+    }
+    const uint8_t *slot = scalar_row.data() + scalar_slot_offset_ + kScalarSlotLen * column_id;
+    const auto &column_name = column_name_[column_id];
+    switch (column_data_type_[column_id]) {
+      case ColumnInt32: {
+        int32_t value = 0;
+        (void)memcpy(&value, slot, sizeof(value));
+        columns_json[column_name] = value;
+        break;
+      }
+      case ColumnInt64: {
+        int64_t value = 0;
+        (void)memcpy(&value, slot, sizeof(value));
+        columns_json[column_name] = value;
+        break;
+      }
+      case ColumnFloat32: {
+        float value = 0;
+        (void)memcpy(&value, slot, sizeof(value));
+        columns_json[column_name] = value;
+        break;
+      }
+      case ColumnFloat64: {
+        double value = 0;
+        (void)memcpy(&value, slot, sizeof(value));
+        columns_json[column_name] = value;
+        break;
+      }
+      default: {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        (void)memcpy(&offset, slot, sizeof(offset));
+        (void)memcpy(&length, slot + sizeof(offset), sizeof(length));
+        columns_json[column_name] = std::string(reinterpret_cast<const char *>(scalar_row.data()) + offset, length);
+        break;
+      }
+    }
+  }
+  return columns_json;
+}
+
+MSRStatus ShardColumn::SetScalarInt(const std::string &column_name, int64_t value, ScalarRow *scalar_row) {
+  uint64_t column_id = 0;
+  if (GetScalarColumnId(column_name, *scalar_row, &column_id) != SUCCESS) {
+    return FAILED;
+  }
+  if (column_data_type_[column_id] == ColumnInt64) {
+    SetScalarBytes(column_id, &value, sizeof(value), scalar_row);
+    return SUCCESS;
+  }
+  if (column_data_type_[column_id] == ColumnInt32 && value >= std::numeric_limits<int32_t>::min() &&
+      value <= std::numeric_limits<int32_t>::max()) {
+    auto int32_value = static_cast<int32_t>(value);
+    SetScalarBytes(column_id, &int32_value, sizeof(int32_value), scalar_row);
+    return SUCCESS;
+  }
+  MS_LOG(ERROR) << "Conversion to int failed, column name is " << column_name << ".";
+  return FAILED;
+}
+
+MSRStatus ShardColumn::SetScalarFloat(const std::string &column_name, double value, ScalarRow *scalar_row) {
+  uint64_t column_id = 0;
+  if (GetScalarColumnId(column_name, *scalar_row, &column_id) != SUCCESS) {
+    return FAILED;
+  }
+  if (column_data_type_[column_id] == ColumnFloat64) {
+    SetScalarBytes(column_id, &value, sizeof(value), scalar_row);
+    return SUCCESS;
+  }
+  if (column_data_type_[column_id] == ColumnFloat32) {
+    auto float_value = static_cast<float>(value);
+    SetScalarBytes(column_id, &float_value, sizeof(float_value), scalar_row);
+    return SUCCESS;
+  }
+  MS_LOG(ERROR) << "Conversion to float failed, column name is " << column_name << ".";
+  return FAILED;
+}
+
+MSRStatus ShardColumn::SetScalarString(const std::string &column_name, const std::string &value,
+                                       ScalarRow *scalar_row) {
+  uint64_t column_id = 0;
+  if (GetScalarColumnId(column_name, *scalar_row, &column_id) != SUCCESS) {
+    return FAILED;
+  }
+  auto column_data_type = column_data_type_[column_id];
+  if (column_data_type != ColumnString && column_data_type != ColumnBytes) {
+    MS_LOG(ERROR) << "Conversion to string failed, column name is " << column_name << ".";
+    return FAILED;
+  }
+  SetScalarBytes(column_id, value.data(), value.size(), scalar_row);
+  return SUCCESS;
+}
+
 MSRStatus ShardColumn::GetColumnFromJson(const std::string &column_name, const json &columns_json,
                                          std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *n_bytes) {
   auto column_id = column_name_id_[column_name];
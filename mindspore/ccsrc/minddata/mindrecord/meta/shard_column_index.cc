@@ -0,0 +1,403 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_column_index.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const uint64_t kColumnIndexMagic = 0x315844494352534DULL;  // "MSRCIDX1"
+const uint64_t kColumnIndexVersion = 2;
+const uint64_t kColumnIndexHeaderLen = 6;
+const char *const kIndexMetaPlaceHolders[] = {":ROW_GROUP_ID",        ":PAGE_ID_RAW",      ":PAGE_OFFSET_RAW",
+                                              ":PAGE_OFFSET_RAW_END", ":PAGE_OFFSET_BLOB", ":PAGE_OFFSET_BLOB_END"};
+
+uint64_t PaddedWords(uint64_t len) { return len / kInt64Len + (len % kInt64Len == 0 ? 0 : 1); }
+
+// The offsets of the strings of a column start at 0 and never decrease, the last one is the number of characters.
+bool IsStringOffsetsValid(const uint64_t *offsets, uint64_t row_count) {
+  if (offsets[0] != 0) {
+    return false;
+  }
+  for (uint64_t i = 0; i < row_count; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WriteWord(std::ofstream *out, uint64_t value) { out->write(reinterpret_cast<const char *>(&value), kInt64Len); }
+
+void WritePadded(std::ofstream *out, const std::string &value) {
+  out->write(value.data(), value.size());
+  std::string padding(PaddedWords(value.size()) * kInt64Len - value.size(), '\0');
+  out->write(padding.data(), padding.size());
+}
+
+bool GetFileSize(const std::string &file, uint64_t *file_size) {
+  struct stat file_stat;
+  if (stat(file.c_str(), &file_stat) != 0) {
+    return false;
+  }
+  *file_size = static_cast<uint64_t>(file_stat.st_size);
+  return true;
+}
+
+// Size and modification time in nanoseconds, a shard file rewritten to the same size still gets a new time.
+bool GetFileVersion(const std::string &file, uint64_t *file_size, uint64_t *file_mtime) {
+  struct stat file_stat;
+  if (stat(file.c_str(), &file_stat) != 0) {
+    return false;
+  }
+  *file_size = static_cast<uint64_t>(file_stat.st_size);
+#if defined(__APPLE__)
+  const struct timespec &mtime = file_stat.st_mtimespec;
+#elif defined(_WIN32) || defined(_WIN64)
+  struct timespec mtime = {file_stat.st_mtime, 0};
+#else
+  const struct timespec &mtime = file_stat.st_mtim;
+#endif
+  *file_mtime = static_cast<uint64_t>(mtime.tv_sec) * 1000000000ULL + static_cast<uint64_t>(mtime.tv_nsec);
+  return true;
+}
+
+// The values come from the index database as text, a malformed one fails the row instead of throwing.
+bool ParseUint64(const std::string &str, uint64_t *value) {
+  if (str.empty() || str[0] == '-') {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  *value = std::strtoull(str.c_str(), &end, 10);
+  return errno == 0 && *end == '\0';
+}
+
+bool ParseInt64(const std::string &str, int64_t *value) {
+  if (str.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  *value = std::strtoll(str.c_str(), &end, 10);
+  return errno == 0 && *end == '\0';
+}
+
+bool ParseFloat64(const std::string &str, double *value) {
+  if (str.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  *value = std::strtod(str.c_str(), &end);
+  return errno != ERANGE && *end == '\0';
+}
+}  // namespace
+
+ShardColumnIndex::~ShardColumnIndex() { Unmap(); }
+
+void ShardColumnIndex::AddColumn(const std::string &name, const std::string &place_holder,
+                                 const std::string &db_type) {
+  Column column;
+  column.name = name;
+  column.place_holder = place_holder;
+  if (db_type == "INTEGER") {
+    column.type = kColumnInt64;
+  } else if (db_type == "NUMERIC") {
+    column.type = kColumnFloat64;
+  } else {
+    column.type = kColumnString;
+  }
+  column_ids_[name] = static_cast<int>(columns_.size());
+  columns_.push_back(std::move(column));
+}
+
+MSRStatus ShardColumnIndex::AddRow(const std::vector<std::tuple<std::string, std::string, std::string>> &row_data) {
+  std::unordered_map<std::string, const std::string *> values;
+  for (const auto &field : row_data) {
+    values[std::get<0>(field)] = &std::get<2>(field);
+  }
+  auto row_id_iter = values.find(":ROW_ID");
+  if (row_id_iter == values.end()) {
+    MS_LOG(ERROR) << "Invalid data, row data of the index does not contain ROW_ID.";
+    return FAILED;
+  }
+  uint64_t row_id = 0;
+  if (!ParseUint64(*row_id_iter->second, &row_id)) {
+    MS_LOG(ERROR) << "Invalid data, ROW_ID of the index is not an unsigned integer: " << *row_id_iter->second;
+    return FAILED;
+  }
+  if (row_id >= row_count_) {
+    row_count_ = row_id + 1;
+    for (auto &meta_values : meta_values_) {
+      meta_values.resize(row_count_, 0);
+    }
+    for (auto &column : columns_) {
+      column.values.resize(column.type == kColumnString ? 0 : row_count_, 0);
+      column.strings.resize(column.type == kColumnString ? row_count_ : 0);
+    }
+  }
+  for (int i = 0; i < kIndexMetaCount; ++i) {
+    auto iter = values.find(kIndexMetaPlaceHolders[i]);
+    if (iter == values.end()) {
+      MS_LOG(ERROR) << "Invalid data, row data of the index does not contain " << kIndexMetaPlaceHolders[i];
+      return FAILED;
+    }
+    uint64_t value = 0;
+    if (!ParseUint64(*iter->second, &value)) {
+      MS_LOG(ERROR) << "Invalid data, " << kIndexMetaPlaceHolders[i] << " of the index is not an unsigned integer: "
+                    << *iter->second;
+      return FAILED;
+    }
+    meta_values_[i][row_id] = value;
+  }
+  for (auto &column : columns_) {
+    auto iter = values.find(column.place_holder);
+    if (iter == values.end()) {
+      continue;
+    }
+    if (column.type == kColumnInt64) {
+      int64_t value = 0;
+      if (!ParseInt64(*iter->second, &value)) {
+        MS_LOG(ERROR) << "Invalid data, field " << column.name << " of the index is not an integer: " << *iter->second;
+        return FAILED;
+      }
+      column.values[row_id] = static_cast<uint64_t>(value);
+    } else if (column.type == kColumnFloat64) {
+      double value = 0;
+      if (!ParseFloat64(*iter->second, &value)) {
+        MS_LOG(ERROR) << "Invalid data, field " << column.name << " of the index is not a number: " << *iter->second;
+        return FAILED;
+      }
+      (void)memcpy(&column.values[row_id], &value, sizeof(value));
+    } else {
+      column.strings[row_id] = *iter->second;
+    }
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardColumnIndex::Save(const std::string &shard_file) const {
+  uint64_t shard_file_size = 0;
+  uint64_t shard_file_mtime = 0;
+  if (!GetFileVersion(shard_file, &shard_file_size, &shard_file_mtime)) {
+    MS_LOG(ERROR) << "Invalid file, failed to get size of file: " << shard_file;
+    return FAILED;
+  }
+  std::string index_file = shard_file + kColumnIndexSuffix;
+  std::ofstream out(index_file, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Invalid file, failed to open file: " << index_file;
+    return FAILED;
+  }
+  WriteWord(&out, kColumnIndexMagic);
+  WriteWord(&out, kColumnIndexVersion);
+  WriteWord(&out, shard_file_size);
+  WriteWord(&out, shard_file_mtime);
+  WriteWord(&out, row_count_);
+  WriteWord(&out, columns_.size());
+  for (const auto &column : columns_) {
+    WriteWord(&out, column.type);
+    WriteWord(&out, column.name.size());
+    WritePadded(&out, column.name);
+  }
+  for (const auto &meta_values : meta_values_) {
+    out.write(reinterpret_cast<const char *>(meta_values.data()), meta_values.size() * kInt64Len);
+  }
+  for (const auto &column : columns_) {
+    if (column.type != kColumnString) {
+      out.write(reinterpret_cast<const char *>(column.values.data()), column.values.size() * kInt64Len);
+      continue;
+    }
+    uint64_t offset = 0;
+    WriteWord(&out, offset);
+    for (const auto &value : column.strings) {
+      offset += value.size();
+      WriteWord(&out, offset);
+    }
+    std::string chars;
+    chars.reserve(offset);
+    for (const auto &value : column.strings) {
+      chars += value;
+    }
+    WritePadded(&out, chars);
+  }
+  out.close();
+  if (!out.good()) {
+    MS_LOG(ERROR) << "File write failed: " << index_file;
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardColumnIndex::Load(const std::string &shard_file) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  Unmap();
+  std::string index_file = shard_file + kColumnIndexSuffix;
+  uint64_t shard_file_size = 0;
+  uint64_t shard_file_mtime = 0;
+  uint64_t index_file_size = 0;
+  if (!GetFileVersion(shard_file, &shard_file_size, &shard_file_mtime) || !GetFileSize(index_file, &index_file_size) ||
+      index_file_size < kColumnIndexHeaderLen * kInt64Len) {
+    MS_LOG(INFO) << "Column index is not found: " << index_file;
+    return FAILED;
+  }
+  int fd = open(index_file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(INFO) << "Failed to open column index: " << index_file;
+    return FAILED;
+  }
+  void *addr = mmap(nullptr, static_cast<size_t>(index_file_size), PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(INFO) << "Failed to map column index: " << index_file;
+    return FAILED;
+  }
+  map_addr_ = addr;
+  map_size_ = index_file_size;
+
+  const uint64_t *words = static_cast<const uint64_t *>(addr);
+  const uint64_t total_words = index_file_size / kInt64Len;
+  if (words[0] != kColumnIndexMagic || words[1] != kColumnIndexVersion || words[2] != shard_file_size ||
+      words[3] != shard_file_mtime) {
+    MS_LOG(INFO) << "Column index was not built for the current shard file, ignore it: " << index_file;
+    Unmap();
+    return FAILED;
+  }
+  row_count_ = words[4];
+  uint64_t column_count = words[5];
+  uint64_t pos = kColumnIndexHeaderLen;
+  auto fits = [&pos, total_words](uint64_t len) { return len <= total_words && pos <= total_words - len; };
+  if (row_count_ >= total_words) {
+    MS_LOG(INFO) << "Column index is truncated or corrupt, ignore it: " << index_file;
+    Unmap();
+    return FAILED;
+  }
+
+  columns_.clear();
+  column_ids_.clear();
+  for (uint64_t i = 0; i < column_count; ++i) {
+    if (!fits(2) || words[pos] > kColumnString) {
+      Unmap();
+      return FAILED;
+    }
+    Column column;
+    column.type = static_cast<ColumnType>(words[pos]);
+    uint64_t name_len = words[pos + 1];
+    pos += 2;
+    if (!fits(PaddedWords(name_len))) {
+      Unmap();
+      return FAILED;
+    }
+    column.name = std::string(reinterpret_cast<const char *>(words + pos), name_len);
+    pos += PaddedWords(name_len);
+    column_ids_[column.name] = static_cast<int>(columns_.size());
+    columns_.push_back(std::move(column));
+  }
+  for (auto &meta : meta_) {
+    if (!fits(row_count_)) {
+      Unmap();
+      return FAILED;
+    }
+    meta = words + pos;
+    pos += row_count_;
+  }
+  for (auto &column : columns_) {
+    if (column.type != kColumnString) {
+      if (!fits(row_count_)) {
+        Unmap();
+        return FAILED;
+      }
+      column.data = words + pos;
+      pos += row_count_;
+      continue;
+    }
+    if (!fits(row_count_ + 1)) {
+      Unmap();
+      return FAILED;
+    }
+    column.data = words + pos;
+    pos += row_count_ + 1;
+    // GetString reads the characters between two offsets without checks, so every offset has to be in order and
+    // within the characters of the column
+    uint64_t chars_len = column.data[row_count_];
+    if (!fits(PaddedWords(chars_len)) || !IsStringOffsetsValid(column.data, row_count_)) {
+      MS_LOG(INFO) << "Column index has invalid string offsets in field: " << column.name << ", ignore it: "
+                   << index_file;
+      Unmap();
+      return FAILED;
+    }
+    column.chars = reinterpret_cast<const char *>(words + pos);
+    pos += PaddedWords(chars_len);
+  }
+  MS_LOG(INFO) << "Load column index of " << row_count_ << " rows: " << index_file;
+  return SUCCESS;
+#else
+  return FAILED;
+#endif
+}
+
+int ShardColumnIndex::GetColumnId(const std::string &name) const {
+  auto iter = column_ids_.find(name);
+  return iter == column_ids_.end() ? -1 : iter->second;
+}
+
+int64_t ShardColumnIndex::GetInt64(int column_id, uint64_t row_id) const {
+  return static_cast<int64_t>(columns_[column_id].data[row_id]);
+}
+
+double ShardColumnIndex::GetFloat64(int column_id, uint64_t row_id) const {
+  double value = 0;
+  (void)memcpy(&value, &columns_[column_id].data[row_id], sizeof(value));
+  return value;
+}
+
+std::string ShardColumnIndex::GetString(int column_id, uint64_t row_id) const {
+  const auto &column = columns_[column_id];
+  return std::string(column.chars + column.data[row_id], column.data[row_id + 1] - column.data[row_id]);
+}
+
+void ShardColumnIndex::Unmap() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (map_addr_ != nullptr) {
+    (void)munmap(map_addr_, static_cast<size_t>(map_size_));
+  }
+#endif
+  map_addr_ = nullptr;
+  map_size_ = 0;
+  row_count_ = 0;
+  for (auto &meta : meta_) {
+    meta = nullptr;
+  }
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -63,11 +63,8 @@ void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
   bool is_enable_mem_reuse = EnvConfigParser::GetInstance().GetSysMemreuse();
-  if (context_ptr->get_param<int>(MS_CTX_EXECUTION_MODE) == kPynativeMode) {
-    // disable mem reuse for kPynativeMode
-    is_enable_mem_reuse = false;
-  }
-  if (is_enable_mem_reuse) {
+  bool is_pynative_mode = context_ptr->get_param<int>(MS_CTX_EXECUTION_MODE) == kPynativeMode;
+  if (is_enable_mem_reuse && !is_pynative_mode) {
     MS_EXCEPTION_IF_NULL(mem_manager_);
     mem_manager_->ResetDynamicMemory();
     AssignDynamicMemory(kernel_graph);
@@ -76,8 +73,13 @@ void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
     mindspore::memreuse::MemReuseChecker::GetInstance().CheckNormalIR(kernel_graph);
 #endif
   } else {
+    // Somas is too heavy to run for every op in kPynativeMode, reuse memory by the lifetimes along the execution
+    // order instead, unless the outputs of all the kernels are read after the graph runs.
+    auto &dump_json_parser = DumpJsonParser::GetInstance();
+    bool dump_all_kernels = dump_json_parser.e2e_dump_enabled() && dump_json_parser.dump_mode() == 0;
+    bool simple_mem_reuse = is_enable_mem_reuse && !kernel_graph->summary_node_exist() && !dump_all_kernels;
     AssignKernelOutputAddress(kernel_graph);
-    static_cast<CPUMemoryManager *>(mem_manager_.get())->AssignMemory(kernel_graph);
+    static_cast<CPUMemoryManager *>(mem_manager_.get())->AssignMemory(kernel_graph, simple_mem_reuse);
   }
 }
 
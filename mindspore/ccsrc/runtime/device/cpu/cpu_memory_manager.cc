@@ -91,8 +91,8 @@ void CPUMemoryManager::MemFree() {
   mem_block_map_.clear();
 }
 
-void CPUMemoryManager::AssignMemory(const session::KernelGraph *graph) {
-  size_t graph_mem_size = mem_plan_.MemPlan(graph);
+void CPUMemoryManager::AssignMemory(const session::KernelGraph *graph, bool reuse) {
+  size_t graph_mem_size = mem_plan_.MemPlan(graph, reuse);
   if (graph_mem_size > mem_size_) {
     if (mem_size_ > 0) {
       dynamic_mem_[mem_ptr_] = mem_size_;
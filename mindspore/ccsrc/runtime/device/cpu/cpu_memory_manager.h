@@ -38,7 +38,9 @@ class CPUMemoryManager : public MemoryManager {
   void FreeDeviceMemory() override { CPUMemoryPool::GetInstance().ReleaseDeviceRes(); }
   void ResetDynamicMemory() override;
 
-  void AssignMemory(const session::KernelGraph *graph);
+  // Assign the memory of the kernel outputs and workspaces of a graph, which share memory if reuse is true and their
+  // lifetimes do not overlap.
+  void AssignMemory(const session::KernelGraph *graph, bool reuse = false);
   void IncreaseAddressRefCount(const session::KernelGraph *graph);
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
   void *StaticMemMalloc(size_t mem_size);
@@ -14,16 +14,58 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <utility>
 #include "backend/session/anf_runtime_algorithm.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+namespace {
+constexpr size_t kMemAlignSize = 64;
+constexpr size_t kMemPlanReservedSize = 32;
+
+size_t AlignMemorySize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+}  // namespace
+
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph, bool reuse) {
   MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  CollectMemBlocks(graph);
+  size_t total_mem_size = kMemPlanReservedSize + PlaceMemBlocks(reuse);
+  if (reuse) {
+    size_t naive_mem_size = kMemPlanReservedSize;
+    for (const auto &block : mem_blocks_) {
+      naive_mem_size += AlignMemorySize(block.size);
+    }
+    MS_LOG(INFO) << "Graph " << graph->graph_id() << " reuses memory, planned size [" << total_mem_size
+                 << "], size without reuse [" << naive_mem_size << "]";
+  }
+  return total_mem_size;
+}
+
+void CPUSimpleMemPlan::CollectMemBlocks(const session::KernelGraph *graph) {
+  planned_graph_ = graph;
+  mem_blocks_.clear();
+  std::map<DeviceAddress *, size_t> block_index;
+  auto visit = [this, &block_index](DeviceAddress *address, size_t step) {
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ != nullptr) {
+      return;
+    }
+    auto iter = block_index.find(address);
+    if (iter == block_index.end()) {
+      block_index[address] = mem_blocks_.size();
+      mem_blocks_.push_back({address, address->size_, step, step, 0});
+    } else {
+      mem_blocks_[iter->second].last_step = step;
+    }
+  };
+
+  const auto &kernels = graph->execution_order();
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    const auto &kernel = kernels[step];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -32,79 +74,90 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       if (kernel_with_index.first->isa<Parameter>()) {
         continue;
       }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      visit(AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true).get(), step);
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      visit(AnfAlgo::GetMutableOutputAddr(kernel, i).get(), step);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      visit(AnfAlgo::GetWorkspaceAddr(kernel, i), step);
     }
   }
 
-  return total_mem_size;
+  // The outputs of the graph are read after the graph runs, so they live until the end of it
+  if (graph->output() == nullptr) {
+    return;
+  }
+  for (const auto &output : AnfAlgo::GetAllOutputWithIndex(graph->output())) {
+    if (!output.first->isa<CNode>() || !AnfAlgo::OutputAddrExist(output.first, output.second)) {
+      continue;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(output.first, output.second, true).get();
+    auto iter = block_index.find(address);
+    if (iter != block_index.end()) {
+      mem_blocks_[iter->second].last_step = kernels.size();
+    }
+  }
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
-  MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+size_t CPUSimpleMemPlan::PlaceMemBlocks(bool reuse) {
+  size_t total_mem_size = 0;
+  if (!reuse) {
+    for (auto &block : mem_blocks_) {
+      block.offset = total_mem_size;
+      total_mem_size += AlignMemorySize(block.size);
     }
+    return total_mem_size;
+  }
 
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+  // Place the largest blocks first, each one at the lowest offset not taken by the placed blocks alive with it
+  std::vector<size_t> order(mem_blocks_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_t a, size_t b) { return mem_blocks_[a].size > mem_blocks_[b].size; });
+  std::vector<size_t> placed;
+  std::vector<std::pair<size_t, size_t>> taken;
+  for (auto index : order) {
+    auto &block = mem_blocks_[index];
+    size_t size = AlignMemorySize(block.size);
+    taken.clear();
+    for (auto other_index : placed) {
+      const auto &other = mem_blocks_[other_index];
+      if (other.first_step <= block.last_step && block.first_step <= other.last_step) {
+        taken.emplace_back(other.offset, other.offset + AlignMemorySize(other.size));
       }
     }
-
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+    std::sort(taken.begin(), taken.end());
+    size_t offset = 0;
+    for (const auto &range : taken) {
+      if (range.first >= offset + size) {
+        break;
       }
+      offset = std::max(offset, range.second);
     }
+    block.offset = offset;
+    total_mem_size = std::max(total_mem_size, offset + size);
+    placed.push_back(index);
+  }
+  return total_mem_size;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  if (graph != planned_graph_) {
+    MS_LOG(EXCEPTION) << "The memory of graph " << graph->graph_id() << " is not planned.";
+  }
+  for (const auto &block : mem_blocks_) {
+    block.address->ptr_ = base_ptr + block.offset;
   }
+  planned_graph_ = nullptr;
+  mem_blocks_.clear();
 }
 }  // namespace cpu
 }  // namespace device
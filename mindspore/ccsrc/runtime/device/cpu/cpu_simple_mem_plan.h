@@ -23,13 +23,33 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// Plans the memory of the kernel outputs and workspaces of a graph in one block. Without reuse each of them gets a
+// slice of its own. With reuse, the slices are placed greedily by size, and two of them may overlap if their
+// lifetimes along the execution order do not, so the block only has to hold the tensors alive at the same time.
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
   ~CPUSimpleMemPlan() = default;
 
-  size_t MemPlan(const session::KernelGraph *graph);
+  // @return the size of the block needed by the graph.
+  size_t MemPlan(const session::KernelGraph *graph, bool reuse = false);
+  // Assign the slices planned by the last MemPlan of the graph.
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+
+ private:
+  struct MemBlock {
+    DeviceAddress *address;
+    size_t size;
+    size_t first_step;  // The kernel which writes it first
+    size_t last_step;   // The kernel which reads it last
+    size_t offset;
+  };
+
+  void CollectMemBlocks(const session::KernelGraph *graph);
+  size_t PlaceMemBlocks(bool reuse);
+
+  const session::KernelGraph *planned_graph_{nullptr};
+  std::vector<MemBlock> mem_blocks_;
 };
 }  // namespace cpu
 }  // namespace device
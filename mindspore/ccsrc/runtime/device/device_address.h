@@ -49,6 +49,11 @@ class GPUMemoryManager;
 class GPUDeviceContext;
 }  // namespace gpu
 }  // namespace device
+namespace runtime {
+class HostQueueDataSourceActor;
+class GraphScheduler;
+struct ActorSet;
+}  // namespace runtime
 }  // namespace mindspore
 
 namespace mindspore {
@@ -137,6 +142,9 @@ class DeviceAddress : public mindspore::DeviceSync {
   friend class mindspore::device::gpu::GPUKernelRuntime;
   friend class mindspore::device::gpu::GPUMemoryManager;
   friend class mindspore::device::gpu::GPUDeviceContext;
+  friend class mindspore::runtime::HostQueueDataSourceActor;
+  friend class mindspore::runtime::GraphScheduler;
+  friend struct mindspore::runtime::ActorSet;
   friend class mindspore::device::ascend::AscendKernelRuntime;
   friend class mindspore::device::ascend::AscendMemoryManager;
   friend class mindspore::device::ascend::DataDumper;
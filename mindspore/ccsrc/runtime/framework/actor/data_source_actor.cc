@@ -201,6 +201,18 @@ void DeviceQueueDataSourceActor::SendRecorderInfo(OpContext<DeviceTensor> *conte
   }
 }
 
+void HostQueueDataSourceActor::Init() {
+  DataSourceActor::Init();
+  borrowed_host_tensors_.resize(data_nodes_.size(), nullptr);
+  is_graph_output_.resize(data_nodes_.size(), false);
+  for (const auto &result_arrow : output_result_arrows_) {
+    MS_EXCEPTION_IF_NULL(result_arrow);
+    if (IntToSize(result_arrow->from_output_index_) < is_graph_output_.size()) {
+      is_graph_output_[IntToSize(result_arrow->from_output_index_)] = true;
+    }
+  }
+}
+
 void HostQueueDataSourceActor::FillDataBuffer() {
   // Construct device tensors.
   std::vector<DeviceTensor *> device_tensors;
@@ -215,6 +227,8 @@ void HostQueueDataSourceActor::FillDataBuffer() {
 
 void HostQueueDataSourceActor::SendMemoryAllocReq(OpContext<DeviceTensor> *context) {
   auto &device_tensors = buffers_.back();
+  // The device tensors using the memory of host tensors have a non null ptr and are skipped by the allocation.
+  BorrowHostTensorMemory(device_tensors);
   if (IsSameDeviceType()) {
     Async(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &device_tensors, device_contexts_[0], context,
           GetAID());
@@ -257,6 +271,10 @@ void HostQueueDataSourceActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *cont
     auto &device_tensor = device_tensors[i];
     MS_EXCEPTION_IF_NULL(host_tensor);
     MS_EXCEPTION_IF_NULL(device_tensor);
+    // The device tensor already uses the memory of the host tensor.
+    if (i < borrowed_host_tensors_.size() && borrowed_host_tensors_[i] == host_tensor) {
+      continue;
+    }
     auto tensor_device_address = std::dynamic_pointer_cast<DeviceTensor>(host_tensor->device_address());
     // Sync data from host_tensor_device_address to device_tensor.
     if (tensor_device_address != nullptr) {
@@ -302,6 +320,54 @@ size_t HostQueueDataSourceActor::FetchDataNodePosition(const AnfNodePtr &data_no
   return iter->second;
 }
 
+void HostQueueDataSourceActor::BorrowHostTensorMemory(const std::vector<DeviceTensor *> &device_tensors) {
+  // The previous step has finished, give back the memory borrowed by it.
+  for (size_t i = 0; i < borrowed_host_tensors_.size() && i < device_tensors.size(); ++i) {
+    if (borrowed_host_tensors_[i] != nullptr) {
+      MS_EXCEPTION_IF_NULL(device_tensors[i]);
+      device_tensors[i]->ptr_ = nullptr;
+      borrowed_host_tensors_[i] = nullptr;
+    }
+  }
+
+  MS_EXCEPTION_IF_NULL(host_queue_);
+  if (host_queue_->IsEmpty()) {
+    return;
+  }
+  const auto &host_tensors = host_queue_->Pull();
+  if ((host_tensors.size() != device_tensors.size()) || (borrowed_host_tensors_.size() != device_tensors.size())) {
+    return;
+  }
+  for (size_t i = 0; i < host_tensors.size(); ++i) {
+    auto &device_tensor = device_tensors[i];
+    if (!CanBorrowHostTensorMemory(i, host_tensors[i], device_tensor)) {
+      continue;
+    }
+    device_tensor->ptr_ = host_tensors[i]->data_c();
+    device_tensor->from_mem_pool_ = false;
+    borrowed_host_tensors_[i] = host_tensors[i];
+  }
+}
+
+bool HostQueueDataSourceActor::CanBorrowHostTensorMemory(size_t index, const TensorPtr &host_tensor,
+                                                         const DeviceTensor *device_tensor) const {
+  MS_EXCEPTION_IF_NULL(device_contexts_[index]);
+  if ((host_tensor == nullptr) || (device_tensor == nullptr) || is_graph_output_[index]) {
+    return false;
+  }
+  // Only the memory of the host is visible to the kernels of CPU, and the data must need no conversion.
+  if ((device_contexts_[index]->GetDeviceAddressType() != device::DeviceAddressType::kCPU) ||
+      (device_tensor->DeviceType() != device::DeviceAddressType::kCPU) || (host_tensor->device_address() != nullptr)) {
+    return false;
+  }
+  if ((host_tensor->data_type() != device_tensor->type_id()) ||
+      (LongToSize(host_tensor->data().nbytes()) != device_tensor->GetSize())) {
+    return false;
+  }
+  // The device tensor of a persistent or still referenced data node keeps the memory of its own.
+  return (device_tensor->GetPtr() == nullptr) && (device_tensor->original_ref_count() != SIZE_MAX);
+}
+
 bool HostQueueDataSourceActor::IsSameDeviceType() const {
   for (size_t i = 1; i < device_contexts_.size(); i++) {
     if (device_contexts_[i] != device_contexts_[0]) {
@@ -138,6 +138,8 @@ class HostQueueDataSourceActor : public DataSourceActor {
       : DataSourceActor(name, buffer_capacity, memory_manager_aid, debug_aid, recorder_aid), host_queue_(host_queue) {}
   ~HostQueueDataSourceActor() override = default;
 
+  void Init() override;
+
   void SendMemoryAllocReq(OpContext<DeviceTensor> *context) override;
   void SendMemoryFreeReq(OpContext<DeviceTensor> *context) override;
   void OnMemoryAllocFinish(OpContext<DeviceTensor> *context) override;
@@ -154,6 +156,11 @@ class HostQueueDataSourceActor : public DataSourceActor {
   // Judge all the data_nodes_ is from the same device.
   bool IsSameDeviceType() const;
 
+  // The device tensors of the data nodes on CPU use the memory of the host tensors directly instead of copying it,
+  // which saves the allocation and the copy of every batch. Called before the memory allocation of each step.
+  void BorrowHostTensorMemory(const std::vector<DeviceTensor *> &device_tensors);
+  bool CanBorrowHostTensorMemory(size_t index, const TensorPtr &host_tensor, const DeviceTensor *device_tensor) const;
+
   HostTensorQueuePtr host_queue_;
   // Input data nodes fetch data from host queue.
   std::vector<AnfNodePtr> data_nodes_;
@@ -162,6 +169,13 @@ class HostQueueDataSourceActor : public DataSourceActor {
 
   // The location of the data node in the data source actor.
   std::unordered_map<AnfNodePtr, size_t> data_node_position_map_;
+
+  // The host tensors whose memory is used by the device tensors of the data nodes in the current step, nullptr for
+  // the data nodes whose device tensors have memory of their own. Holding them keeps the memory alive until the next
+  // step has fetched its data, then the memory goes back to its owner with the last reference to the host tensor.
+  std::vector<TensorPtr> borrowed_host_tensors_;
+  // The data nodes which are graph outputs, the output tensors keep their device tensors after the step.
+  std::vector<bool> is_graph_output_;
 };
 
 using DataSourceActorPtr = std::shared_ptr<DataSourceActor>;
@@ -15,6 +15,7 @@
  */
 
 #include "runtime/framework/actor/kernel_actor.h"
+#include <algorithm>
 #include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/framework/actor/output_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
@@ -24,6 +25,22 @@
 
 namespace mindspore {
 namespace runtime {
+namespace {
+// Whether the current thread is running the fused actors of a chain.
+thread_local bool running_fused_actors = false;
+// The kernel actor launched last in the current thread, whose fused actor waits for its output data.
+thread_local const KernelActor *pending_fused_actor = nullptr;
+
+class FusedActorsGuard {
+ public:
+  FusedActorsGuard() { running_fused_actors = true; }
+  ~FusedActorsGuard() {
+    running_fused_actors = false;
+    pending_fused_actor = nullptr;
+  }
+};
+}  // namespace
+
 void KernelActor::Init() {
   // Set the number of actor running dependent messages.
   running_dependent_msg_num_ = SizeToInt(input_datas_num_ + input_controls_num_);
@@ -92,12 +109,13 @@ void KernelActor::RunOpData(OpData<DeviceTensor> *input_data, OpContext<DeviceTe
 
     FetchInputDeviceTensor(context);
     FetchOutputDeviceTensor();
-    if (memory_alloc_list_.size() > 0) {
+    if (NeedAllocateMemory()) {
       SendMemoryAllocReq(context);
     } else {
       OnMemoryAllocFinish(context);
     }
   }
+  RunFusedActors(context);
 }
 
 void KernelActor::RunOpControl(AID *input_control, OpContext<DeviceTensor> *context) {
@@ -113,12 +131,13 @@ void KernelActor::RunOpControl(AID *input_control, OpContext<DeviceTensor> *cont
 
     FetchInputDeviceTensor(context);
     FetchOutputDeviceTensor();
-    if (memory_alloc_list_.size() > 0) {
+    if (NeedAllocateMemory()) {
       SendMemoryAllocReq(context);
     } else {
       OnMemoryAllocFinish(context);
     }
   }
+  RunFusedActors(context);
 }
 
 void KernelActor::RunOpControlWithInputTensor(AID *input_control, OpContext<DeviceTensor> *context,
@@ -224,6 +243,7 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *context) {
   }
 
   PostLaunchKernel(context);
+  RunFusedActors(context);
 }
 
 void KernelActor::SendDebugReq(OpContext<DeviceTensor> *context) {
@@ -234,6 +254,7 @@ void KernelActor::SendDebugReq(OpContext<DeviceTensor> *context) {
 void KernelActor::OnDebugFinish(OpContext<DeviceTensor> *context) {
   MS_EXCEPTION_IF_NULL(context);
   PostLaunchKernel(context);
+  RunFusedActors(context);
 }
 
 bool KernelActor::CheckLaunchCondition(OpContext<DeviceTensor> *context) const {
@@ -404,12 +425,42 @@ void KernelActor::PostLaunchKernel(OpContext<DeviceTensor> *context) {
   // the next actor and the actor is asynchronous execution. So it is necessary to ensure that SendMemoryFreeReq of the
   // current actor is in front of SendMemoryAllocReq of the next actor.  One is to reuse the memory more fully, the
   // other is to ensure the execution order and avoid the illegal memory timing problem.
-  if (memory_free_list_.size() > 0) {
+  if (NeedFreeMemory()) {
     SendMemoryFreeReq(context);
   }
   SendOutput(context);
 }
 
+void KernelActor::RunFusedActors(OpContext<DeviceTensor> *context) {
+  // The outermost actor runs the chain after it is launched in this thread.
+  if (running_fused_actors || (pending_fused_actor != this)) {
+    return;
+  }
+  FusedActorsGuard guard;
+  // The chain stops at the actor which waits for the memory alloc or debug, and goes on in its callback.
+  while (pending_fused_actor != nullptr) {
+    auto actor = pending_fused_actor;
+    pending_fused_actor = nullptr;
+    MS_EXCEPTION_IF_NULL(actor->output_data_[0]);
+    // The direct call bypasses the mailbox of the fused actor, which is only safe because FuseKernelActorChains
+    // requires its input_datas_num_ == 1 and input_controls_num_ == 0: the data from this actor is its only message,
+    // so no other thread runs it at the same time.
+    actor->fused_actor_->RunOpData(actor->output_data_[0], context);
+  }
+}
+
+bool KernelActor::NeedAllocateMemory() const {
+  return std::any_of(memory_alloc_list_.begin(), memory_alloc_list_.end(), [](const DeviceTensor *device_tensor) {
+    return (device_tensor == nullptr) || (device_tensor->GetPtr() == nullptr);
+  });
+}
+
+bool KernelActor::NeedFreeMemory() const {
+  return std::any_of(memory_free_list_.begin(), memory_free_list_.end(), [](const DeviceTensor *device_tensor) {
+    return (device_tensor == nullptr) || (device_tensor->original_ref_count() != SIZE_MAX);
+  });
+}
+
 void KernelActor::SendOutput(OpContext<DeviceTensor> *context) const {
   MS_EXCEPTION_IF_NULL(context);
   if (strategy_ == GraphExecutionStrategy::kStep) {
@@ -424,10 +475,14 @@ void KernelActor::SendOutput(OpContext<DeviceTensor> *context) const {
           result_arrow->to_input_index_, context);
   }
 
-  // 2.Send output data.
-  for (auto &output_data : output_data_) {
-    MS_EXCEPTION_IF_NULL(output_data);
-    Async(output_data->op_id_, &OpActor::RunOpData, output_data, context);
+  // 2.Send output data, the only output data of the fused actor is sent by RunFusedActors.
+  if (fused_actor_ != nullptr) {
+    pending_fused_actor = this;
+  } else {
+    for (auto &output_data : output_data_) {
+      MS_EXCEPTION_IF_NULL(output_data);
+      Async(output_data->op_id_, &OpActor::RunOpData, output_data, context);
+    }
   }
 
   // 3.Send output control.
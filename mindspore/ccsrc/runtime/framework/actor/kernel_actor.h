@@ -100,8 +100,16 @@ class KernelActor : public DebugAwareActor {
   // The processing after kernel launch: 1.erase input, 2.free memory, 3.send output.
   void PostLaunchKernel(OpContext<DeviceTensor> *context);
 
+  // The device tensors with fixed addresses from the static memory plan need no memory alloc and free, so the requests
+  // are only needed when some device tensor is allocated and freed in the running.
+  bool NeedAllocateMemory() const;
+  bool NeedFreeMemory() const;
+
   // Send output data and output controls when finish kernel launch.
   void SendOutput(OpContext<DeviceTensor> *context) const;
+  // Run the fused actors after this one in turn, the nested actors leave their fused actors to the outermost one
+  // instead of running them recursively.
+  void RunFusedActors(OpContext<DeviceTensor> *context);
   // Erase input data and input controls when finish kernel launch.
   void EraseInput(OpContext<DeviceTensor> *context);
 
@@ -167,6 +175,10 @@ class KernelActor : public DebugAwareActor {
   std::vector<std::vector<OpDataUniquePtr<DeviceTensor>>> output_data_by_output_index_;
   //  The output_data_ corresponds to the output_data_arrows_ one by one.
   std::vector<OpData<DeviceTensor> *> output_data_;
+
+  // The next kernel actor of the fused chain, which receives the only output data of this actor by the direct call
+  // instead of the message.
+  KernelActor *fused_actor_{nullptr};
 };
 
 using KernelActorPtr = std::shared_ptr<KernelActor>;
@@ -15,6 +15,7 @@
  */
 
 #include "runtime/framework/graph_scheduler.h"
+#include <numeric>
 #include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/framework/actor/debug_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
@@ -29,6 +30,7 @@
 #include "utils/ms_context.h"
 #include "common/trans.h"
 #include "debug/data_dump/dump_json_parser.h"
+#include "debug/env_config_parser.h"
 #ifdef ENABLE_DUMP_IR
 #include "debug/rdr/recorder_manager.h"
 #endif
@@ -409,8 +411,90 @@ bool RunInStepMode(const ActorSet *actor_set, const std::vector<TensorPtr> *inpu
   MsException::Instance().CheckException();
   return result_future.IsOK();
 }
+
+// A device tensor of the static memory plan.
+struct StaticMemoryTensor {
+  DeviceTensorPtr device_tensor;
+  bool plannable;
+  // The topological positions of the kernel actors using the device tensor in order, the first one writes it.
+  std::vector<size_t> users;
+  size_t offset;
+};
+
+constexpr size_t kStaticMemoryAlignSize = 512;
+// The reachability of the kernel actors costs the square of their number in bits.
+constexpr size_t kMaxStaticMemoryPlanActorNum = 16384;
+constexpr size_t kBitsPerWord = 64;
+
+size_t AlignStaticMemorySize(size_t size) {
+  return (size + kStaticMemoryAlignSize - 1) / kStaticMemoryAlignSize * kStaticMemoryAlignSize;
+}
+
+// Whether all the uses of the former device tensor happen before the latter is written, the actors run concurrently
+// and only the arrows of the actor DAG order them.
+bool IsUsedBeforeWritten(const StaticMemoryTensor &former, const StaticMemoryTensor &latter,
+                         const std::vector<uint64_t> &ancestors, size_t words) {
+  size_t writer = latter.users.front();
+  if (former.users.back() >= writer) {
+    return false;
+  }
+  const uint64_t *writer_ancestors = &ancestors[writer * words];
+  return std::all_of(former.users.begin(), former.users.end(), [writer_ancestors](size_t user) {
+    return ((writer_ancestors[user / kBitsPerWord] >> (user % kBitsPerWord)) & 1) != 0;
+  });
+}
+
+// Place the device tensors greedily by size, each one at the lowest offset not taken by a placed device tensor whose
+// lifetime is not ordered with its own.
+size_t PlaceStaticMemoryTensors(std::vector<StaticMemoryTensor> *tensors, const std::vector<uint64_t> &ancestors,
+                                size_t words) {
+  MS_EXCEPTION_IF_NULL(tensors);
+  std::vector<size_t> order(tensors->size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [tensors](size_t a, size_t b) {
+    return (*tensors)[a].device_tensor->GetSize() > (*tensors)[b].device_tensor->GetSize();
+  });
+
+  size_t total_size = 0;
+  std::vector<size_t> placed;
+  std::vector<std::pair<size_t, size_t>> taken;
+  for (auto index : order) {
+    auto &tensor = (*tensors)[index];
+    size_t size = AlignStaticMemorySize(tensor.device_tensor->GetSize());
+    taken.clear();
+    for (auto placed_index : placed) {
+      const auto &other = (*tensors)[placed_index];
+      if (!IsUsedBeforeWritten(tensor, other, ancestors, words) &&
+          !IsUsedBeforeWritten(other, tensor, ancestors, words)) {
+        taken.emplace_back(other.offset, other.offset + AlignStaticMemorySize(other.device_tensor->GetSize()));
+      }
+    }
+    std::sort(taken.begin(), taken.end());
+    size_t offset = 0;
+    for (const auto &range : taken) {
+      if (range.first >= offset + size) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    tensor.offset = offset;
+    total_size = std::max(total_size, offset + size);
+    placed.emplace_back(index);
+  }
+  return total_size;
+}
 }  // namespace
 
+ActorSet::~ActorSet() {
+  // The device tensors of the static memory plan may outlive the actor set, such as the ones shared with another
+  // graph, so unbind them from the memory blocks before the blocks are freed.
+  for (const auto &tensor : static_memory_tensors_) {
+    tensor.first->set_ptr(nullptr);
+    tensor.first->set_original_ref_count(tensor.second);
+    tensor.first->ResetRefCount();
+  }
+}
+
 void GraphScheduler::Clear() {
   // Terminate all actors.
   auto actorMgr = ActorMgr::GetActorMgrRef();
@@ -526,6 +610,9 @@ ActorSet *GraphScheduler::Transform(const GraphCompilerInfo &graph_compiler_info
   Link(actor_set.get(), graph_compiler_info);
   // The copy actors are built in the link, so need push into the actor set after link.
   actor_set->copy_actors_ = copy_actors_;
+  // The static memory plan and the actor fusion depend on all the arrows, so must be behind the link.
+  BuildStaticMemoryPlan(actor_set.get(), graph_compiler_info);
+  FuseKernelActorChains(actor_set.get(), graph_compiler_info);
 
   actors_.emplace(actor_set->name_, actor_set);
 
@@ -2769,6 +2856,203 @@ void GraphScheduler::PersistDeviceTensor(const GraphCompilerInfo &graph_compiler
   }
 }
 
+void GraphScheduler::BuildStaticMemoryPlan(ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  // The kernel actors in the control flow may run many times in a step.
+  if ((graph_compiler_info.strategy_ != GraphExecutionStrategy::kPipeline) ||
+      (!graph_compiler_info.control_nodes_.empty()) || (!EnvConfigParser::GetInstance().GetSysMemreuse())) {
+    return;
+  }
+  for (size_t i = 0; i < graph_compiler_info.graphs_.size(); ++i) {
+    BuildStaticMemoryPlan(actor_set, graph_compiler_info.graphs_[i], graph_compiler_info.device_contexts_[i]);
+  }
+}
+
+void GraphScheduler::BuildStaticMemoryPlan(ActorSet *actor_set, const KernelGraphPtr &graph,
+                                           const DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(device_context);
+  // 1.Collect the kernel actors of graph, the communication kernels run in other streams and need continuous memory.
+  std::vector<KernelActor *> kernel_actors;
+  std::unordered_map<std::string, size_t> actor_name_to_index;
+  for (const auto &kernel : graph->execution_order()) {
+    if (AnfAlgo::IsCommunicationOp(kernel)) {
+      MS_LOG(INFO) << "Graph " << graph->graph_id() << " has communication kernels, skip the static memory plan.";
+      return;
+    }
+    const auto &kernel_actor = dynamic_cast<KernelActor *>(FetchActor(kernel->fullname_with_scope()));
+    if (kernel_actor == nullptr) {
+      continue;
+    }
+    actor_name_to_index[kernel_actor->GetAID().Name()] = kernel_actors.size();
+    kernel_actors.emplace_back(kernel_actor);
+  }
+  size_t actor_num = kernel_actors.size();
+  if ((actor_num == 0) || (actor_num > kMaxStaticMemoryPlanActorNum)) {
+    return;
+  }
+
+  // 2.Sort the kernel actors topologically by the input arrows from the kernel actors of graph.
+  std::vector<std::vector<size_t>> successors(actor_num);
+  std::vector<size_t> input_num(actor_num, 0);
+  for (size_t i = 0; i < actor_num; ++i) {
+    auto link = [&](const std::vector<AID> &input_aids) {
+      for (const auto &input_aid : input_aids) {
+        const auto &iter = actor_name_to_index.find(input_aid.Name());
+        if (iter != actor_name_to_index.end()) {
+          successors[iter->second].emplace_back(i);
+          ++input_num[i];
+        }
+      }
+    };
+    link(kernel_actors[i]->input_data_arrow_aids_);
+    link(kernel_actors[i]->input_control_arrow_aids_);
+  }
+  std::vector<size_t> topo_order;
+  for (size_t i = 0; i < actor_num; ++i) {
+    if (input_num[i] == 0) {
+      topo_order.emplace_back(i);
+    }
+  }
+  for (size_t i = 0; i < topo_order.size(); ++i) {
+    for (auto successor : successors[topo_order[i]]) {
+      if (--input_num[successor] == 0) {
+        topo_order.emplace_back(successor);
+      }
+    }
+  }
+  if (topo_order.size() != actor_num) {
+    MS_LOG(WARNING) << "The kernel actors of graph " << graph->graph_id() << " are not a DAG.";
+    return;
+  }
+  std::vector<size_t> topo_position(actor_num);
+  for (size_t i = 0; i < actor_num; ++i) {
+    topo_position[topo_order[i]] = i;
+  }
+
+  // 3.Compute the ancestors of each kernel actor by the topological position.
+  size_t words = (actor_num + kBitsPerWord - 1) / kBitsPerWord;
+  std::vector<uint64_t> ancestors(actor_num * words, 0);
+  for (size_t position = 0; position < actor_num; ++position) {
+    for (auto successor : successors[topo_order[position]]) {
+      auto successor_ancestors = &ancestors[topo_position[successor] * words];
+      for (size_t word = 0; word < words; ++word) {
+        successor_ancestors[word] |= ancestors[position * words + word];
+      }
+      successor_ancestors[position / kBitsPerWord] |= static_cast<uint64_t>(1) << (position % kBitsPerWord);
+    }
+  }
+
+  // 4.Collect the outputs and workspaces of the static shape kernels, which only the kernel actors of graph use.
+  std::vector<StaticMemoryTensor> tensors;
+  std::unordered_map<DeviceTensor *, size_t> tensor_to_index;
+  auto add_user = [&tensors, &tensor_to_index](const DeviceTensorPtr &device_tensor, size_t user, bool plannable) {
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    const auto &iter = tensor_to_index.find(device_tensor.get());
+    if (iter == tensor_to_index.end()) {
+      tensor_to_index[device_tensor.get()] = tensors.size();
+      tensors.push_back({device_tensor, plannable, {user}, 0});
+    } else {
+      tensors[iter->second].plannable = tensors[iter->second].plannable && plannable;
+      tensors[iter->second].users.emplace_back(user);
+    }
+  };
+  for (size_t i = 0; i < actor_num; ++i) {
+    const auto &kernel_actor = kernel_actors[i];
+    MS_EXCEPTION_IF_NULL(kernel_actor->kernel_);
+    bool is_static_shape = !AnfAlgo::IsDynamicShape(kernel_actor->kernel_);
+    const auto &kernel_info = static_cast<KernelInfo *>(kernel_actor->kernel_->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    const auto &output_addresses = kernel_info->output_address_list();
+    for (size_t output_index = 0; output_index < output_addresses.size(); ++output_index) {
+      const auto &output_address = output_addresses[output_index];
+      bool plannable = is_static_shape;
+      for (const auto &result_arrow : kernel_actor->output_result_arrows_) {
+        plannable = plannable && (IntToSize(result_arrow->from_output_index_) != output_index);
+      }
+      add_user(output_address, topo_position[i], plannable);
+      for (const auto &data_arrow : kernel_actor->output_data_arrows_) {
+        if (IntToSize(data_arrow->from_output_index_) != output_index) {
+          continue;
+        }
+        // The output sent to the other actors, such as copy actors, is not plannable.
+        const auto &iter = actor_name_to_index.find(data_arrow->to_op_id_.Name());
+        bool to_graph_kernel_actor = (iter != actor_name_to_index.end());
+        add_user(output_address, to_graph_kernel_actor ? topo_position[iter->second] : topo_position[i],
+                 to_graph_kernel_actor);
+      }
+    }
+    for (const auto &workspace_address : kernel_info->workspace_address_list()) {
+      add_user(workspace_address, topo_position[i], is_static_shape);
+    }
+  }
+  size_t total_tensor_size = 0;
+  std::vector<StaticMemoryTensor> planned_tensors;
+  for (auto &tensor : tensors) {
+    if (tensor.plannable && (tensor.device_tensor->GetPtr() == nullptr) && (tensor.device_tensor->GetSize() > 0) &&
+        (tensor.device_tensor->original_ref_count() != SIZE_MAX)) {
+      std::sort(tensor.users.begin(), tensor.users.end());
+      total_tensor_size += AlignStaticMemorySize(tensor.device_tensor->GetSize());
+      planned_tensors.emplace_back(std::move(tensor));
+    }
+  }
+  if (planned_tensors.empty()) {
+    return;
+  }
+
+  // 5.Allocate the memory block of graph and bind the fixed addresses, the max reference count keeps them from being
+  // freed.
+  size_t block_size = PlaceStaticMemoryTensors(&planned_tensors, ancestors, words);
+  auto memory_block = device_context->CreateDeviceAddress(nullptr, block_size, kOpFormat_DEFAULT, kNumberTypeUInt8);
+  MS_EXCEPTION_IF_NULL(memory_block);
+  if (!device_context->AllocateMemory(memory_block.get(), block_size)) {
+    MS_LOG(WARNING) << "Device(id:" << device_context->device_context_key().device_id_
+                    << ") memory isn't enough for the static memory plan of graph " << graph->graph_id()
+                    << ", alloc size: " << block_size << ", allocate the memory in the running instead.";
+    return;
+  }
+  auto base_ptr = static_cast<uint8_t *>(memory_block->GetMutablePtr());
+  for (const auto &tensor : planned_tensors) {
+    actor_set->static_memory_tensors_.emplace_back(tensor.device_tensor, tensor.device_tensor->original_ref_count());
+    tensor.device_tensor->set_ptr(base_ptr + tensor.offset);
+    UpdateRefCount(tensor.device_tensor.get(), true);
+  }
+  actor_set->static_memory_blocks_.emplace_back(memory_block);
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " plans the static memory of " << planned_tensors.size()
+               << " device tensors, memory block size: " << block_size << ", total size: " << total_tensor_size;
+}
+
+void GraphScheduler::FuseKernelActorChains(const ActorSet *actor_set,
+                                           const GraphCompilerInfo &graph_compiler_info) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  if ((graph_compiler_info.strategy_ != GraphExecutionStrategy::kPipeline) ||
+      (!graph_compiler_info.control_nodes_.empty()) || (common::GetEnv("MS_ACTOR_CHAIN_FUSION") == "0")) {
+    return;
+  }
+
+  size_t fused_actor_num = 0;
+  for (const auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    if ((kernel_actor->strategy_ != GraphExecutionStrategy::kPipeline) ||
+        (kernel_actor->output_data_arrows_.size() != 1) || (!kernel_actor->output_control_arrows_.empty()) ||
+        (!kernel_actor->output_result_arrows_.empty())) {
+      continue;
+    }
+    const auto &output_aid = kernel_actor->output_data_arrows_[0]->to_op_id_;
+    const auto &to_actor = dynamic_cast<KernelActor *>(FetchActor(output_aid.Name()));
+    if ((to_actor == nullptr) || (to_actor->strategy_ != GraphExecutionStrategy::kPipeline) ||
+        (to_actor->device_context_ != kernel_actor->device_context_) || (to_actor->input_datas_num_ != 1) ||
+        (to_actor->input_controls_num_ != 0)) {
+      continue;
+    }
+    kernel_actor->fused_actor_ = to_actor;
+    ++fused_actor_num;
+  }
+  MS_LOG(INFO) << "Graph(" << graph_compiler_info.name_ << ") fuses " << fused_actor_num
+               << " kernel actors into the chains of their previous kernel actors.";
+}
+
 HostTensorQueue *GraphScheduler::FetchHostQueue(const ActorInfo &actor_info) const {
   const auto &iter = actor_to_host_queue_.find(actor_info);
   if (iter != actor_to_host_queue_.end()) {
@@ -3020,6 +3304,9 @@ void GraphScheduler::DumpKernelActor(const KernelActor *actor, std::ofstream &of
         << "\tto_actor_name:" << result_arrow->to_op_id_.Name()
         << "\toutput_node_position:" << result_arrow->to_input_index_ << "\n";
   }
+  if (actor->fused_actor_ != nullptr) {
+    ofs << "\t\tfused_actor_name:" << actor->fused_actor_->GetAID().Name() << "\n";
+  }
   ofs << "\n";
 }
 
@@ -111,6 +111,7 @@ struct GraphCompilerInfo {
 // The output actor is used to receive the output result of actor which represents the graph output.
 struct ActorSet {
   explicit ActorSet(const ActorInfo &name) : name_(name) {}
+  ~ActorSet();
   std::vector<DataSourceActorPtr> data_source_actors_;
   std::vector<KernelActorPtr> kernel_actors_;
   // No input kernel actors need be triggered specifically.
@@ -120,6 +121,11 @@ struct ActorSet {
   std::vector<CopyActorPtr> copy_actors_;
   LoopCountActorPtr loop_count_actor_{nullptr};
   OutputActorPtr output_actor_{nullptr};
+  // The memory blocks of the static memory plan, which hold the fixed addresses of device tensors.
+  std::vector<DeviceTensorPtr> static_memory_blocks_;
+  // The device tensors bound to the memory blocks and their original reference counts before the plan, which are
+  // restored when the actor set is destroyed.
+  std::vector<std::pair<DeviceTensorPtr, size_t>> static_memory_tensors_;
   ActorInfo name_;
 };
 using ActorSetPtr = std::shared_ptr<ActorSet>;
@@ -284,6 +290,18 @@ class GraphScheduler {
   // Persist device tensors of graph's some nodes(such as weights and value nodes).
   void PersistDeviceTensor(const GraphCompilerInfo &graph_compiler_info);
 
+  // Plan the memory of the kernel actors of each graph at build time, which is used in pipeline mode. The device
+  // tensors of static shape kernels get fixed addresses in one memory block of the graph, and two of them share memory
+  // only if the actor DAG orders all the uses of one before the other is written. The kernel actors need no memory
+  // alloc and free requests for these device tensors.
+  void BuildStaticMemoryPlan(ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info);
+  void BuildStaticMemoryPlan(ActorSet *actor_set, const KernelGraphPtr &graph, const DeviceContext *device_context);
+
+  // Fuse the chains of kernel actors on the same device, in which each kernel actor only sends one output data to the
+  // next one and the next one only receives it. The kernel actors of a chain run back to back in the thread of the
+  // chain head instead of sending the data by the messages, which is used in pipeline mode without control flow.
+  void FuseKernelActorChains(const ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info) const;
+
   // Fetch the hsot tensor queue by actor info.
   HostTensorQueue *FetchHostQueue(const ActorInfo &actor_info) const;
 
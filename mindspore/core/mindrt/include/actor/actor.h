@@ -64,6 +64,7 @@ class ActorBase : std::enable_shared_from_this<ActorBase> {
   virtual ~ActorBase();
 
   // send  MessageBase message to the  actor.
+  // return a positive value when the message is sent, ERRORCODE_SUCCESS for a local actor, else an error code.
   int Send(const AID &to, std::unique_ptr<MessageBase> msg);
 
   // send string message to the actor
@@ -197,6 +198,7 @@ class ActorBase : std::enable_shared_from_this<ActorBase> {
 
   void Run();
   void Quit();
+  bool KeepsRunning() const;
   int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
 
   void Spawn(const std::shared_ptr<ActorBase> &actor, std::unique_ptr<ActorPolicy> actorThread);
@@ -17,10 +17,12 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
 #include <utility>
 #include <string>
 
 #include "actor/aid.h"
+#include "actor/msgpool.h"
 
 namespace mindspore {
 class ActorBase;
@@ -52,6 +54,21 @@ class MessageBase {
 
   virtual ~MessageBase() {}
 
+  // The messages live in the blocks of the message pool, the virtual destructor passes the size of the derived message.
+  static void *operator new(size_t size) {
+    void *ptr = MessagePool::Alloc(size);
+    MINDRT_OOM_EXIT(ptr);
+    return ptr;
+  }
+
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept { return MessagePool::Alloc(size); }
+
+  static void operator delete(void *ptr, size_t size) noexcept { MessagePool::Free(ptr, size); }
+
+  // Only called when a constructor throws after the nothrow new, without the size. Every block of the pool comes from
+  // the global new, so the memory goes straight back to the heap.
+  static void operator delete(void *ptr, const std::nothrow_t &) noexcept { ::operator delete(ptr); }
+
   inline std::string &Name() { return name; }
 
   inline void SetName(const std::string &aName) { this->name = aName; }
@@ -79,6 +96,11 @@ class MessageBase {
   std::string name;
   std::string body;
   Type type;
+
+ private:
+  friend class Mailbox;
+  // The link of the intrusive mailbox queue of the receiving actor.
+  std::atomic<MessageBase *> next{nullptr};
 };
 
 }  // namespace mindspore
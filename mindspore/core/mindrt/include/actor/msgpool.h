@@ -0,0 +1,96 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSGPOOL_H
+#define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSGPOOL_H
+
+#include <cstddef>
+#include <new>
+
+namespace mindspore {
+
+// Fixed-size memory blocks for the messages, so that sending a message in steady state does not hit the heap.
+// Every thread keeps a free list of its own: a message is usually allocated by the sending thread and freed by the
+// receiving one, and as the actor threads do both, the blocks circulate between their free lists without any lock.
+class MessagePool {
+ public:
+  // Fits a message with the closure of an Async call of a few arguments, bigger messages come from the heap.
+  static constexpr size_t kBlockSize = 320;
+  // The blocks above this number freed by a thread go back to the heap.
+  static constexpr size_t kMaxFreeBlocks = 4096;
+
+  static void *Alloc(size_t size) noexcept {
+    if (size > kBlockSize) {
+      return ::operator new(size, std::nothrow);
+    }
+    FreeList &list = LocalFreeList();
+    Block *block = list.head;
+    if (block == nullptr) {
+      return ::operator new(kBlockSize, std::nothrow);
+    }
+    list.head = block->next;
+    --list.count;
+    return block;
+  }
+
+  static void Free(void *ptr, size_t size) noexcept {
+    if (ptr == nullptr) {
+      return;
+    }
+    if (size > kBlockSize) {
+      ::operator delete(ptr);
+      return;
+    }
+    FreeList &list = LocalFreeList();
+    if (list.count >= kMaxFreeBlocks) {
+      ::operator delete(ptr);
+      return;
+    }
+    Block *block = static_cast<Block *>(ptr);
+    block->next = list.head;
+    list.head = block;
+    ++list.count;
+  }
+
+ private:
+  struct Block {
+    Block *next;
+  };
+
+  struct FreeList {
+    Block *head = nullptr;
+    size_t count = 0;
+
+    ~FreeList() {
+      while (head != nullptr) {
+        Block *block = head;
+        head = block->next;
+        ::operator delete(block);
+      }
+      // The messages freed later on in the exit of the thread go straight back to the heap.
+      count = kMaxFreeBlocks;
+    }
+  };
+
+  static FreeList &LocalFreeList() noexcept {
+    thread_local FreeList list;
+    return list;
+  }
+};
+
+}  // namespace mindspore
+
+#endif
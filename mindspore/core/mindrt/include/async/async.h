@@ -19,6 +19,7 @@
 
 #include <tuple>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "actor/actor.h"
@@ -31,18 +32,29 @@ namespace mindspore {
 
 using MessageHandler = std::function<void(ActorBase *)>;
 
+// The closure of an Async call is held inline in its message, which comes from the message pool, so that sending
+// it allocates nothing as long as the captured arguments are small.
+template <typename F>
 class MessageAsync : public MessageBase {
  public:
-  explicit MessageAsync(MessageHandler &h) : MessageBase("Async", Type::KASYNC), handler(h) {}
+  explicit MessageAsync(F &&h) : MessageBase("Async", Type::KASYNC), handler(std::move(h)) {}
   ~MessageAsync() override {}
-  void Run(ActorBase *actor) override { (handler)(actor); }
+  void Run(ActorBase *actor) override { handler(actor); }
 
  private:
-  MessageHandler handler;
+  F handler;
 };
 
 namespace internal {
 
+template <typename F>
+void SendAsync(const AID &aid, F &&handler) {
+  using Handler = typename std::decay<F>::type;
+  std::unique_ptr<MessageBase> msg(new (std::nothrow) MessageAsync<Handler>(Handler(std::forward<F>(handler))));
+  MINDRT_OOM_EXIT(msg);
+  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+}
+
 template <typename R>
 struct AsyncHelper;
 
@@ -51,10 +63,8 @@ template <>
 struct AsyncHelper<void> {
   template <typename F>
   void operator()(const AID &aid, F &&f) {
-    std::function<void(ActorBase *)> handler = [=](ActorBase *) { f(); };
-    std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    auto handler = [f = std::forward<F>(f)](ActorBase *) { f(); };
+    internal::SendAsync(aid, std::move(handler));
   }
 };
 
@@ -66,11 +76,9 @@ struct AsyncHelper<Future<R>> {
     MINDRT_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    MessageHandler handler = [=](ActorBase *) { promise->Associate(f()); };
+    auto handler = [promise, f = std::forward<F>(f)](ActorBase *) { promise->Associate(f()); };
 
-    std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    internal::SendAsync(aid, std::move(handler));
     return future;
   }
 };
@@ -83,10 +91,8 @@ struct AsyncHelper {
     MINDRT_OOM_EXIT(promise);
     Future<R> future = promise->GetFuture();
 
-    std::function<void(ActorBase *)> handler = [=](ActorBase *) { promise->SetValue(f()); };
-    std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-    MINDRT_OOM_EXIT(msg);
-    (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+    auto handler = [promise, f = std::forward<F>(f)](ActorBase *) { promise->SetValue(f()); };
+    internal::SendAsync(aid, std::move(handler));
     return future;
   }
 };
@@ -96,41 +102,35 @@ struct AsyncHelper {
 // return void
 template <typename T>
 void Async(const AID &aid, void (T::*method)()) {
-  std::function<void(ActorBase *)> handler = [method](ActorBase *actor) {
+  auto handler = [method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     (t->*method)();
   };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
 }
 
 template <typename T, typename Arg0, typename Arg1>
 void Async(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg) {
-  std::function<void(ActorBase *)> handler = [method, arg](ActorBase *actor) {
+  auto handler = [method, arg = std::forward<Arg1>(arg)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     (t->*method)(arg);
   };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
 }
 
 template <typename T, typename... Args0, typename... Args1>
 void Async(const AID &aid, void (T::*method)(Args0...), std::tuple<Args1...> &&tuple) {
-  std::function<void(ActorBase *)> handler = [method, tuple](ActorBase *actor) {
+  auto handler = [method, tuple = std::move(tuple)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     Apply(t, method, tuple);
   };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
 }
 
 template <typename T, typename... Args0, typename... Args1>
@@ -146,15 +146,13 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)()) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method](ActorBase *actor) {
+  auto handler = [promise, method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate((t->*method)());
   };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -164,16 +162,14 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Arg0), Arg1 &&arg) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, arg](ActorBase *actor) {
+  auto handler = [promise, method, arg = std::forward<Arg1>(arg)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate((t->*method)(arg));
   };
 
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -183,16 +179,14 @@ Future<R> Async(const AID &aid, Future<R> (T::*method)(Args0...), std::tuple<Arg
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, tuple](ActorBase *actor) {
+  auto handler = [promise, method, tuple = std::move(tuple)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->Associate(Apply(t, method, tuple));
   };
 
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -210,16 +204,14 @@ Future<R> Async(const AID &aid, R (T::*method)()) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method](ActorBase *actor) {
+  auto handler = [promise, method](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue((t->*method)());
   };
 
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -231,15 +223,13 @@ Future<R> Async(const AID &aid, R (T::*method)(Arg0), Arg1 &&arg) {
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, arg](ActorBase *actor) {
+  auto handler = [promise, method, arg = std::forward<Arg1>(arg)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue((t->*method)(arg));
   };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
@@ -251,15 +241,13 @@ Future<R> Async(const AID &aid, R (T::*method)(Args0...), std::tuple<Args1...> &
   MINDRT_OOM_EXIT(promise);
   Future<R> future = promise->GetFuture();
 
-  std::function<void(ActorBase *)> handler = [promise, method, tuple](ActorBase *actor) {
+  auto handler = [promise, method, tuple = std::move(tuple)](ActorBase *actor) {
     MINDRT_ASSERT(actor != nullptr);
     T *t = static_cast<T *>(actor);
     MINDRT_ASSERT(t != nullptr);
     promise->SetValue(Apply(t, method, tuple));
   };
-  std::unique_ptr<MessageAsync> msg(new (std::nothrow) MessageAsync(handler));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::SendAsync(aid, std::move(handler));
   return future;
 }
 
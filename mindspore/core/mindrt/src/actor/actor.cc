@@ -65,6 +65,8 @@ void ActorBase::HandlekMsg(const std::unique_ptr<MessageBase> &msg) {
 }
 int ActorBase::EnqueMessage(std::unique_ptr<MessageBase> &&msg) { return actorPolicy->EnqueMessage(std::move(msg)); }
 
+bool ActorBase::KeepsRunning() const { return actorPolicy->KeepsRunning(); }
+
 void ActorBase::Quit() {
   Finalize();
   actorPolicy->Terminate(this);
@@ -74,49 +76,41 @@ void ActorBase::Quit() {
 
 void ActorBase::Run() {
   for (;;) {
-    auto msgs = actorPolicy->GetMsgs();
-    if (msgs == nullptr) {
+    std::unique_ptr<MessageBase> msg = actorPolicy->GetMsg();
+    if (msg == nullptr) {
       return;
     }
-    for (auto it = msgs->begin(); it != msgs->end(); ++it) {
-      std::unique_ptr<MessageBase> &msg = *it;
-      if (msg == nullptr) {
-        continue;
-      }
-      //            std::cout << "dequeue message]actor=" << id.Name() << ",msg=" << msg->Name() << std::endl;
-      AddMsgRecord(msg->Name());
-      switch (msg->GetType()) {
-        case MessageBase::Type::KMSG:
-        case MessageBase::Type::KUDP: {
-          if (Filter(msg)) {
-            continue;
-          }
-          this->HandlekMsg(msg);
-          break;
-        }
-        case MessageBase::Type::KHTTP: {
-          this->HandleHttp(std::move(msg));
-          break;
-        }
-        case MessageBase::Type::KASYNC: {
-          msg->Run(this);
-          break;
-        }
-        case MessageBase::Type::KLOCAL: {
-          this->HandleLocalMsg(std::move(msg));
-          break;
-        }
-        case MessageBase::Type::KTERMINATE: {
-          this->Quit();
-          return;
-        }
-        case MessageBase::Type::KEXIT: {
-          this->Exited(msg->From());
-          break;
+    AddMsgRecord(msg->Name());
+    switch (msg->GetType()) {
+      case MessageBase::Type::KMSG:
+      case MessageBase::Type::KUDP: {
+        if (Filter(msg)) {
+          continue;
         }
+        this->HandlekMsg(msg);
+        break;
+      }
+      case MessageBase::Type::KHTTP: {
+        this->HandleHttp(std::move(msg));
+        break;
+      }
+      case MessageBase::Type::KASYNC: {
+        msg->Run(this);
+        break;
+      }
+      case MessageBase::Type::KLOCAL: {
+        this->HandleLocalMsg(std::move(msg));
+        break;
+      }
+      case MessageBase::Type::KTERMINATE: {
+        this->Quit();
+        return;
+      }
+      case MessageBase::Type::KEXIT: {
+        this->Exited(msg->From());
+        break;
       }
     }
-    msgs->clear();
   }
 }
 
@@ -26,7 +26,7 @@ void ActorPolicy::SetRunningStatus(bool startRun) {
   Notify();
 }
 
-SingleThread::SingleThread() {}
+SingleThread::SingleThread() : waiting(false) {}
 SingleThread::~SingleThread() {}
 
 void SingleThread::Terminate(const ActorBase *actor) {
@@ -37,40 +37,40 @@ void SingleThread::Terminate(const ActorBase *actor) {
 }
 
 int SingleThread::EnqueMessage(std::unique_ptr<MessageBase> &&msg) {
-  int result;
-  {
-    std::lock_guard<std::mutex> lock(mailboxLock);
-    enqueMailbox->push_back(std::move(msg));
-    result = ++msgCount;
-  }
+  mailbox.Push(std::move(msg));
 
-  // Notify when the count of message  is from  empty to one.
-  if (start && result == 1) {
+  // Notify only when the actor thread waits, it checks the mailbox under the lock before waiting.
+  if (start && waiting) {
+    std::lock_guard<std::mutex> lock(mailboxLock);
     conditionVar.notify_one();
   }
 
-  return result;
+  return ERRORCODE_SUCCESS;
 }
 void SingleThread::Notify() {
-  if (start && msgCount > 0) {
+  if (start && waiting) {
     conditionVar.notify_one();
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *SingleThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
-  std::unique_lock<std::mutex> lock(mailboxLock);
-  conditionVar.wait(lock, [this] { return (!this->enqueMailbox->empty()); });
-  SwapMailbox();
-
-  // REF_PRIVATE_MEMBER
-  result = dequeMailbox;
+std::unique_ptr<MessageBase> SingleThread::GetMsg() {
+  std::unique_ptr<MessageBase> result = mailbox.Pop();
+  while (result == nullptr) {
+    std::unique_lock<std::mutex> lock(mailboxLock);
+    waiting = true;
+    conditionVar.wait(lock, [this] { return !this->mailbox.Empty(); });
+    waiting = false;
+    lock.unlock();
+    result = mailbox.Pop();
+  }
 
   return result;
 }
 
-ShardedThread::ShardedThread(const std::shared_ptr<ActorBase> &aActor)
-    : ready(false), terminated(false), actor(aActor) {}
+// The actor keeps its thread, it only waits there for its next message.
+bool SingleThread::KeepsRunning() const { return true; }
+
+ShardedThread::ShardedThread(const std::shared_ptr<ActorBase> &aActor) : ready(false), actor(aActor) {}
 ShardedThread::~ShardedThread() {}
 
 void ShardedThread::Terminate(const ActorBase *aActor) {
@@ -79,49 +79,47 @@ void ShardedThread::Terminate(const ActorBase *aActor) {
   // remove actor from actorMgr
   ActorMgr::GetActorMgrRef()->RemoveActor(actorName);
 
+  // The actor terminates in its run, so ready stays set and no one schedules the actor any more.
   mailboxLock.lock();
-  terminated = true;
   this->actor = nullptr;
   mailboxLock.unlock();
 }
 
 int ShardedThread::EnqueMessage(std::unique_ptr<MessageBase> &&msg) {
-  mailboxLock.lock();
-  enqueMailbox->push_back(std::move(msg));
-  ++msgCount;
+  mailbox.Push(std::move(msg));
 
   // true : The actor is running. else  the actor will  be  ready to run.
-  if (start && (ready == false) && (terminated == false)) {
+  if (start && !ready.exchange(true)) {
     ActorMgr::GetActorMgrRef()->SetActorReady(actor);
-    ready = true;
   }
-  mailboxLock.unlock();
-  return msgCount;
+  return ERRORCODE_SUCCESS;
 }
 
 void ShardedThread::Notify() {
-  if (start && ready == false && terminated == false && msgCount > 0) {
+  if (start && mailbox.HasMsgs() && !ready.exchange(true)) {
     ActorMgr::GetActorMgrRef()->SetActorReady(actor);
-    ready = true;
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *ShardedThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
-  mailboxLock.lock();
-
-  if (enqueMailbox->empty()) {
+std::unique_ptr<MessageBase> ShardedThread::GetMsg() {
+  std::unique_ptr<MessageBase> result = mailbox.Pop();
+  if (result != nullptr) {
+    return result;
+  }
+  // Once ready is cleared another actor thread may run the actor, even terminate it and drop the last reference to it,
+  // before the mailbox is checked below. Hold the actor until then, only its own run clears this->actor.
+  std::shared_ptr<ActorBase> keepActor = actor;
+  for (;;) {
     ready = false;
-    result = nullptr;
-  } else {
-    ready = true;
-    SwapMailbox();
-    result = dequeMailbox;
+    // The senders which saw the actor ready before it is cleared did not schedule the actor, keep running for them.
+    if (mailbox.Empty() || ready.exchange(true)) {
+      return nullptr;
+    }
+    result = mailbox.Pop();
+    if (result != nullptr) {
+      return result;
+    }
   }
-
-  mailboxLock.unlock();
-
-  return result;
 }
 
 };  // end of namespace mindspore
@@ -16,7 +16,8 @@
 
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
-#include <list>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <string>
 #include <utility>
@@ -33,12 +34,12 @@ class ShardedThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual std::unique_ptr<MessageBase> GetMsg();
   virtual void Notify();
 
  private:
-  bool ready;
-  bool terminated;
+  // Whether the actor is queued in or run by the thread pool, whoever sets it schedules the actor.
+  std::atomic_bool ready;
   std::shared_ptr<ActorBase> actor;
 };
 
@@ -50,11 +51,14 @@ class SingleThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual std::unique_ptr<MessageBase> GetMsg();
   virtual void Notify();
+  virtual bool KeepsRunning() const;
 
  private:
   std::condition_variable conditionVar;
+  // Whether the actor thread waits for messages, only then the senders notify it.
+  std::atomic_bool waiting;
 };
 
 };  // end of namespace mindspore
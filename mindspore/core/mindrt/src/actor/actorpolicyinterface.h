@@ -17,47 +17,37 @@
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 
-#include <list>
+#include <atomic>
 #include <memory>
+#include <mutex>
+
+#include "actor/mailbox.h"
 
 namespace mindspore {
 
 class ActorPolicy {
  public:
-  ActorPolicy() : mailbox1(), mailbox2() {
-    enqueMailbox = &mailbox1;
-    dequeMailbox = &mailbox2;
-    msgCount = 0;
-    start = false;
-  }
+  ActorPolicy() : mailbox(), start(false) {}
   virtual ~ActorPolicy() {}
-  inline void SwapMailbox() {
-    std::list<std::unique_ptr<MessageBase>> *temp;
-    temp = enqueMailbox;
-    enqueMailbox = dequeMailbox;
-    dequeMailbox = temp;
-    msgCount = 0;
-  }
 
  protected:
   void SetRunningStatus(bool startRun);
   virtual void Terminate(const ActorBase *actor) = 0;
+  // Returns ERRORCODE_SUCCESS. It used to return the count of the queued messages, which the lock-free mailbox does not
+  // keep, callers only relied on it being positive.
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg) = 0;
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs() = 0;
+  // Returns nullptr when the actor has no message to run for now.
+  virtual std::unique_ptr<MessageBase> GetMsg() = 0;
   virtual void Notify() = 0;
+  // Whether the actor goes on running on its thread after the current message, so the actors it readies wait for it.
+  virtual bool KeepsRunning() const { return mailbox.HasMsgs(); }
 
-  std::list<std::unique_ptr<MessageBase>> *enqueMailbox;
-  std::list<std::unique_ptr<MessageBase>> *dequeMailbox;
-
-  int msgCount;
-  bool start;
+  Mailbox mailbox;
+  std::atomic_bool start;
   std::mutex mailboxLock;
 
  private:
   friend class ActorBase;
-
-  std::list<std::unique_ptr<MessageBase>> mailbox1;
-  std::list<std::unique_ptr<MessageBase>> mailbox2;
 };
 
 };  // end of namespace mindspore
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_MAILBOX_H
+#define MINDSPORE_CORE_MINDRT_SRC_ACTOR_MAILBOX_H
+
+#include <atomic>
+#include <memory>
+
+#include "actor/msg.h"
+
+namespace mindspore {
+
+// The mailbox of an actor: a lock-free queue of many senders and the one actor thread receiving, linking the
+// messages through their own next field, so enqueuing a message allocates nothing.
+// refer to http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+class Mailbox {
+ public:
+  Mailbox() : tail(&stub), head(&stub) {}
+  Mailbox(const Mailbox &) = delete;
+  Mailbox &operator=(const Mailbox &) = delete;
+  ~Mailbox() {
+    while (Pop() != nullptr) {
+    }
+  }
+
+  // Called by any thread.
+  void Push(std::unique_ptr<MessageBase> &&msg) { Push(msg.release()); }
+
+  // Called by the receiving thread only. Returns nullptr when the mailbox is empty, or while the message at its head
+  // is still being linked by its sender, which makes sure the actor is run again after linking it.
+  std::unique_ptr<MessageBase> Pop() {
+    MessageBase *first = head.load(std::memory_order_relaxed);
+    MessageBase *next = first->next.load(std::memory_order_acquire);
+    if (first == &stub) {
+      if (next == nullptr) {
+        return nullptr;
+      }
+      head.store(next, std::memory_order_relaxed);
+      first = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      head.store(next, std::memory_order_relaxed);
+      return std::unique_ptr<MessageBase>(first);
+    }
+    if (first != tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    // The first message is the last one, put the stub behind it to take it out.
+    Push(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      head.store(next, std::memory_order_relaxed);
+      return std::unique_ptr<MessageBase>(first);
+    }
+    return nullptr;
+  }
+
+  // Called by the receiving thread, or by the thread which just gave up the actor to another receiving thread.
+  bool Empty() const { return head.load(std::memory_order_relaxed) == &stub && stub.next.load() == nullptr; }
+
+  // Called by any thread, it may miss the messages being pushed while the receiving thread pops.
+  bool HasMsgs() const { return tail.load() != &stub; }
+
+ private:
+  void Push(MessageBase *msg) {
+    msg->next.store(nullptr, std::memory_order_relaxed);
+    MessageBase *prev = tail.exchange(msg);
+    prev->next.store(msg);
+  }
+
+  std::atomic<MessageBase *> tail;
+  // Only written by the receiving thread. It is atomic because ShardedThread::GetMsg checks Empty() right after giving
+  // up the actor, while another thread may already pop the mailbox.
+  std::atomic<MessageBase *> head;
+  MessageBase stub;
+};
+
+};  // end of namespace mindspore
+#endif
@@ -19,6 +19,12 @@
 
 namespace mindspore {
 constexpr size_t MAX_READY_ACTOR_NR = 1024;
+// the runs of the next actor in a row before a worker takes the actor at the head of its local queue
+constexpr size_t MAX_NEXT_ACTOR_RUNS = 16;
+namespace {
+thread_local ActorWorker *current_actor_worker = nullptr;
+}  // namespace
+
 void ActorWorker::CreateThread(ActorThreadPool *pool) {
   THREAD_RETURN_IF_NULL(pool);
   pool_ = pool;
@@ -30,6 +36,7 @@ void ActorWorker::RunWithSpin() {
   static std::atomic_int index = {0};
   pthread_setname_np(pthread_self(), ("ActorThread_" + std::to_string(index++)).c_str());
 #endif
+  current_actor_worker = this;
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
@@ -46,14 +53,54 @@ void ActorWorker::RunWithSpin() {
 
 bool ActorWorker::RunQueueActorTask() {
   THREAD_ERROR_IF_NULL(pool_);
-  auto actor = pool_->PopActorFromQueue();
+  auto actor = PopLocalActor();
+  if (actor == nullptr) {
+    actor = pool_->PopActorFromQueue();
+  }
+  if (actor == nullptr) {
+    actor = pool_->StealActor(this);
+  }
   if (actor == nullptr) {
     return false;
   }
+  (void)run_count_.fetch_add(1, std::memory_order_release);
+  current_actor_ = actor;
   actor->Run();
+  current_actor_ = nullptr;
   return true;
 }
 
+ActorBase *ActorWorker::PopLocalActor() {
+  // the other workers may steal the next actor, take it out of the slot before deciding on it
+  ActorBase *actor = next_actor_.exchange(nullptr, std::memory_order_acq_rel);
+  if (actor != nullptr && next_actor_runs_ < MAX_NEXT_ACTOR_RUNS) {
+    ++next_actor_runs_;
+    return actor;
+  }
+  next_actor_runs_ = 0;
+  // let the actors queued behind the next actor run first, so that two actors readying each other do not starve them
+  if (actor != nullptr && !local_queue_.Push(actor)) {
+    return actor;
+  }
+  return local_queue_.Pop();
+}
+
+ActorBase *ActorWorker::StealNextActor() {
+  ActorBase *actor = next_actor_.load(std::memory_order_acquire);
+  if (actor == nullptr) {
+    return nullptr;
+  }
+  // the first time a thief sees the next actor in a run, the owner may be just about to take it
+  uint64_t seen = run_count_.load(std::memory_order_acquire) + 1;
+  if (next_actor_seen_.exchange(seen, std::memory_order_acq_rel) != seen) {
+    return nullptr;
+  }
+  if (!next_actor_.compare_exchange_strong(actor, nullptr, std::memory_order_acq_rel)) {
+    return nullptr;
+  }
+  return actor;
+}
+
 bool ActorWorker::Active() {
   if (status_ != kThreadIdle) {
     return false;
@@ -75,10 +122,18 @@ ActorThreadPool::~ActorThreadPool() {
       terminate = actor_queue_.empty();
 #endif
     }
+    for (size_t i = 0; i < actor_workers_.size() && terminate; ++i) {
+      terminate = actor_workers_[i]->LocalEmpty();
+    }
     if (!terminate) {
       std::this_thread::yield();
     }
   } while (!terminate);
+  // stop all the actor threads before deleting any worker, the others may be stealing from it
+  for (auto &worker : actor_workers_) {
+    worker->Stop();
+  }
+  actor_workers_.clear();
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
@@ -103,10 +158,59 @@ ActorBase *ActorThreadPool::PopActorFromQueue() {
 #endif
 }
 
+ActorBase *ActorThreadPool::StealActor(ActorWorker *thief) {
+  // start from a different victim each time, so that the thieves spread over the busy workers
+  size_t start = thief->NextStealIndex();
+  for (size_t i = 0; i < actor_workers_.size(); ++i) {
+    auto victim = actor_workers_[(start + i) % actor_workers_.size()];
+    if (victim == thief) {
+      continue;
+    }
+    auto actor = victim->StealActor();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  for (size_t i = 0; i < actor_workers_.size(); ++i) {
+    auto victim = actor_workers_[(start + i) % actor_workers_.size()];
+    if (victim == thief) {
+      continue;
+    }
+    auto actor = victim->StealNextActor();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
+  ActorWorker *worker = current_actor_worker;
+  if (worker == nullptr || worker->pool() != this) {
+    PushActorToGlobalQueue(actor);
+    return;
+  }
+  // the actor readied by this worker runs next on it, the one in its place before goes to the local queue
+  auto prev_actor = worker->SetNextActor(actor);
+  if (prev_actor == nullptr) {
+    // the next actor only waits for the end of the current run, unless the current actor goes on running
+    if (worker->CurrentActorKeepsRunning()) {
+      ActiveIdleWorker();
+    }
+    return;
+  }
+  if (!worker->PushLocalActor(prev_actor)) {
+    PushActorToGlobalQueue(prev_actor);
+    return;
+  }
+  // the queued actor waits for this worker, let an idle one steal it
+  ActiveIdleWorker();
+}
+
+void ActorThreadPool::PushActorToGlobalQueue(ActorBase *actor) {
   {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
@@ -117,9 +221,12 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
 #endif
   }
   THREAD_INFO("actor[%s] enqueue success", actor->GetAID().Name().c_str());
+  ActiveIdleWorker();
+}
+
+void ActorThreadPool::ActiveIdleWorker() {
   // active one idle actor thread if exist
-  for (size_t i = 0; i < actor_thread_num_; ++i) {
-    auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
+  for (auto worker : actor_workers_) {
     if (worker->Active()) {
       break;
     }
@@ -138,13 +245,18 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     THREAD_ERROR("thread num is invalid");
     return THREAD_ERROR;
   }
-  for (size_t i = 0; i < actor_thread_num_; ++i) {
+  {
     std::lock_guard<std::mutex> _l(pool_mutex_);
-    auto worker = new (std::nothrow) ActorWorker();
-    THREAD_ERROR_IF_NULL(worker);
-    worker->CreateThread(this);
-    workers_.push_back(worker);
-    THREAD_INFO("create actor thread[%zu]", i);
+    for (size_t i = 0; i < actor_thread_num_; ++i) {
+      auto worker = new (std::nothrow) ActorWorker();
+      THREAD_ERROR_IF_NULL(worker);
+      workers_.push_back(worker);
+      actor_workers_.push_back(worker);
+    }
+    for (size_t i = 0; i < actor_thread_num_; ++i) {
+      actor_workers_[i]->CreateThread(this);
+      THREAD_INFO("create actor thread[%zu]", i);
+    }
   }
   size_t kernel_thread_num = all_thread_num - actor_thread_num_;
   if (kernel_thread_num > 0) {
@@ -18,6 +18,7 @@
 #define MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
 
 #include <queue>
+#include <vector>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
@@ -28,16 +29,79 @@
 namespace mindspore {
 class ActorThreadPool;
 
+// The ready actors queued on a worker: pushed by the worker only, and taken by it or stolen by the other workers.
+class ActorRunQueue {
+ public:
+  static constexpr uint32_t kCapacity = 256;
+
+  // Called by the owner worker only, false if the queue is full.
+  bool Push(ActorBase *actor) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= kCapacity) {
+      return false;
+    }
+    buffer_[tail % kCapacity].store(actor, std::memory_order_relaxed);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Called by any worker.
+  ActorBase *Pop() {
+    uint32_t head = head_.load(std::memory_order_acquire);
+    while (head != tail_.load(std::memory_order_acquire)) {
+      ActorBase *actor = buffer_[head % kCapacity].load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return actor;
+      }
+    }
+    return nullptr;
+  }
+
+  bool Empty() const { return head_.load() == tail_.load(); }
+
+ private:
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<ActorBase *> buffer_[kCapacity] = {};
+};
+
 class ActorWorker : public Worker {
  public:
   void CreateThread(ActorThreadPool *pool);
   bool Active();
 
+  // Called on the thread of the worker only. The actor runs next on this worker, returns the actor it takes the place
+  // of, or nullptr.
+  ActorBase *SetNextActor(ActorBase *actor) { return next_actor_.exchange(actor, std::memory_order_acq_rel); }
+  // Called on the thread of the worker only, false if the local queue is full.
+  bool PushLocalActor(ActorBase *actor) { return local_queue_.Push(actor); }
+  // Called on the thread of the worker only, whether the actor it runs goes on running after readying another one.
+  bool CurrentActorKeepsRunning() const { return current_actor_ != nullptr && current_actor_->KeepsRunning(); }
+  ActorBase *StealActor() { return local_queue_.Pop(); }
+  // Called by the other workers, takes the next actor when a thief saw it already in the same run of this worker.
+  ActorBase *StealNextActor();
+  bool LocalEmpty() const { return next_actor_.load() == nullptr && local_queue_.Empty(); }
+  const ActorThreadPool *pool() const { return pool_; }
+  size_t NextStealIndex() { return steal_index_++; }
+
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  ActorBase *PopLocalActor();
 
   ActorThreadPool *pool_{nullptr};
+  // The actor readied last by this worker, it runs next here while its messages are hot in the cache.
+  std::atomic<ActorBase *> next_actor_{nullptr};
+  // The runs of the next actor in a row, the local queue gets its turn after a few of them.
+  size_t next_actor_runs_{0};
+  // The actor running on this worker, only known on its thread.
+  ActorBase *current_actor_{nullptr};
+  // The count of the actor runs started on this worker, and the count a thief saw along with the next actor plus one,
+  // 0 for none. A thief seeing the next actor again within the same run takes it.
+  std::atomic<uint64_t> run_count_{0};
+  std::atomic<uint64_t> next_actor_seen_{0};
+  ActorRunQueue local_queue_;
+  size_t steal_index_{0};
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -48,13 +112,20 @@ class ActorThreadPool : public ThreadPool {
   static ActorThreadPool *CreateThreadPool(size_t thread_num);
   ~ActorThreadPool() override;
 
+  // The actor readied on an actor thread runs on it, the others go to the global queue.
   void PushActorToQueue(ActorBase *actor);
   ActorBase *PopActorFromQueue();
+  // Steal a ready actor from the local queue of another actor thread, or its next actor held up by a long run.
+  ActorBase *StealActor(ActorWorker *thief);
 
  private:
   ActorThreadPool() {}
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num);
+  void PushActorToGlobalQueue(ActorBase *actor);
+  void ActiveIdleWorker();
   size_t actor_thread_num_{0};
+  // the actor workers in workers_, complete before any of them starts as they steal from each other
+  std::vector<ActorWorker *> actor_workers_;
 
   std::mutex actor_mutex_;
   std::condition_variable actor_cond_;
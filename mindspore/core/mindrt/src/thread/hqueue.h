@@ -38,7 +38,8 @@ template <typename T>
 struct HQNode {
   std::atomic<Pointer> next;
   T *value = nullptr;
-  std::atomic_bool free = {true};
+  // the next node in the free list
+  std::atomic<int32_t> nextFree = {-1};
 };
 
 template <typename T>
@@ -53,15 +54,15 @@ class HQueue {
     for (int32_t i = 0; i < sz; i++) {
       auto node = new HQNode<T>();
       node->value = nullptr;
-      node->free = true;
       node->next = {-1, 0};
+      node->nextFree = i + 1 < sz ? i + 1 : -1;
       nodes.template emplace_back(node);
     }
 
-    // init first node as dummy head
+    // init first node as dummy head, the others make up the free list
     qhead = {0, 0};
     qtail = {0, 0};
-    nodes[0]->free = false;
+    qfree = {sz > 1 ? 1 : -1, 0};
     return;
   }
 
@@ -73,18 +74,11 @@ class HQueue {
   }
 
   bool Enqueue(T *t) {
-    HQNode<T> *node = nullptr;
-    int32_t nodeIdx;
-    for (nodeIdx = 0; nodeIdx < static_cast<int32_t>(nodes.size()); nodeIdx++) {
-      bool expected = true;
-      if (nodes[nodeIdx]->free.compare_exchange_strong(expected, false)) {
-        node = nodes[nodeIdx];
-        break;
-      }
-    }
-    if (node == nullptr) {
+    int32_t nodeIdx = AllocNode();
+    if (nodeIdx == -1) {
       return false;
     }
+    HQNode<T> *node = nodes[nodeIdx];
     node->value = t;
     node->next = {-1, 0};
 
@@ -139,7 +133,7 @@ class HQueue {
         ret = nodes[next.index]->value;
         if (this->qhead.compare_exchange_strong(head, {next.index, head.version + 1})) {
           // free head
-          nodes[head.index]->free = true;
+          FreeNode(head.index);
           return ret;
         }
       }
@@ -163,7 +157,28 @@ class HQueue {
 
   std::atomic<Pointer> qhead;
   std::atomic<Pointer> qtail;
+  // the top of the stack of free nodes, versioned against ABA as the queue pointers
+  std::atomic<Pointer> qfree;
   std::vector<HQNode<T> *> nodes;
+
+ private:
+  int32_t AllocNode() {
+    Pointer top = qfree;
+    while (top.index != -1) {
+      int32_t next = nodes[top.index]->nextFree;
+      if (qfree.compare_exchange_weak(top, {next, top.version + 1})) {
+        return top.index;
+      }
+    }
+    return -1;
+  }
+
+  void FreeNode(int32_t index) {
+    Pointer top = qfree;
+    do {
+      nodes[index]->nextFree = top.index;
+    } while (!qfree.compare_exchange_weak(top, {index, top.version + 1}));
+  }
 };
 
 }  // namespace mindspore
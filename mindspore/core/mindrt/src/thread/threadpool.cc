@@ -18,7 +18,9 @@
 #include "thread/core_affinity.h"
 
 namespace mindspore {
-Worker::~Worker() {
+Worker::~Worker() { Stop(); }
+
+void Worker::Stop() {
   {
     std::lock_guard<std::mutex> _l(mutex_);
     alive_ = false;
@@ -57,6 +57,8 @@ class Worker {
   virtual ~Worker();
   // create thread and start running at the same time
   void CreateThread();
+  // stop running and wait for the thread to exit
+  void Stop();
   // assign task and then activate thread
   void Active(Task *task, int task_id);
   // whether or not it is idle and marked as held
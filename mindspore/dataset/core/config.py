@@ -27,7 +27,7 @@ __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'se
            'get_num_parallel_workers', 'set_numa_enable', 'get_numa_enable', 'set_monitor_sampling_interval',
            'get_monitor_sampling_interval', 'set_callback_timeout', 'get_callback_timeout',
            'set_auto_num_workers', 'get_auto_num_workers', 'set_enable_shared_mem', 'get_enable_shared_mem',
-           'set_sending_batches', 'load', '_init_device_info']
+           'set_enable_autotune', 'get_enable_autotune', 'set_sending_batches', 'load', '_init_device_info']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -451,6 +451,42 @@ def set_enable_shared_mem(enable):
     _config.set_enable_shared_mem(enable)
 
 
+def get_enable_autotune():
+    """
+    Get the default state of AutoTune enabled variable.
+
+    Returns:
+        bool, the state of AutoTune enabled variable (default=False).
+
+    Examples:
+        >>> # Get the flag of AutoTune feature.
+        >>> autotune_flag = ds.config.get_enable_autotune()
+    """
+    return _config.get_enable_autotune()
+
+
+def set_enable_autotune(enable):
+    """
+    Set the default state of AutoTune flag. If enable is True, the number of active workers of map and batch
+    operators and the capacity of the operator connectors will be adjusted while the pipeline is running,
+    according to the bottleneck found from the connector queues. The decisions are logged and, when profiling
+    is enabled, written to the profiling output.
+
+    Args:
+        enable (bool): Whether to tune the pipeline while it is running.
+
+    Raises:
+        TypeError: If enable is not a boolean data type.
+
+    Examples:
+        >>> # Enable AutoTune to adjust the pipeline while training.
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_autotune(enable)
+
+
 def set_sending_batches(batch_num):
     """
     Set the default sending batches when training with sink_mode=True in Ascend device.
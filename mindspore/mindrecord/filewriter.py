@@ -297,6 +297,24 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_streaming_mode(self, streaming):
+        """
+        Set streaming mode. In streaming mode, write_raw_data only queues the data, \
+        which is validated, serialized and flushed to disk in background while the \
+        next data is prepared. An error of the queued data is raised by a later \
+        write_raw_data or by commit. It is ignored if parallel_writer is True.
+
+        Args:
+           streaming (bool): Write in streaming mode if it equals to True.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMWriteDatasetError: If failed to write the data queued in streaming mode.
+        """
+        return self._writer.set_streaming_mode(streaming)
+
     def commit(self):
         """
         Flush data in memory to disk and generate the corresponding database files.
@@ -332,10 +350,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in [item + ".db", item + ".idx"]:
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
@@ -114,6 +114,25 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_streaming_mode(self, streaming):
+        """
+        Set streaming mode, in which data is written to disk in background while next data is prepared.
+
+        Args:
+           streaming (bool): Write in streaming mode if it equals to True.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMWriteDatasetError: If failed to write the data queued in streaming mode.
+        """
+        ret = self._writer.set_streaming_mode(streaming)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to write dataset in streaming mode.")
+            raise MRMWriteDatasetError
+        return ret
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
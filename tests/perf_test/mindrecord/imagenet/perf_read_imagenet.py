@@ -13,6 +13,7 @@
 # limitations under the License.
 # ============================================================================
 """test dataset performance about mindspore.MindDataset, mindspore.TFRecordDataset, tf.data.TFRecordDataset"""
+import os
 import time
 import tensorflow as tf
 
@@ -55,6 +56,24 @@ def use_minddataset(mindrecord):
     print("Read by MindDataset - total rows: {}, cost time: {}s".format(num_iter, end - start))
 
 
+def use_minddataset_io_mode(mindrecord):
+    """compare samples/sec of MindDataset when blobs are read from memory mapped files and by seek and read"""
+    columns_list = ["data", "label"]
+    for use_mmap in ["false", "true"]:
+        os.environ["MS_MINDRECORD_MMAP"] = use_mmap
+        data_set = ds.MindDataset(dataset_file=mindrecord,
+                                  columns_list=columns_list,
+                                  num_parallel_workers=4)
+        start = time.time()
+        num_iter = 0
+        for _ in data_set.create_tuple_iterator(num_epochs=1, output_numpy=True):
+            num_iter += 1
+        end = time.time()
+        print("Read by MindDataset with MS_MINDRECORD_MMAP={} - total rows: {}, samples/sec: {}"
+              .format(use_mmap, num_iter, num_iter / (end - start)))
+    os.environ.pop("MS_MINDRECORD_MMAP")
+
+
 def use_tfrecorddataset(tfrecord):
     start = time.time()
     columns_list = ["data", "label"]
@@ -98,6 +117,7 @@ if __name__ == '__main__':
     # use MindDataset
     mindrecord_test = './imagenet.mindrecord00'
     use_minddataset(mindrecord_test)
+    use_minddataset_io_mode(mindrecord_test)
 
     # use TFRecordDataset
     tfrecord_test = ['imagenet.tfrecord00', 'imagenet.tfrecord01', 'imagenet.tfrecord02', 'imagenet.tfrecord03',
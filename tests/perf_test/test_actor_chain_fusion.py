@@ -0,0 +1,69 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Steps per second of a deep MLP on CPU with and without the actor chain fusion."""
+
+import os
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+batch_size = 16
+width = 64
+depth = 64
+warmup_steps = 10
+steps = 500
+
+
+class DeepMLP(nn.Cell):
+    """A linear chain of small dense layers, whose kernels cost less than the messages between their actors."""
+
+    def __init__(self):
+        super(DeepMLP, self).__init__()
+        self.layers = nn.SequentialCell([nn.Dense(width, width, activation='relu') for _ in range(depth)])
+
+    def construct(self, x):
+        return self.layers(x)
+
+
+def steps_per_second(fusion):
+    """Build the graph with the fusion switch and time the steps."""
+    os.environ["MS_ACTOR_CHAIN_FUSION"] = "1" if fusion else "0"
+    net = DeepMLP()
+    inp = Tensor(np.random.randn(batch_size, width).astype(np.float32))
+    for _ in range(warmup_steps):
+        net(inp)
+    start = time.time()
+    for _ in range(steps):
+        out = net(inp)
+    out.asnumpy()
+    return steps / (time.time() - start)
+
+
+def test_actor_chain_fusion_mlp():
+    unfused = steps_per_second(False)
+    fused = steps_per_second(True)
+    print("Deep MLP steps/sec, depth {}: unfused {:.1f}, fused {:.1f}, speedup {:.2f}x".format(
+        depth, unfused, fused, fused / unfused))
+
+
+if __name__ == "__main__":
+    test_actor_chain_fusion_mlp()
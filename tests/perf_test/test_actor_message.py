@@ -0,0 +1,77 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Time per kernel actor of a wide graph of tiny CPU kernels, dominated by the MindRT messages between the actors."""
+
+import os
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+import mindspore.ops.operations as P
+from mindspore import Tensor
+from mindspore import context
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+size = 16
+branches = 32
+depth = 8
+warmup_steps = 10
+steps = 200
+
+
+class WideNet(nn.Cell):
+    """Parallel branches of Add kernels summed at the end, every kernel actor sends and receives a few messages."""
+
+    def __init__(self):
+        super(WideNet, self).__init__()
+        self.add = P.Add()
+        self.addn = P.AddN()
+
+    def construct(self, x, y):
+        outs = ()
+        for i in range(branches):
+            out = x
+            for _ in range(depth):
+                out = self.add(out, y)
+            outs = outs + (out * (i + 1),)
+        return self.addn(outs)
+
+
+def us_per_kernel_actor():
+    """Time the steps of the wide net, without fusing the chains of the branches into single actors."""
+    os.environ["MS_ACTOR_CHAIN_FUSION"] = "0"
+    net = WideNet()
+    x = Tensor(np.random.randn(size).astype(np.float32))
+    y = Tensor(np.random.randn(size).astype(np.float32))
+    for _ in range(warmup_steps):
+        net(x, y)
+    start = time.time()
+    for _ in range(steps):
+        out = net(x, y)
+    out.asnumpy()
+    kernel_num = branches * (depth + 1) + 1
+    return (time.time() - start) * 1e6 / (steps * kernel_num)
+
+
+def test_actor_message():
+    print("Wide net, {} branches of depth {}: {:.2f} us per kernel actor".format(branches, depth,
+                                                                                  us_per_kernel_actor()))
+
+
+if __name__ == "__main__":
+    test_actor_message()
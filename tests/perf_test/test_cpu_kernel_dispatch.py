@@ -0,0 +1,68 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Time per kernel of a chain of small elementwise CPU kernels, dominated by the ParallelFor dispatch."""
+
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+import mindspore.ops.operations as P
+from mindspore import Tensor
+from mindspore import context
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+depth = 64
+sizes = [1024, 16384, 262144]
+warmup_steps = 10
+steps = 200
+
+
+class AddChain(nn.Cell):
+    """A chain of Add kernels, each one a single ParallelFor launch."""
+
+    def __init__(self):
+        super(AddChain, self).__init__()
+        self.add = P.Add()
+
+    def construct(self, x, y):
+        for _ in range(depth):
+            x = self.add(x, y)
+        return x
+
+
+def us_per_kernel(size):
+    """Time the steps of the chain on tensors of the given size."""
+    net = AddChain()
+    x = Tensor(np.random.randn(size).astype(np.float32))
+    y = Tensor(np.random.randn(size).astype(np.float32))
+    for _ in range(warmup_steps):
+        net(x, y)
+    start = time.time()
+    for _ in range(steps):
+        out = net(x, y)
+    out.asnumpy()
+    return (time.time() - start) * 1e6 / (steps * depth)
+
+
+def test_cpu_kernel_dispatch():
+    for size in sizes:
+        print("Add chain, depth {}, size {}: {:.2f} us per kernel".format(depth, size, us_per_kernel(size)))
+
+
+if __name__ == "__main__":
+    test_cpu_kernel_dispatch()
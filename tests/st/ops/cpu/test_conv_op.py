@@ -336,3 +336,67 @@ class MSGradNet(nn.Cell):
         grad_op = self.grad(self.network, self.params)
         output = grad_op(x, dy)
         return output
+
+
+class NetConvWeight(nn.Cell):
+    def __init__(self, weight):
+        super(NetConvWeight, self).__init__()
+        self.conv = P.Conv2D(out_channel=weight.shape[0], kernel_size=weight.shape[2])
+        self.w = Parameter(weight, name='w')
+
+    def construct(self, x):
+        return self.conv(x, self.w)
+
+
+class NetAssign(nn.Cell):
+    def __init__(self, param):
+        super(NetAssign, self).__init__()
+        self.param = param
+        self.assign = P.Assign()
+
+    def construct(self, value):
+        return self.assign(self.param, value)
+
+
+def np_conv2d(x, w):
+    """Valid 2D convolution with stride 1 of an NCHW input and an OIHW weight."""
+    kh, kw = w.shape[2], w.shape[3]
+    oh, ow = x.shape[2] - kh + 1, x.shape[3] - kw + 1
+    out = np.zeros((x.shape[0], w.shape[0], oh, ow), np.float32)
+    for i in range(kh):
+        for j in range(kw):
+            out += np.einsum('nchw,oc->nohw', x[:, :, i:i + oh, j:j + ow], w[:, :, i, j])
+    return out
+
+
+def check_conv_weight_updated_in_place():
+    # Channels of 16 make the convolution run in a blocked layout, which needs a reorder of the weight.
+    np.random.seed(0)
+    x = np.random.randn(2, 16, 8, 8).astype(np.float32)
+    w0 = np.random.randn(16, 16, 3, 3).astype(np.float32)
+    w1 = np.random.randn(16, 16, 3, 3).astype(np.float32)
+    conv = NetConvWeight(Tensor(w0))
+    output0 = conv(Tensor(x)).asnumpy()
+    assert np.allclose(output0, np_conv2d(x, w0), rtol=1e-3, atol=1e-3)
+    # Another graph writes the new weight to the same address, the convolution must see it.
+    NetAssign(conv.w)(Tensor(w1))
+    output1 = conv(Tensor(x)).asnumpy()
+    assert np.allclose(output1, np_conv2d(x, w1), rtol=1e-3, atol=1e-3)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv2d_weight_updated_in_place():
+    check_conv_weight_updated_in_place()
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv2d_weight_updated_in_place_pynative():
+    context.set_context(mode=context.PYNATIVE_MODE)
+    try:
+        check_conv_weight_updated_in_place()
+    finally:
+        context.set_context(mode=context.GRAPH_MODE)
@@ -0,0 +1,67 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import os
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+width = 32
+depth = 8
+
+
+class ChainNet(nn.Cell):
+    """Linear chains of dense layers, which are fused, joined by adds, which are not."""
+
+    def __init__(self, weights):
+        super(ChainNet, self).__init__()
+        self.left = nn.SequentialCell([nn.Dense(width, width, weight_init=Tensor(w), activation='relu')
+                                       for w in weights[:depth]])
+        self.right = nn.SequentialCell([nn.Dense(width, width, weight_init=Tensor(w), activation='tanh')
+                                        for w in weights[depth:]])
+        self.add = P.Add()
+
+    def construct(self, x):
+        y = self.add(self.left(x), self.right(x))
+        return self.add(self.left(y), y)
+
+
+def run_net(fusion, weights, inputs):
+    os.environ["MS_ACTOR_CHAIN_FUSION"] = "1" if fusion else "0"
+    try:
+        net = ChainNet(weights)
+        return [net(Tensor(x)).asnumpy() for x in inputs]
+    finally:
+        os.environ.pop("MS_ACTOR_CHAIN_FUSION")
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_actor_chain_fusion_same_outputs():
+    np.random.seed(1)
+    weights = [(np.random.randn(width, width) / np.sqrt(width)).astype(np.float32) for _ in range(2 * depth)]
+    inputs = [np.random.randn(4, width).astype(np.float32) for _ in range(3)]
+    unfused = run_net(False, weights, inputs)
+    fused = run_net(True, weights, inputs)
+    for unfused_output, fused_output in zip(unfused, fused):
+        assert np.array_equal(unfused_output, fused_output)
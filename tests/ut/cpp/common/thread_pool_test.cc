@@ -0,0 +1,150 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <vector>
+#include "common/common_test.h"
+#include "common/thread_pool.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace common {
+class ThreadPoolTest : public UT::Common {
+ public:
+  ThreadPoolTest() = default;
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+namespace {
+int CountRange(const void *closure, size_t start, size_t end) {
+  auto hits = static_cast<std::vector<std::atomic<int>> *>(const_cast<void *>(closure));
+  for (size_t i = start; i < end; ++i) {
+    (*hits)[i]++;
+  }
+  return SUCCESS;
+}
+}  // namespace
+
+TEST_F(ThreadPoolTest, test_parallel_launch_covers_every_element_once) {
+  auto &thread_pool = ThreadPool::GetInstance();
+  for (size_t count : {0, 1, 2, 7, 100, 1000, 12345}) {
+    for (size_t grain : {1, 3, 128}) {
+      std::vector<std::atomic<int>> hits(count);
+      EXPECT_TRUE(thread_pool.ParallelLaunch(CountRange, &hits, count, grain, thread_pool.GetSyncRunThreadNum()));
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(hits[i].load(), 1);
+      }
+    }
+  }
+}
+
+TEST_F(ThreadPoolTest, test_sync_run_reports_failed_task) {
+  std::vector<Task> tasks;
+  for (int i = 0; i < 10; ++i) {
+    tasks.emplace_back([i]() { return i == 5 ? FAIL : SUCCESS; });
+  }
+  EXPECT_FALSE(ThreadPool::GetInstance().SyncRun(tasks));
+}
+
+TEST_F(ThreadPoolTest, test_nested_parallel_for_runs_inline) {
+  std::vector<std::atomic<int>> hits(64 * 256);
+  auto outer = [&hits](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      kernel::CPUKernelUtils::ParallelFor(
+        [&hits, i](size_t inner_start, size_t inner_end) {
+          for (size_t j = inner_start; j < inner_end; ++j) {
+            hits[i * 256 + j]++;
+          }
+        },
+        256);
+    }
+  };
+  kernel::CPUKernelUtils::ParallelFor(outer, 64);
+  for (auto &hit : hits) {
+    ASSERT_EQ(hit.load(), 1);
+  }
+}
+
+TEST_F(ThreadPoolTest, test_parallel_for_auto_search) {
+  kernel::ParallelSearchInfo search_info;
+  const size_t count = 1000;
+  size_t launch_num = 0;
+  while (search_info.best_thread_num == 0) {
+    std::vector<std::atomic<int>> hits(count);
+    kernel::CPUKernelUtils::ParallelForAutoSearch(
+      [&hits](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+          hits[i]++;
+        }
+      },
+      count, &search_info);
+    for (auto &hit : hits) {
+      ASSERT_EQ(hit.load(), 1);
+    }
+    ASSERT_LE(++launch_num, search_info.candidate_thread_nums.size() * kernel::kParallelSearchRounds);
+  }
+  EXPECT_EQ(search_info.count, count);
+  EXPECT_EQ(search_info.candidate_thread_nums.front(), 1);
+  EXPECT_EQ(search_info.candidate_thread_nums.back(), ThreadPool::GetInstance().GetSyncRunThreadNum());
+}
+
+TEST_F(ThreadPoolTest, test_parallel_for_covers_every_index_once) {
+  for (size_t count : {0, 1, 2, 127, 128, 129, 1000, 100000}) {
+    std::vector<std::atomic<int>> hits(count);
+    kernel::CPUKernelUtils::ParallelFor(
+      [&hits](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+          hits[i]++;
+        }
+      },
+      count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(hits[i].load(), 1);
+    }
+  }
+}
+
+TEST_F(ThreadPoolTest, test_nested_parallel_for_with_zero_size_ranges) {
+  // Row i has i % 4 columns, so a quarter of the inner launches are empty.
+  const size_t rows = 512;
+  const size_t max_cols = 4;
+  std::vector<std::atomic<int>> hits(rows * max_cols);
+  std::atomic<size_t> bad_range_num{0};
+  auto outer = [&hits, &bad_range_num](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      kernel::CPUKernelUtils::ParallelFor(
+        [&hits, &bad_range_num, i](size_t inner_start, size_t inner_end) {
+          if (inner_start > inner_end || inner_end > i % max_cols) {
+            bad_range_num++;
+            return;
+          }
+          for (size_t j = inner_start; j < inner_end; ++j) {
+            hits[i * max_cols + j]++;
+          }
+        },
+        i % max_cols);
+    }
+  };
+  kernel::CPUKernelUtils::ParallelFor(outer, rows);
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < max_cols; ++j) {
+      ASSERT_EQ(hits[i * max_cols + j].load(), j < i % max_cols ? 1 : 0);
+    }
+  }
+  EXPECT_EQ(bad_range_num.load(), 0);
+}
+}  // namespace common
+}  // namespace mindspore
@@ -13,12 +13,18 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
 #include "common/common.h"
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/include/dataset/datasets.h"
 
 // need for CsvRecord
 #include "minddata/dataset/engine/ir/datasetops/source/csv_node.h"
+// need for CSV_READ_CHUNK_SIZE
+#include "minddata/dataset/engine/datasetops/source/csv_op.h"
 
 using namespace mindspore::dataset;
 
@@ -297,6 +303,149 @@ TEST_F(MindDataTestPipeline, TestCSVDatasetType) {
   iter->Stop();
 }
 
+TEST_F(MindDataTestPipeline, TestCSVDatasetLargeFile) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestCSVDatasetLargeFile.";
+
+  // A file large enough to be read by several workers, with line ends inside quoted fields
+  std::string file = "csv_dataset_large_file.csv";
+  const int32_t num_rows = 10000;
+  {
+    std::ofstream out(file, std::ios::trunc);
+    for (int32_t i = 0; i < num_rows; i++) {
+      out << i << ",\"a\r\n" << i << "\"\n";
+    }
+  }
+  std::vector<std::shared_ptr<CsvBase>> colum_type = {
+    std::make_shared<CsvRecord<int>>(CsvType::INT, 0),
+    std::make_shared<CsvRecord<std::string>>(CsvType::STRING, ""),
+  };
+  std::vector<std::string> column_names = {"col1", "col2"};
+  std::shared_ptr<Dataset> ds = CSV({file}, ',', colum_type, column_names, 0, ShuffleMode::kFalse);
+  EXPECT_NE(ds, nullptr);
+  ds = ds->SetNumWorkers(4);
+  EXPECT_NE(ds, nullptr);
+
+  std::shared_ptr<Iterator> iter = ds->CreateIterator();
+  EXPECT_NE(iter, nullptr);
+
+  // Every row is read once, whichever worker reads it
+  std::vector<int32_t> seen(num_rows, 0);
+  std::unordered_map<std::string, mindspore::MSTensor> row;
+  ASSERT_OK(iter->GetNextRow(&row));
+  uint64_t i = 0;
+  while (row.size() != 0) {
+    std::shared_ptr<Tensor> de_index;
+    ASSERT_OK(Tensor::CreateFromMSTensor(row["col1"], &de_index));
+    int32_t index = 0;
+    ASSERT_OK(de_index->GetItemAt(&index, {}));
+    ASSERT_TRUE(index >= 0 && index < num_rows);
+    seen[index]++;
+
+    std::shared_ptr<Tensor> de_text;
+    ASSERT_OK(Tensor::CreateFromMSTensor(row["col2"], &de_text));
+    std::string_view sv;
+    ASSERT_OK(de_text->GetItemAt(&sv, {}));
+    EXPECT_EQ(std::string(sv), "a\r\n" + std::to_string(index));
+    ASSERT_OK(iter->GetNextRow(&row));
+    i++;
+  }
+
+  EXPECT_EQ(i, num_rows);
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), num_rows);
+
+  // Manually terminate the pipeline
+  iter->Stop();
+  (void)remove(file.c_str());
+}
+
+TEST_F(MindDataTestPipeline, TestCSVDatasetQuotedChunkBoundary) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestCSVDatasetQuotedChunkBoundary.";
+
+  // Quoted fields with escaped quotes, commas and line ends, some of them cut by the chunks the file is read in
+  std::string file = "csv_dataset_quoted_chunk_boundary.csv";
+  std::string content;
+  std::vector<std::string> texts;
+  auto add_row = [&content, &texts](const std::string &text) {
+    std::string quoted;
+    for (char c : text) {
+      quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+    }
+    content += std::to_string(texts.size()) + ",\"" + quoted + "\"\n";
+    texts.push_back(text);
+  };
+  // Add rows up to a row whose quoted field, opening quote at 0, has its character at field_pos at file offset pos
+  auto add_row_at = [&content, &texts, &add_row](size_t pos, size_t field_pos, const std::string &text) {
+    while (content.size() + 512 < pos) {
+      add_row("x\"y,\nz" + std::to_string(texts.size()) + std::string(200, '.'));
+    }
+    size_t filler_size = pos - field_pos - content.size() - std::to_string(texts.size() + 1).size() - 1;
+    add_row(std::string(filler_size - std::to_string(texts.size()).size() - 4, 'p'));
+    add_row(text);
+  };
+  const size_t chunk = CSV_READ_CHUNK_SIZE;
+  // An escaped quote split between two chunks
+  add_row_at(chunk - 1, 2, "a\"b,c\nd");
+  ASSERT_EQ(content.substr(chunk - 1, 2), "\"\"");
+  // A line end in a quoted field starting a chunk
+  add_row_at(2 * chunk, 4, "e,f\ng\"h");
+  ASSERT_EQ(content[2 * chunk], '\n');
+  // An opening quote ending a chunk
+  add_row_at(3 * chunk - 1, 0, ",\r\n\"");
+  ASSERT_EQ(content.substr(3 * chunk - 1, 3), "\",\r");
+  for (int32_t i = 0; i < 100; i++) {
+    add_row("\"" + std::to_string(texts.size()) + "\",\n");
+  }
+  {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out << content;
+  }
+
+  std::vector<std::shared_ptr<CsvBase>> colum_type = {
+    std::make_shared<CsvRecord<int>>(CsvType::INT, 0),
+    std::make_shared<CsvRecord<std::string>>(CsvType::STRING, ""),
+  };
+  std::vector<std::string> column_names = {"col1", "col2"};
+  // One worker reads the chunks in order, several workers also start reading in the middle of the file
+  for (int32_t num_workers : {1, 4}) {
+    std::shared_ptr<Dataset> ds = CSV({file}, ',', colum_type, column_names, 0, ShuffleMode::kFalse);
+    EXPECT_NE(ds, nullptr);
+    ds = ds->SetNumWorkers(num_workers);
+    EXPECT_NE(ds, nullptr);
+    std::shared_ptr<Iterator> iter = ds->CreateIterator();
+    EXPECT_NE(iter, nullptr);
+
+    const int32_t num_rows = static_cast<int32_t>(texts.size());
+    std::vector<int32_t> seen(num_rows, 0);
+    std::unordered_map<std::string, mindspore::MSTensor> row;
+    ASSERT_OK(iter->GetNextRow(&row));
+    int32_t i = 0;
+    while (row.size() != 0) {
+      std::shared_ptr<Tensor> de_index;
+      ASSERT_OK(Tensor::CreateFromMSTensor(row["col1"], &de_index));
+      int32_t index = 0;
+      ASSERT_OK(de_index->GetItemAt(&index, {}));
+      ASSERT_TRUE(index >= 0 && index < num_rows);
+      if (num_workers == 1) {
+        EXPECT_EQ(index, i);
+      }
+      seen[index]++;
+
+      std::shared_ptr<Tensor> de_text;
+      ASSERT_OK(Tensor::CreateFromMSTensor(row["col2"], &de_text));
+      std::string_view sv;
+      ASSERT_OK(de_text->GetItemAt(&sv, {}));
+      EXPECT_EQ(std::string(sv), texts[index]);
+      ASSERT_OK(iter->GetNextRow(&row));
+      i++;
+    }
+
+    EXPECT_EQ(i, num_rows);
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), num_rows);
+    iter->Stop();
+  }
+  (void)remove(file.c_str());
+}
+
 TEST_F(MindDataTestPipeline, TestCSVDatasetHeader) {
   MS_LOG(INFO) << "Doing MindDataTestPipeline-TestCSVDatasetHeader.";
 
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/dataset/engine/cache/cache_hw.h"
+#include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/services.h"
+#define private public
+#include "minddata/dataset/engine/cache/cache_pool.h"
+#undef private
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestCachePool : public UT::Common {
+ public:
+  MindDataTestCachePool() = default;
+
+  void SetUp() override {
+    spill_ = Path("/tmp") / ("cache_pool_test_" + Services::GetUniqueID());
+    ASSERT_OK(spill_.CreateDirectories());
+  }
+
+  void TearDown() override {
+    auto it = Path::DirIterator::OpenDirectory(&spill_);
+    while (it->hasNext()) {
+      (void)it->next().Remove();
+    }
+    (void)spill_.Remove();
+  }
+
+  // A pool which has room for num_rows rows of kRowSize bytes in memory, and spills the rest to the test folder.
+  std::shared_ptr<CachePool> MakePool(int num_rows) {
+    auto hw = std::make_shared<CacheServerHW>();
+    auto mp = std::make_shared<NumaMemoryPool>(hw, 0.01);
+    auto cp = std::make_shared<CachePool>(mp);
+    EXPECT_OK(cp->ServiceStart());
+    cp->min_avail_mem_ = kRowSize;
+    cp->soft_mem_limit_ = kRowSize * (num_rows + 1);
+    cp->sm_ = std::make_shared<StorageManager>(spill_, 1);
+    EXPECT_OK(cp->sm_->ServiceStart());
+    return cp;
+  }
+
+  static std::vector<uint8_t> Row(CachePool::key_type key) {
+    return std::vector<uint8_t>(kRowSize, static_cast<uint8_t>(key));
+  }
+
+  static Status Insert(const std::shared_ptr<CachePool> &cp, CachePool::key_type key) {
+    auto row = Row(key);
+    return cp->Insert(key, {ReadableSlice(row.data(), row.size())});
+  }
+
+  static void ExpectRow(const std::shared_ptr<CachePool> &cp, CachePool::key_type key) {
+    std::vector<uint8_t> row(kRowSize, 0);
+    WritableSlice dest(row.data(), row.size());
+    size_t bytes_read = 0;
+    EXPECT_OK(cp->Read(key, &dest, &bytes_read));
+    EXPECT_EQ(bytes_read, kRowSize);
+    EXPECT_EQ(row, Row(key));
+  }
+
+  static bool InMemory(const std::shared_ptr<CachePool> &cp, CachePool::key_type key) {
+    auto r = cp->tree_->Search(key);
+    EXPECT_TRUE(r.second);
+    return r.second && r.first.value().ptr != nullptr;
+  }
+
+  static constexpr size_t kRowSize = 64;
+  Path spill_{""};
+};
+
+// Fetches of rows in memory, of rows spilled to disk and of rows not in the cache are counted apart.
+TEST_F(MindDataTestCachePool, TestGetDataLocatorCounters) {
+  auto hw = std::make_shared<CacheServerHW>();
+  auto mp = std::make_shared<NumaMemoryPool>(hw, 0.01);
+  auto cp = std::make_shared<CachePool>(mp);
+  ASSERT_OK(cp->ServiceStart());
+
+  // Rows 1 and 2 are cached in memory.
+  const int64_t row_sz = 64;
+  for (CachePool::key_type key : {1, 2}) {
+    CachePool::DataLocator bl;
+    ASSERT_OK(mp->Allocate(row_sz, reinterpret_cast<void **>(&bl.ptr)));
+    bl.sz = row_sz;
+    ASSERT_OK(cp->tree_->DoInsert(key, std::move(bl)));
+  }
+  // Row 3 has been spilled, its locator has no memory address but a storage key.
+  CachePool::DataLocator spilled;
+  spilled.sz = row_sz;
+  spilled.storage_key = 1;
+  ASSERT_OK(cp->tree_->DoInsert(3, std::move(spilled)));
+
+  auto fetch = [&cp](CachePool::key_type key) {
+    auto fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
+    flatbuffers::Offset<DataLocatorMsg> offset;
+    EXPECT_OK(cp->GetDataLocator(key, fbb, &offset));
+    fbb->Finish(offset);
+    auto *msg = flatbuffers::GetRoot<DataLocatorMsg>(fbb->GetBufferPointer());
+    EXPECT_EQ(msg->key(), key);
+    return std::make_pair(msg->addr(), msg->size());
+  };
+  for (int i = 0; i < 3; ++i) {
+    auto loc = fetch(1);
+    EXPECT_NE(loc.first, 0);
+    EXPECT_EQ(loc.second, row_sz);
+  }
+  EXPECT_NE(fetch(2).first, 0);
+  for (int i = 0; i < 2; ++i) {
+    auto loc = fetch(3);
+    EXPECT_EQ(loc.first, 0);
+    EXPECT_EQ(loc.second, row_sz);
+  }
+  for (CachePool::key_type key : {0, 4, 100, 4}) {
+    auto loc = fetch(key);
+    EXPECT_EQ(loc.first, 0);
+    EXPECT_EQ(loc.second, 0);
+  }
+
+  auto stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 2);
+  EXPECT_EQ(stat.num_disk_cached, 1);
+  EXPECT_EQ(stat.num_mem_hit, 4);
+  EXPECT_EQ(stat.num_disk_hit, 2);
+  EXPECT_EQ(stat.num_miss, 4);
+
+  // Reading the stat does not count as a fetch.
+  stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_hit + stat.num_disk_hit + stat.num_miss, 10);
+  ASSERT_OK(cp->ServiceStop());
+}
+
+// A full pool moves the row not read for the longest time to disk, and brings it back when it is read again.
+TEST_F(MindDataTestCachePool, TestClockEviction) {
+  auto cp = MakePool(3);
+  for (CachePool::key_type key : {1, 2, 3}) {
+    ASSERT_OK(Insert(cp, key));
+  }
+  // Row 1 is read, so row 2 is the one to go.
+  ExpectRow(cp, 1);
+  ASSERT_OK(Insert(cp, 4));
+  EXPECT_TRUE(InMemory(cp, 1));
+  EXPECT_FALSE(InMemory(cp, 2));
+  EXPECT_TRUE(InMemory(cp, 3));
+  EXPECT_TRUE(InMemory(cp, 4));
+  auto stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 3);
+  EXPECT_EQ(stat.num_disk_cached, 1);
+  EXPECT_EQ(stat.num_evicted, 1);
+
+  // Reading row 2 from disk promotes it and pushes row 3 out.
+  ExpectRow(cp, 2);
+  EXPECT_TRUE(InMemory(cp, 2));
+  EXPECT_FALSE(InMemory(cp, 3));
+  stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 3);
+  EXPECT_EQ(stat.num_disk_cached, 1);
+  EXPECT_EQ(stat.num_evicted, 2);
+  for (CachePool::key_type key : {1, 2, 3, 4}) {
+    ExpectRow(cp, key);
+  }
+  ASSERT_OK(cp->ServiceStop());
+}
+
+// A persisted pool is reloaded from its spill folder with all its rows on disk.
+TEST_F(MindDataTestCachePool, TestPersistRestore) {
+  const std::vector<CachePool::key_type> keys = {5, 6, 7, 8, 9};
+  flatbuffers::FlatBufferBuilder fbb;
+  {
+    auto cp = MakePool(2);
+    for (auto key : keys) {
+      ASSERT_OK(Insert(cp, key));
+    }
+    flatbuffers::Offset<CachePoolManifestMsg> offset;
+    ASSERT_OK(cp->Persist(&fbb, &offset));
+    fbb.Finish(offset);
+    ASSERT_OK(cp->ServiceStop());
+  }
+  auto *manifest = flatbuffers::GetRoot<CachePoolManifestMsg>(fbb.GetBufferPointer());
+  ASSERT_EQ(manifest->rows()->size(), keys.size());
+
+  auto cp = MakePool(2);
+  ASSERT_OK(cp->Restore(manifest));
+  auto stat = cp->GetStat();
+  EXPECT_EQ(stat.num_mem_cached, 0);
+  EXPECT_EQ(stat.num_disk_cached, keys.size());
+  EXPECT_EQ(stat.min_key, keys.front());
+  EXPECT_EQ(stat.max_key, keys.back());
+  for (auto key : keys) {
+    ExpectRow(cp, key);
+  }
+  // New rows go to new containers, next to the reloaded ones.
+  ASSERT_OK(Insert(cp, 10));
+  ExpectRow(cp, 10);
+  for (auto key : keys) {
+    ExpectRow(cp, key);
+  }
+  ASSERT_OK(cp->ServiceStop());
+}
@@ -122,6 +122,53 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+// Test3: the number of producers taking part in the roundrobin changes while the connector is in use
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3: change the number of active producers.";
+  Connector<uint32_t> conn(4, 1, 8);
+  // Rows 0-3 go to producers 0-3, rows 4-7 to producers 0-1 and rows 8-10 to producers 0-2.
+  std::vector<int32_t> producers = {0, 1, 2, 3, 0, 1, 0, 1, 0, 1, 2};
+  conn.SetActiveProducers(2, 4);
+  conn.SetActiveProducers(3, 8);
+  for (uint32_t i = 0; i < producers.size(); i++) {
+    ASSERT_TRUE(conn.Push(producers[i], i).IsOk());
+  }
+  ASSERT_EQ(conn.capacity(), 32);
+  for (uint32_t i = 0; i < producers.size(); i++) {
+    uint32_t result = 0;
+    ASSERT_TRUE(conn.Pop(0, &result).IsOk());
+    ASSERT_EQ(result, i);
+  }
+  ASSERT_EQ(conn.capacity(), 24);
+  ASSERT_TRUE(conn.Resize(2).IsOk());
+  ASSERT_EQ(conn.capacity(), 6);
+}
+
+// Test4: a connector launched with fewer active producers than it has goes back to that number on Reset()
+TEST_F(MindDataTestConnector, Test4) {
+  MS_LOG(INFO) << "MindDataTestConnector Test4: reset to the active producers at launch.";
+  Connector<uint32_t> conn(4, 1, 8);
+  conn.SetLaunchProducers(2);
+  ASSERT_EQ(conn.capacity(), 16);
+  // Rows 0-3 go to producers 0-1 and rows 4-8 to producers 0-2.
+  std::vector<int32_t> producers = {0, 1, 0, 1, 0, 1, 2, 0, 1};
+  conn.SetActiveProducers(3, 4);
+  for (int epoch = 0; epoch < 2; epoch++) {
+    for (uint32_t i = 0; i < producers.size(); i++) {
+      ASSERT_TRUE(conn.Push(producers[i], i).IsOk());
+    }
+    for (uint32_t i = 0; i < producers.size(); i++) {
+      uint32_t result = 0;
+      ASSERT_TRUE(conn.Pop(0, &result).IsOk());
+      ASSERT_EQ(result, i);
+    }
+    ASSERT_EQ(conn.capacity(), 24);
+    conn.Reset();
+    ASSERT_EQ(conn.capacity(), 16);
+    conn.SetActiveProducers(3, 4);
+  }
+}
+
 
 
 // Implementation of MindDataTestConnector class and the helper functions.
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+#include "minddata/dataset/kernels/image/horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestFusedImageOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedImageOp() : CVOpCommon() {}
+
+  // Run the ops one by one and fused, and compare the two float32 images
+  void CheckFused(const std::vector<std::shared_ptr<TensorOp>> &ops, float tolerance) {
+    ASSERT_TRUE(FusedImageOp::CanFuse(ops));
+    std::shared_ptr<Tensor> expected = input_tensor_;
+    for (const auto &op : ops) {
+      std::shared_ptr<Tensor> result;
+      ASSERT_OK(op->Compute(expected, &result));
+      expected = result;
+    }
+    FusedImageOp fused_op(ops);
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(fused_op.Compute(input_tensor_, &output));
+    ASSERT_EQ(output->shape(), expected->shape());
+    ASSERT_EQ(output->type(), expected->type());
+    auto expected_it = expected->begin<float>();
+    for (auto it = output->begin<float>(); it != output->end<float>(); ++it, ++expected_it) {
+      ASSERT_NEAR(*it, *expected_it, tolerance);
+    }
+  }
+};
+
+TEST_F(MindDataTestFusedImageOp, TestCropFlipNormalize) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestCropFlipNormalize.";
+  int32_t height = static_cast<int32_t>(input_tensor_->shape()[0]);
+  int32_t width = static_cast<int32_t>(input_tensor_->shape()[1]);
+  // crop whole pixels, so the fused op samples the same pixels as the crop
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<CenterCropOp>(height - height / 4 * 2, width - width / 4 * 2),
+    std::make_shared<HorizontalFlipOp>(), std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+    std::make_shared<NormalizeOp>(std::vector<float>{0.485, 0.456, 0.406}, std::vector<float>{0.229, 0.224, 0.225}),
+    std::make_shared<HwcToChwOp>()};
+  CheckFused(ops, 1e-4);
+}
+
+TEST_F(MindDataTestFusedImageOp, TestResizeRescale) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestResizeRescale.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<ResizeOp>(64, 48),
+                                                std::make_shared<RescaleOp>(1.0 / 255, 0.0)};
+  // the resized uint8 image is rounded, the fused op interpolates in float
+  CheckFused(ops, 1.01 / 255);
+}
+
+// The rescaled image is float, so the resize is not rounded and the edge pixels are compared exactly
+TEST_F(MindDataTestFusedImageOp, TestUpscaleEdges) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestUpscaleEdges.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<CenterCropOp>(32, 24),
+                                                std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+                                                std::make_shared<ResizeOp>(75, 61), std::make_shared<HwcToChwOp>()};
+  CheckFused(ops, 1e-4);
+}
+
+// A crop after a resize keeps the edges of the resized image, the first rows and columns of the crop are not
+// clamped to the crop box in the source image
+TEST_F(MindDataTestFusedImageOp, TestCropAfterUpscale) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestCropAfterUpscale.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<CenterCropOp>(32, 24), std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+    std::make_shared<ResizeOp>(64, 48), std::make_shared<CenterCropOp>(30, 20), std::make_shared<HorizontalFlipOp>()};
+  CheckFused(ops, 1e-4);
+}
+
+TEST_F(MindDataTestFusedImageOp, TestFlipCropDownscaleEdges) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestFlipCropDownscaleEdges.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<RescaleOp>(1.0 / 255, 0.0), std::make_shared<HorizontalFlipOp>(),
+    std::make_shared<CenterCropOp>(63, 47), std::make_shared<ResizeOp>(20, 15)};
+  CheckFused(ops, 1e-4);
+}
+
+TEST_F(MindDataTestFusedImageOp, TestCanFuse) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp-TestCanFuse.";
+  auto resize = std::make_shared<ResizeOp>(64, 48);
+  auto rescale = std::make_shared<RescaleOp>(1.0 / 255, 0.0);
+  auto hwc2chw = std::make_shared<HwcToChwOp>();
+  auto nearest_resize = std::make_shared<ResizeOp>(64, 48, InterpolationMode::kNearestNeighbour);
+  EXPECT_TRUE(FusedImageOp::CanFuse({resize, rescale, hwc2chw}));
+  // a chain needs both a geometric and a pixel-wise op
+  EXPECT_FALSE(FusedImageOp::CanFuse({rescale, hwc2chw}));
+  EXPECT_FALSE(FusedImageOp::CanFuse({resize, hwc2chw}));
+  // HWC2CHW can only end the chain
+  EXPECT_FALSE(FusedImageOp::CanFuse({resize, hwc2chw, rescale}));
+  // only bilinear resize is fused
+  EXPECT_FALSE(FusedImageOp::CanFuse({nearest_resize, rescale}));
+}
@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <map>
 #include <memory>
+#include <random>
 #include <unordered_set>
 
 #include "common/common.h"
@@ -25,6 +29,7 @@
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
+#include "minddata/dataset/engine/gnn/graph_storage.h"
 
 using namespace mindspore::dataset;
 using namespace mindspore::dataset::gnn;
@@ -408,3 +413,161 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestWeightSampledNeighbors) {
+  // Neighbors of type 1 with some zero weights, of type 2 with a single non zero weight. The edges to the neighbors
+  // of type 1 are of two types, so their weights are split between two adjacency blocks.
+  std::vector<GraphStorage::NodeRows> nodes(1);
+  std::vector<GraphStorage::EdgeRows> edges(1);
+  nodes[0].ids.push_back(1);
+  nodes[0].types.push_back(0);
+  auto add_neighbor = [&nodes, &edges](NodeIdType id, NodeType type, EdgeType edge_type, WeightType weight) {
+    nodes[0].ids.push_back(id);
+    nodes[0].types.push_back(type);
+    edges[0].ids.push_back(id);
+    edges[0].types.push_back(edge_type);
+    edges[0].src_ids.push_back(1);
+    edges[0].dst_ids.push_back(id);
+    edges[0].weights.push_back(weight);
+  };
+  std::vector<WeightType> weights = {0.0, 1.0, 2.0, 0.0, 3.0, 4.0};
+  for (size_t i = 0; i < weights.size(); ++i) {
+    add_neighbor(10 + i, 1, i % 2, weights[i]);
+  }
+  std::vector<WeightType> single_weight = {0.0, 0.0, 5.0, 0.0};
+  for (size_t i = 0; i < single_weight.size(); ++i) {
+    add_neighbor(20 + i, 2, 0, single_weight[i]);
+  }
+  GraphStorage storage;
+  ASSERT_TRUE(storage.Build(&nodes, &edges).IsOk());
+  int32_t node = 0;
+  ASSERT_TRUE(storage.FindNode(1, &node));
+
+  // The frequencies follow the weights, 0.01 is over 6 standard deviations of any of them
+  const int32_t samples_num = 100000;
+  std::mt19937 rnd(1);
+  std::vector<NodeIdType> neighbors;
+  EXPECT_TRUE(storage.SampleNeighbors(node, 1, samples_num, SamplingStrategy::kEdgeWeight, &rnd, &neighbors).IsOk());
+  ASSERT_EQ(neighbors.size(), static_cast<size_t>(samples_num));
+  std::map<NodeIdType, int32_t> counts;
+  for (auto neighbor : neighbors) {
+    counts[neighbor]++;
+  }
+  EXPECT_TRUE(counts.find(10) == counts.end());
+  EXPECT_TRUE(counts.find(13) == counts.end());
+  for (size_t i = 0; i < weights.size(); ++i) {
+    double expected = weights[i] / 10.0;
+    EXPECT_NEAR(static_cast<double>(counts[10 + i]) / samples_num, expected, 0.01) << "neighbor " << 10 + i;
+  }
+
+  neighbors.clear();
+  EXPECT_TRUE(storage.SampleNeighbors(node, 2, samples_num, SamplingStrategy::kEdgeWeight, &rnd, &neighbors).IsOk());
+  ASSERT_EQ(neighbors.size(), static_cast<size_t>(samples_num));
+  EXPECT_TRUE(std::all_of(neighbors.begin(), neighbors.end(), [](NodeIdType id) { return id == 22; }));
+}
+
+TEST_F(MindDataTestGNNGraph, TestGetInNeighbors) {
+  // 1 -> 3, 2 -> 3, 3 -> 1 and 2 -> 4, nodes 1 and 2 are of type 0, 3 and 4 of type 1
+  std::vector<GraphStorage::NodeRows> nodes(2);
+  nodes[0].ids = {3, 1};
+  nodes[0].types = {1, 0};
+  nodes[1].ids = {4, 2};
+  nodes[1].types = {1, 0};
+  std::vector<GraphStorage::EdgeRows> edges(1);
+  edges[0].ids = {10, 11, 12, 13};
+  edges[0].types = {0, 1, 0, 0};
+  edges[0].src_ids = {1, 2, 3, 2};
+  edges[0].dst_ids = {3, 3, 1, 4};
+  edges[0].weights = {1.0, 1.0, 1.0, 1.0};
+  GraphStorage storage;
+  ASSERT_TRUE(storage.Build(&nodes, &edges).IsOk());
+
+  auto neighbors_of = [&storage](NodeIdType id, NodeType neighbor_type, EdgeDirection direction) {
+    int32_t node = 0;
+    EXPECT_TRUE(storage.FindNode(id, &node));
+    std::vector<NodeIdType> neighbors;
+    storage.GetNeighbors(node, neighbor_type, direction, &neighbors);
+    return neighbors;
+  };
+  EXPECT_EQ(neighbors_of(3, 0, EdgeDirection::kIn), std::vector<NodeIdType>({1, 2}));
+  EXPECT_EQ(neighbors_of(4, 0, EdgeDirection::kIn), std::vector<NodeIdType>({2}));
+  EXPECT_EQ(neighbors_of(1, 1, EdgeDirection::kIn), std::vector<NodeIdType>({3}));
+  EXPECT_TRUE(neighbors_of(2, 1, EdgeDirection::kIn).empty());
+  // the neighbors are ordered by edge type, 2 -> 4 is of type 0 and 2 -> 3 of type 1
+  EXPECT_EQ(neighbors_of(2, 1, EdgeDirection::kOut), std::vector<NodeIdType>({4, 3}));
+
+  int32_t node = 0;
+  ASSERT_TRUE(storage.FindNode(2, &node));
+  EXPECT_EQ(storage.FindEdgeBetween(node, 4), 13);
+  EXPECT_EQ(storage.FindEdgeBetween(node, 1), -1);
+}
+
+TEST_F(MindDataTestGNNGraph, TestGraphFile) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  std::string graph_file = path + GraphStorage::kSuffix;
+  (void)remove(graph_file.c_str());
+
+  // Save the graph file whatever the size of the graph
+  GraphDataImpl graph(path, 1);
+  GraphLoader loader(&graph, path, 1, false, 0);
+  ASSERT_TRUE(loader.InitAndLoad().IsOk());
+  ASSERT_TRUE(loader.GetNodesAndEdges().IsOk());
+
+  GraphStorage storage;
+  ASSERT_TRUE(storage.Load(graph_file).IsOk());
+  MetaInfo graph_info;
+  ASSERT_TRUE(graph.GetMetaInfo(&graph_info).IsOk());
+  int64_t num_nodes = 0;
+  for (const auto &node_num : graph_info.node_num) {
+    num_nodes += node_num.second;
+  }
+  int64_t num_edges = 0;
+  for (const auto &edge_num : graph_info.edge_num) {
+    num_edges += edge_num.second;
+  }
+  EXPECT_EQ(storage.NumNodes(), num_nodes);
+  EXPECT_EQ(storage.NumEdges(), num_edges);
+
+  // The graph mapped from the graph file answers the same as the graph read from the dataset
+  GraphDataImpl mapped(path, 1);
+  GraphLoader mapped_loader(&mapped, path, 1, false, 0);
+  ASSERT_TRUE(mapped_loader.InitAndLoad().IsOk());
+  ASSERT_TRUE(mapped_loader.GetNodesAndEdges().IsOk());
+  MetaInfo meta_info;
+  ASSERT_TRUE(mapped.GetMetaInfo(&meta_info).IsOk());
+  std::shared_ptr<Tensor> nodes;
+  std::shared_ptr<Tensor> mapped_nodes;
+  ASSERT_TRUE(graph.GetAllNodes(meta_info.node_type[0], &nodes).IsOk());
+  ASSERT_TRUE(mapped.GetAllNodes(meta_info.node_type[0], &mapped_nodes).IsOk());
+  EXPECT_EQ(nodes->ToString(), mapped_nodes->ToString());
+  std::vector<NodeIdType> node_list;
+  for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+    node_list.push_back(*itr);
+  }
+  std::shared_ptr<Tensor> neighbors;
+  std::shared_ptr<Tensor> mapped_neighbors;
+  ASSERT_TRUE(graph.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kCoo, &neighbors).IsOk());
+  ASSERT_TRUE(mapped.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kCoo, &mapped_neighbors).IsOk());
+  EXPECT_EQ(neighbors->ToString(), mapped_neighbors->ToString());
+  TensorRow features;
+  TensorRow mapped_features;
+  ASSERT_TRUE(graph.GetNodeFeature(nodes, meta_info.node_feature_type, &features).IsOk());
+  ASSERT_TRUE(mapped.GetNodeFeature(mapped_nodes, meta_info.node_feature_type, &mapped_features).IsOk());
+  ASSERT_EQ(features.size(), mapped_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_EQ(features[i]->ToString(), mapped_features[i]->ToString());
+  }
+
+  // A truncated graph file is rejected
+  std::string truncated_file = graph_file + ".truncated";
+  {
+    std::ifstream in(graph_file, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(truncated_file, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size() / 2);
+  }
+  GraphStorage truncated;
+  EXPECT_TRUE(truncated.Load(truncated_file).IsError());
+  (void)remove(truncated_file.c_str());
+  (void)remove(graph_file.c_str());
+}
@@ -737,3 +737,61 @@ TEST_F(MindDataTestMapOp, ImageFolder_Decode_Repeat_Resize_NoInputColumns) {
   }
   EXPECT_TRUE(i == 88);
 }
+
+// With AutoTune the map and batch ops launch spare workers. The rows keep their order while the number of
+// active workers changes, including across the end of an epoch.
+TEST_F(MindDataTestMapOp, ImageFolder_Decode_Batch_Repeat_AutoTune) {
+  MS_LOG(INFO) << "Doing ImageFolder_Decode_Batch_Repeat_AutoTune.";
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  bool enable_autotune = config_manager->enable_autotune();
+  config_manager->set_enable_autotune(true);
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  uint32_t num_repeats = 2;
+  int32_t op_connector_size = config_manager->op_connector_size();
+  std::vector<std::shared_ptr<TensorOp>> func_list = {std::make_shared<DecodeOp>(),
+                                                      std::make_shared<ResizeOp>(32, 32)};
+  std::shared_ptr<MapOp> map_op =
+    std::make_shared<MapOp>(std::vector<std::string>{"image"}, std::vector<std::string>{}, func_list, 2,
+                            op_connector_size);
+  EXPECT_TRUE(map_op->IsWorkersTunable());
+  EXPECT_GE(map_op->num_workers(), 2);
+  EXPECT_EQ(map_op->NumActiveWorkers(), 2);
+  auto batch_op = Batch(4);
+  auto image_folder_op = ImageFolder(2, 2, 32, folder_path, false);
+  image_folder_op->set_total_repeats(num_repeats);
+  image_folder_op->set_num_repeats_per_epoch(num_repeats);
+  map_op->set_total_repeats(num_repeats);
+  map_op->set_num_repeats_per_epoch(num_repeats);
+  batch_op->set_total_repeats(num_repeats);
+  batch_op->set_num_repeats_per_epoch(num_repeats);
+  my_tree_ = Build({image_folder_op, map_op, batch_op, Repeat(num_repeats)});
+  ASSERT_OK(my_tree_->Prepare());
+  ASSERT_OK(my_tree_->Launch());
+
+  DatasetIterator di(my_tree_);
+  TensorMap tensor_map;
+  ASSERT_OK(di.GetNextAsMap(&tensor_map));
+  uint64_t i = 0;
+  int32_t img_class[] = {0, 1, 2, 3};
+  while (tensor_map.size() != 0) {
+    // Change the active workers at a few points of both epochs, on top of what AutoTune does
+    if (i % 11 == 3) {
+      ASSERT_OK(map_op->SetNumActiveWorkers(map_op->num_workers()));
+      ASSERT_OK(batch_op->SetNumActiveWorkers(1));
+    } else if (i % 11 == 7) {
+      ASSERT_OK(map_op->SetNumActiveWorkers(1));
+      ASSERT_OK(batch_op->SetNumActiveWorkers(batch_op->num_workers()));
+    }
+    EXPECT_EQ(tensor_map["image"]->shape(), TensorShape({4, 32, 32, 3}));
+    for (int64_t k = 0; k < 4; ++k) {
+      int32_t label = -1;
+      ASSERT_OK(tensor_map["label"]->GetItemAt<int32_t>(&label, {k}));
+      EXPECT_EQ(label, img_class[((i % 11) * 4 + k) / 11]);
+    }
+    ASSERT_OK(di.GetNextAsMap(&tensor_map));
+    i++;
+  }
+  EXPECT_EQ(i, 22);
+  config_manager->set_enable_autotune(enable_autotune);
+}
@@ -24,6 +24,7 @@
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/post/auto_worker_pass.h"
+#include "minddata/dataset/engine/tree_adapter.h"
 #include "minddata/dataset/include/dataset/transforms.h"
 #include "minddata/dataset/include/dataset/vision.h"
 #include "minddata/dataset/include/dataset/vision_lite.h"
@@ -111,3 +112,47 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+TEST_F(MindDataTestOptimizationPass, MindDataTestBatchMapFusionPass) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestBatchMapFusionPass.";
+  std::string folder_path = datasets_root_path_ + "/testMnistData/";
+  auto rescale_op = vision::Rescale(1.0 / 255, 0);
+  auto normalize_op = vision::Normalize({0.5}, {0.25});
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> ds = Mnist(folder_path, "all", std::make_shared<SequentialSampler>(0, 5))
+                                  ->Map({rescale_op, normalize_op, hwc2chw_op}, {"image"})
+                                  ->Batch(2);
+
+  TreeAdapter row_tree;
+  row_tree.SetOptimize(false);
+  ASSERT_OK(row_tree.Compile(ds->IRNode(), 1));
+  TreeAdapter batch_tree;
+  batch_tree.SetOptimize(true);
+  ASSERT_OK(batch_tree.Compile(ds->IRNode(), 1));
+
+  // the map runs after the batch, on whole batches
+  std::shared_ptr<DatasetOp> root_op = batch_tree.GetRoot().lock();
+  ASSERT_NE(root_op, nullptr);
+  EXPECT_EQ(root_op->Name(), kMapOp);
+  EXPECT_TRUE(std::dynamic_pointer_cast<MapOp>(root_op)->RunOnBatch());
+  EXPECT_EQ(root_op->child(0)->Name(), kBatchOp);
+
+  // and gives the same batches as the map running on each row
+  TensorRow expected;
+  TensorRow row;
+  ASSERT_OK(row_tree.GetNext(&expected));
+  ASSERT_OK(batch_tree.GetNext(&row));
+  uint64_t i = 0;
+  while (!expected.empty()) {
+    ASSERT_EQ(row.size(), expected.size());
+    EXPECT_EQ(row[0]->shape(), TensorShape({i < 2 ? 2 : 1, 1, 28, 28}));
+    for (size_t j = 0; j < row.size(); j++) {
+      EXPECT_EQ(*row[j], *expected[j]);
+    }
+    ASSERT_OK(row_tree.GetNext(&expected));
+    ASSERT_OK(batch_tree.GetNext(&row));
+    i++;
+  }
+  EXPECT_TRUE(row.empty());
+  EXPECT_EQ(i, 3);
+}
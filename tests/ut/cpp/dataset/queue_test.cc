@@ -177,3 +177,27 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, Test7) {
+  // Resize a queue holding elements which have wrapped around the end of its buffer
+  Queue<int> que(3);
+  int v = 0;
+  ASSERT_TRUE(que.Add(1).IsOk());
+  ASSERT_TRUE(que.Add(2).IsOk());
+  ASSERT_TRUE(que.PopFront(&v).IsOk());
+  ASSERT_TRUE(que.Add(3).IsOk());
+  ASSERT_TRUE(que.Add(4).IsOk());
+  ASSERT_TRUE(que.Resize(5).IsOk());
+  ASSERT_EQ(que.capacity(), 5);
+  ASSERT_TRUE(que.Add(5).IsOk());
+  ASSERT_TRUE(que.Add(6).IsOk());
+  // The queue never shrinks below the elements it holds
+  ASSERT_TRUE(que.Resize(1).IsOk());
+  ASSERT_EQ(que.capacity(), 5);
+  for (int expected = 2; expected <= 6; expected++) {
+    ASSERT_TRUE(que.PopFront(&v).IsOk());
+    ASSERT_EQ(v, expected);
+  }
+  ASSERT_TRUE(que.Resize(1).IsOk());
+  ASSERT_EQ(que.capacity(), 1);
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+
+#include "minddata/dataset/util/recycle_pool.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestRecyclePool : public UT::Common {
+ public:
+  MindDataTestRecyclePool() {}
+};
+
+TEST_F(MindDataTestRecyclePool, TestRecycle) {
+  RecyclePool pool;
+  void *p = nullptr;
+  ASSERT_OK(pool.Allocate(1000, &p));
+  pool.Deallocate(p);
+  // the same size class is served by the freed block
+  void *q = nullptr;
+  ASSERT_OK(pool.Allocate(1010, &q));
+  ASSERT_EQ(p, q);
+
+  // a block freed by another thread returns to the thread which allocated it
+  std::thread consumer([&pool, q]() { pool.Deallocate(q); });
+  consumer.join();
+  ASSERT_OK(pool.Allocate(1000, &p));
+  ASSERT_EQ(p, q);
+  ASSERT_EQ(pool.SystemAllocations(), 1);
+
+  // a block grows in place up to its size class
+  ASSERT_OK(pool.Reallocate(&p, 1000, 1020));
+  ASSERT_EQ(p, q);
+  pool.Deallocate(p);
+}
+
+TEST_F(MindDataTestRecyclePool, TestReserve) {
+  RecyclePool pool;
+  const size_t batch_size = 3 * 1024 * 1024;
+  ASSERT_OK(pool.Reserve(batch_size, 4));
+  ASSERT_EQ(pool.SystemAllocations(), 4);
+  std::vector<void *> blocks(4, nullptr);
+  for (auto &block : blocks) {
+    ASSERT_OK(pool.Allocate(batch_size, &block));
+  }
+  ASSERT_EQ(pool.SystemAllocations(), 4);
+  for (auto &block : blocks) {
+    pool.Deallocate(block);
+  }
+
+  // the cache of a thread which exits is adopted with its blocks
+  std::thread first([&pool]() {
+    void *p = nullptr;
+    ASSERT_OK(pool.Allocate(77777, &p));
+    pool.Deallocate(p);
+  });
+  first.join();
+  std::thread second([&pool]() {
+    void *p = nullptr;
+    ASSERT_OK(pool.Allocate(77777, &p));
+    pool.Deallocate(p);
+  });
+  second.join();
+  ASSERT_EQ(pool.SystemAllocations(), 5);
+}
+
+TEST_F(MindDataTestRecyclePool, TestProcessCap) {
+  const size_t block_size = static_cast<size_t>(1) << 30;
+  const size_t cached = RecyclePool::ProcessCachedBytes();
+  RecyclePool pool(4 * RecyclePool::kMaxProcessCachedBytes);
+  // the blocks are not touched, only their headers
+  const size_t num_blocks = (RecyclePool::kMaxProcessCachedBytes - cached) / block_size + 1;
+  std::vector<void *> blocks(num_blocks, nullptr);
+  for (auto &block : blocks) {
+    ASSERT_OK(pool.Allocate(block_size, &block));
+  }
+  for (auto &block : blocks) {
+    pool.Deallocate(block);
+  }
+  // the thread cache has room for all of them, the process does not
+  ASSERT_LE(RecyclePool::ProcessCachedBytes(), RecyclePool::kMaxProcessCachedBytes);
+  ASSERT_GT(RecyclePool::ProcessCachedBytes() + block_size, RecyclePool::kMaxProcessCachedBytes);
+  for (auto &block : blocks) {
+    ASSERT_OK(pool.Allocate(block_size, &block));
+  }
+  ASSERT_EQ(pool.SystemAllocations(), num_blocks + 1);
+  for (auto &block : blocks) {
+    pool.Deallocate(block);
+  }
+}
+
+TEST_F(MindDataTestRecyclePool, TestDestroyPool) {
+  const size_t cached = RecyclePool::ProcessCachedBytes();
+  {
+    RecyclePool pool;
+    void *p = nullptr;
+    ASSERT_OK(pool.Allocate(1024 * 1024, &p));
+    pool.Deallocate(p);
+    std::thread other([&pool]() {
+      void *q = nullptr;
+      ASSERT_OK(pool.Allocate(4096, &q));
+      pool.Deallocate(q);
+    });
+    other.join();
+    ASSERT_GT(RecyclePool::ProcessCachedBytes(), cached);
+  }
+  // the blocks cached by a thread which is still alive go back to the system with the pool
+  ASSERT_EQ(RecyclePool::ProcessCachedBytes(), cached);
+
+  // and the thread drops the cache of the destroyed pool once it uses another pool
+  RecyclePool pool;
+  void *p = nullptr;
+  ASSERT_OK(pool.Allocate(1024 * 1024, &p));
+  pool.Deallocate(p);
+  ASSERT_OK(pool.Allocate(1024 * 1024, &p));
+  ASSERT_EQ(pool.SystemAllocations(), 1);
+  pool.Deallocate(p);
+}
@@ -0,0 +1,229 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_queue.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestRingQueue : public UT::Common {
+ public:
+  MindDataTestRingQueue() {}
+};
+
+namespace {
+// Push rows_per_producer rows from each producer thread and pop them all from one consumer thread. Each row holds
+// its producer and its sequence number, in its id and in its tensors, and is checked to come out whole and in the
+// order its producer pushed it.
+template <typename Q>
+void CheckRows(Q *que, int32_t num_producers, int64_t rows_per_producer) {
+  std::vector<std::thread> producers;
+  for (int32_t p = 0; p < num_producers; p++) {
+    producers.emplace_back([que, p, rows_per_producer]() {
+      for (int64_t i = 0; i < rows_per_producer; i++) {
+        std::shared_ptr<Tensor> producer;
+        std::shared_ptr<Tensor> seq;
+        EXPECT_TRUE(Tensor::CreateScalar<int32_t>(p, &producer).IsOk());
+        EXPECT_TRUE(Tensor::CreateScalar<int64_t>(i, &seq).IsOk());
+        EXPECT_TRUE(que->Add(TensorRow(p * rows_per_producer + i, {producer, seq})).IsOk());
+      }
+    });
+  }
+  std::vector<int64_t> next_seq(num_producers, 0);
+  TensorRow out;
+  for (int64_t i = 0; i < num_producers * rows_per_producer; i++) {
+    ASSERT_TRUE(que->PopFront(&out).IsOk());
+    ASSERT_EQ(out.size(), 2);
+    int32_t producer = -1;
+    int64_t seq = -1;
+    ASSERT_TRUE(out[0]->GetItemAt(&producer, {}).IsOk());
+    ASSERT_TRUE(out[1]->GetItemAt(&seq, {}).IsOk());
+    ASSERT_TRUE(producer >= 0 && producer < num_producers);
+    ASSERT_EQ(seq, next_seq[producer]);
+    ASSERT_EQ(out.getId(), producer * rows_per_producer + seq);
+    next_seq[producer]++;
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  ASSERT_EQ(next_seq, std::vector<int64_t>(num_producers, rows_per_producer));
+  ASSERT_TRUE(que->empty());
+}
+
+// Push the same row rows_per_producer times from each producer thread, pop them all from one consumer thread.
+// @return the number of rows per second through the queue.
+template <typename Q>
+double RunRows(Q *que, int32_t num_producers, int64_t rows_per_producer) {
+  std::shared_ptr<Tensor> t;
+  EXPECT_TRUE(Tensor::CreateScalar<int64_t>(1, &t).IsOk());
+  TensorRow row(0, {t});
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (int32_t p = 0; p < num_producers; p++) {
+    producers.emplace_back([que, row, rows_per_producer]() {
+      for (int64_t i = 0; i < rows_per_producer; i++) {
+        EXPECT_TRUE(que->Add(row).IsOk());
+      }
+    });
+  }
+  TensorRow out;
+  int64_t num_popped = 0;
+  for (int64_t i = 0; i < num_producers * rows_per_producer; i++) {
+    EXPECT_TRUE(que->PopFront(&out).IsOk());
+    EXPECT_EQ(out.size(), 1);
+    num_popped++;
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(num_popped, num_producers * rows_per_producer);
+  EXPECT_TRUE(que->empty());
+  return num_popped / elapsed.count();
+}
+}  // namespace
+
+TEST_F(MindDataTestRingQueue, TestSpscOrder) {
+  SpscQueue<std::unique_ptr<int>> que(3);
+  const int num_elements = 10000;
+  std::thread producer([&que]() {
+    for (int i = 0; i < num_elements; i++) {
+      EXPECT_TRUE(que.Add(std::make_unique<int>(i)).IsOk());
+    }
+  });
+  std::unique_ptr<int> v;
+  for (int i = 0; i < num_elements; i++) {
+    ASSERT_TRUE(que.PopFront(&v).IsOk());
+    ASSERT_EQ(*v, i);
+  }
+  producer.join();
+  ASSERT_TRUE(que.empty());
+}
+
+TEST_F(MindDataTestRingQueue, TestMpmcSum) {
+  MpmcQueue<int64_t> que(8);
+  const int32_t num_threads = 4;
+  const int64_t num_elements = 10000;
+  std::atomic<int64_t> sum(0);
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&que, &sum]() {
+      int64_t v = 0;
+      for (int64_t j = 0; j < num_elements; j++) {
+        EXPECT_TRUE(que.PopFront(&v).IsOk());
+        sum += v;
+      }
+    });
+    threads.emplace_back([&que]() {
+      for (int64_t j = 1; j <= num_elements; j++) {
+        EXPECT_TRUE(que.Add(j).IsOk());
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(sum, num_threads * num_elements * (num_elements + 1) / 2);
+}
+
+TEST_F(MindDataTestRingQueue, TestResize) {
+  MpmcQueue<int> que(4);
+  for (int i = 1; i <= 3; i++) {
+    ASSERT_TRUE(que.Add(i).IsOk());
+  }
+  // The queue never shrinks below the elements it holds
+  ASSERT_TRUE(que.Resize(1).IsOk());
+  ASSERT_EQ(que.capacity(), 3);
+  // Growing beyond the ring chains a new ring, the elements of the old one come out first
+  ASSERT_TRUE(que.Resize(10).IsOk());
+  ASSERT_EQ(que.capacity(), 10);
+  for (int i = 4; i <= 10; i++) {
+    ASSERT_TRUE(que.Add(i).IsOk());
+  }
+  ASSERT_EQ(que.size(), 10);
+  int v = 0;
+  for (int i = 1; i <= 5; i++) {
+    ASSERT_TRUE(que.PopFront(&v).IsOk());
+    ASSERT_EQ(v, i);
+  }
+  ASSERT_EQ(que.size(), 5);
+  ASSERT_TRUE(que.Add(11).IsOk());
+  que.Reset();
+  ASSERT_TRUE(que.empty());
+}
+
+// Rows keep their order while the queue grows under a running producer and consumer
+TEST_F(MindDataTestRingQueue, TestGrowWhileInUse) {
+  SpscQueue<TensorRow> spsc_queue(2);
+  MpmcQueue<TensorRow> mpmc_queue(2);
+  std::atomic<bool> done(false);
+  std::thread resizer([&spsc_queue, &mpmc_queue, &done]() {
+    for (size_t sz = 4; sz <= 64 && !done; sz *= 2) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      EXPECT_TRUE(spsc_queue.Resize(sz).IsOk());
+      EXPECT_TRUE(mpmc_queue.Resize(sz).IsOk());
+    }
+  });
+  CheckRows(&spsc_queue, 1, 20000);
+  CheckRows(&mpmc_queue, 4, 5000);
+  done = true;
+  resizer.join();
+}
+
+// TensorRows keep their content and their order through many wraparounds of a small ring
+TEST_F(MindDataTestRingQueue, TestRowsWraparound) {
+  const int32_t capacity = 3;
+  const int64_t num_rows = 6000;
+  SpscQueue<TensorRow> spsc_queue(capacity);
+  CheckRows(&spsc_queue, 1, num_rows);
+  for (int32_t num_producers : {1, 4}) {
+    MpmcQueue<TensorRow> mpmc_queue(capacity);
+    CheckRows(&mpmc_queue, num_producers, num_rows / num_producers);
+  }
+}
+
+// Not a pass/fail test, compares the rows per second passing through the mutex based Queue and the ring queues.
+TEST_F(MindDataTestRingQueue, TestRowsPerSecond) {
+  const int32_t capacity = 16;
+  const int64_t num_rows = 200000;
+  for (int32_t num_producers : {1, 4, 8}) {
+    Queue<TensorRow> queue(capacity);
+    MpmcQueue<TensorRow> mpmc_queue(capacity);
+    double queue_rate = RunRows(&queue, num_producers, num_rows / num_producers);
+    double mpmc_rate = RunRows(&mpmc_queue, num_producers, num_rows / num_producers);
+    MS_LOG(INFO) << num_producers << " producer(s): Queue " << queue_rate << " rows/s, MpmcQueue " << mpmc_rate
+                 << " rows/s.";
+  }
+  Queue<TensorRow> queue(capacity);
+  SpscQueue<TensorRow> spsc_queue(capacity);
+  double queue_rate = RunRows(&queue, 1, num_rows);
+  double spsc_rate = RunRows(&spsc_queue, 1, num_rows);
+  MS_LOG(INFO) << "1 producer: Queue " << queue_rate << " rows/s, SpscQueue " << spsc_rate << " rows/s.";
+}
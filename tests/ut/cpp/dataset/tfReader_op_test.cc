@@ -13,12 +13,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/engine/datasetops/source/tf_record_index.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
@@ -731,3 +736,116 @@ TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   TFReaderOp::CountTotalRows(&total_rows, filenames, 729, true);
   ASSERT_EQ(total_rows, 60);
 }
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordIndexSidecar) {
+  // Copy the file, the sidecar file is written next to it
+  std::string tf_file = "tf_record_index_test.data";
+  std::string sidecar = tf_file + TFRecordIndex::kSuffix;
+  {
+    std::ifstream in(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    std::ofstream out(tf_file, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  (void)remove(sidecar.c_str());
+
+  // Too few records to be cached by default
+  std::shared_ptr<TFRecordIndex> index;
+  ASSERT_OK(TFRecordIndex::Load(tf_file, &index));
+  ASSERT_EQ(index->NumRecords(), 12);
+  ASSERT_FALSE(std::ifstream(sidecar).good());
+
+  ASSERT_OK(TFRecordIndex::Load(tf_file, &index, 0));
+  ASSERT_TRUE(std::ifstream(sidecar).good());
+  std::vector<uint64_t> offsets;
+  std::vector<uint64_t> lengths;
+  for (int64_t i = 0; i < index->NumRecords(); i++) {
+    offsets.push_back(index->DataOffset(i));
+    lengths.push_back(index->DataLength(i));
+  }
+
+  // Loaded from the sidecar file
+  std::shared_ptr<TFRecordIndex> cached_index;
+  ASSERT_OK(TFRecordIndex::Load(tf_file, &cached_index, 0));
+  ASSERT_EQ(cached_index->NumRecords(), 12);
+  ASSERT_EQ(cached_index->file_size(), index->file_size());
+  for (int64_t i = 0; i < cached_index->NumRecords(); i++) {
+    EXPECT_EQ(cached_index->DataOffset(i), offsets[i]);
+    EXPECT_EQ(cached_index->DataLength(i), lengths[i]);
+  }
+
+  (void)remove(sidecar.c_str());
+  (void)remove(tf_file.c_str());
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordIndexTruncatedFile) {
+  std::string tf_file = "tf_record_index_truncated.data";
+  {
+    std::ifstream in(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(tf_file, std::ios::binary | std::ios::trunc);
+    out << content.substr(0, content.size() - 1);
+  }
+  std::shared_ptr<TFRecordIndex> index;
+  ASSERT_ERROR(TFRecordIndex::Load(tf_file, &index, 0));
+  (void)remove(tf_file.c_str());
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFRecordIndexStaleSidecar) {
+  std::string tf_file = "tf_record_index_stale.data";
+  std::string sidecar = tf_file + TFRecordIndex::kSuffix;
+  {
+    std::ifstream in(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    std::ofstream out(tf_file, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  std::shared_ptr<TFRecordIndex> index;
+  ASSERT_OK(TFRecordIndex::Load(tf_file, &index, 0));
+  ASSERT_TRUE(std::ifstream(sidecar).good());
+
+  // A corrupt offset fails the checksum of the sidecar file, the file is indexed again
+  {
+    std::fstream io(sidecar, std::ios::in | std::ios::out | std::ios::binary);
+    io.seekp(7 * sizeof(uint64_t));
+    io.put(1);
+  }
+  std::shared_ptr<TFRecordIndex> reindexed;
+  ASSERT_OK(TFRecordIndex::Load(tf_file, &reindexed, TFRecordIndex::kNoCache));
+  ASSERT_EQ(reindexed->NumRecords(), index->NumRecords());
+  for (int64_t i = 0; i < index->NumRecords(); i++) {
+    EXPECT_EQ(reindexed->DataOffset(i), index->DataOffset(i));
+    EXPECT_EQ(reindexed->DataLength(i), index->DataLength(i));
+  }
+
+  // A file rewritten with the same size, within the same second
+  ASSERT_OK(TFRecordIndex::Load(tf_file, &index, 0));
+  struct stat file_stat;
+  ASSERT_EQ(stat(tf_file.c_str(), &file_stat), 0);
+  struct timespec times[2] = {file_stat.st_atim, file_stat.st_mtim};
+  times[1].tv_nsec = times[1].tv_nsec == 0 ? 1 : times[1].tv_nsec - 1;
+  ASSERT_EQ(utimensat(AT_FDCWD, tf_file.c_str(), times, 0), 0);
+  ASSERT_OK(TFRecordIndex::Load(tf_file, &reindexed, TFRecordIndex::kNoCache));
+  ASSERT_EQ(reindexed->NumRecords(), index->NumRecords());
+
+  (void)remove(sidecar.c_str());
+  (void)remove(tf_file.c_str());
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTotalRowsWritesNoSidecar) {
+  // Enough records to be cached when the file is read, but counting rows never writes next to the dataset
+  std::string tf_file = "tf_record_index_count.data";
+  std::string sidecar = tf_file + TFRecordIndex::kSuffix;
+  {
+    std::ifstream in(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(tf_file, std::ios::binary | std::ios::trunc);
+    for (int i = 0; i < 86; i++) {
+      out << content;
+    }
+  }
+  (void)remove(sidecar.c_str());
+  int64_t total_rows = 0;
+  ASSERT_OK(TFReaderOp::CountTotalRows(&total_rows, {tf_file}, 1));
+  ASSERT_EQ(total_rows, 12 * 86);
+  ASSERT_FALSE(std::ifstream(sidecar).good());
+  (void)remove(tf_file.c_str());
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#undef private
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class CPUSimpleMemPlanTest : public UT::Common {
+ public:
+  CPUSimpleMemPlanTest() = default;
+
+  void AddBlock(size_t size, size_t first_step, size_t last_step) {
+    mem_plan_.mem_blocks_.push_back({nullptr, size, first_step, last_step, 0});
+  }
+
+  // Place the blocks with reuse and check it against the plan without reuse.
+  void CheckPlace() {
+    size_t naive_size = mem_plan_.PlaceMemBlocks(false);
+    size_t planned_size = mem_plan_.PlaceMemBlocks(true);
+    EXPECT_LE(planned_size, naive_size);
+    const auto &blocks = mem_plan_.mem_blocks_;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      EXPECT_EQ(blocks[i].offset % 64, 0);
+      EXPECT_LE(blocks[i].offset + blocks[i].size, planned_size);
+      for (size_t j = i + 1; j < blocks.size(); ++j) {
+        bool alive_together =
+          blocks[i].first_step <= blocks[j].last_step && blocks[j].first_step <= blocks[i].last_step;
+        bool share_memory = blocks[i].offset < blocks[j].offset + blocks[j].size &&
+                            blocks[j].offset < blocks[i].offset + blocks[i].size;
+        EXPECT_FALSE(alive_together && share_memory) << "blocks " << i << " and " << j;
+      }
+    }
+  }
+
+  CPUSimpleMemPlan mem_plan_;
+};
+
+// A chain of kernels, each output is read by the next kernel only, so every other output shares memory.
+TEST_F(CPUSimpleMemPlanTest, chain) {
+  const size_t steps = 8;
+  for (size_t step = 0; step < steps; ++step) {
+    AddBlock(1000, step, step + 1);
+  }
+  CheckPlace();
+  EXPECT_EQ(mem_plan_.PlaceMemBlocks(true), 2 * 1024);
+  EXPECT_EQ(mem_plan_.PlaceMemBlocks(false), steps * 1024);
+}
+
+// A block alive during a step does not share memory with the workspace of that step, even at the edges.
+TEST_F(CPUSimpleMemPlanTest, touching_lifetimes) {
+  AddBlock(100, 0, 2);
+  AddBlock(300, 2, 2);
+  AddBlock(200, 2, 4);
+  AddBlock(100, 3, 4);
+  AddBlock(500, 5, 5);
+  CheckPlace();
+  // The block of step 5 reuses the memory of all the others.
+  EXPECT_EQ(mem_plan_.mem_blocks_[4].offset, 0);
+}
+
+TEST_F(CPUSimpleMemPlanTest, random_lifetimes) {
+  std::mt19937 rng(2021);
+  std::uniform_int_distribution<size_t> size_dist(1, 10000);
+  std::uniform_int_distribution<size_t> step_dist(0, 50);
+  std::uniform_int_distribution<size_t> span_dist(0, 10);
+  for (int round = 0; round < 10; ++round) {
+    mem_plan_.mem_blocks_.clear();
+    for (int i = 0; i < 200; ++i) {
+      size_t first_step = step_dist(rng);
+      // Some blocks are graph outputs and live until the end.
+      size_t last_step = i % 20 == 0 ? 51 : first_step + span_dist(rng);
+      AddBlock(size_dist(rng), first_step, last_step);
+    }
+    CheckPlace();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class BroadcastPatternTest : public UT::Common {
+ public:
+  BroadcastPatternTest() = default;
+
+  // Compare BroadcastLaunch over several uneven ranges with the per element BroadcastIterator walk.
+  void CheckLaunch(const std::vector<size_t> &shape_a, const std::vector<size_t> &shape_b,
+                   const std::vector<size_t> &output_shape) {
+    size_t size_a = 1;
+    size_t size_b = 1;
+    size_t output_size = 1;
+    for (auto dim : shape_a) {
+      size_a *= dim;
+    }
+    for (auto dim : shape_b) {
+      size_b *= dim;
+    }
+    for (auto dim : output_shape) {
+      output_size *= dim;
+    }
+    std::vector<float> a(size_a);
+    std::vector<float> b(size_b);
+    for (size_t i = 0; i < size_a; ++i) {
+      a[i] = static_cast<float>(i);
+    }
+    for (size_t i = 0; i < size_b; ++i) {
+      b[i] = static_cast<float>(i) * 0.5f;
+    }
+    std::vector<float> expect(output_size);
+    BroadcastIterator iter(shape_a, shape_b, output_shape);
+    for (size_t i = 0; i < output_size; ++i) {
+      expect[i] = a[iter.GetInputPosA()] * 3 - b[iter.GetInputPosB()];
+      iter.GenNextPos();
+    }
+
+    auto pattern = CPUKernelUtils::GetBroadcastPattern(shape_a, shape_b, output_shape);
+    auto loop = MakeElementwiseLoop<float, float>([](float x, float y) { return x * 3 - y; });
+    std::vector<float> output(output_size);
+    const size_t step = 5;
+    for (size_t start = 0; start < output_size; start += step) {
+      BroadcastLaunch(pattern, a.data(), b.data(), output.data(), loop, start, std::min(start + step, output_size));
+    }
+    EXPECT_EQ(output, expect);
+  }
+};
+
+TEST_F(BroadcastPatternTest, classify_pattern) {
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({2, 3, 4}, {2, 3, 4}, {2, 3, 4}).type, BROADCAST_SAME_SHAPE);
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({1}, {2, 3, 4}, {2, 3, 4}).type, BROADCAST_SCALAR_A);
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({2, 3, 4}, {}, {2, 3, 4}).type, BROADCAST_SCALAR_B);
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({3, 4}, {2, 3, 4}, {2, 3, 4}).type, BROADCAST_ROW_A);
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({2, 3, 4}, {1, 1, 4}, {2, 3, 4}).type, BROADCAST_ROW_B);
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({2, 3, 1}, {2, 3, 4}, {2, 3, 4}).type, BROADCAST_COLUMN_A);
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({2, 3, 4}, {2, 1, 1}, {2, 3, 4}).type, BROADCAST_COLUMN_B);
+  EXPECT_EQ(CPUKernelUtils::GetBroadcastPattern({2, 1, 4}, {1, 3, 1}, {2, 3, 4}).type, BROADCAST_GENERAL);
+
+  auto pattern = CPUKernelUtils::GetBroadcastPattern({2, 3, 4}, {3, 4}, {2, 3, 4});
+  EXPECT_EQ(pattern.inner_size, 12u);
+  EXPECT_EQ(pattern.output_shape, std::vector<size_t>({2, 12}));
+}
+
+TEST_F(BroadcastPatternTest, launch_matches_iterator) {
+  CheckLaunch({2, 3, 4}, {2, 3, 4}, {2, 3, 4});
+  CheckLaunch({1}, {2, 3, 4}, {2, 3, 4});
+  CheckLaunch({2, 3, 4}, {1}, {2, 3, 4});
+  CheckLaunch({1, 3, 4}, {2, 3, 4}, {2, 3, 4});
+  CheckLaunch({2, 3, 4}, {4}, {2, 3, 4});
+  CheckLaunch({2, 3, 1}, {2, 3, 4}, {2, 3, 4});
+  CheckLaunch({2, 3, 4}, {2, 1, 1}, {2, 3, 4});
+  CheckLaunch({2, 1, 4}, {1, 3, 1}, {2, 3, 4});
+  CheckLaunch({5, 1, 3, 1}, {1, 2, 3, 4}, {5, 2, 3, 4});
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class ReduceCpuKernelTest : public UT::Common {
+ public:
+  ReduceCpuKernelTest() = default;
+
+  AddressPtr CreateKernelAddress(void *addr, size_t elem_num) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = elem_num * sizeof(float);
+    return kernel_addr;
+  }
+
+  // Reduce the (outer, reduce, inner) input over its middle axis with the kernel.
+  std::vector<float> Reduce(bool is_max, const std::vector<size_t> &shape, const std::vector<int64_t> &axis,
+                            std::vector<float> input, size_t output_size) {
+    ReduceCPUKernel<float> kernel;
+    kernel.input_shape_ = shape;
+    kernel.axis_ = axis;
+    kernel.reduce_type_ = is_max ? ReduceCPUKernel<float>::kReduceMax : ReduceCPUKernel<float>::kReduceMin;
+    kernel.InitReduceShape();
+    std::vector<float> output(output_size);
+    std::vector<AddressPtr> inputs = {CreateKernelAddress(input.data(), input.size())};
+    std::vector<AddressPtr> outputs = {CreateKernelAddress(output.data(), output.size())};
+    EXPECT_TRUE(kernel.Launch(inputs, {}, outputs));
+    return output;
+  }
+
+  // The running reduction over the middle axis, input first as in std::max(input, acc).
+  std::vector<float> RunningReduce(bool is_max, size_t outer, size_t reduce, size_t inner,
+                                   const std::vector<float> &input) {
+    std::vector<float> output(outer * inner);
+    for (size_t i = 0; i < outer; ++i) {
+      for (size_t k = 0; k < inner; ++k) {
+        float acc = input[i * reduce * inner + k];
+        for (size_t j = 1; j < reduce; ++j) {
+          float value = input[(i * reduce + j) * inner + k];
+          acc = is_max ? std::max(value, acc) : std::min(value, acc);
+        }
+        output[i * inner + k] = acc;
+      }
+    }
+    return output;
+  }
+
+  void ExpectSame(const std::vector<float> &expected, const std::vector<float> &output) {
+    ASSERT_EQ(expected.size(), output.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      if (std::isnan(expected[i])) {
+        EXPECT_TRUE(std::isnan(output[i])) << "at " << i;
+      } else {
+        EXPECT_EQ(expected[i], output[i]) << "at " << i;
+      }
+    }
+  }
+
+  // Rows of several lengths, plain, with a NaN as the first and with a NaN as the last element.
+  std::vector<float> CreateInput(size_t outer, size_t reduce, size_t inner) {
+    std::vector<float> input(outer * reduce * inner);
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<float>((i * 7919) % 1009) - 500.0f;
+    }
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (size_t k = 0; k < inner; ++k) {
+      if (outer > 1) {
+        input[reduce * inner + k] = nan;
+      }
+      if (outer > 2) {
+        input[(3 * reduce - 1) * inner + k] = nan;
+      }
+    }
+    return input;
+  }
+};
+
+// Inner axis rows of these lengths go through the eight lane accumulators, ending in every lane.
+TEST_F(ReduceCpuKernelTest, inner_axis_nan) {
+  for (size_t reduce : {3, 16, 17, 23, 33, 40, 4099}) {
+    const size_t outer = 4;
+    auto input = CreateInput(outer, reduce, 1);
+    for (bool is_max : {true, false}) {
+      auto output = Reduce(is_max, {outer, reduce}, {1}, input, outer);
+      ExpectSame(RunningReduce(is_max, outer, reduce, 1, input), output);
+      EXPECT_TRUE(std::isnan(output[2]));
+      EXPECT_FALSE(std::isnan(output[1]));
+    }
+  }
+}
+
+TEST_F(ReduceCpuKernelTest, middle_axis_nan) {
+  const size_t outer = 3;
+  const size_t reduce = 20;
+  const size_t inner = 5;
+  auto input = CreateInput(outer, reduce, inner);
+  for (bool is_max : {true, false}) {
+    auto output = Reduce(is_max, {outer, reduce, inner}, {1}, input, outer * inner);
+    ExpectSame(RunningReduce(is_max, outer, reduce, inner, input), output);
+  }
+}
+
+// A full reduction combines the per block results, a NaN in the last element of the last block shows up.
+TEST_F(ReduceCpuKernelTest, full_reduce_nan) {
+  const size_t size = 3 * 4096 + 5;
+  std::vector<float> input = CreateInput(1, size, 1);
+  for (bool is_max : {true, false}) {
+    ExpectSame(RunningReduce(is_max, 1, size, 1, input), Reduce(is_max, {size}, {0}, input, 1));
+  }
+  input.back() = std::numeric_limits<float>::quiet_NaN();
+  for (bool is_max : {true, false}) {
+    auto output = Reduce(is_max, {size}, {0}, input, 1);
+    EXPECT_TRUE(std::isnan(output[0]));
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_column_index.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardColumnIndex : public UT::Common {
+ public:
+  TestShardColumnIndex() {}
+};
+
+TEST_F(TestShardColumnIndex, SaveAndLoad) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumnIndex: save and load");
+  std::string shard_file = "./column_index_test.mindrecord";
+  {
+    std::ofstream out(shard_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    out << "mindrecord";
+  }
+
+  ShardColumnIndex writer;
+  writer.AddColumn("label", ":label_0", "INTEGER");
+  writer.AddColumn("score", ":score_0", "NUMERIC");
+  writer.AddColumn("file_name", ":file_name_0", "TEXT");
+  // rows are placed by ROW_ID, not by the order they are added in
+  for (int row_id : {1, 0, 2}) {
+    std::vector<std::tuple<std::string, std::string, std::string>> row_data = {
+      {":ROW_ID", "INTEGER", std::to_string(row_id)},
+      {":ROW_GROUP_ID", "INTEGER", std::to_string(row_id / 2)},
+      {":PAGE_ID_RAW", "INTEGER", "0"},
+      {":PAGE_OFFSET_RAW", "INTEGER", std::to_string(row_id * 16)},
+      {":PAGE_OFFSET_RAW_END", "INTEGER", std::to_string(row_id * 16 + 16)},
+      {":PAGE_ID_BLOB", "INTEGER", "1"},
+      {":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(row_id * 100)},
+      {":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(row_id * 100 + 100)},
+      {":INC_0", "INTEGER", "0"},
+      {":label_0", "INTEGER", std::to_string(-row_id)},
+      {":score_0", "NUMERIC", std::to_string(row_id * 0.5)},
+      {":file_name_0", "TEXT", "image_" + std::to_string(row_id) + ".jpg"}};
+    ASSERT_EQ(writer.AddRow(row_data), SUCCESS);
+  }
+  ASSERT_EQ(writer.Save(shard_file), SUCCESS);
+
+  ShardColumnIndex reader;
+  ASSERT_EQ(reader.Load(shard_file), SUCCESS);
+  ASSERT_EQ(reader.GetRowCount(), 3u);
+  int label = reader.GetColumnId("label");
+  int score = reader.GetColumnId("score");
+  int file_name = reader.GetColumnId("file_name");
+  ASSERT_EQ(reader.GetColumnId("data"), -1);
+  ASSERT_EQ(reader.GetColumnType(label), ShardColumnIndex::kColumnInt64);
+  ASSERT_EQ(reader.GetColumnType(score), ShardColumnIndex::kColumnFloat64);
+  ASSERT_EQ(reader.GetColumnType(file_name), ShardColumnIndex::kColumnString);
+  for (uint64_t row_id = 0; row_id < 3; ++row_id) {
+    ASSERT_EQ(reader.GetMeta(ShardColumnIndex::kRowGroupId, row_id), row_id / 2);
+    ASSERT_EQ(reader.GetMeta(ShardColumnIndex::kPageOffsetRawEnd, row_id), row_id * 16 + 16);
+    ASSERT_EQ(reader.GetMeta(ShardColumnIndex::kPageOffsetBlob, row_id), row_id * 100);
+    ASSERT_EQ(reader.GetInt64(label, row_id), -static_cast<int64_t>(row_id));
+    ASSERT_DOUBLE_EQ(reader.GetFloat64(score, row_id), row_id * 0.5);
+    ASSERT_EQ(reader.GetString(file_name, row_id), "image_" + std::to_string(row_id) + ".jpg");
+  }
+
+  // An index built for another version of the shard file is ignored
+  {
+    std::ofstream out(shard_file, std::ios::out | std::ios::binary | std::ios::app);
+    out << "appended";
+  }
+  ShardColumnIndex stale_reader;
+  ASSERT_EQ(stale_reader.Load(shard_file), FAILED);
+
+  (void)remove(shard_file.c_str());
+  (void)remove((shard_file + kColumnIndexSuffix).c_str());
+}
+
+TEST_F(TestShardColumnIndex, StaleModificationTime) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumnIndex: shard file rewritten to the same size");
+  std::string shard_file = "./column_index_mtime_test.mindrecord";
+  {
+    std::ofstream out(shard_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    out << "mindrecord";
+  }
+  ShardColumnIndex writer;
+  ASSERT_EQ(writer.Save(shard_file), SUCCESS);
+  ShardColumnIndex reader;
+  ASSERT_EQ(reader.Load(shard_file), SUCCESS);
+
+  struct timespec times[2] = {{0, UTIME_OMIT}, {1000000000, 0}};
+  ASSERT_EQ(utimensat(AT_FDCWD, shard_file.c_str(), times, 0), 0);
+  ShardColumnIndex stale_reader;
+  ASSERT_EQ(stale_reader.Load(shard_file), FAILED);
+
+  (void)remove(shard_file.c_str());
+  (void)remove((shard_file + kColumnIndexSuffix).c_str());
+}
+
+TEST_F(TestShardColumnIndex, CorruptStringOffsets) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumnIndex: string offsets out of the characters fail the load");
+  std::string shard_file = "./column_index_corrupt_test.mindrecord";
+  std::string index_file = shard_file + kColumnIndexSuffix;
+  {
+    std::ofstream out(shard_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    out << "mindrecord";
+  }
+  ShardColumnIndex writer;
+  writer.AddColumn("file_name", ":file_name_0", "TEXT");
+  for (int row_id : {0, 1}) {
+    std::vector<std::tuple<std::string, std::string, std::string>> row_data = {
+      {":ROW_ID", "INTEGER", std::to_string(row_id)},
+      {":ROW_GROUP_ID", "INTEGER", "0"},
+      {":PAGE_ID_RAW", "INTEGER", "0"},
+      {":PAGE_OFFSET_RAW", "INTEGER", "0"},
+      {":PAGE_OFFSET_RAW_END", "INTEGER", "16"},
+      {":PAGE_OFFSET_BLOB", "INTEGER", "0"},
+      {":PAGE_OFFSET_BLOB_END", "INTEGER", "100"},
+      {":file_name_0", "TEXT", "image_" + std::to_string(row_id) + ".jpg"}};
+    ASSERT_EQ(writer.AddRow(row_data), SUCCESS);
+  }
+
+  // header, type and name of the field, 6 meta arrays, then the string offsets of the 2 rows
+  const uint64_t offsets_pos = 6 + 2 + 2 + 6 * 2;
+  auto load_with_word = [&](uint64_t pos, uint64_t value) {
+    EXPECT_EQ(writer.Save(shard_file), SUCCESS);
+    {
+      std::fstream index(index_file, std::ios::in | std::ios::out | std::ios::binary);
+      index.seekp(static_cast<std::streamoff>(pos * sizeof(uint64_t)));
+      index.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+    ShardColumnIndex reader;
+    return reader.Load(shard_file);
+  };
+  ASSERT_EQ(load_with_word(offsets_pos, 0), SUCCESS);
+  ASSERT_EQ(load_with_word(offsets_pos, 5), FAILED);
+  ASSERT_EQ(load_with_word(offsets_pos + 1, 1000), FAILED);
+  ASSERT_EQ(load_with_word(offsets_pos + 2, 1000), FAILED);
+  ASSERT_EQ(load_with_word(offsets_pos + 2, UINT64_MAX), FAILED);
+
+  // a truncated index misses some of the characters
+  ASSERT_EQ(writer.Save(shard_file), SUCCESS);
+  ASSERT_EQ(truncate(index_file.c_str(), (offsets_pos + 4) * sizeof(uint64_t)), 0);
+  ShardColumnIndex reader;
+  ASSERT_EQ(reader.Load(shard_file), FAILED);
+
+  (void)remove(shard_file.c_str());
+  (void)remove(index_file.c_str());
+}
+
+TEST_F(TestShardColumnIndex, MalformedValue) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumnIndex: malformed values fail the row");
+  auto make_row = [](const std::string &row_id, const std::string &page_offset, const std::string &label,
+                     const std::string &score) {
+    return std::vector<std::tuple<std::string, std::string, std::string>>{
+      {":ROW_ID", "INTEGER", row_id},
+      {":ROW_GROUP_ID", "INTEGER", "0"},
+      {":PAGE_ID_RAW", "INTEGER", "0"},
+      {":PAGE_OFFSET_RAW", "INTEGER", page_offset},
+      {":PAGE_OFFSET_RAW_END", "INTEGER", "16"},
+      {":PAGE_OFFSET_BLOB", "INTEGER", "0"},
+      {":PAGE_OFFSET_BLOB_END", "INTEGER", "100"},
+      {":label_0", "INTEGER", label},
+      {":score_0", "NUMERIC", score}};
+  };
+  ShardColumnIndex writer;
+  writer.AddColumn("label", ":label_0", "INTEGER");
+  writer.AddColumn("score", ":score_0", "NUMERIC");
+  ASSERT_EQ(writer.AddRow(make_row("0", "0", "-1", "0.5")), SUCCESS);
+  ASSERT_EQ(writer.AddRow(make_row("", "0", "1", "0.5")), FAILED);
+  ASSERT_EQ(writer.AddRow(make_row("-1", "0", "1", "0.5")), FAILED);
+  ASSERT_EQ(writer.AddRow(make_row("1x", "0", "1", "0.5")), FAILED);
+  ASSERT_EQ(writer.AddRow(make_row("1", "99999999999999999999999", "1", "0.5")), FAILED);
+  ASSERT_EQ(writer.AddRow(make_row("1", "0", "label", "0.5")), FAILED);
+  ASSERT_EQ(writer.AddRow(make_row("1", "0", "1", "0.5.5")), FAILED);
+  ASSERT_EQ(writer.AddRow(make_row("1", "0", "1", "")), FAILED);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_column.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardColumn : public UT::Common {
+ public:
+  TestShardColumn() {}
+};
+
+TEST_F(TestShardColumn, ScalarRowRoundTrip) {
+  MS_LOG(INFO) << FormatInfo("Test ShardColumn: encode and decode scalar row");
+  json schema_json = R"({"schema": {"label": {"type": "int32"}, "id": {"type": "int64"},
+                                    "score": {"type": "float32"}, "file_name": {"type": "string"},
+                                    "data": {"type": "bytes"}},
+                         "blob_fields": ["data"]})"_json;
+  ShardColumn shard_column(schema_json, false);
+  json row_json = R"({"label": -3, "id": 4294967296, "score": 0.5, "file_name": "image_3.jpg"})"_json;
+  ScalarRow scalar_row;
+  ASSERT_EQ(shard_column.EncodeScalarRow(row_json, &scalar_row), SUCCESS);
+  ASSERT_EQ(shard_column.DecodeScalarRow(scalar_row), row_json);
+
+  const unsigned char *data = nullptr;
+  std::unique_ptr<unsigned char[]> data_ptr;
+  uint64_t n_bytes = 0;
+  ColumnDataType column_data_type = ColumnNoDataType;
+  uint64_t column_data_type_size = 0;
+  std::vector<int64_t> column_shape;
+  ASSERT_EQ(shard_column.GetColumnValueFromRow("label", {}, scalar_row, &data, &data_ptr, &n_bytes, &column_data_type,
+                                               &column_data_type_size, &column_shape),
+            SUCCESS);
+  int32_t label = 0;
+  ASSERT_EQ(n_bytes, sizeof(label));
+  (void)memcpy(&label, data, sizeof(label));
+  ASSERT_EQ(label, -3);
+  ASSERT_EQ(shard_column.GetColumnValueFromRow("file_name", {}, scalar_row, &data, &data_ptr, &n_bytes,
+                                               &column_data_type, &column_data_type_size, &column_shape),
+            SUCCESS);
+  ASSERT_EQ(std::string(data, data + n_bytes), "image_3.jpg");
+
+  // a column which is not in the row is reported when it is read
+  ScalarRow partial_row;
+  ASSERT_EQ(shard_column.SetScalarFloat("score", 1.25, &partial_row), FAILED);
+  shard_column.InitScalarRow(&partial_row);
+  ASSERT_EQ(shard_column.SetScalarFloat("score", 1.25, &partial_row), SUCCESS);
+  ASSERT_EQ(shard_column.SetScalarInt("label", static_cast<int64_t>(1) << 40, &partial_row), FAILED);
+  ASSERT_EQ(shard_column.GetColumnValueFromRow("label", {}, partial_row, &data, &data_ptr, &n_bytes,
+                                               &column_data_type, &column_data_type_size, &column_shape),
+            FAILED);
+  ASSERT_EQ(shard_column.DecodeScalarRow(partial_row), R"({"score": 1.25})"_json);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -1136,5 +1136,72 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
   }
 }
 
+TEST_F(TestShardWriter, TestShardWriterStreaming) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test write imageNet in streaming mode"));
+
+  // load binary data
+  std::vector<std::vector<uint8_t>> bin_data;
+  std::vector<std::string> filenames;
+  ASSERT_NE(-1, mindrecord::GetAbsoluteFiles("./data/mindrecord/testImageNetData/images", filenames));
+  ASSERT_NE(-1, mindrecord::Img2DataUint8(filenames, bin_data));
+
+  // init shardHeader
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  std::vector<std::pair<uint64_t, std::string>> fields = {std::make_pair(anno_schema_id, "label")};
+  header_data.AddIndexFields(fields);
+
+  // load  meta data
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+  ASSERT_EQ(annotations.size(), bin_data.size());
+
+  std::vector<std::string> file_names = {"./streaming.shard01", "./streaming.shard02"};
+  mindrecord::ShardWriter fw;
+  ASSERT_EQ(fw.Open(file_names), SUCCESS);
+  ASSERT_EQ(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)), SUCCESS);
+  ASSERT_EQ(fw.SetStreamingMode(true), SUCCESS);
+
+  // write in batches of 3 rows, more than the streaming queue holds
+  const size_t batch_size = 3;
+  for (size_t start = 0; start < annotations.size(); start += batch_size) {
+    size_t end = std::min(start + batch_size, annotations.size());
+    std::map<std::uint64_t, std::vector<json>> rawdatas;
+    rawdatas[anno_schema_id] = std::vector<json>(annotations.begin() + start, annotations.begin() + end);
+    std::vector<std::vector<uint8_t>> batch_data(bin_data.begin() + start, bin_data.begin() + end);
+    ASSERT_EQ(fw.WriteRawData(rawdatas, batch_data), SUCCESS);
+  }
+  ASSERT_EQ(fw.Commit(), SUCCESS);
+
+  mindrecord::ShardIndexGenerator sg{file_names[0]};
+  sg.Build();
+  ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({file_names[0]}, true, 4), SUCCESS);
+  dataset.Launch();
+  size_t count = 0;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      ASSERT_FALSE(std::get<0>(j).empty());
+      ASSERT_TRUE(std::get<1>(j).find("label") != std::get<1>(j).end());
+      count++;
+    }
+  }
+  ASSERT_EQ(count, annotations.size());
+  dataset.Close();
+  for (const auto &filename : file_names) {
+    auto filename_db = filename + ".db";
+    remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename + kColumnIndexSuffix));
+    remove(common::SafeCStr(filename));
+  }
+}
+
 }  // namespace mindrecord
 }  // namespace mindspore
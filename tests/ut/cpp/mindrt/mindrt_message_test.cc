@@ -0,0 +1,268 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actormgr.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kActorThreadNum = 4;
+constexpr size_t kSenderNum = 4;
+constexpr size_t kMessageNum = 20000;
+constexpr size_t kPingPongRounds = 2000;
+constexpr size_t kHoldRounds = 100;
+constexpr size_t kBenchMessageNum = 1000000;
+constexpr size_t kBenchRounds = 100000;
+
+class SinkActor : public ActorBase {
+ public:
+  explicit SinkActor(const std::string &name) : ActorBase(name) {}
+  ~SinkActor() override = default;
+
+  void Receive(size_t value) {
+    sum_ += value;
+    (void)count_.fetch_add(1, std::memory_order_release);
+  }
+
+  size_t count() const { return count_.load(std::memory_order_acquire); }
+  size_t sum() const { return sum_; }
+
+ private:
+  size_t sum_{0};
+  std::atomic<size_t> count_{0};
+};
+
+class PingPongActor : public ActorBase {
+ public:
+  explicit PingPongActor(const std::string &name) : ActorBase(name) {}
+  ~PingPongActor() override = default;
+
+  void set_peer(const AID &peer) { peer_ = peer; }
+
+  void Ping(size_t rounds) {
+    ++hops_;
+    if (rounds == 0) {
+      done_.store(true, std::memory_order_release);
+      return;
+    }
+    Async(peer_, &PingPongActor::Ping, rounds - 1);
+  }
+
+  bool done() const { return done_.load(std::memory_order_acquire); }
+  size_t hops() const { return hops_; }
+
+ private:
+  AID peer_;
+  size_t hops_{0};
+  std::atomic_bool done_{false};
+};
+
+// Holds its actor thread in every run until the sink it readied has run, which only another actor thread can do.
+class HoldActor : public ActorBase {
+ public:
+  explicit HoldActor(const std::string &name) : ActorBase(name) {}
+  ~HoldActor() override = default;
+
+  void set_sink(const std::shared_ptr<SinkActor> &sink) { sink_ = sink; }
+  // Start holding once all the messages are queued, so that every run has messages queued behind it.
+  void release() { released_.store(true, std::memory_order_release); }
+
+  void Hold(size_t round) {
+    if (stuck_ || !SpinUntil([this]() { return released_.load(std::memory_order_acquire); })) {
+      return;
+    }
+    Async(sink_->GetAID(), &SinkActor::Receive, round);
+    (void)SpinUntil([this, round]() { return sink_->count() > round; });
+  }
+
+  void Done() { done_.store(true, std::memory_order_release); }
+
+  bool done() const { return done_.load(std::memory_order_acquire); }
+  bool stuck() const { return stuck_; }
+
+ private:
+  template <typename Pred>
+  bool SpinUntil(Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pred()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        stuck_ = true;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::shared_ptr<SinkActor> sink_;
+  std::atomic_bool released_{false};
+  bool stuck_{false};
+  std::atomic_bool done_{false};
+};
+
+template <typename T>
+std::shared_ptr<T> SpawnActor(const std::string &name, ActorThreadPool *pool, bool share_thread = true) {
+  auto actor = std::make_shared<T>(name);
+  auto base_actor = static_cast<ActorReference>(actor);
+  base_actor->set_thread_pool(pool);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(base_actor, share_thread);
+  return actor;
+}
+
+// Wait until the messages sent have run, a lost message fails the test instead of hanging it.
+template <typename Pred>
+bool WaitFor(Pred pred) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+double SecondsSince(const std::chrono::steady_clock::time_point &start) {
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}  // namespace
+
+class TestMindrtMessage : public UT::Common {
+ public:
+  TestMindrtMessage() = default;
+
+  void SetUp() override {
+    pool_ = ActorThreadPool::CreateThreadPool(kActorThreadNum);
+    ASSERT_NE(pool_, nullptr);
+  }
+
+  void TearDown() override {
+    ActorMgr::GetActorMgrRef()->Finalize();
+    delete pool_;
+    pool_ = nullptr;
+  }
+
+ protected:
+  ActorThreadPool *pool_{nullptr};
+};
+
+// Send messages to one actor from several threads at once, every message runs exactly once.
+TEST_F(TestMindrtMessage, test_many_senders) {
+  auto sink = SpawnActor<SinkActor>("SinkActor", pool_);
+  std::vector<std::thread> senders;
+  for (size_t i = 0; i < kSenderNum; ++i) {
+    senders.emplace_back([&sink]() {
+      for (size_t j = 0; j < kMessageNum / kSenderNum; ++j) {
+        Async(sink->GetAID(), &SinkActor::Receive, j);
+      }
+    });
+  }
+  for (auto &sender : senders) {
+    sender.join();
+  }
+  const size_t per_sender = kMessageNum / kSenderNum;
+  const size_t total = per_sender * kSenderNum;
+  ASSERT_TRUE(WaitFor([&sink, total]() { return sink->count() >= total; }));
+  EXPECT_EQ(sink->count(), total);
+  EXPECT_EQ(sink->sum(), kSenderNum * (per_sender * (per_sender - 1) / 2));
+}
+
+// Bounce a message between two actors, each one runs every other hop and the last hop lands on the first actor.
+TEST_F(TestMindrtMessage, test_ping_pong) {
+  auto ping = SpawnActor<PingPongActor>("PingActor", pool_);
+  auto pong = SpawnActor<PingPongActor>("PongActor", pool_);
+  ping->set_peer(pong->GetAID());
+  pong->set_peer(ping->GetAID());
+  Async(ping->GetAID(), &PingPongActor::Ping, 2 * kPingPongRounds);
+  ASSERT_TRUE(WaitFor([&ping]() { return ping->done(); }));
+  EXPECT_FALSE(pong->done());
+  EXPECT_EQ(ping->hops(), kPingPongRounds + 1);
+  EXPECT_EQ(pong->hops(), kPingPongRounds);
+}
+
+// The ping actor keeps an actor thread of its own, the pong actor it readies there runs on the other actor threads.
+TEST_F(TestMindrtMessage, test_ping_pong_single_thread) {
+  auto ping = SpawnActor<PingPongActor>("SingleThreadPingActor", pool_, false);
+  auto pong = SpawnActor<PingPongActor>("SingleThreadPongActor", pool_);
+  ping->set_peer(pong->GetAID());
+  pong->set_peer(ping->GetAID());
+  Async(ping->GetAID(), &PingPongActor::Ping, 2 * kPingPongRounds);
+  ASSERT_TRUE(WaitFor([&ping]() { return ping->done(); }));
+  EXPECT_EQ(ping->hops(), kPingPongRounds + 1);
+  EXPECT_EQ(pong->hops(), kPingPongRounds);
+}
+
+// An actor readied by a long run with more messages queued behind it is stolen by another actor thread, instead of
+// waiting for the end of the run on the actor thread it was readied on.
+TEST_F(TestMindrtMessage, test_steal_from_long_run) {
+  auto hold = SpawnActor<HoldActor>("HoldActor", pool_);
+  auto sink = SpawnActor<SinkActor>("HoldSinkActor", pool_);
+  hold->set_sink(sink);
+  for (size_t round = 0; round < kHoldRounds; ++round) {
+    Async(hold->GetAID(), &HoldActor::Hold, round);
+  }
+  Async(hold->GetAID(), &HoldActor::Done);
+  hold->release();
+  ASSERT_TRUE(WaitFor([&hold]() { return hold->done(); }));
+  EXPECT_FALSE(hold->stuck());
+  EXPECT_EQ(sink->count(), kHoldRounds);
+  EXPECT_EQ(sink->sum(), kHoldRounds * (kHoldRounds - 1) / 2);
+}
+
+// Not a pass/fail test beyond the message counts, measures the messages per second which several threads send to one
+// actor, and the latency of a message bounced between two actors, where every hop waits for the previous one.
+TEST_F(TestMindrtMessage, test_message_rate) {
+  auto sink = SpawnActor<SinkActor>("RateSinkActor", pool_);
+  const size_t per_sender = kBenchMessageNum / kSenderNum;
+  const size_t total = per_sender * kSenderNum;
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> senders;
+  for (size_t i = 0; i < kSenderNum; ++i) {
+    senders.emplace_back([&sink, per_sender]() {
+      for (size_t j = 0; j < per_sender; ++j) {
+        Async(sink->GetAID(), &SinkActor::Receive, j);
+      }
+    });
+  }
+  for (auto &sender : senders) {
+    sender.join();
+  }
+  ASSERT_TRUE(WaitFor([&sink, total]() { return sink->count() >= total; }));
+  double messages_per_second = total / SecondsSince(start);
+  EXPECT_EQ(sink->count(), total);
+
+  auto ping = SpawnActor<PingPongActor>("RatePingActor", pool_);
+  auto pong = SpawnActor<PingPongActor>("RatePongActor", pool_);
+  ping->set_peer(pong->GetAID());
+  pong->set_peer(ping->GetAID());
+  start = std::chrono::steady_clock::now();
+  Async(ping->GetAID(), &PingPongActor::Ping, 2 * kBenchRounds);
+  ASSERT_TRUE(WaitFor([&ping]() { return ping->done(); }));
+  double us_per_message = SecondsSince(start) * 1e6 / (ping->hops() + pong->hops());
+  EXPECT_EQ(ping->hops() + pong->hops(), 2 * kBenchRounds + 1);
+
+  MS_LOG(INFO) << kSenderNum << " senders to one actor: " << messages_per_second << " messages/s, ping pong: "
+               << us_per_message << " us per message.";
+}
+}  // namespace mindspore
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/kernel_graph.h"
+#include "utils/ms_utils.h"
+#define private public
+#define protected public
+#include "runtime/framework/graph_scheduler.h"
+#include "runtime/hardware/cpu/cpu_device_context.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+using device::DeviceContextKey;
+using device::cpu::CPUDeviceContext;
+
+class ActorChainFusionTest : public UT::Common {
+ public:
+  ActorChainFusionTest() = default;
+
+  void SetUp() override {
+    device_context_ = std::make_shared<CPUDeviceContext>(DeviceContextKey{"CPU", 0});
+    graph_ = std::make_shared<session::KernelGraph>();
+    actor_set_ = std::make_shared<ActorSet>("ActorChainFusionTest");
+  }
+
+  void TearDown() override {
+    auto &scheduler = GraphScheduler::GetInstance();
+    for (const auto &kernel_actor : kernel_actors_) {
+      (void)scheduler.actor_name_to_actor_.erase(kernel_actor->GetAID().Name());
+    }
+    (void)common::SetEnv("MS_ACTOR_CHAIN_FUSION", "");
+  }
+
+  // Add a kernel actor which gets the output of each input kernel actor by a data arrow.
+  size_t AddKernel(const std::vector<size_t> &inputs) {
+    size_t index = kernel_actors_.size();
+    auto kernel = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>("ActorChainFusionTest"))});
+    auto name = "ActorChainFusionTest/kernel-" + std::to_string(index);
+    kernel->set_fullname_with_scope(name);
+    auto kernel_actor = std::make_shared<KernelActor>(name, kernel, device_context_.get(),
+                                                      AID("ActorChainFusionTestMemory"), nullptr, nullptr,
+                                                      GraphExecutionStrategy::kPipeline);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      kernel_actors_[inputs[i]]->output_data_arrows_.emplace_back(
+        std::make_shared<DataArrow>(0, kernel_actor->GetAID(), SizeToInt(i)));
+      kernel_actor->input_data_arrow_aids_.emplace_back(kernel_actors_[inputs[i]]->GetAID());
+    }
+    kernel_actor->input_datas_num_ = inputs.size();
+
+    GraphScheduler::GetInstance().actor_name_to_actor_[name] = kernel_actor.get();
+    actor_set_->kernel_actors_.emplace_back(kernel_actor);
+    kernel_actors_.emplace_back(kernel_actor);
+    return index;
+  }
+
+  void AddControl(size_t from, size_t to) {
+    kernel_actors_[from]->output_control_arrows_.emplace_back(kernel_actors_[to]->GetAID());
+    kernel_actors_[to]->input_control_arrow_aids_.emplace_back(kernel_actors_[from]->GetAID());
+    ++kernel_actors_[to]->input_controls_num_;
+  }
+
+  void Fuse() {
+    GraphCompilerInfo graph_compiler_info({graph_}, {device_context_.get()}, {}, {}, {}, {}, nullptr, {}, 0,
+                                          "ActorChainFusionTest", GraphExecutionStrategy::kPipeline);
+    GraphScheduler::GetInstance().FuseKernelActorChains(actor_set_.get(), graph_compiler_info);
+  }
+
+  KernelActor *FusedActor(size_t index) const { return kernel_actors_[index]->fused_actor_; }
+
+  KernelActor *Actor(size_t index) const { return kernel_actors_[index].get(); }
+
+  std::shared_ptr<CPUDeviceContext> device_context_;
+  std::shared_ptr<session::KernelGraph> graph_;
+  ActorSetPtr actor_set_;
+  std::vector<KernelActorPtr> kernel_actors_;
+};
+
+// Every actor of a linear chain calls the next one directly, except the last one which sends no data.
+TEST_F(ActorChainFusionTest, LinearChain) {
+  auto first = AddKernel({});
+  auto second = AddKernel({first});
+  auto third = AddKernel({second});
+  auto last = AddKernel({third});
+  Fuse();
+  EXPECT_EQ(FusedActor(first), Actor(second));
+  EXPECT_EQ(FusedActor(second), Actor(third));
+  EXPECT_EQ(FusedActor(third), Actor(last));
+  EXPECT_EQ(FusedActor(last), nullptr);
+}
+
+// The fused actor is run without its mailbox, so an actor with more than one input data or with an input control,
+// which another thread may send at the same time, is never fused.
+TEST_F(ActorChainFusionTest, NotFusedInputs) {
+  auto left = AddKernel({});
+  auto right = AddKernel({});
+  auto join = AddKernel({left, right});
+  auto controlled = AddKernel({join});
+  auto controller = AddKernel({});
+  AddControl(controller, controlled);
+  auto next = AddKernel({controlled});
+  Fuse();
+  EXPECT_EQ(FusedActor(left), nullptr);
+  EXPECT_EQ(FusedActor(right), nullptr);
+  // The join sends its only data to an actor with an input control.
+  EXPECT_EQ(FusedActor(join), nullptr);
+  EXPECT_EQ(FusedActor(controller), nullptr);
+  // The actor after the controlled one has only one input data, so it is still fused.
+  EXPECT_EQ(FusedActor(controlled), Actor(next));
+}
+
+// An actor sending more than one data, or sending a control, keeps sending them by messages.
+TEST_F(ActorChainFusionTest, NotFusedOutputs) {
+  auto source = AddKernel({});
+  (void)AddKernel({source});
+  (void)AddKernel({source});
+  auto controller = AddKernel({});
+  (void)AddKernel({controller});
+  auto controlled = AddKernel({});
+  AddControl(controller, controlled);
+  Fuse();
+  EXPECT_EQ(FusedActor(source), nullptr);
+  EXPECT_EQ(FusedActor(controller), nullptr);
+}
+
+TEST_F(ActorChainFusionTest, DisabledByEnv) {
+  (void)common::SetEnv("MS_ACTOR_CHAIN_FUSION", "0");
+  auto first = AddKernel({});
+  auto second = AddKernel({first});
+  (void)AddKernel({second});
+  Fuse();
+  for (const auto &kernel_actor : kernel_actors_) {
+    EXPECT_EQ(kernel_actor->fused_actor_, nullptr);
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "abstract/abstract_value.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "ir/tensor.h"
+#include "runtime/device/cpu/cpu_memory_manager.h"
+#include "runtime/device/kernel_info.h"
+#define private public
+#define protected public
+#include "runtime/framework/actor/data_source_actor.h"
+#include "runtime/framework/actor/memory_manager_actor.h"
+#include "runtime/hardware/cpu/cpu_device_context.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+using device::DeviceContextKey;
+using device::cpu::CPUDeviceContext;
+using device::cpu::CPUMemoryManager;
+using tensor::Tensor;
+
+class HostQueueDataSourceActorTest : public UT::Common {
+ public:
+  HostQueueDataSourceActorTest() = default;
+
+  void SetUp() override {
+    device_context_ = std::make_shared<CPUDeviceContext>(DeviceContextKey{"CPU", 0});
+    device_context_->mem_manager_ = std::make_shared<CPUMemoryManager>();
+    host_queue_ = std::make_shared<HostTensorQueue>();
+    // The messages to the memory manager go nowhere, the test calls it in their place.
+    actor_ = std::make_shared<HostQueueDataSourceActor>("HostQueueDataSourceActorTest", 1,
+                                                        AID("HostQueueDataSourceActorTestMemory"), nullptr, nullptr,
+                                                        host_queue_);
+    graph_ = std::make_shared<session::KernelGraph>();
+  }
+
+  // Add a float32 data node on CPU, its device tensor has no memory yet and is used once per step.
+  void AddDataNode(const ShapeVector &shape) {
+    auto parameter = graph_->add_parameter();
+    parameter->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    parameter->set_kernel_info(std::make_shared<device::KernelInfo>());
+    auto device_address =
+      device_context_->CreateDeviceAddress(nullptr, kSize * sizeof(float), kOpFormat_DEFAULT, kNumberTypeFloat32);
+    device_address->set_original_ref_count(1);
+    device_address->ResetRefCount();
+    AnfAlgo::SetOutputAddr(device_address, 0, parameter.get());
+    actor_->data_nodes_.emplace_back(parameter);
+    actor_->device_contexts_.emplace_back(device_context_.get());
+  }
+
+  template <typename T>
+  std::shared_ptr<Tensor> CreateHostTensor(TypeId type, T first) {
+    auto tensor = std::make_shared<Tensor>(type, ShapeVector{kRows, kCols});
+    auto data = static_cast<T *>(tensor->data_c());
+    for (int64_t i = 0; i < kSize; ++i) {
+      data[i] = first + static_cast<T>(i);
+    }
+    return tensor;
+  }
+
+  // The actor side of a step up to the launch of the kernels: fetch the data, allocate the memory, fill the data.
+  bool FetchData() {
+    OpContext<DeviceTensor> op_context;
+    std::vector<Promise<int>> result(1);
+    op_context.sequential_num_ = nullptr;
+    op_context.results_ = &result;
+    actor_->FetchData(&op_context);
+    memory_manager_.AllocateMemory(&actor_->buffers_.back(), device_context_.get(), &op_context, actor_->GetAID());
+    actor_->OnMemoryAllocFinish(&op_context);
+    auto result_future = result[0].GetFuture();
+    return result_future.IsOK();
+  }
+
+  // The free of the memory of the step, once its kernels are done.
+  void FreeMemory() {
+    OpContext<DeviceTensor> op_context;
+    memory_manager_.FreeMemory(&actor_->buffers_.front(), device_context_.get(), &op_context);
+  }
+
+  DeviceTensor *GetDeviceTensor(size_t index) {
+    return AnfAlgo::GetMutableOutputAddr(actor_->data_nodes_[index], 0, false).get();
+  }
+
+  static constexpr int64_t kRows = 2;
+  static constexpr int64_t kCols = 3;
+  static constexpr int64_t kSize = kRows * kCols;
+
+  std::shared_ptr<CPUDeviceContext> device_context_;
+  HostTensorQueuePtr host_queue_;
+  std::shared_ptr<HostQueueDataSourceActor> actor_;
+  std::shared_ptr<session::KernelGraph> graph_;
+  MemoryManagerActor memory_manager_;
+};
+
+// The memory of a host tensor is used in place, and the host tensor lives until the next step has fetched its data.
+TEST_F(HostQueueDataSourceActorTest, BorrowHostTensorUntilNextStep) {
+  AddDataNode({kRows, kCols});
+  actor_->Init();
+
+  auto host_tensor = CreateHostTensor<float>(kNumberTypeFloat32, 1.0f);
+  void *host_data = host_tensor->data_c();
+  std::weak_ptr<Tensor> weak_host_tensor = host_tensor;
+  host_queue_->Push({host_tensor});
+  host_tensor = nullptr;
+  ASSERT_TRUE(FetchData());
+  EXPECT_TRUE(host_queue_->IsEmpty());
+
+  // The kernels read the host memory, which is neither freed nor given back to the memory pool by the step.
+  auto device_tensor = GetDeviceTensor(0);
+  EXPECT_EQ(device_tensor->GetPtr(), host_data);
+  EXPECT_FALSE(device_tensor->from_mem_pool());
+  EXPECT_FALSE(weak_host_tensor.expired());
+  FreeMemory();
+  EXPECT_EQ(device_tensor->GetPtr(), host_data);
+  EXPECT_FALSE(weak_host_tensor.expired());
+  auto pool_data = device_context_->mem_manager_->MallocMemFromMemPool(kSize * sizeof(float));
+  EXPECT_NE(pool_data, host_data);
+  device_context_->mem_manager_->FreeMemFromMemPool(pool_data);
+  for (int64_t i = 0; i < kSize; ++i) {
+    EXPECT_EQ(static_cast<float *>(host_data)[i], 1.0f + i);
+  }
+
+  // The next step borrows its own host tensor and lets the previous one go.
+  auto next_host_tensor = CreateHostTensor<float>(kNumberTypeFloat32, 10.0f);
+  host_queue_->Push({next_host_tensor});
+  ASSERT_TRUE(FetchData());
+  EXPECT_TRUE(weak_host_tensor.expired());
+  EXPECT_EQ(device_tensor->GetPtr(), next_host_tensor->data_c());
+  FreeMemory();
+}
+
+// The data of graph outputs and of host tensors needing a conversion is still copied into memory of the pool.
+TEST_F(HostQueueDataSourceActorTest, CopyHostTensor) {
+  AddDataNode({kRows, kCols});
+  AddDataNode({kRows, kCols});
+  actor_->Init();
+  actor_->is_graph_output_[0] = true;
+
+  auto output_host_tensor = CreateHostTensor<float>(kNumberTypeFloat32, 1.0f);
+  auto double_host_tensor = CreateHostTensor<double>(kNumberTypeFloat64, 100.0);
+  host_queue_->Push({output_host_tensor, double_host_tensor});
+  ASSERT_TRUE(FetchData());
+  EXPECT_TRUE(actor_->borrowed_host_tensors_[0] == nullptr);
+  EXPECT_TRUE(actor_->borrowed_host_tensors_[1] == nullptr);
+
+  auto device_tensor = GetDeviceTensor(1);
+  ASSERT_NE(device_tensor->GetPtr(), nullptr);
+  EXPECT_NE(device_tensor->GetPtr(), double_host_tensor->data_c());
+  EXPECT_TRUE(device_tensor->from_mem_pool());
+  for (int64_t i = 0; i < kSize; ++i) {
+    EXPECT_EQ(static_cast<float *>(device_tensor->GetMutablePtr())[i], 100.0f + i);
+  }
+  FreeMemory();
+  EXPECT_EQ(device_tensor->GetPtr(), nullptr);
+}
+}  // namespace runtime
+}  // namespace mindspore
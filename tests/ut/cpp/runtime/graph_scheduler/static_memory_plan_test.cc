@@ -0,0 +1,242 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "runtime/device/cpu/cpu_memory_manager.h"
+#define private public
+#define protected public
+#include "runtime/framework/graph_scheduler.h"
+#include "runtime/hardware/cpu/cpu_device_context.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace runtime {
+using device::DeviceContextKey;
+using device::cpu::CPUDeviceContext;
+using device::cpu::CPUMemoryManager;
+
+class StaticMemoryPlanTest : public UT::Common {
+ public:
+  StaticMemoryPlanTest() = default;
+
+  void SetUp() override {
+    device_context_ = std::make_shared<CPUDeviceContext>(DeviceContextKey{"CPU", 0});
+    device_context_->mem_manager_ = std::make_shared<CPUMemoryManager>();
+    graph_ = std::make_shared<session::KernelGraph>();
+    actor_set_ = std::make_shared<ActorSet>("StaticMemoryPlanTest");
+  }
+
+  void TearDown() override {
+    auto &scheduler = GraphScheduler::GetInstance();
+    for (const auto &kernel_actor : kernel_actors_) {
+      (void)scheduler.actor_name_to_actor_.erase(kernel_actor->GetAID().Name());
+    }
+    for (const auto &memory_block : actor_set_->static_memory_blocks_) {
+      device_context_->FreeMemory(memory_block.get());
+    }
+  }
+
+  // Add a kernel with one output and an optional workspace, its actor gets the output of each input kernel by a data
+  // arrow. The kernels are added in a topological order.
+  size_t AddKernel(const std::vector<size_t> &inputs, size_t output_size, size_t workspace_size = 0) {
+    size_t index = kernel_actors_.size();
+    auto kernel = graph_->NewCNode({NewValueNode(std::make_shared<Primitive>("StaticMemoryPlanTest"))});
+    auto name = "StaticMemoryPlanTest/kernel-" + std::to_string(index);
+    kernel->set_fullname_with_scope(name);
+    auto kernel_actor = std::make_shared<KernelActor>(name, kernel, device_context_.get(),
+                                                      AID("StaticMemoryPlanTestMemory"), nullptr, nullptr,
+                                                      GraphExecutionStrategy::kPipeline);
+
+    ancestors_.emplace_back();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      auto input = inputs[i];
+      kernel_actors_[input]->output_data_arrows_.emplace_back(
+        std::make_shared<DataArrow>(0, kernel_actor->GetAID(), SizeToInt(i)));
+      kernel_actor->input_data_arrow_aids_.emplace_back(kernel_actors_[input]->GetAID());
+      tensors_[output_tensor_[input]].users.emplace_back(index);
+      ancestors_[index].insert(ancestors_[input].begin(), ancestors_[input].end());
+      ancestors_[index].insert(input);
+    }
+
+    auto output = device_context_->CreateDeviceAddress(nullptr, output_size, kOpFormat_DEFAULT, kNumberTypeUInt8);
+    AnfAlgo::SetOutputAddr(output, 0, kernel.get());
+    output_tensor_.emplace_back(tensors_.size());
+    tensors_.push_back({output.get(), {index}});
+    if (workspace_size > 0) {
+      auto workspace =
+        device_context_->CreateDeviceAddress(nullptr, workspace_size, kOpFormat_DEFAULT, kNumberTypeUInt8);
+      AnfAlgo::SetWorkspaceAddr(workspace, 0, kernel.get());
+      workspace_tensor_.emplace_back(tensors_.size());
+      tensors_.push_back({workspace.get(), {index}});
+    } else {
+      workspace_tensor_.emplace_back(SIZE_MAX);
+    }
+
+    GraphScheduler::GetInstance().actor_name_to_actor_[name] = kernel_actor.get();
+    actor_set_->kernel_actors_.emplace_back(kernel_actor);
+    kernel_actors_.emplace_back(kernel_actor);
+    execution_order_.emplace_back(kernel);
+    return index;
+  }
+
+  void Plan() {
+    graph_->set_execution_order(execution_order_);
+    GraphScheduler::GetInstance().BuildStaticMemoryPlan(actor_set_.get(), graph_, device_context_.get());
+  }
+
+  // All the kernels using the former tensor are ancestors of the kernel writing the latter one.
+  bool IsUsedBeforeWritten(size_t former, size_t latter) {
+    const auto &writer_ancestors = ancestors_[tensors_[latter].users.front()];
+    for (auto user : tensors_[former].users) {
+      if (writer_ancestors.count(user) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool IsSharedMemory(size_t a, size_t b) {
+    auto a_ptr = static_cast<const uint8_t *>(tensors_[a].device_tensor->GetPtr());
+    auto b_ptr = static_cast<const uint8_t *>(tensors_[b].device_tensor->GetPtr());
+    return a_ptr < b_ptr + tensors_[b].device_tensor->GetSize() && b_ptr < a_ptr + tensors_[a].device_tensor->GetSize();
+  }
+
+  // Every tensor is planned, and two tensors share memory only if the actor DAG orders all the uses of one of them
+  // before the other one is written. Return the number of pairs sharing memory.
+  size_t CheckPlan() {
+    EXPECT_EQ(actor_set_->static_memory_blocks_.size(), 1);
+    size_t shared_pairs = 0;
+    for (size_t i = 0; i < tensors_.size(); ++i) {
+      EXPECT_NE(tensors_[i].device_tensor->GetPtr(), nullptr) << "tensor " << i;
+      if (tensors_[i].device_tensor->GetPtr() == nullptr) {
+        return 0;
+      }
+      EXPECT_EQ(tensors_[i].device_tensor->ref_count(), SIZE_MAX) << "tensor " << i;
+    }
+    for (size_t i = 0; i < tensors_.size(); ++i) {
+      for (size_t j = i + 1; j < tensors_.size(); ++j) {
+        if (IsSharedMemory(i, j)) {
+          ++shared_pairs;
+          EXPECT_TRUE(IsUsedBeforeWritten(i, j) || IsUsedBeforeWritten(j, i)) << "tensors " << i << " and " << j;
+        }
+      }
+    }
+    return shared_pairs;
+  }
+
+  struct TestTensor {
+    DeviceTensor *device_tensor;
+    // The kernels using the tensor, the first one writes it.
+    std::vector<size_t> users;
+  };
+
+  std::shared_ptr<CPUDeviceContext> device_context_;
+  std::shared_ptr<session::KernelGraph> graph_;
+  ActorSetPtr actor_set_;
+  std::vector<KernelActorPtr> kernel_actors_;
+  std::vector<CNodePtr> execution_order_;
+  std::vector<std::set<size_t>> ancestors_;
+  std::vector<TestTensor> tensors_;
+  std::vector<size_t> output_tensor_;
+  std::vector<size_t> workspace_tensor_;
+};
+
+// Two parallel branches run concurrently, so none of their tensors share memory, while the tensors of a chain reuse
+// the memory of the tensors read by their ancestors.
+TEST_F(StaticMemoryPlanTest, ParallelBranches) {
+  auto source = AddKernel({}, 4096);
+  auto left = AddKernel({source}, 1024, 2048);
+  auto left_next = AddKernel({left}, 1024, 2048);
+  auto right = AddKernel({source}, 1024, 2048);
+  auto join = AddKernel({left_next, right}, 4096);
+  auto chain = AddKernel({join}, 4096);
+  auto chain_next = AddKernel({chain}, 4096);
+  (void)AddKernel({chain_next}, 4096);
+  Plan();
+  EXPECT_GT(CheckPlan(), 0);
+
+  for (auto left_kernel : {left, left_next}) {
+    for (auto tensor : {output_tensor_[left_kernel], workspace_tensor_[left_kernel]}) {
+      EXPECT_FALSE(IsSharedMemory(tensor, output_tensor_[right]));
+      EXPECT_FALSE(IsSharedMemory(tensor, workspace_tensor_[right]));
+    }
+  }
+  // The source output is read by both branches, only the join and the kernels after it may reuse its memory.
+  for (auto branch_kernel : {left, left_next, right}) {
+    EXPECT_FALSE(IsSharedMemory(output_tensor_[source], workspace_tensor_[branch_kernel]));
+  }
+
+  size_t total_size = 0;
+  for (const auto &tensor : tensors_) {
+    total_size += tensor.device_tensor->GetSize();
+  }
+  EXPECT_LT(actor_set_->static_memory_blocks_[0]->GetSize(), total_size);
+}
+
+// The workspaces of the kernels fanned out from one kernel are all alive together.
+TEST_F(StaticMemoryPlanTest, FanOut) {
+  const size_t branch_num = 8;
+  const size_t workspace_size = 1024;
+  auto source = AddKernel({}, 512);
+  std::vector<size_t> branches;
+  for (size_t i = 0; i < branch_num; ++i) {
+    branches.emplace_back(AddKernel({source}, 512, workspace_size));
+  }
+  (void)AddKernel(branches, 512);
+  Plan();
+  (void)CheckPlan();
+  for (size_t i = 0; i < branch_num; ++i) {
+    for (size_t j = i + 1; j < branch_num; ++j) {
+      EXPECT_FALSE(IsSharedMemory(workspace_tensor_[branches[i]], workspace_tensor_[branches[j]]));
+      EXPECT_FALSE(IsSharedMemory(output_tensor_[branches[i]], workspace_tensor_[branches[j]]));
+    }
+  }
+  EXPECT_GE(actor_set_->static_memory_blocks_[0]->GetSize(), branch_num * workspace_size);
+}
+
+// The device tensors outlive the actor set, which gives them back their reference counts and drops their addresses
+// in the memory block before the block is freed.
+TEST_F(StaticMemoryPlanTest, DestroyActorSet) {
+  auto source = AddKernel({}, 1024);
+  auto middle = AddKernel({source}, 1024, 512);
+  (void)AddKernel({middle}, 1024);
+  tensors_[output_tensor_[source]].device_tensor->set_original_ref_count(2);
+  std::vector<size_t> original_ref_counts;
+  for (const auto &tensor : tensors_) {
+    original_ref_counts.emplace_back(tensor.device_tensor->original_ref_count());
+  }
+  Plan();
+  (void)CheckPlan();
+
+  // Keep the memory blocks for TearDown to free them.
+  auto memory_blocks = actor_set_->static_memory_blocks_;
+  actor_set_ = std::make_shared<ActorSet>("StaticMemoryPlanTest");
+  actor_set_->static_memory_blocks_ = memory_blocks;
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    EXPECT_EQ(tensors_[i].device_tensor->GetPtr(), nullptr) << "tensor " << i;
+    EXPECT_EQ(tensors_[i].device_tensor->original_ref_count(), original_ref_counts[i]) << "tensor " << i;
+    EXPECT_EQ(tensors_[i].device_tensor->ref_count(), original_ref_counts[i]) << "tensor " << i;
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
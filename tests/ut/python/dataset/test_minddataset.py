@@ -52,6 +52,8 @@ def add_and_remove_cv_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -67,11 +69,15 @@ def add_and_remove_cv_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
 
 
 @pytest.fixture
@@ -85,6 +91,8 @@ def add_and_remove_nlp_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(NLP_FILE_NAME, FILES_NUM)
         data = [x for x in get_nlp_data(NLP_FILE_POS, NLP_FILE_VOCAB, 10)]
         nlp_schema_json = {"id": {"type": "string"}, "label": {"type": "int32"},
@@ -107,11 +115,15 @@ def add_and_remove_nlp_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
 
 
 @pytest.fixture
@@ -125,6 +137,8 @@ def add_and_remove_nlp_compress_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(NLP_FILE_NAME, FILES_NUM)
         data = []
         for row_id in range(16):
@@ -159,11 +173,15 @@ def add_and_remove_nlp_compress_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
 
 
 def test_nlp_compress_data(add_and_remove_nlp_compress_file):
@@ -227,6 +245,8 @@ def test_cv_minddataset_writer_tutorial():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"file_name": {"type": "string"}, "label": {"type": "int32"},
@@ -239,11 +259,15 @@ def test_cv_minddataset_writer_tutorial():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
 
 
 def test_cv_minddataset_partition_tutorial(add_and_remove_cv_file):
@@ -669,10 +693,14 @@ def test_cv_minddataset_reader_two_dataset(add_and_remove_cv_file):
             os.remove(CV1_FILE_NAME)
         if os.path.exists("{}.db".format(CV1_FILE_NAME)):
             os.remove("{}.db".format(CV1_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+            os.remove("{}.idx".format(CV1_FILE_NAME))
         if os.path.exists(CV2_FILE_NAME):
             os.remove(CV2_FILE_NAME)
         if os.path.exists("{}.db".format(CV2_FILE_NAME)):
             os.remove("{}.db".format(CV2_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV2_FILE_NAME)):
+            os.remove("{}.idx".format(CV2_FILE_NAME))
         writer = FileWriter(CV1_FILE_NAME, 1)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -718,20 +746,28 @@ def test_cv_minddataset_reader_two_dataset(add_and_remove_cv_file):
             os.remove(CV1_FILE_NAME)
         if os.path.exists("{}.db".format(CV1_FILE_NAME)):
             os.remove("{}.db".format(CV1_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+            os.remove("{}.idx".format(CV1_FILE_NAME))
         if os.path.exists(CV2_FILE_NAME):
             os.remove(CV2_FILE_NAME)
         if os.path.exists("{}.db".format(CV2_FILE_NAME)):
             os.remove("{}.db".format(CV2_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV2_FILE_NAME)):
+            os.remove("{}.idx".format(CV2_FILE_NAME))
         raise error
     else:
         if os.path.exists(CV1_FILE_NAME):
             os.remove(CV1_FILE_NAME)
         if os.path.exists("{}.db".format(CV1_FILE_NAME)):
             os.remove("{}.db".format(CV1_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+            os.remove("{}.idx".format(CV1_FILE_NAME))
         if os.path.exists(CV2_FILE_NAME):
             os.remove(CV2_FILE_NAME)
         if os.path.exists("{}.db".format(CV2_FILE_NAME)):
             os.remove("{}.db".format(CV2_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV2_FILE_NAME)):
+            os.remove("{}.idx".format(CV2_FILE_NAME))
 
 
 def test_cv_minddataset_reader_two_dataset_partition(add_and_remove_cv_file):
@@ -743,6 +779,8 @@ def test_cv_minddataset_reader_two_dataset_partition(add_and_remove_cv_file):
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV1_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -778,11 +816,15 @@ def test_cv_minddataset_reader_two_dataset_partition(add_and_remove_cv_file):
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
 
 
 def test_cv_minddataset_reader_basic_tutorial(add_and_remove_cv_file):
@@ -1119,6 +1161,8 @@ def test_write_with_multi_bytes_and_array_and_read_by_MindDataset():
             os.remove("{}".format(mindrecord_file_name))
         if os.path.exists("{}.db".format(mindrecord_file_name)):
             os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
         data = [{"file_name": "001.jpg", "label": 4,
                  "image1": bytes("image1 bytes abc", encoding='UTF-8'),
                  "image2": bytes("image1 bytes def", encoding='UTF-8'),
@@ -1362,10 +1406,14 @@ def test_write_with_multi_bytes_and_array_and_read_by_MindDataset():
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_with_multi_bytes_and_MindDataset():
@@ -1543,10 +1591,14 @@ def test_write_with_multi_bytes_and_MindDataset():
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_with_multi_array_and_MindDataset():
@@ -1746,10 +1798,14 @@ def test_write_with_multi_array_and_MindDataset():
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_numpy_generic():
@@ -1761,6 +1817,8 @@ def test_numpy_generic():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         cv_schema_json = {"label1": {"type": "int32"}, "label2": {"type": "int64"},
                           "label3": {"type": "float32"}, "label4": {"type": "float64"}}
@@ -1791,11 +1849,15 @@ def test_numpy_generic():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
 
 
 def test_write_with_float32_float64_float32_array_float64_array_and_MindDataset():
@@ -1945,10 +2007,14 @@ def test_write_with_float32_float64_float32_array_float64_array_and_MindDataset(
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
 FILES = ["0.mindrecord", "1.mindrecord", "2.mindrecord", "3.mindrecord"]
 ITEMS = [10, 14, 8, 20]
@@ -1964,6 +2030,8 @@ def create_multi_mindrecord_files():
             if os.path.exists(key):
                 os.remove("{}".format(key))
                 os.remove("{}.db".format(key))
+                if os.path.exists("{}.idx".format(key)):
+                    os.remove("{}.idx".format(key))
 
             value = FILES_ITEMS[key]
             data_list = []
@@ -1984,12 +2052,16 @@ def create_multi_mindrecord_files():
             if os.path.exists(filename):
                 os.remove("{}".format(filename))
                 os.remove("{}.db".format(filename))
+                if os.path.exists("{}.idx".format(filename)):
+                    os.remove("{}.idx".format(filename))
         raise error
     else:
         for filename in FILES_ITEMS:
             if os.path.exists(filename):
                 os.remove("{}".format(filename))
                 os.remove("{}.db".format(filename))
+                if os.path.exists("{}.idx".format(filename)):
+                    os.remove("{}.idx".format(filename))
 
 def test_shuffle_with_global_infile_files(create_multi_mindrecord_files):
     datas_all = []
@@ -31,6 +31,8 @@ def create_cv_mindrecord(files_num):
         os.remove(CV_FILE_NAME)
     if os.path.exists("{}.db".format(CV_FILE_NAME)):
         os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
     writer = FileWriter(CV_FILE_NAME, files_num)
     cv_schema_json = {"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}}
     data = [{"file_name": "001.jpg", "label": 43, "data": bytes('0xffsafdafda', encoding='utf-8')}]
@@ -46,6 +48,8 @@ def create_diff_schema_cv_mindrecord(files_num):
         os.remove(CV1_FILE_NAME)
     if os.path.exists("{}.db".format(CV1_FILE_NAME)):
         os.remove("{}.db".format(CV1_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+        os.remove("{}.idx".format(CV1_FILE_NAME))
     writer = FileWriter(CV1_FILE_NAME, files_num)
     cv_schema_json = {"file_name_1": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}}
     data = [{"file_name_1": "001.jpg", "label": 43, "data": bytes('0xffsafdafda', encoding='utf-8')}]
@@ -61,6 +65,8 @@ def create_diff_page_size_cv_mindrecord(files_num):
         os.remove(CV1_FILE_NAME)
     if os.path.exists("{}.db".format(CV1_FILE_NAME)):
         os.remove("{}.db".format(CV1_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+        os.remove("{}.idx".format(CV1_FILE_NAME))
     writer = FileWriter(CV1_FILE_NAME, files_num)
     writer.set_page_size(1 << 26)  # 64MB
     cv_schema_json = {"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}}
@@ -80,6 +86,8 @@ def test_cv_lack_json():
         ds.MindDataset(CV_FILE_NAME, "no_exist.json", columns_list, num_readers)
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_lack_mindrecord():
@@ -112,6 +120,8 @@ def test_invalid_mindrecord():
 def test_minddataset_lack_db():
     create_cv_mindrecord(1)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
     columns_list = ["data", "file_name", "label"]
     num_readers = 4
     with pytest.raises(Exception, match="MindRecordOp init failed"):
@@ -140,6 +150,8 @@ def test_cv_minddataset_pk_sample_error_class_column():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_minddataset_pk_sample_exclusive_shuffle():
@@ -155,6 +167,8 @@ def test_cv_minddataset_pk_sample_exclusive_shuffle():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_minddataset_reader_different_schema():
@@ -170,8 +184,12 @@ def test_cv_minddataset_reader_different_schema():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
     os.remove(CV1_FILE_NAME)
     os.remove("{}.db".format(CV1_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+        os.remove("{}.idx".format(CV1_FILE_NAME))
 
 
 def test_cv_minddataset_reader_different_page_size():
@@ -187,8 +205,12 @@ def test_cv_minddataset_reader_different_page_size():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
     os.remove(CV1_FILE_NAME)
     os.remove("{}.db".format(CV1_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+        os.remove("{}.idx".format(CV1_FILE_NAME))
 
 
 def test_minddataset_invalidate_num_shards():
@@ -205,10 +227,14 @@ def test_minddataset_invalidate_num_shards():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_minddataset_invalidate_shard_id():
@@ -225,10 +251,14 @@ def test_minddataset_invalidate_shard_id():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_minddataset_shard_id_bigger_than_num_shard():
@@ -245,6 +275,8 @@ def test_minddataset_shard_id_bigger_than_num_shard():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
 
     with pytest.raises(Exception) as error_info:
@@ -257,10 +289,14 @@ def test_minddataset_shard_id_bigger_than_num_shard():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_minddataset_partition_num_samples_equals_0():
@@ -285,10 +321,14 @@ def test_cv_minddataset_partition_num_samples_equals_0():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+            os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_mindrecord_exception():
@@ -319,6 +359,8 @@ def test_mindrecord_exception():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 if __name__ == '__main__':
@@ -77,12 +77,16 @@ def test_cv_minddataset_reader_multi_image_and_ndarray_tutorial():
     except Exception as error:
         if os.path.exists("{}".format(CV_FILE_NAME + ".db")):
             os.remove(CV_FILE_NAME + ".db")
+        if os.path.exists(CV_FILE_NAME + ".idx"):
+            os.remove(CV_FILE_NAME + ".idx")
         if os.path.exists("{}".format(CV_FILE_NAME)):
             os.remove(CV_FILE_NAME)
         raise error
     else:
         if os.path.exists("{}".format(CV_FILE_NAME + ".db")):
             os.remove(CV_FILE_NAME + ".db")
+        if os.path.exists(CV_FILE_NAME + ".idx"):
+            os.remove(CV_FILE_NAME + ".idx")
         if os.path.exists("{}".format(CV_FILE_NAME)):
             os.remove(CV_FILE_NAME)
 
@@ -406,6 +406,8 @@ def add_and_remove_cv_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -421,11 +423,15 @@ def add_and_remove_cv_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
 
 
 def test_Mindrecord_Padded(remove_mindrecord_file):
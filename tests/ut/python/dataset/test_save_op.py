@@ -37,21 +37,29 @@ def fixture_remove():
         os.remove("{}".format(TEMP_FILE))
     if os.path.exists("{}.db".format(TEMP_FILE)):
         os.remove("{}.db".format(TEMP_FILE))
+    if os.path.exists("{}.idx".format(TEMP_FILE)):
+        os.remove("{}.idx".format(TEMP_FILE))
 
     if os.path.exists("{}".format(AUTO_FILE)):
         os.remove("{}".format(AUTO_FILE))
     if os.path.exists("{}.db".format(AUTO_FILE)):
         os.remove("{}.db".format(AUTO_FILE))
+    if os.path.exists("{}.idx".format(AUTO_FILE)):
+        os.remove("{}.idx".format(AUTO_FILE))
     yield "yield_cv_data"
     if os.path.exists("{}".format(TEMP_FILE)):
         os.remove("{}".format(TEMP_FILE))
     if os.path.exists("{}.db".format(TEMP_FILE)):
         os.remove("{}.db".format(TEMP_FILE))
+    if os.path.exists("{}.idx".format(TEMP_FILE)):
+        os.remove("{}.idx".format(TEMP_FILE))
 
     if os.path.exists("{}".format(AUTO_FILE)):
         os.remove("{}".format(AUTO_FILE))
     if os.path.exists("{}.db".format(AUTO_FILE)):
         os.remove("{}.db".format(AUTO_FILE))
+    if os.path.exists("{}.idx".format(AUTO_FILE)):
+        os.remove("{}.idx".format(AUTO_FILE))
 
 
 def test_case_00(add_remove_file):  # only bin data
@@ -366,6 +374,8 @@ def type_tester(t):
         os.remove("{}".format(AUTO_FILE))
     if os.path.exists("{}.db".format(AUTO_FILE)):
         os.remove("{}.db".format(AUTO_FILE))
+    if os.path.exists("{}.idx".format(AUTO_FILE)):
+        os.remove("{}.idx".format(AUTO_FILE))
 
 
 def test_case_04():
@@ -409,6 +419,8 @@ def test_case_07():
         os.remove("{}".format(AUTO_FILE))
     if os.path.exists("{}.db".format(AUTO_FILE)):
         os.remove("{}.db".format(AUTO_FILE))
+    if os.path.exists("{}.idx".format(AUTO_FILE)):
+        os.remove("{}.idx".format(AUTO_FILE))
     d1 = ds.TFRecordDataset(TFRECORD_FILES, shuffle=False)
     tf_data = []
     for x in d1.create_dict_iterator(num_epochs=1, output_numpy=True):
@@ -434,6 +446,8 @@ def test_case_07():
         os.remove("{}".format(AUTO_FILE))
     if os.path.exists("{}.db".format(AUTO_FILE)):
         os.remove("{}.db".format(AUTO_FILE))
+    if os.path.exists("{}.idx".format(AUTO_FILE)):
+        os.remove("{}.idx".format(AUTO_FILE))
 
 
 def generator_dynamic_1d():
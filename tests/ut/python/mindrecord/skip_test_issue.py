@@ -46,6 +46,8 @@ def test_cv_file_writer_default_shard_num():
 
     os.remove("{}".format(CV_FILE_NAME))
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_file_writer_shard_num_10():
@@ -69,6 +71,8 @@ def test_cv_file_writer_shard_num_10():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        if os.path.exists("{}.idx".format(item)):
+            os.remove("{}.idx".format(item))
 
 
 def test_cv_file_writer_file_name_none():
@@ -189,6 +193,8 @@ def test_file_writer_fail_add_index():
 
     os.remove("{}".format(file_name))
     os.remove("{}.db".format(file_name))
+    if os.path.exists("{}.idx".format(file_name)):
+        os.remove("{}.idx".format(file_name))
 
 
 def test_add_index_with_incorrect_field():
@@ -250,6 +256,8 @@ def test_mkv_file_reader_with_negative_num_consumer():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_write_raw_data_with_empty_list():
@@ -273,6 +281,8 @@ def test_write_raw_data_with_empty_list():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_issue_38():
@@ -311,6 +321,8 @@ def test_issue_39():
     reader.close()
     os.remove("{}".format(CV_FILE_NAME))
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_issue_40():
@@ -328,6 +340,8 @@ def test_issue_40():
 
     os.remove("{}".format(CV_FILE_NAME))
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_issue_73():
@@ -353,6 +367,8 @@ def test_issue_73():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_issue_117():
@@ -394,6 +410,8 @@ def test_issue_95():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
 
 
 def test_mindrecord_add_index_016():
@@ -444,6 +462,8 @@ def test_issue_118():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        if os.path.exists("{}.idx".format(item)):
+            os.remove("{}.idx".format(item))
 
 
 def test_issue_87():
@@ -512,6 +532,8 @@ def test_issue_84():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        if os.path.exists("{}.idx".format(item)):
+            os.remove("{}.idx".format(item))
 
     os.rename("imagenet.mindrecord1.db.bk", "imagenet.mindrecord1.db")
     paths = ["{}{}".format(CV_FILE_NAME, str(x).rjust(1, '0'))
@@ -519,6 +541,8 @@ def test_issue_84():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        if os.path.exists("{}.idx".format(item)):
+            os.remove("{}.idx".format(item))
 
 
 def test_issue_65():
@@ -573,6 +597,8 @@ def test_issue_124():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        if os.path.exists("{}.idx".format(item)):
+            os.remove("{}.idx".format(item))
 
 
 def test_issue_36():
@@ -611,6 +637,8 @@ def test_issue_34():
     reader.close()
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_file_writer_raw_data_038():
@@ -638,6 +666,8 @@ def test_file_writer_raw_data_038():
     if shard_num == 1:
         os.remove("test_file_writer_raw_data_")
         os.remove("test_file_writer_raw_data_.db")
+        if os.path.exists("test_file_writer_raw_data_.idx"):
+            os.remove("test_file_writer_raw_data_.idx")
         return
     for x in range(shard_num):
         n = str(x)
@@ -647,6 +677,8 @@ def test_file_writer_raw_data_038():
             os.remove("test_file_writer_raw_data_{}".format(n))
         if os.path.exists("test_file_writer_raw_data_{}.db".format(n)):
             os.remove("test_file_writer_raw_data_{}.db".format(n))
+        if os.path.exists("test_file_writer_raw_data_{}.idx".format(n)):
+            os.remove("test_file_writer_raw_data_{}.idx".format(n))
 
 
 def test_more_than_1_bytes_in_schema():
@@ -686,3 +718,5 @@ def test_shard_4_raw_data_1():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        if os.path.exists("{}.idx".format(x)):
+            os.remove("{}.idx".format(x))
@@ -40,12 +40,14 @@ def remove_multi_files(file_name, file_num):
     for x in paths:
         remove_one_file("{}".format(x))
         remove_one_file("{}.db".format(x))
+        remove_one_file("{}.idx".format(x))
 
 
 def test_write_read_process():
     mindrecord_file_name = "test.mindrecord"
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
              "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -93,12 +95,14 @@ def test_write_read_process():
 
     remove_one_file("{}".format(mindrecord_file_name))
     remove_one_file("{}.db".format(mindrecord_file_name))
+    remove_one_file("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_read_process_with_define_index_field():
     mindrecord_file_name = "test.mindrecord"
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
              "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -147,6 +151,7 @@ def test_write_read_process_with_define_index_field():
 
     remove_one_file("{}".format(mindrecord_file_name))
     remove_one_file("{}.db".format(mindrecord_file_name))
+    remove_one_file("{}.idx".format(mindrecord_file_name))
 
 
 def test_cv_file_writer_tutorial(remove_file=True):
@@ -481,6 +486,7 @@ def test_cv_file_writer_without_data():
     """test cv file writer without data."""
     remove_one_file(CV_FILE_NAME)
     remove_one_file(CV_FILE_NAME + ".db")
+    remove_one_file(CV_FILE_NAME + ".idx")
 
     writer = FileWriter(CV_FILE_NAME, 1)
     cv_schema_json = {"file_name": {"type": "string"},
@@ -497,12 +503,14 @@ def test_cv_file_writer_without_data():
     reader.close()
     remove_one_file(CV_FILE_NAME)
     remove_one_file(CV_FILE_NAME + ".db")
+    remove_one_file(CV_FILE_NAME + ".idx")
 
 
 def test_cv_file_writer_no_blob():
     """test cv file writer without blob data."""
     remove_one_file(CV_FILE_NAME)
     remove_one_file(CV_FILE_NAME + ".db")
+    remove_one_file(CV_FILE_NAME + ".idx")
 
     writer = FileWriter(CV_FILE_NAME, 1)
     data = get_data("../data/mindrecord/testImageNetData/")
@@ -522,12 +530,14 @@ def test_cv_file_writer_no_blob():
     reader.close()
     remove_one_file(CV_FILE_NAME)
     remove_one_file(CV_FILE_NAME + ".db")
+    remove_one_file(CV_FILE_NAME + ".idx")
 
 
 def test_cv_file_writer_no_raw():
     """test cv file writer without raw data."""
     remove_one_file(NLP_FILE_NAME)
     remove_one_file(NLP_FILE_NAME + ".db")
+    remove_one_file(NLP_FILE_NAME + ".idx")
 
     writer = FileWriter(NLP_FILE_NAME)
     data = list(get_nlp_data("../data/mindrecord/testAclImdbData/pos",
@@ -553,12 +563,14 @@ def test_cv_file_writer_no_raw():
     reader.close()
     remove_one_file(NLP_FILE_NAME)
     remove_one_file(NLP_FILE_NAME + ".db")
+    remove_one_file(NLP_FILE_NAME + ".idx")
 
 
 def test_write_read_process_with_multi_bytes():
     mindrecord_file_name = "test.mindrecord"
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     data = [{"file_name": "001.jpg", "label": 43,
              "image1": bytes("image1 bytes abc", encoding='UTF-8'),
@@ -681,12 +693,14 @@ def test_write_read_process_with_multi_bytes():
 
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
 
 def test_write_read_process_with_multi_array():
     mindrecord_file_name = "test.mindrecord"
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     data = [{"source_sos_ids": np.array([1, 2, 3, 4, 5], dtype=np.int64),
              "source_sos_mask": np.array([6, 7, 8, 9, 10, 11, 12], dtype=np.int64),
@@ -828,12 +842,14 @@ def test_write_read_process_with_multi_array():
 
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
 
 def test_write_read_process_with_multi_bytes_and_array():
     mindrecord_file_name = "test.mindrecord"
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     data = [{"file_name": "001.jpg", "label": 4,
              "image1": bytes("image1 bytes abc", encoding='UTF-8'),
@@ -1018,12 +1034,14 @@ def test_write_read_process_with_multi_bytes_and_array():
 
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
 
 def test_write_read_process_without_ndarray_type():
     mindrecord_file_name = "test.mindrecord"
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     # field: mask derivation type is int64, but schema type is int32
     data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9]),
@@ -1058,3 +1076,4 @@ def test_write_read_process_without_ndarray_type():
 
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
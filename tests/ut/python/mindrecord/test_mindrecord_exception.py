@@ -37,11 +37,15 @@ def remove_file(file_name):
     remove_one_file(x)
     x = file_name + ".db"
     remove_one_file(x)
+    x = file_name + ".idx"
+    remove_one_file(x)
     for i in range(FILES_NUM):
         x = file_name + str(i)
         remove_one_file(x)
         x = file_name + str(i) + ".db"
         remove_one_file(x)
+        x = file_name + str(i) + ".idx"
+        remove_one_file(x)
 
 @pytest.fixture
 def fixture_cv_file():
@@ -116,6 +120,8 @@ def test_lack_db(fixture_cv_file):
     """test file reader when db file does not exist."""
     create_cv_mindrecord(1)
     os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
     with pytest.raises(MRMOpenError) as err:
         reader = FileReader(CV_FILE_NAME)
         reader.close()
@@ -129,6 +135,8 @@ def test_lack_some_partition_and_db(fixture_cv_file):
              for x in range(FILES_NUM)]
     os.remove("{}".format(paths[3]))
     os.remove("{}.db".format(paths[3]))
+    if os.path.exists("{}.idx".format(paths[3])):
+        os.remove("{}.idx".format(paths[3]))
     with pytest.raises(MRMOpenError) as err:
         reader = FileReader(CV_FILE_NAME + "0")
         reader.close()
@@ -188,6 +196,8 @@ def test_lack_some_db(fixture_cv_file):
     paths = ["{}{}".format(CV_FILE_NAME, str(x).rjust(1, '0'))
              for x in range(FILES_NUM)]
     os.remove("{}.db".format(paths[3]))
+    if os.path.exists("{}.idx".format(paths[3])):
+        os.remove("{}.idx".format(paths[3]))
     with pytest.raises(MRMOpenError) as err:
         reader = FileReader(CV_FILE_NAME + "0")
         reader.close()
@@ -210,6 +220,8 @@ def test_invalid_db(fixture_cv_file):
     """test file reader when the content of db is illegal."""
     create_cv_mindrecord(1)
     os.remove("imagenet.mindrecord.db")
+    if os.path.exists("imagenet.mindrecord.idx"):
+        os.remove("imagenet.mindrecord.idx")
     with open('imagenet.mindrecord.db', 'w') as f:
         f.write('just for test')
     with pytest.raises(MRMOpenError) as err:
@@ -350,6 +362,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # int32  =>  np.int32
     schema = {"file_name": {"type": "string"},
@@ -365,6 +379,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # float64  =>  np.float64
     schema = {"file_name": {"type": "string"},
@@ -380,6 +396,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # int64  =>  int8
     schema = {"file_name": {"type": "string"},
@@ -395,6 +413,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # int64  =>  uint64
     schema = {"file_name": {"type": "string"},
@@ -410,6 +430,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # bytes  =>  byte
     schema = {"file_name": {"type": "strint"},
@@ -425,6 +447,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # float32  => float3
     schema = {"file_name": {"type": "string"},
@@ -440,6 +464,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # string with shape
     schema = {"file_name": {"type": "string", "shape": [-1]},
@@ -455,6 +481,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
     # bytes with shape
     schema = {"file_name": {"type": "string"},
@@ -470,6 +498,8 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
 
 def test_write_with_invalid_data():
     mindrecord_file_name = "test.mindrecord"
@@ -478,6 +508,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"filename": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -513,6 +544,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "masks": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -548,6 +580,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -583,6 +616,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "labels": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -618,6 +652,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "scores": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -653,6 +688,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": 1, "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -688,6 +724,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": "cat", "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -723,6 +760,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -758,6 +796,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": [3, 6, 9],
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -793,6 +832,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -827,6 +867,7 @@ def test_write_with_invalid_data():
     # more field is ok
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
              "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -860,3 +901,4 @@ def test_write_with_invalid_data():
 
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
@@ -187,6 +187,8 @@ def test_tfrecord_to_mindrecord():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image_bytes"])
@@ -200,6 +202,8 @@ def test_tfrecord_to_mindrecord():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -226,6 +230,8 @@ def test_tfrecord_to_mindrecord_scalar_with_1():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image_bytes"])
@@ -239,6 +245,8 @@ def test_tfrecord_to_mindrecord_scalar_with_1():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -265,6 +273,8 @@ def test_tfrecord_to_mindrecord_scalar_with_1_list_small_len_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -275,6 +285,8 @@ def test_tfrecord_to_mindrecord_scalar_with_1_list_small_len_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -301,6 +313,8 @@ def test_tfrecord_to_mindrecord_list_with_diff_type_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -311,6 +325,8 @@ def test_tfrecord_to_mindrecord_list_with_diff_type_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -337,6 +353,8 @@ def test_tfrecord_to_mindrecord_list_without_bytes_type():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict)
@@ -350,6 +368,8 @@ def test_tfrecord_to_mindrecord_list_without_bytes_type():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -376,6 +396,8 @@ def test_tfrecord_to_mindrecord_scalar_with_2_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image_bytes"])
@@ -386,6 +408,8 @@ def test_tfrecord_to_mindrecord_scalar_with_2_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -412,6 +436,8 @@ def test_tfrecord_to_mindrecord_scalar_string_with_1_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -422,6 +448,8 @@ def test_tfrecord_to_mindrecord_scalar_string_with_1_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -448,6 +476,8 @@ def test_tfrecord_to_mindrecord_scalar_bytes_with_10_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -458,6 +488,8 @@ def test_tfrecord_to_mindrecord_scalar_bytes_with_10_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -484,6 +516,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_string_type():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -494,6 +528,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_string_type():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -520,6 +556,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_list():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -530,6 +568,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_list():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -552,6 +592,8 @@ def test_tfrecord_to_mindrecord_with_special_field_name():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image/encoded"])
@@ -565,5 +607,7 @@ def test_tfrecord_to_mindrecord_with_special_field_name():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))